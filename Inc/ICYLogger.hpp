@@ -123,6 +123,52 @@ public:
     */
     virtual bool GetStats(STStatistics* pStats) = 0;
 
+    /**
+     * @brief Set the rotation policy of an added appender, replacing the shared size limit for it.
+    */
+    virtual void SetRotation(ELogType eLogType, const STRotationPolicy& objPolicy) = 0;
+
+    /**
+     * @brief Get the enqueue to write latency percentiles of an added appender.
+     * @param bReset start a new measurement window after reading.
+    */
+    virtual bool GetLatency(ELogType eLogType, STLatencyStats* pStats, bool bReset) = 0;
+
+    /**
+     * @brief Get one statistics record per added appender, each record is read consistently without stopping the log thread.
+     * @param pSnapshot header, nRecordSize is set by the caller, the rest by the library.
+     * @param pRecords array of nCapacity records of nRecordSize bytes.
+    */
+    virtual bool GetStatsSnapshot(STStatsSnapshot* pSnapshot, STAppenderStats* pRecords, uint32_t nCapacity) = 0;
+
+    /**
+     * @brief Export the statistics on the schedule thread, starting it if needed. Call it after SetRestriction.
+     * @param pszFile Prometheus text file rewritten every LOG_METRICS_INTERVAL seconds, nullptr or empty disables it.
+     * @param nPort serve the metrics over HTTP on 127.0.0.1:nPort, 0 disables it.
+    */
+    virtual void SetMetrics(const TChar* pszFile, int nPort) = 0;
+
+    /**
+     * @brief Read the lines kept by an appender added with LOG_MODE_FILE_MEMORY, oldest first, each ended by '\n'.
+     * @param pszBuffer receives the lines and a terminating 0 when nSize is larger than their length, nothing is copied otherwise.
+     * @param bClear empty the ring after the lines were copied.
+     * @return length of the kept lines in characters, 0 for any other appender.
+    */
+    virtual uint32_t ReadMemoryLog(ELogType eLogType, TChar* pszBuffer, uint32_t nSize, bool bClear) = 0;
+
+    /**
+     * @brief Get the contention of the named locks, one record per lock name, recorded when LOG_LOCK_PROFILE is set.
+     * @param pRecords array of nCapacity records, records beyond the capacity are not written.
+     * @param bReset start a new measurement window after reading.
+     * @return number of lock names, 0 when LOG_LOCK_PROFILE is not set.
+    */
+    virtual uint32_t GetLockStats(STLockStats* pRecords, uint32_t nCapacity, bool bReset) = 0;
+
+    /**
+     * @brief Write the contention of the named locks to pszFile as a text table, most contended first.
+    */
+    virtual bool DumpLockStats(const TChar* pszFile) = 0;
+
 public:
     /**
      * @brief Get Instance.
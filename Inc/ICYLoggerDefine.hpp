@@ -154,6 +154,52 @@ enum ELogFileMode
 {
     LOG_MODE_FILE_APPEND            = 0x00,         ///< Append log file.
     LOG_MODE_FILE_TIME              = 0x01,         ///< Named log file by time.
+    LOG_MODE_FILE_BINARY            = 0x10,         ///< Write compact binary records instead of text, combine with APPEND or TIME. Only for the TRACE ~ FATAL appenders, decode with cylog-decode.
+    LOG_MODE_FILE_COMPRESS          = 0x20,         ///< Compress text as it is written into CRC checked blocks (<name>.lz), combine with APPEND or TIME. Only for the TRACE ~ FATAL appenders, read with cylog-decode -z.
+    LOG_MODE_FILE_NULL              = 0x40,         ///< Format and count the lines but write nothing, measures the pipeline without I/O. Any appender but the console.
+    LOG_MODE_FILE_MEMORY            = 0x80,         ///< Keep the formatted lines in a ring of LOG_MEMORY_SINK_SIZE characters in RAM, read back with ReadMemoryLog. Any appender but the console.
+    LOG_MODE_FILE_NAME_MASK         = 0x0F,         ///< Bits selecting the naming method.
+};
+
+/**
+ * @brief Log time capture clock. The producer reads this clock once per message, the log thread orders messages by
+ * the raw value and, except for LOG_CLOCK_SYSTEM, breaks it down into local time itself.
+*/
+enum ELogClockMode
+{
+    LOG_CLOCK_SYSTEM                = 0x00,         ///< System clock, broken down on the caller thread.
+    LOG_CLOCK_COARSE                = 0x01,         ///< Coarse realtime clock (CLOCK_REALTIME_COARSE on Linux), millisecond resolution at a fraction of the cost, no localtime on the caller thread.
+    LOG_CLOCK_TSC                   = 0x02,         ///< Raw time stamp counter, converted to wall clock time by the backend.
+};
+
+/**
+ * @brief Rotated log file compression codec.
+*/
+enum ELogZipCodec
+{
+    LOG_ZIP_NONE                    = 0x00,         ///< Keep rotated log files uncompressed.
+    LOG_ZIP_LZ                      = 0x01,         ///< Built-in LZ codec, no dependency (.lz).
+    LOG_ZIP_GZIP                    = 0x02,         ///< gzip through zlib (.gz), falls back to LOG_ZIP_LZ when built without zlib.
+};
+
+/**
+ * @brief Wall clock boundary a log file is rotated at.
+*/
+enum ELogRotateTime
+{
+    LOG_ROTATE_TIME_NONE            = 0x00,         ///< No time based rotation.
+    LOG_ROTATE_TIME_HOURLY          = 0x01,         ///< Rotate at every local hour.
+    LOG_ROTATE_TIME_DAILY           = 0x02,         ///< Rotate at every local midnight.
+};
+
+/**
+ * @brief Rotation policy of one LOG_MODE_FILE_TIME appender, the file is rotated at whichever limit is reached first.
+*/
+struct STRotationPolicy
+{
+    uint64_t       nMaxBytes        = 0;                        ///< Rotate once the file grows past this many bytes, 0 uses the nCheckFileSize of SetRestriction.
+    uint64_t       nMaxLines        = 0;                        ///< Rotate once the file holds this many lines, 0 disables the limit.
+    ELogRotateTime eRotateTime      = LOG_ROTATE_TIME_NONE;     ///< Rotate at this wall clock boundary.
 };
 
 /**
@@ -167,6 +213,73 @@ enum ELogLayoutType
     LOG_LAYOUT_TYPE_BUILDIN_3       = 0x03,         ///< Log built-in template 3.
 };
 
+/**
+ * @brief Enqueue to write latency of one appender, in nanoseconds. Percentiles are bucket upper bounds, within about 3% of the exact value.
+*/
+struct STLatencyStats
+{
+    uint64_t nCount                 = 0;             ///< Messages recorded since the last reset.
+    uint64_t nP50                   = 0;             ///< Median latency.
+    uint64_t nP90                   = 0;             ///< 90th percentile latency.
+    uint64_t nP99                   = 0;             ///< 99th percentile latency.
+    uint64_t nP999                  = 0;             ///< 99.9th percentile latency.
+    uint64_t nMax                   = 0;             ///< Largest latency.
+};
+
+/**
+ * @brief Version of STAppenderStats, raised whenever fields are appended to it.
+*/
+static constexpr uint32_t LOG_STATS_VERSION = 1;
+
+/**
+ * @brief Statistics of one added appender. Fields are only ever appended, see STStatsSnapshot::nRecordSize.
+*/
+struct STAppenderStats
+{
+    ELogType eLogType               = LOG_TYPE_NONE; ///< Type the appender was added as.
+    char     szName[32]             = {};            ///< Log thread name of the appender.
+    uint64_t nLine                  = 0;             ///< Lines written.
+    uint64_t nByte                  = 0;             ///< Bytes written.
+    uint64_t nDrop                  = 0;             ///< Lines dropped because the sink was full or unreachable.
+    double   fCurrentFps            = 0;             ///< The current fps written.
+    double   fAverageFps            = 0;             ///< The average fps written.
+    uint32_t nQueueDepth            = 0;             ///< Messages taken over by the last flip of the queue.
+    uint32_t nQueueDepthMax         = 0;             ///< Largest nQueueDepth seen.
+    uint64_t nBatchCount            = 0;             ///< Batches written.
+    uint32_t nBatchLast             = 0;             ///< Lines of the last batch.
+    uint32_t nBatchMax              = 0;             ///< Lines of the largest batch.
+    uint64_t nWriteTime             = 0;             ///< Time spent formatting and writing the lines of all batches, in nanoseconds.
+    uint64_t nWriteTimeMax          = 0;             ///< Longest write of one batch, in nanoseconds.
+    uint64_t nFlushTime             = 0;             ///< Time spent in the end of batch flush of all batches, in nanoseconds.
+    uint64_t nFlushTimeMax          = 0;             ///< Longest end of batch flush, in nanoseconds.
+    STLatencyStats objLatency;                       ///< Enqueue to write latency since the last reset through GetLatency.
+};
+
+/**
+ * @brief Header of a statistics snapshot. The library writes at most nRecordSize bytes per record and steps through
+ *        the array by nRecordSize, so a caller built against an older STAppenderStats keeps working.
+*/
+struct STStatsSnapshot
+{
+    uint32_t nVersion               = LOG_STATS_VERSION;        ///< Set by the library to its LOG_STATS_VERSION.
+    uint32_t nRecordSize            = sizeof(STAppenderStats);  ///< Size of one record of the caller's array.
+    uint32_t nCount                 = 0;                        ///< Added appenders, records beyond the capacity are not written.
+    uint64_t nTimestamp             = 0;                        ///< Steady clock time the snapshot was taken at, in nanoseconds.
+};
+
+/**
+ * @brief Contention of all named locks sharing one name, recorded when LOG_LOCK_PROFILE is set. Times are in nanoseconds.
+*/
+struct STLockStats
+{
+    char     szName[64]             = {};            ///< Name the locks were created with.
+    uint32_t nInstance              = 0;             ///< Locks created with this name.
+    uint64_t nAcquire               = 0;             ///< Acquisitions.
+    uint64_t nContend               = 0;             ///< Acquisitions that found the lock held by another thread.
+    STLatencyStats objWait;                          ///< Wait of the contended acquisitions.
+    STLatencyStats objHold;                          ///< Time from acquiring to releasing the lock.
+};
+
 /**
  * @brief Log statistics.
 */
@@ -270,10 +383,45 @@ CYLOGGER_NAMESPACE_END
 // CYLogger Config.
 //////////////////////////////////////////////////////////////////////////
 static constexpr bool                               LOG_SHOW_CONSOLE_WINDOW = false;                ///< Whether the console log displays the window.
+static constexpr bool                               LOG_CONSOLE_COLOR = true;                       ///< Color console lines by level with ANSI escapes on POSIX, only when stdout is a terminal.
+static constexpr bool                               LOG_CONSOLE_NONBLOCK = false;                   ///< Drop console output instead of stalling the console thread when stdout is a slow pipe or terminal.
 static constexpr bool                               LOG_WRITE_REMOTE = false;                       ///< Whether to write logs to remote.
+static constexpr int                                LOG_REMOTE_MTU = 1400;                          ///< Largest UDP payload the remote appender packs lines into, in bytes. Keep it below the path MTU to avoid IP fragmentation.
+static constexpr int                                LOG_REMOTE_BATCH_COUNT = 64;                    ///< Datagrams handed to the kernel per send call (sendmmsg on Linux), bounds the pending batch to LOG_REMOTE_MTU * LOG_REMOTE_BATCH_COUNT bytes.
+static constexpr int                                LOG_REMOTE_RETRY_BUFFER = 4 * 1024 * 1024;      ///< Bytes of framed lines a stream remote appender (tcp:// or unix://) keeps while the collector is slow or unreachable, newer lines are dropped beyond it.
+static constexpr int                                LOG_REMOTE_RECONNECT_MIN = 100;                 ///< First reconnect delay of a stream remote appender, doubled after each failure, in milliseconds.
+static constexpr int                                LOG_REMOTE_RECONNECT_MAX = 30 * 1000;           ///< Largest reconnect delay of a stream remote appender, in milliseconds.
+static constexpr int                                LOG_REMOTE_CONNECT_TIMEOUT = 3000;              ///< Time a stream remote appender waits for one address to accept before trying the next, in milliseconds.
+static constexpr int                                LOG_REMOTE_FLUSH_TIMEOUT = 1000;                ///< Time a stream remote appender keeps sending pending lines when it stops, in milliseconds.
+static constexpr uint64_t                           LOG_REMOTE_SPILL_SIZE = 256ULL * 1024 * 1024;   ///< Disk budget of the segment files a stream remote appender spills to once LOG_REMOTE_RETRY_BUFFER is full, 0 disables spilling.
+static constexpr uint64_t                           LOG_REMOTE_SPILL_SEGMENT = 16ULL * 1024 * 1024; ///< Size of one spill segment file, a segment is deleted once all of its lines have been sent.
 static constexpr bool                               LOG_WRITE_SYS = false;                          ///< Whether to write the error log to the system event log, only applicable to Windows operating system.
+static constexpr int                                LOG_SYSLOG_BATCH_COUNT = 64;                    ///< Syslog frames or journal entries handed to the kernel per sendmmsg call on Linux.
+static constexpr int                                LOG_SYSLOG_RECONNECT = 1000;                    ///< Smallest delay between two attempts to connect the syslog socket, in milliseconds.
+static constexpr int                                LOG_SYSLOG_SEND_TIMEOUT = 1000;                 ///< Time a send to a full syslog or journal socket may block before the rest of the batch is dropped and counted, in milliseconds. syslog(3) would block instead.
 static constexpr CYLOGGER_NAMESPACE::ELogFileMode   LOG_FILE_MODE = CYLOGGER_NAMESPACE::ELogFileMode::LOG_MODE_FILE_TIME;    ///< Log file naming method.
 static constexpr CYLOGGER_NAMESPACE::ELogLayoutType LOG_LAYOUT_TYPE = CYLOGGER_NAMESPACE::ELogLayoutType::LOG_LAYOUT_TYPE_BUILDIN_1; ///< Default log layout template.
+static constexpr CYLOGGER_NAMESPACE::ELogClockMode  LOG_TIME_CLOCK_MODE = CYLOGGER_NAMESPACE::ELogClockMode::LOG_CLOCK_SYSTEM; ///< Clock used to capture the log time, the only clock a producer reads.
+static constexpr int                                LOG_TSC_INIT_CALIBRATE_TIME = 10;               ///< Initial TSC calibration time, in milliseconds.
+static constexpr int                                LOG_TSC_CALIBRATE_TIME = 1;                     ///< TSC recalibration interval on the log and schedule threads, in seconds.
+static constexpr double                             LOG_TSC_MAX_DRIFT = 0.001;                      ///< Largest relative change of the TSC rate a recalibration accepts, a larger one means the realtime clock was stepped.
+static constexpr int                                LOG_TSC_MAX_SLEW = 100;                         ///< Largest gap between the TSC mapping and the realtime clock slewed away without a jump, in milliseconds.
+static constexpr int                                LOG_SCHEDULE_INTERVAL = 1000;                   ///< Schedule thread wake up interval, in milliseconds.
+static constexpr bool                               LOG_FILE_STANDBY = true;                        ///< Size rotation of LOG_MODE_FILE_TIME text files swaps to a standby file created and preallocated on the schedule thread, the rotated file is closed there too.
+static constexpr int                                LOG_NEW_FILE_TIMEOUT = 3000;                    ///< Longest wait of the schedule thread for the appenders to open new files before an upload, in milliseconds.
+static constexpr CYLOGGER_NAMESPACE::ELogZipCodec   LOG_ZIP_CODEC = CYLOGGER_NAMESPACE::ELogZipCodec::LOG_ZIP_GZIP; ///< Codec used to compress rotated log files on the schedule thread.
+static constexpr int                                LOG_ZIP_CHECK_TIME = 60;                        ///< Interval for compressing rotated log files, in seconds.
+static constexpr int                                LOG_ZIP_IDLE_TIME = 30;                         ///< A rotated log file is compressed once it has not been written for this many seconds.
+static constexpr int                                LOG_ZIP_BLOCK_SIZE = 64 * 1024;                 ///< Compression block size in bytes, bounds the memory used while compressing.
+static constexpr long long                          LOG_ZIP_MAX_BYTES = 64LL * 1024 * 1024;         ///< Log bytes compressed per schedule wake up at most, the remaining files are compressed at the next wake ups.
+static constexpr size_t                             LOG_CACHE_LINE_SIZE = 64;                       ///< Alignment of the statistics counter blocks, so counters written by different threads never share a cache line.
+static constexpr bool                               LOG_LATENCY_STATS = true;                       ///< Stamp each message when it is queued and record its enqueue to write latency in a histogram per appender, see GetLatency.
+static constexpr size_t                             LOG_STATS_SHARD_COUNT = 16;                     ///< Shards of the statistics counters written by every log thread, each thread adds to its own shard and the shards are summed when read.
+static constexpr int                                LOG_METRICS_INTERVAL = 15;                      ///< Interval for rewriting the metrics file set by SetMetrics, in seconds.
+static constexpr int                                LOG_METRICS_HTTP_TIMEOUT = 100;                 ///< Longest time the schedule thread spends on one metrics HTTP client, reading its request and sending the answer, in milliseconds.
+static constexpr int                                LOG_METRICS_HTTP_CLIENTS = 8;                   ///< Most metrics HTTP clients answered per schedule wake-up, the others wait in the listen backlog.
+static constexpr size_t                             LOG_MEMORY_SINK_SIZE = 1024 * 1024;             ///< Characters kept by a LOG_MODE_FILE_MEMORY appender, the oldest whole lines are dropped first.
+static constexpr bool                               LOG_LOCK_PROFILE = false;                       ///< Record acquisitions, contention, wait and hold times of every named lock, see GetLockStats. Each lock then reads the clock up to three times.
 
 // CYLogger Limit.
 //////////////////////////////////////////////////////////////////////////
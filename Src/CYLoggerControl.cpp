@@ -7,7 +7,15 @@
 #include "Common/CYFileRestriction.hpp"
 #include "Entity/Filter/CYLoggerPatternFilterManager.hpp"
 #include "Entity/Layout/CYLoggerTemplateLayoutManager.hpp"
+#include "Common/Time/CYTscClock.hpp"
+#include "Statistics/CYLatencyHistogram.hpp"
+#include "Statistics/CYLockProfile.hpp"
+#include "Common/CYTraceProbe.hpp"
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
 
 CYLOGGER_NAMESPACE_BEGIN
 
@@ -27,6 +35,11 @@ CYLoggerControl::~CYLoggerControl()
 */
 bool CYLoggerControl::Init()
 {
+	if constexpr (LOG_TIME_CLOCK_MODE == ELogClockMode::LOG_CLOCK_TSC)
+	{
+		CYTscClock::Init();
+	}
+
 	m_ptrSchedule = MakeUnique<CYLoggerSchedule>("ScheduleThread");
 	IfTrueThrow(nullptr == m_ptrSchedule, TEXT("m_ptrSchedule cannot be empty."));
 	return true;
@@ -73,15 +86,16 @@ bool CYLoggerControl::AddApender(ELogType eLogType, const TChar* szChannel, cons
 	IfTrueThrow(nullptr == m_ptrSchedule, TEXT("m_ptrSchedule cannot be empty."));
 	m_ptrSchedule->AddLogType(eLogType);
 
-    if (eLogType != LOG_TYPE_REMOTE)
+    if (eLogType != LOG_TYPE_REMOTE && eLogType != LOG_TYPE_SYS)
     {
-        TString strLogFile = CYPathConvert::GetLogFilePath(szChannel, szFile, eFileMode);
+        TString strLogFile = CYPathConvert::GetLogFilePath(szChannel, szFile, static_cast<ELogFileMode>(eFileMode & LOG_MODE_FILE_NAME_MASK));
         TString strLogPath = CYPathConvert::ConvertFilePath(strLogFile.c_str(), LoggerConfig()->GetLogPath().c_str(), LOG_DIR);
         m_arrayEntity[eLogType] = CYLoggerEntityFactory::CreateEntity(eLogType, strLogPath, eFileMode);
     }
     else
     {
-        m_arrayEntity[eLogType] = CYLoggerEntityFactory::CreateEntity(eLogType, szFile, eFileMode);
+        // Remote address or system log app name, used as given.
+        m_arrayEntity[eLogType] = CYLoggerEntityFactory::CreateEntity(eLogType, szFile ? szFile : TEXT(""), eFileMode);
     }
 
 	IfTrueThrow(nullptr == m_arrayEntity[eLogType], TEXT("CreateEntity failed!"));
@@ -91,13 +105,15 @@ bool CYLoggerControl::AddApender(ELogType eLogType, const TChar* szChannel, cons
 /**
 * @brief Put message to the Log
 */
-void CYLoggerControl::WriteLog(int nLogLevel, const SharePtr<CYBaseMessage>& ptrMessage)
+void CYLoggerControl::WriteLog(int nLogLevel, const SharePtr<CYLoggerMessage>& ptrMessage)
 {
     IfTrueThrow(!ptrMessage, TEXT("ptrMessage cannot be empty"));
 
 	if (0 == (m_eLogFilterLevel & nLogLevel))
 		return;
 
+	CY_PROBE_ENQUEUE(nLogLevel, ptrMessage->GetMsgType(), ptrMessage->GetMsgBytes());
+
 	if (!m_arrayEntity[LOG_TYPE_NONE])
 	{
 		m_arrayEntity[LOG_TYPE_NONE] = CYLoggerEntityFactory::CreateEntity(ELogType::LOG_TYPE_NONE, TString(), ELogFileMode::LOG_MODE_FILE_APPEND);
@@ -186,6 +202,27 @@ void CYLoggerControl::SetRestriction(bool bEnableCheck, bool m_bClearUnLogFile,
     if (bEnableCheck) m_ptrSchedule->StartSchedule();
 }
 
+/**
+ * @brief Export the statistics on the schedule thread, the schedule is started if SetRestriction did not.
+*/
+void CYLoggerControl::SetMetrics(const TChar* pszFile, int nPort)
+{
+	IfTrueThrow(!m_ptrSchedule, TEXT("m_ptrSchedule cannot be empty"));
+
+	m_ptrSchedule->SetMetrics(pszFile ? TString(pszFile) : TString(), nPort);
+	m_ptrSchedule->StartSchedule();
+}
+
+/**
+ * @brief Set the rotation policy of an added appender.
+*/
+void CYLoggerControl::SetRotation(ELogType eLogType, const STRotationPolicy& objPolicy)
+{
+	IfTrueThrow(eLogType < 0 || eLogType >= ELogType::LOG_TYPE_MAX, TEXT("eLogType out of range."));
+	IfTrueThrow(nullptr == m_arrayEntity[eLogType], TEXT("m_arrayEntity[eLogType] was empty."));
+	m_arrayEntity[eLogType]->SetRotation(objPolicy);
+}
+
 /**
  * @brief Log special character filtering.
  * @param pFilter needs to be saved globally, and its scope is larger than the log library instance.
@@ -278,7 +315,7 @@ bool CYLoggerControl::GetStats(STStatistics* pStats)
 	fTotalCurrentFps += pStats->fRemoteCurrentFps;
 	fTotalCurrentFps += pStats->fSysCurrentFps;
 
-	pStats->fSysCurrentFps = fTotalCurrentFps;
+	pStats->fTotalCurrentFps = fTotalCurrentFps;
 
     fTotalAverageFps += pStats->fConsoleAverageFps;
     fTotalAverageFps += pStats->fTraceAverageFps;
@@ -291,7 +328,7 @@ bool CYLoggerControl::GetStats(STStatistics* pStats)
     fTotalAverageFps += pStats->fRemoteAverageFps;
     fTotalAverageFps += pStats->fSysAverageFps;
 
-    pStats->fSysCurrentFps = fTotalAverageFps;
+    pStats->fTotalAverageFps = fTotalAverageFps;
 
     //////////////////////////////////////////////////////////////////////////
     pStats->nConsolePublicDQueue = Statistics()->GetConsolePublicDQueue();
@@ -383,4 +420,101 @@ bool CYLoggerControl::GetStats(STStatistics* pStats)
 	return true;
 }
 
+/**
+ * @brief Get the enqueue to write latency percentiles of an added appender.
+*/
+bool CYLoggerControl::GetLatency(ELogType eLogType, STLatencyStats* pStats, bool bReset)
+{
+    IfTrueThrow(!pStats, TEXT("pStats cannot be empty"));
+	IfTrueThrow(eLogType < 0 || eLogType >= ELogType::LOG_TYPE_MAX, TEXT("eLogType out of range."));
+	IfTrueThrow(nullptr == m_arrayEntity[eLogType], TEXT("m_arrayEntity[eLogType] was empty."));
+	m_arrayEntity[eLogType]->GetLatency(*pStats, bReset);
+	return true;
+}
+
+/**
+ * @brief Get one statistics record per added appender, in ELogType order.
+*/
+bool CYLoggerControl::GetStatsSnapshot(STStatsSnapshot* pSnapshot, STAppenderStats* pRecords, uint32_t nCapacity)
+{
+    IfTrueThrow(!pSnapshot, TEXT("pSnapshot cannot be empty"));
+    IfTrueThrow(nCapacity > 0 && !pRecords, TEXT("pRecords cannot be empty"));
+    IfTrueThrow(pSnapshot->nRecordSize == 0, TEXT("nRecordSize cannot be 0"));
+
+    // The caller's records may be older and shorter than STAppenderStats, or newer and longer.
+    const size_t nCopySize = (std::min)(static_cast<size_t>(pSnapshot->nRecordSize), sizeof(STAppenderStats));
+    char* pRecord = reinterpret_cast<char*>(pRecords);
+
+    pSnapshot->nVersion = LOG_STATS_VERSION;
+    pSnapshot->nTimestamp = static_cast<uint64_t>(CYLatencyHistogram::Now());
+    pSnapshot->nCount = 0;
+    for (auto& ptrEntity : m_arrayEntity)
+    {
+        STAppenderStats objStats;
+        if (!ptrEntity || !ptrEntity->GetStats(objStats))
+            continue;
+
+        if (pSnapshot->nCount < nCapacity)
+        {
+            std::memcpy(pRecord, &objStats, nCopySize);
+            pRecord += pSnapshot->nRecordSize;
+        }
+        pSnapshot->nCount++;
+    }
+    return true;
+}
+
+/**
+ * @brief Read the lines kept by a memory appender, 0 for any other appender.
+*/
+uint32_t CYLoggerControl::ReadMemoryLog(ELogType eLogType, TChar* pszBuffer, uint32_t nSize, bool bClear)
+{
+    IfTrueThrow(nSize > 0 && !pszBuffer, TEXT("pszBuffer cannot be empty"));
+    IfTrueThrow(eLogType < 0 || eLogType >= ELogType::LOG_TYPE_MAX, TEXT("eLogType out of range."));
+    IfTrueThrow(nullptr == m_arrayEntity[eLogType], TEXT("m_arrayEntity[eLogType] was empty."));
+    return static_cast<uint32_t>(m_arrayEntity[eLogType]->ReadMemory(pszBuffer, nSize, bClear));
+}
+
+/**
+ * @brief Get the contention of the named locks, one record per lock name.
+*/
+uint32_t CYLoggerControl::GetLockStats(STLockStats* pRecords, uint32_t nCapacity, bool bReset)
+{
+    IfTrueThrow(nCapacity > 0 && !pRecords, TEXT("pRecords cannot be empty"));
+
+    std::vector<STLockStats> vecStats;
+    CYLockProfile::GetStats(vecStats, bReset);
+    std::copy_n(vecStats.begin(), (std::min)(vecStats.size(), static_cast<size_t>(nCapacity)), pRecords);
+    return static_cast<uint32_t>(vecStats.size());
+}
+
+/**
+ * @brief Write the contention of the named locks to a file, most contended first, times in microseconds.
+*/
+bool CYLoggerControl::DumpLockStats(const TChar* pszFile)
+{
+    IfTrueThrow(!pszFile || !pszFile[0], TEXT("pszFile cannot be empty"));
+
+    std::vector<STLockStats> vecStats;
+    CYLockProfile::GetStats(vecStats, false);
+    std::stable_sort(vecStats.begin(), vecStats.end(), [](const STLockStats& a, const STLockStats& b) { return a.nContend > b.nContend; });
+
+    std::ofstream objFile(pszFile, std::ios::binary | std::ios::trunc);
+    IfTrueThrow(!objFile, TString(TEXT("cannot open file ")) += pszFile);
+
+    char szLine[256];
+    std::snprintf(szLine, sizeof(szLine), "%-32s %5s %12s %12s %10s %10s %10s %10s %10s %10s\n",
+        "lock", "count", "acquire", "contend", "wait_p50", "wait_p99", "wait_max", "hold_p50", "hold_p99", "hold_max");
+    objFile << szLine;
+    for (const STLockStats& objStats : vecStats)
+    {
+        std::snprintf(szLine, sizeof(szLine), "%-32s %5u %12llu %12llu %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+            objStats.szName, objStats.nInstance, static_cast<unsigned long long>(objStats.nAcquire), static_cast<unsigned long long>(objStats.nContend),
+            objStats.objWait.nP50 / 1e3, objStats.objWait.nP99 / 1e3, objStats.objWait.nMax / 1e3,
+            objStats.objHold.nP50 / 1e3, objStats.objHold.nP99 / 1e3, objStats.objHold.nMax / 1e3);
+        objFile << szLine;
+    }
+    return static_cast<bool>(objFile);
+}
+
 CYLOGGER_NAMESPACE_END
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include "Inc/ICYLogger.hpp"
 #include "Common/CYPrivateDefine.hpp"
 #include "Entity/CYLoggerEntity.hpp"
-#include "CYCommon/Common/Message/CYBaseMessage.hpp"
+#include "Common/Message/CYLoggerMessage.hpp"
 
 #include <array>
 
@@ -38,7 +38,7 @@ public:
 	/**
 	* @brief Put message to the Log
 	*/
-	virtual void WriteLog(int nLogLevel, const SharePtr<CYBaseMessage>& ptrMessage);
+	virtual void WriteLog(int nLogLevel, const SharePtr<CYLoggerMessage>& ptrMessage);
 
 	/**
 	 * @brief Get Log Filter Level.
@@ -51,6 +51,11 @@ public:
     */
 	virtual void SetRestriction(bool bEnableCheck, bool m_bClearUnLogFile, int nLimitTimeClearLog, int nLimitTimeExpiredFile, int nCheckFileSizeTime, int nCheckFileCountTime, int nCheckFileSize, int nFileCountPerType, int nCheckFileTypeSize, int nCheckALLFileSize);
 
+    /**
+     * @brief Set the rotation policy of an added appender.
+    */
+    virtual void SetRotation(ELogType eLogType, const STRotationPolicy& objPolicy);
+
     /**
      * @brief Log special character filtering.
      * @param pFilter needs to be saved globally, and its scope is larger than the log library instance.
@@ -68,6 +73,36 @@ public:
     */
 	virtual bool GetStats(STStatistics* pStats);
 
+    /**
+     * @brief Get the enqueue to write latency percentiles of an added appender.
+    */
+	virtual bool GetLatency(ELogType eLogType, STLatencyStats* pStats, bool bReset);
+
+    /**
+     * @brief Get one statistics record per added appender.
+    */
+	virtual bool GetStatsSnapshot(STStatsSnapshot* pSnapshot, STAppenderStats* pRecords, uint32_t nCapacity);
+
+    /**
+     * @brief Export the statistics on the schedule thread.
+    */
+	virtual void SetMetrics(const TChar* pszFile, int nPort);
+
+    /**
+     * @brief Read the lines kept by a memory appender.
+    */
+	virtual uint32_t ReadMemoryLog(ELogType eLogType, TChar* pszBuffer, uint32_t nSize, bool bClear);
+
+    /**
+     * @brief Get the contention of the named locks.
+    */
+	virtual uint32_t GetLockStats(STLockStats* pRecords, uint32_t nCapacity, bool bReset);
+
+    /**
+     * @brief Write the contention of the named locks to a file.
+    */
+	virtual bool DumpLockStats(const TChar* pszFile);
+
 private:
 	/**
 	 * @brief Log cleaning and other scheduling.
@@ -3,6 +3,7 @@
 #include "Config/CYLoggerConfig.hpp"
 #include "Common/CYPublicFunction.hpp"
 #include "Common/Message/CYEscapeMessage.hpp"
+#include "Common/Message/CYLogArgs.hpp"
 #include "Common/Message/CYNormalMessage.hpp"
 #include "Common/Message/CYStrMessage.hpp"
 #include "CYCommon/Common/Exception/CYException.hpp"
@@ -167,6 +168,21 @@ void CYLLoggerImpl::WriteLog(int nLogLevel, ELogType eMsgType, int nSeverCode, c
     EXCEPTION_BEGIN
     {
         va_list args;
+    #if !CY_USE_UNICODE
+        // Capture the arguments by type, the log thread renders the text.
+        std::string strArgs;
+        va_start(args, szMsg);
+        bool bCaptured = CYLogArgs::Capture(szMsg, args, strArgs);
+        va_end(args);
+        if (bCaptured)
+        {
+            SharePtr<CYNormalMessage> ptrMessage = MakeShared<CYNormalMessage>(TEXT(""), eMsgType, nSeverCode, szMsg, pszFile, pszFuncName, nLine);
+            ptrMessage->SetArgs(std::move(strArgs));
+            m_ptrLoggerControl->WriteLog(nLogLevel, ptrMessage);
+            return;
+        }
+    #endif
+
     #if defined(CYLOGGER_WIN_OS) && CY_USE_UNICODE
         va_start(args, szMsg);
         int iLen = cy_vscprintf(szMsg, args) + 1;
@@ -222,6 +238,21 @@ void CYLLoggerImpl::WriteEscapeLog(int nLogLevel, ELogType eMsgType, int nSeverC
 	EXCEPTION_BEGIN
 	{
         va_list args;
+    #if !CY_USE_UNICODE
+        // Capture the arguments by type, the log thread renders the text.
+        std::string strArgs;
+        va_start(args, szMsg);
+        bool bCaptured = CYLogArgs::Capture(szMsg, args, strArgs);
+        va_end(args);
+        if (bCaptured)
+        {
+            SharePtr<CYEscapeMessage> ptrMessage = MakeShared<CYEscapeMessage>(TEXT(""), eMsgType, nSeverCode, szMsg, pszFile, pszFuncName, nLine);
+            ptrMessage->SetArgs(std::move(strArgs));
+            m_ptrLoggerControl->WriteLog(nLogLevel, ptrMessage);
+            return;
+        }
+    #endif
+
     #if defined(CYLOGGER_WIN_OS) && CY_USE_UNICODE
         va_start(args, szMsg);
         int iLen = cy_vscprintf(szMsg, args) + 1;
@@ -330,6 +361,23 @@ void CYLLoggerImpl::SetRestriction(bool bEnableCheck, bool m_bClearUnLogFile, in
     EXCEPTION_END
 }
 
+/**
+ * @brief Set the rotation policy of an added appender, replacing the shared size limit for it.
+*/
+void CYLLoggerImpl::SetRotation(ELogType eLogType, const STRotationPolicy& objPolicy) noexcept
+{
+    EXCEPTION_BEGIN
+    {
+        IfTrueThrow(!m_ptrLoggerControl, TEXT("m_ptrLoggerControl cannot be empty"));
+
+        if (m_bExit)
+            return;
+
+        m_ptrLoggerControl->SetRotation(eLogType, objPolicy);
+    }
+    EXCEPTION_END
+}
+
 /**
  * @brief Log special character filtering.
  * @param pFilter needs to be saved globally, and its scope is larger than the log library instance.
@@ -385,6 +433,113 @@ bool CYLLoggerImpl::GetStats(STStatistics* pStats) noexcept
     return false;
 }
 
+/**
+ * @brief Get the enqueue to write latency percentiles of an added appender.
+*/
+bool CYLLoggerImpl::GetLatency(ELogType eLogType, STLatencyStats* pStats, bool bReset) noexcept
+{
+    EXCEPTION_BEGIN
+    {
+        IfTrueThrow(!m_ptrLoggerControl, TEXT("m_ptrLoggerControl cannot be empty"));
+
+        if (m_bExit)
+            return false;
+
+        return m_ptrLoggerControl->GetLatency(eLogType, pStats, bReset);
+    }
+    EXCEPTION_END
+    return false;
+}
+
+/**
+ * @brief Get one statistics record per added appender.
+*/
+bool CYLLoggerImpl::GetStatsSnapshot(STStatsSnapshot* pSnapshot, STAppenderStats* pRecords, uint32_t nCapacity) noexcept
+{
+    EXCEPTION_BEGIN
+    {
+        IfTrueThrow(!m_ptrLoggerControl, TEXT("m_ptrLoggerControl cannot be empty"));
+
+        if (m_bExit)
+            return false;
+
+        return m_ptrLoggerControl->GetStatsSnapshot(pSnapshot, pRecords, nCapacity);
+    }
+    EXCEPTION_END
+    return false;
+}
+
+/**
+ * @brief Export the statistics on the schedule thread.
+*/
+void CYLLoggerImpl::SetMetrics(const TChar* pszFile, int nPort) noexcept
+{
+    EXCEPTION_BEGIN
+    {
+        IfTrueThrow(!m_ptrLoggerControl, TEXT("m_ptrLoggerControl cannot be empty"));
+
+        if (m_bExit)
+            return;
+
+        m_ptrLoggerControl->SetMetrics(pszFile, nPort);
+    }
+    EXCEPTION_END
+}
+
+/**
+ * @brief Read the lines kept by a memory appender.
+*/
+uint32_t CYLLoggerImpl::ReadMemoryLog(ELogType eLogType, TChar* pszBuffer, uint32_t nSize, bool bClear) noexcept
+{
+    EXCEPTION_BEGIN
+    {
+        IfTrueThrow(!m_ptrLoggerControl, TEXT("m_ptrLoggerControl cannot be empty"));
+
+        if (m_bExit)
+            return 0;
+
+        return m_ptrLoggerControl->ReadMemoryLog(eLogType, pszBuffer, nSize, bClear);
+    }
+    EXCEPTION_END
+    return 0;
+}
+
+/**
+ * @brief Get the contention of the named locks.
+*/
+uint32_t CYLLoggerImpl::GetLockStats(STLockStats* pRecords, uint32_t nCapacity, bool bReset) noexcept
+{
+    EXCEPTION_BEGIN
+    {
+        IfTrueThrow(!m_ptrLoggerControl, TEXT("m_ptrLoggerControl cannot be empty"));
+
+        if (m_bExit)
+            return 0;
+
+        return m_ptrLoggerControl->GetLockStats(pRecords, nCapacity, bReset);
+    }
+    EXCEPTION_END
+    return 0;
+}
+
+/**
+ * @brief Write the contention of the named locks to a file.
+*/
+bool CYLLoggerImpl::DumpLockStats(const TChar* pszFile) noexcept
+{
+    EXCEPTION_BEGIN
+    {
+        IfTrueThrow(!m_ptrLoggerControl, TEXT("m_ptrLoggerControl cannot be empty"));
+
+        if (m_bExit)
+            return false;
+
+        return m_ptrLoggerControl->DumpLockStats(pszFile);
+    }
+    EXCEPTION_END
+    return false;
+}
+
 /**
  * @brief Get Log Filter Level.
 */
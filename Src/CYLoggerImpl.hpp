@@ -70,6 +70,41 @@ public:
     */
 	virtual bool GetStats(STStatistics* pStats) noexcept override;
 
+    /**
+     * @brief Set the rotation policy of an added appender, replacing the shared size limit for it.
+    */
+    virtual void SetRotation(ELogType eLogType, const STRotationPolicy& objPolicy) noexcept override;
+
+    /**
+     * @brief Get the enqueue to write latency percentiles of an added appender.
+    */
+	virtual bool GetLatency(ELogType eLogType, STLatencyStats* pStats, bool bReset) noexcept override;
+
+    /**
+     * @brief Get one statistics record per added appender.
+    */
+	virtual bool GetStatsSnapshot(STStatsSnapshot* pSnapshot, STAppenderStats* pRecords, uint32_t nCapacity) noexcept override;
+
+    /**
+     * @brief Export the statistics on the schedule thread.
+    */
+	virtual void SetMetrics(const TChar* pszFile, int nPort) noexcept override;
+
+    /**
+     * @brief Read the lines kept by a memory appender.
+    */
+	virtual uint32_t ReadMemoryLog(ELogType eLogType, TChar* pszBuffer, uint32_t nSize, bool bClear) noexcept override;
+
+    /**
+     * @brief Get the contention of the named locks.
+    */
+	virtual uint32_t GetLockStats(STLockStats* pRecords, uint32_t nCapacity, bool bReset) noexcept override;
+
+    /**
+     * @brief Write the contention of the named locks to a file.
+    */
+	virtual bool DumpLockStats(const TChar* pszFile) noexcept override;
+
 	/**
 	 * @brief Get Log Filter Level.
 	*/
@@ -0,0 +1,239 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_BINARY_LOG_FORMAT_HPP__
+#define __CY_BINARY_LOG_FORMAT_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+
+#include <string>
+#include <string_view>
+#include <istream>
+#include <cstdint>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Binary log file layout.
+ *
+ * File    : MAGIC(4) VERSION(1) PID(varint) BASE_TIME_NS(fixed64) { RECORD }
+ * CALLSITE: TAG(1) ID(varint) FILE(string) FUNCTION(string) LINE(varint) FORMAT(string)
+ * LOG     : TAG(1) SEQ(varint) DELTA_TIME_NS(zigzag) CALLSITE_ID(varint) LEVEL(1) SERVER_CODE(zigzag) TID(varint) CHANNEL(string) ARGS(string)
+ * ARGS    : { TYPE(1) VALUE }, one entry per '*' and conversion of FORMAT, see EBinaryArgType.
+ *
+ * Strings are a varint byte length followed by UTF-8 bytes, at most LOG_BINARY_MAX_STRING of them. Call site ids count up
+ * from 0 in each segment. A call site is emitted once per file, before its first record.
+ * The time delta is relative to the previous LOG record, or to BASE_TIME_NS for the first one.
+ * Text that was not written through a printf format is stored with the format "%s" and a single string argument.
+*/
+static constexpr char    LOG_BINARY_MAGIC[4] = { 'C', 'Y', 'L', 'B' };
+static constexpr uint8_t LOG_BINARY_VERSION = 2;
+static constexpr size_t  LOG_BINARY_MAX_STRING = 16 * 1024 * 1024;
+
+/**
+ * @brief Binary record tag.
+*/
+enum EBinaryRecordTag : uint8_t
+{
+    BINARY_TAG_CALLSITE     = 0x01,                 ///< Call site dictionary entry.
+    BINARY_TAG_LOG          = 0x02,                 ///< Log record.
+};
+
+/**
+ * @brief Type of a captured printf argument.
+*/
+enum EBinaryArgType : uint8_t
+{
+    BINARY_ARG_SIGNED       = 0x01,                 ///< Signed integer or character, zigzag.
+    BINARY_ARG_UNSIGNED     = 0x02,                 ///< Unsigned integer, varint.
+    BINARY_ARG_DOUBLE       = 0x03,                 ///< Double, IEEE 754 bits as fixed64.
+    BINARY_ARG_STRING       = 0x04,                 ///< Narrow string, string.
+    BINARY_ARG_POINTER      = 0x05,                 ///< Pointer value, varint.
+};
+
+/**
+ * @brief Append binary primitives to a byte buffer.
+*/
+class CYBinaryWriter final
+{
+public:
+    explicit CYBinaryWriter(std::string& strBuffer)
+        : m_strBuffer(strBuffer)
+    {
+    }
+
+    void PutByte(uint8_t nValue)
+    {
+        m_strBuffer.push_back(static_cast<char>(nValue));
+    }
+
+    void PutVarint(uint64_t nValue)
+    {
+        char szBuffer[10];
+        size_t nLen = 0;
+        while (nValue >= 0x80)
+        {
+            szBuffer[nLen++] = static_cast<char>((nValue & 0x7F) | 0x80);
+            nValue >>= 7;
+        }
+        szBuffer[nLen++] = static_cast<char>(nValue);
+        m_strBuffer.append(szBuffer, nLen);
+    }
+
+    void PutZigZag(int64_t nValue)
+    {
+        PutVarint((static_cast<uint64_t>(nValue) << 1) ^ static_cast<uint64_t>(nValue >> 63));
+    }
+
+    void PutFixed64(uint64_t nValue)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            m_strBuffer.push_back(static_cast<char>((nValue >> (i * 8)) & 0xFF));
+        }
+    }
+
+    void PutString(std::string_view strValue)
+    {
+        // Longer strings are cut, the reader treats them as corruption.
+        strValue = strValue.substr(0, LOG_BINARY_MAX_STRING);
+        PutVarint(strValue.size());
+        m_strBuffer.append(strValue.data(), strValue.size());
+    }
+
+private:
+    std::string& m_strBuffer;
+};
+
+/**
+ * @brief Read binary primitives from a stream, every getter returns false on a short read or a value out of range,
+ * the latter also marks the reader corrupt.
+*/
+class CYBinaryReader final
+{
+public:
+    explicit CYBinaryReader(std::istream& objStream)
+        : m_objStream(objStream)
+    {
+    }
+
+    bool GetByte(uint8_t& nValue)
+    {
+        int nChar = m_objStream.get();
+        if (nChar == std::char_traits<char>::eof())
+            return false;
+        nValue = static_cast<uint8_t>(nChar);
+        return true;
+    }
+
+    bool GetVarint(uint64_t& nValue)
+    {
+        nValue = 0;
+        for (int nShift = 0; nShift < 64; nShift += 7)
+        {
+            uint8_t nByte = 0;
+            if (!GetByte(nByte))
+                return false;
+            nValue |= static_cast<uint64_t>(nByte & 0x7F) << nShift;
+            if ((nByte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    bool GetZigZag(int64_t& nValue)
+    {
+        uint64_t nRaw = 0;
+        if (!GetVarint(nRaw))
+            return false;
+        nValue = static_cast<int64_t>(nRaw >> 1) ^ -static_cast<int64_t>(nRaw & 1);
+        return true;
+    }
+
+    bool GetFixed64(uint64_t& nValue)
+    {
+        nValue = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            uint8_t nByte = 0;
+            if (!GetByte(nByte))
+                return false;
+            nValue |= static_cast<uint64_t>(nByte) << (i * 8);
+        }
+        return true;
+    }
+
+    bool GetString(std::string& strValue)
+    {
+        uint64_t nLen = 0;
+        if (!GetVarint(nLen))
+            return false;
+        if (nLen > LOG_BINARY_MAX_STRING)
+            return SetCorrupt();
+        strValue.resize(static_cast<size_t>(nLen));
+        m_objStream.read(strValue.data(), static_cast<std::streamsize>(nLen));
+        return static_cast<uint64_t>(m_objStream.gcount()) == nLen;
+    }
+
+    /**
+     * @brief Mark the stream corrupt, returns false so getters can fail with it.
+    */
+    bool SetCorrupt()
+    {
+        m_bCorrupt = true;
+        return false;
+    }
+
+    bool IsCorrupt() const
+    {
+        return m_bCorrupt;
+    }
+
+private:
+    std::istream& m_objStream;
+    bool m_bCorrupt = false;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_BINARY_LOG_FORMAT_HPP__
@@ -2,6 +2,9 @@
 #include "Common/CYPublicFunction.hpp"
 #include "Common/CYFormatDefine.hpp"
 #include "CYCommon/Common/Time/CYTimeStamps.hpp"
+#include "Common/Time/CYTimeFormat.hpp"
+
+#include <ctime>
 
 CYLOGGER_NAMESPACE_BEGIN
 
@@ -12,6 +15,12 @@ int CYFileRestriction::m_nCheckFileSize = 1024 * 1024 * 5;
 
 CYFileRestriction::CYFileRestriction()
     : m_nFileSize(0)
+    , m_nFileLine(0)
+    , m_nMaxSize(0)
+    , m_nMaxLine(0)
+    , m_eRotateTime(LOG_ROTATE_TIME_NONE)
+    , m_nDeadline(INT64_MAX)
+    , m_bPolicyChanged(false)
 {
 }
 
@@ -27,17 +36,46 @@ void CYFileRestriction::SetRestriction(int nCheckFileSize)
     m_nCheckFileSize = nCheckFileSize;
 }
 
+/**
+ * @brief Get the file size limit, in bytes.
+*/
+int CYFileRestriction::GetRestriction()
+{
+    return m_nCheckFileSize;
+}
+
+/**
+ * @brief Set the rotation policy of this file, applied by the log thread before its next check. Any thread.
+*/
+void CYFileRestriction::SetRotation(const STRotationPolicy& objPolicy)
+{
+    LockGuard locker(m_mutexPolicy);
+    m_objPendingPolicy = objPolicy;
+    m_bPolicyChanged.store(true, std::memory_order_release);
+}
+
 void CYFileRestriction::AddFileSize(uint64_t nSize)
 {
     m_nFileSize += nSize;
 }
 
 /**
- * @brief Reset file size.
+ * @brief Cumulative line count written to file.
+*/
+void CYFileRestriction::AddFileLine(uint64_t nLine)
+{
+    m_nFileLine += nLine;
+}
+
+/**
+ * @brief Reset file size and line count, and move the time deadline to the next boundary.
 */
 void CYFileRestriction::ResetFileSize()
 {
     m_nFileSize = 0;
+    m_nFileLine = 0;
+    if (m_eRotateTime != LOG_ROTATE_TIME_NONE)
+        m_nDeadline = GetNextDeadline(CYTimeFormat::Now(), m_eRotateTime);
 }
 
 /**
@@ -48,12 +86,83 @@ uint64_t CYFileRestriction::GetFileSize()
     return m_nFileSize;
 }
 
+/**
+ * @brief Size limit of this file, the nMaxBytes of its policy or the global restriction, in bytes. Log thread.
+*/
+uint64_t CYFileRestriction::GetMaxSize()
+{
+    if (m_bPolicyChanged.load(std::memory_order_relaxed))
+        ApplyRotation();
+
+    return m_nMaxSize ? m_nMaxSize : static_cast<uint64_t>(m_nCheckFileSize);
+}
+
 /**
  * @brief Whether to create new files.
 */
 bool CYFileRestriction::IsCreateNewLog()
 {
-    return m_nFileSize > m_nCheckFileSize;
+    return m_nFileSize > GetMaxSize() || (m_nMaxLine && m_nFileLine >= m_nMaxLine);
+}
+
+/**
+ * @brief Whether the time boundary of the file has passed, checked once per batch.
+*/
+bool CYFileRestriction::IsRotateTimeDue()
+{
+    if (m_bPolicyChanged.load(std::memory_order_relaxed))
+        ApplyRotation();
+
+    return m_nDeadline != INT64_MAX && CYTimeFormat::Now() >= m_nDeadline;
+}
+
+/**
+ * @brief Take over a policy set by SetRotation.
+*/
+void CYFileRestriction::ApplyRotation()
+{
+    LockGuard locker(m_mutexPolicy);
+    m_bPolicyChanged.store(false, std::memory_order_relaxed);
+    m_nMaxSize = m_objPendingPolicy.nMaxBytes;
+    m_nMaxLine = m_objPendingPolicy.nMaxLines;
+
+    // The deadline of the open file only moves when the boundary kind changes.
+    if (m_eRotateTime != m_objPendingPolicy.eRotateTime)
+    {
+        m_eRotateTime = m_objPendingPolicy.eRotateTime;
+        m_nDeadline = GetNextDeadline(CYTimeFormat::Now(), m_eRotateTime);
+    }
+}
+
+/**
+ * @brief Next local hour or day boundary after nNow, in nanoseconds since epoch, INT64_MAX if eRotateTime is none.
+*/
+int64_t CYFileRestriction::GetNextDeadline(int64_t nNow, ELogRotateTime eRotateTime)
+{
+    if (eRotateTime == LOG_ROTATE_TIME_NONE)
+        return INT64_MAX;
+
+    time_t nSecond = static_cast<time_t>(nNow / 1000000000);
+    struct tm objTm = {};
+#ifdef CYLOGGER_WIN_OS
+    localtime_s(&objTm, &nSecond);
+#else
+    localtime_r(&nSecond, &objTm);
+#endif
+    objTm.tm_sec = 0;
+    objTm.tm_min = 0;
+    if (eRotateTime == LOG_ROTATE_TIME_DAILY)
+    {
+        objTm.tm_hour = 0;
+        objTm.tm_mday += 1;
+    }
+    else
+    {
+        objTm.tm_hour += 1;
+    }
+    // Let mktime work out the daylight saving offset of the boundary.
+    objTm.tm_isdst = -1;
+    return static_cast<int64_t>(mktime(&objTm)) * 1000000000;
 }
 
 /**
@@ -45,6 +45,10 @@
 #define __CY_FILE_RESTRICTION_HPP__
 
 #include "Inc/ICYLoggerDefine.hpp"
+#include "Common/CYPrivateDefine.hpp"
+#include "Common/Thread/CYNamedLocker.hpp"
+
+#include <atomic>
 
 CYLOGGER_NAMESPACE_BEGIN
 
@@ -60,13 +64,28 @@ public:
     */
     static void SetRestriction(int nCheckFileSize);
 
+    /**
+     * @brief Get the file size limit, in bytes.
+    */
+    static int GetRestriction();
+
+    /**
+     * @brief Set the rotation policy of this file, applied by the log thread before its next check. Any thread.
+    */
+    void SetRotation(const STRotationPolicy& objPolicy);
+
     /**
      * @brief Cumulative byte size written to file.
     */
     void AddFileSize(uint64_t nSize);
 
     /**
-     * @brief Reset file size.
+     * @brief Cumulative line count written to file.
+    */
+    void AddFileLine(uint64_t nLine);
+
+    /**
+     * @brief Reset file size and line count, and move the time deadline to the next boundary.
     */
     void ResetFileSize();
 
@@ -76,14 +95,35 @@ public:
     uint64_t GetFileSize();
 
     /**
-     * @brief Whether to create new files.
+     * @brief Size limit of this file, the nMaxBytes of its policy or the global restriction, in bytes. Log thread.
+    */
+    uint64_t GetMaxSize();
+
+    /**
+     * @brief Whether to create new files, by the size or line limit.
     */
     bool IsCreateNewLog();
 
+    /**
+     * @brief Whether the time boundary of the file has passed, checked once per batch.
+    */
+    bool IsRotateTimeDue();
+
     /**
      * @brief Get new log file name.
     */
-    const TString GetNewLogName(const TString& strCurrentLogName);
+    static const TString GetNewLogName(const TString& strCurrentLogName);
+
+private:
+    /**
+     * @brief Take over a policy set by SetRotation.
+    */
+    void ApplyRotation();
+
+    /**
+     * @brief Next local hour or day boundary after nNow, in nanoseconds since epoch, INT64_MAX if eRotateTime is none.
+    */
+    static int64_t GetNextDeadline(int64_t nNow, ELogRotateTime eRotateTime);
 
 private:
     /**
@@ -95,6 +135,46 @@ private:
      * @brief File Size.
     */
     uint64_t m_nFileSize;
+
+    /**
+     * @brief Line Count.
+    */
+    uint64_t m_nFileLine;
+
+    /**
+     * @brief Size limit of this file, 0 uses m_nCheckFileSize.
+    */
+    uint64_t m_nMaxSize;
+
+    /**
+     * @brief Line limit of this file, 0 disables it.
+    */
+    uint64_t m_nMaxLine;
+
+    /**
+     * @brief Time boundary the file is rotated at.
+    */
+    ELogRotateTime m_eRotateTime;
+
+    /**
+     * @brief Time the current file is rotated at, in nanoseconds since epoch.
+    */
+    int64_t m_nDeadline;
+
+    /**
+     * @brief A policy is waiting in m_objPendingPolicy.
+    */
+    std::atomic<bool> m_bPolicyChanged;
+
+    /**
+     * @brief Policy set by SetRotation, guarded by m_mutexPolicy.
+    */
+    STRotationPolicy m_objPendingPolicy;
+
+    /**
+     * @brief Guards m_objPendingPolicy.
+    */
+    CYNamedLocker m_mutexPolicy{ TEXT("CYFileRestriction") };
 };
 
 CYLOGGER_NAMESPACE_END
@@ -0,0 +1,235 @@
+#include "Common/CYFileStandby.hpp"
+#include "Common/CYFileRestriction.hpp"
+#include "Common/CYPublicFunction.hpp"
+
+#include <filesystem>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+namespace
+{
+    constexpr const TChar* STANDBY_SUFFIX = TEXT(".standby");
+}
+
+CYFileStandby::CYFileStandby()
+    : m_nFileSize(0)
+    , m_bReady(false)
+{
+}
+
+CYFileStandby::~CYFileStandby()
+{
+    CloseRetired();
+
+    // An unused standby file is empty.
+    if (m_bReady)
+    {
+        m_objStandby.close();
+        CYPublicFunction::Remove(m_strStandbyName);
+        m_bReady = false;
+    }
+}
+
+/**
+ * @brief Set the file currently written after an inline reopen, a standby named before it is dropped. Log thread.
+*/
+void CYFileStandby::SetFileName(const TString& strFileName)
+{
+    LockGuard locker(m_mutex);
+    if (m_strFileName == strFileName)
+        return;
+
+    m_strFileName = strFileName;
+    if (m_bReady)
+    {
+        m_lstRetired.push_back({ std::move(m_objStandby), std::move(m_strStandbyName), true });
+        m_strStandbyName.clear();
+        m_bReady = false;
+    }
+}
+
+/**
+ * @brief Size the next standby file is preallocated to, the size limit of the appender. Log thread.
+*/
+void CYFileStandby::SetFileSize(uint64_t nFileSize)
+{
+    LockGuard locker(m_mutex);
+    m_nFileSize = nFileSize;
+}
+
+/**
+ * @brief Name the standby file after the rotation time and swap it with objLogFile and strFileName, the old stream is
+ *        closed later by Process. Log thread.
+ * @return false if no standby file is ready or it cannot be named, the caller reopens inline.
+*/
+bool CYFileStandby::Swap(TOfStream& objLogFile, TString& strFileName)
+{
+    TOfStream objStandby;
+    TString strStandbyName;
+    {
+        LockGuard locker(m_mutex);
+        if (!m_bReady)
+            return false;
+        objStandby.swap(m_objStandby);
+        strStandbyName.swap(m_strStandbyName);
+        m_bReady = false;
+    }
+
+    // The name carries the time the file is swapped in, not the time it was prepared.
+    const TString strNewName = CYFileRestriction::GetNewLogName(strFileName);
+    std::error_code ec;
+    bool bNamed = strNewName != strFileName && !std::filesystem::exists(strNewName, ec);
+    if (bNamed)
+    {
+#ifdef CYLOGGER_WIN_OS
+        // An open stream cannot be renamed on Windows, it is reopened under the new name and keeps its reserved blocks.
+        objStandby.close();
+        std::filesystem::rename(strStandbyName, strNewName, ec);
+        if (!ec)
+        {
+            strStandbyName = strNewName;
+            objStandby.open(strStandbyName.c_str(), TIos::out | TIos::app);
+        }
+        bNamed = !ec && objStandby.is_open();
+#else
+        std::filesystem::rename(strStandbyName, strNewName, ec);
+        bNamed = !ec;
+        if (bNamed)
+            strStandbyName = strNewName;
+#endif
+    }
+
+    LockGuard locker(m_mutex);
+    if (!bNamed)
+    {
+        m_lstRetired.push_back({ std::move(objStandby), std::move(strStandbyName), true });
+        return false;
+    }
+
+    objLogFile.swap(objStandby);
+    strFileName.swap(strStandbyName);
+    m_lstRetired.push_back({ std::move(objStandby), std::move(strStandbyName), false });
+    m_strFileName = strFileName;
+    return true;
+}
+
+/**
+ * @brief Hand over a stream that may be preallocated, the next Process closes it and gives back the reserved tail. Log thread.
+*/
+void CYFileStandby::Retire(TOfStream& objFile, const TString& strFileName)
+{
+    if (!objFile.is_open())
+        return;
+
+    LockGuard locker(m_mutex);
+    m_lstRetired.push_back({ std::move(objFile), strFileName, false });
+}
+
+/**
+ * @brief Close the rotated streams and create the next standby file when bPrepare is set. Schedule thread.
+*/
+void CYFileStandby::Process(bool bPrepare)
+{
+    CloseRetired();
+    if (bPrepare)
+    {
+        Prepare();
+    }
+}
+
+/**
+ * @brief Names of the standby file and of the rotated files not closed yet.
+*/
+void CYFileStandby::GetReservedFiles(std::list<TString>& lstFile)
+{
+    LockGuard locker(m_mutex);
+    if (m_bReady)
+    {
+        lstFile.push_back(m_strStandbyName);
+    }
+    for (const auto& objRetired : m_lstRetired)
+    {
+        lstFile.push_back(objRetired.strFileName);
+    }
+}
+
+/**
+ * @brief Close the rotated streams and give back the preallocated tail.
+*/
+void CYFileStandby::CloseRetired()
+{
+    std::list<STRetiredFile> lstRetired;
+    {
+        LockGuard locker(m_mutex);
+        lstRetired.splice(lstRetired.end(), m_lstRetired);
+    }
+
+    for (auto& objRetired : lstRetired)
+    {
+        if (objRetired.bRemove)
+        {
+            objRetired.objFile.close();
+            CYPublicFunction::Remove(objRetired.strFileName);
+            continue;
+        }
+        Close(objRetired.objFile, objRetired.strFileName);
+    }
+}
+
+/**
+ * @brief Close a stream and give back the blocks preallocated past its end.
+*/
+void CYFileStandby::Close(TOfStream& objFile, const TString& strFileName)
+{
+    if (!objFile.is_open())
+        return;
+
+    objFile.close();
+    CYPublicFunction::ResizeFile(strFileName, CYPublicFunction::GetFileSize(strFileName));
+}
+
+/**
+ * @brief Create and preallocate the next standby file.
+*/
+void CYFileStandby::Prepare()
+{
+    TString strFileName;
+    uint64_t nFileSize = 0;
+    {
+        LockGuard locker(m_mutex);
+        if (m_bReady || m_strFileName.empty())
+            return;
+        strFileName = m_strFileName;
+        nFileSize = m_nFileSize ? m_nFileSize : static_cast<uint64_t>(CYFileRestriction::GetRestriction());
+    }
+
+    // The standby file gets its log name when it is swapped in, a placeholder left by a crash is removed first.
+    const TString strStandbyName = strFileName + STANDBY_SUFFIX;
+    CYPublicFunction::Remove(strStandbyName);
+
+    TOfStream objStandby;
+#if CY_USE_UNICODE
+    objStandby.imbue(std::locale(std::locale::classic(), ".OCP", std::locale::ctype | std::locale::collate));
+#endif
+    // Append mode keeps the blocks reserved past the end of file.
+    objStandby.open(strStandbyName.c_str(), TIos::out | TIos::app);
+    if (!objStandby)
+        return;
+    CYPublicFunction::PreallocateFile(strStandbyName, static_cast<unsigned long long>(nFileSize));
+
+    {
+        LockGuard locker(m_mutex);
+        if (!m_bReady && m_strFileName == strFileName)
+        {
+            m_objStandby.swap(objStandby);
+            m_strStandbyName = strStandbyName;
+            m_bReady = true;
+            return;
+        }
+    }
+
+    objStandby.close();
+    CYPublicFunction::Remove(strStandbyName);
+}
+
+CYLOGGER_NAMESPACE_END
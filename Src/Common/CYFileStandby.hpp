@@ -0,0 +1,163 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_FILE_STANDBY_HPP__
+#define __CY_FILE_STANDBY_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Common/CYPrivateDefine.hpp"
+#include "Common/Thread/CYNamedLocker.hpp"
+
+#include <list>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Standby file of a rotating text appender. The schedule thread creates and preallocates the next file
+ *        under a placeholder name and closes the rotated one, the log thread swaps the streams and names the file.
+*/
+class CYFileStandby
+{
+public:
+    CYFileStandby();
+    ~CYFileStandby();
+
+public:
+    /**
+     * @brief Set the file currently written after an inline reopen, a standby named before it is dropped. Log thread.
+    */
+    void SetFileName(const TString& strFileName);
+
+    /**
+     * @brief Size the next standby file is preallocated to, the size limit of the appender. Log thread.
+    */
+    void SetFileSize(uint64_t nFileSize);
+
+    /**
+     * @brief Name the standby file after the rotation time and swap it with objLogFile and strFileName, the old stream is
+     *        closed later by Process. Log thread.
+     * @return false if no standby file is ready or it cannot be named, the caller reopens inline.
+    */
+    bool Swap(TOfStream& objLogFile, TString& strFileName);
+
+    /**
+     * @brief Hand over a stream that may be preallocated, the next Process closes it and gives back the reserved tail. Log thread.
+    */
+    void Retire(TOfStream& objFile, const TString& strFileName);
+
+    /**
+     * @brief Close the rotated streams and create the next standby file when bPrepare is set. Schedule thread.
+    */
+    void Process(bool bPrepare);
+
+    /**
+     * @brief Names of the standby file and of the rotated files not closed yet.
+    */
+    void GetReservedFiles(std::list<TString>& lstFile);
+
+    /**
+     * @brief Close a stream and give back the blocks preallocated past its end.
+    */
+    static void Close(TOfStream& objFile, const TString& strFileName);
+
+private:
+    /**
+     * @brief Rotated stream waiting to be closed.
+    */
+    struct STRetiredFile
+    {
+        TOfStream objFile;
+        TString strFileName;
+        bool bRemove;
+    };
+
+    /**
+     * @brief Close the rotated streams and give back the preallocated tail.
+    */
+    void CloseRetired();
+
+    /**
+     * @brief Create and preallocate the next standby file.
+    */
+    void Prepare();
+
+private:
+    /**
+     * @brief File currently written.
+    */
+    TString m_strFileName;
+
+    /**
+     * @brief Standby stream, open when m_bReady is set.
+    */
+    TOfStream m_objStandby;
+
+    /**
+     * @brief Placeholder name of the standby file, it is renamed when swapped in.
+    */
+    TString m_strStandbyName;
+
+    /**
+     * @brief Bytes preallocated for the next standby file, 0 uses the global size restriction.
+    */
+    uint64_t m_nFileSize;
+
+    /**
+     * @brief A standby file is ready to be swapped in.
+    */
+    bool m_bReady;
+
+    /**
+     * @brief Rotated streams.
+    */
+    std::list<STRetiredFile> m_lstRetired;
+
+    /**
+     * @brief Guards all members, never held while a file is opened or closed.
+    */
+    CYNamedLocker m_mutex{ TEXT("CYFileStandby") };
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_FILE_STANDBY_HPP__
@@ -77,6 +77,7 @@ CYLOGGER_NAMESPACE_BEGIN
 #define TBLUE		FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_INTENSITY
 
 #define LOG_DIR  TEXT("Log")
+#define LOG_SPILL_DIR  TEXT("Spill")
 
 #ifdef CYLOGGER_WIN_OS
 #define LOG_SEPARATOR		TEXT('\\')
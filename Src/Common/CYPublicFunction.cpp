@@ -60,22 +60,18 @@ void CYPublicFunction::CreateDirectory(const TString& strPath)
     }
 #else
     // Unix/Linux/macOS implementation
+    // Collect the directory names of the parent path, deepest first like the Windows branch.
     std::vector<TString> dirs;
-    TString path = strPath;
-    size_t pos = 0;
-    size_t lastPos = 0;
-
-    while ((pos = path.find('/', lastPos)) != TString::npos)
+    size_t nEnd = strPath.find_last_of(LOG_SEPARATOR);
+    while (nEnd != TString::npos && nEnd > 0)
     {
-        if (pos > lastPos)
+        size_t nBegin = strPath.find_last_of(LOG_SEPARATOR, nEnd - 1);
+        size_t nStart = (nBegin == TString::npos) ? 0 : nBegin + 1;
+        if (nEnd > nStart)
         {
-            dirs.push_back(path.substr(0, pos));
+            dirs.push_back(strPath.substr(nStart, nEnd - nStart));
         }
-        lastPos = pos + 1;
-    }
-    if (lastPos < path.length())
-    {
-        dirs.push_back(path);
+        nEnd = nBegin;
     }
 #endif
 
@@ -541,6 +537,66 @@ bool CYPublicFunction::Remove(const TString& strPath)
 #endif
 }
 
+/**
+ * @brief Rename File, replacing the destination.
+*/
+bool CYPublicFunction::Rename(const TString& strSrc, const TString& strDst)
+{
+#if defined(CYLOGGER_WIN_OS)
+    std::error_code ec;
+    std::filesystem::rename(strSrc, strDst, ec);
+    return !ec;
+#else
+    return std::rename(strSrc.c_str(), strDst.c_str()) == 0;
+#endif
+}
+
+/**
+ * @brief Truncate or extend File to nSize bytes.
+*/
+bool CYPublicFunction::ResizeFile(const TString& strPath, unsigned long long nSize)
+{
+#if defined(CYLOGGER_WIN_OS)
+    std::error_code ec;
+    std::filesystem::resize_file(strPath, nSize, ec);
+    return !ec;
+#else
+    return ::truncate(strPath.c_str(), static_cast<off_t>(nSize)) == 0;
+#endif
+}
+
+/**
+ * @brief Reserve disk blocks for nSize bytes without changing the file size, false where the platform has no support.
+*/
+bool CYPublicFunction::PreallocateFile(const TString& strPath, unsigned long long nSize)
+{
+#if defined(CYLOGGER_LINUX_OS) || defined(CYLOGGER_ANDROID_OS)
+    const int nFd = ::open(strPath.c_str(), O_WRONLY | O_CLOEXEC);
+    if (nFd < 0)
+        return false;
+    const bool bRet = ::fallocate(nFd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(nSize)) == 0;
+    ::close(nFd);
+    return bRet;
+#elif defined(CYLOGGER_MAC_OS)
+    const int nFd = ::open(strPath.c_str(), O_WRONLY | O_CLOEXEC);
+    if (nFd < 0)
+        return false;
+    fstore_t objStore = { F_ALLOCATECONTIG, F_PEOFPOSMODE, 0, static_cast<off_t>(nSize), 0 };
+    bool bRet = ::fcntl(nFd, F_PREALLOCATE, &objStore) != -1;
+    if (!bRet)
+    {
+        objStore.fst_flags = F_ALLOCATEALL;
+        bRet = ::fcntl(nFd, F_PREALLOCATE, &objStore) != -1;
+    }
+    ::close(nFd);
+    return bRet;
+#else
+    (void)strPath;
+    (void)nSize;
+    return false;
+#endif
+}
+
 /**
  * @brief Get File SIze.
  */
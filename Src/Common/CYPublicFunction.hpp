@@ -122,6 +122,21 @@ public:
     */
     static bool Remove(const TString& strPath);
 
+    /**
+     * @brief Rename File, replacing the destination.
+    */
+    static bool Rename(const TString& strSrc, const TString& strDst);
+
+    /**
+     * @brief Truncate or extend File to nSize bytes.
+    */
+    static bool ResizeFile(const TString& strPath, unsigned long long nSize);
+
+    /**
+     * @brief Reserve disk blocks for nSize bytes without changing the file size, false where the platform has no support.
+    */
+    static bool PreallocateFile(const TString& strPath, unsigned long long nSize);
+
     /**
      * @brief Get File SIze.
      */
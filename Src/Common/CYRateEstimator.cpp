@@ -0,0 +1,66 @@
+#include "Common/CYRateEstimator.hpp"
+
+#include <cmath>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+CYRateEstimator::CYRateEstimator(int nWindowMs, int nAverageSeconds) noexcept
+    : m_nWindow(static_cast<int64_t>(nWindowMs) * 1000000)
+    , m_fAverageTime(static_cast<double>(nAverageSeconds))
+    , m_nWindowStart(0)
+    , m_nWindowCount(0)
+    , m_fCurrentRate(0.0)
+    , m_fAverageRate(0.0)
+    , m_bFirstWindow(true)
+{
+}
+
+/**
+ * @brief Count the lines of one batch, 0 for a wake up that drained nothing so the rates decay while idle.
+*/
+void CYRateEstimator::Update(uint64_t nCount, int64_t nNow)
+{
+    if (m_nWindowStart == 0)
+        m_nWindowStart = nNow;
+
+    m_nWindowCount += nCount;
+
+    const int64_t nElapsed = nNow - m_nWindowStart;
+    if (nElapsed < m_nWindow)
+        return;
+
+    // A window stretched by an idle log thread still yields the true rate, and weighs in by its length.
+    const double fElapsed = nElapsed / 1e9;
+    m_fCurrentRate = m_nWindowCount / fElapsed;
+    if (m_bFirstWindow)
+    {
+        m_fAverageRate = m_fCurrentRate;
+        m_bFirstWindow = false;
+    }
+    else
+    {
+        const double fAlpha = 1.0 - std::exp(-fElapsed / m_fAverageTime);
+        m_fAverageRate += fAlpha * (m_fCurrentRate - m_fAverageRate);
+    }
+
+    m_nWindowStart = nNow;
+    m_nWindowCount = 0;
+}
+
+/**
+ * @brief Lines per second of the last closed window.
+*/
+double CYRateEstimator::GetCurrentRate() const
+{
+    return m_fCurrentRate;
+}
+
+/**
+ * @brief Moving average of the window rates, in lines per second.
+*/
+double CYRateEstimator::GetAverageRate() const
+{
+    return m_fAverageRate;
+}
+
+CYLOGGER_NAMESPACE_END
@@ -0,0 +1,98 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_RATE_ESTIMATOR_HPP__
+#define __CY_RATE_ESTIMATOR_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Lines per second of one log thread, fed once per drained batch with a time the caller already has. The
+ *        current rate is the count of the last closed window, the average is an exponentially weighted moving
+ *        average of the window rates. Log thread only.
+*/
+class CYRateEstimator final
+{
+public:
+    /**
+     * @brief Constructor.
+     * @param nWindowMs length of a measurement window, in milliseconds.
+     * @param nAverageSeconds time constant of the moving average, in seconds.
+    */
+    CYRateEstimator(int nWindowMs, int nAverageSeconds) noexcept;
+    ~CYRateEstimator() noexcept = default;
+
+public:
+    /**
+     * @brief Count the lines of one batch, 0 for a wake up that drained nothing so the rates decay while idle.
+     * @param nNow steady clock time in nanoseconds.
+    */
+    void Update(uint64_t nCount, int64_t nNow);
+
+    /**
+     * @brief Lines per second of the last closed window.
+    */
+    double GetCurrentRate() const;
+
+    /**
+     * @brief Moving average of the window rates, in lines per second.
+    */
+    double GetAverageRate() const;
+
+private:
+    int64_t m_nWindow;
+    double m_fAverageTime;
+
+    int64_t m_nWindowStart;
+    uint64_t m_nWindowCount;
+
+    double m_fCurrentRate;
+    double m_fAverageRate;
+    bool m_bFirstWindow;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_RATE_ESTIMATOR_HPP__
@@ -0,0 +1,87 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_TRACE_PROBE_HPP__
+#define __CY_TRACE_PROBE_HPP__
+
+/**
+ * @brief USDT probes of the provider cylogger, compiled in when CMake finds sys/sdt.h with CYLOGGER_USE_USDT on.
+ *        An unattached probe is a single nop, bpftrace or perf turn it into a trap when they attach. Types are
+ *        ELogType values, times are in nanoseconds.
+ *
+ *        enqueue      (level bits, message type, captured bytes)     a message passed the level filter.
+ *        flip         (type, queue depth)                            the log thread took over the public queue.
+ *        drain_start  (type, queue depth)                            the log thread starts writing the batch.
+ *        batch_write  (type, lines, bytes, write time)               the lines of the batch were written.
+ *        flush        (type, flush time)                             the end of batch flush returned.
+ *        drain_end    (type, lines, bytes, write and flush time)     the batch is done, statistics are published.
+ *        rotate       (type)                                         the appender moved on to a new file.
+ *        drop         (type, lines)                                  the sink dropped lines.
+*/
+#ifdef CYLOGGER_HAVE_USDT
+
+#include <sys/sdt.h>
+
+#define CY_PROBE_ENQUEUE(nLevel, nMsgType, nBytes)                  DTRACE_PROBE3(cylogger, enqueue, nLevel, nMsgType, nBytes)
+#define CY_PROBE_FLIP(nType, nDepth)                                DTRACE_PROBE2(cylogger, flip, nType, nDepth)
+#define CY_PROBE_DRAIN_START(nType, nDepth)                         DTRACE_PROBE2(cylogger, drain_start, nType, nDepth)
+#define CY_PROBE_BATCH_WRITE(nType, nLine, nBytes, nTime)           DTRACE_PROBE4(cylogger, batch_write, nType, nLine, nBytes, nTime)
+#define CY_PROBE_FLUSH(nType, nTime)                                DTRACE_PROBE2(cylogger, flush, nType, nTime)
+#define CY_PROBE_DRAIN_END(nType, nLine, nBytes, nTime)             DTRACE_PROBE4(cylogger, drain_end, nType, nLine, nBytes, nTime)
+#define CY_PROBE_ROTATE(nType)                                      DTRACE_PROBE1(cylogger, rotate, nType)
+#define CY_PROBE_DROP(nType, nLine)                                 DTRACE_PROBE2(cylogger, drop, nType, nLine)
+
+#else
+
+#define CY_PROBE_ENQUEUE(nLevel, nMsgType, nBytes)                  ((void)0)
+#define CY_PROBE_FLIP(nType, nDepth)                                ((void)0)
+#define CY_PROBE_DRAIN_START(nType, nDepth)                         ((void)0)
+#define CY_PROBE_BATCH_WRITE(nType, nLine, nBytes, nTime)           ((void)0)
+#define CY_PROBE_FLUSH(nType, nTime)                                ((void)0)
+#define CY_PROBE_DRAIN_END(nType, nLine, nBytes, nTime)             ((void)0)
+#define CY_PROBE_ROTATE(nType)                                      ((void)0)
+#define CY_PROBE_DROP(nType, nLine)                                 ((void)0)
+
+#endif
+
+#endif // __CY_TRACE_PROBE_HPP__
@@ -0,0 +1,254 @@
+#include "Common/Compress/CYLogFileCompressor.hpp"
+#include "Common/Compress/CYLzCodec.hpp"
+
+#include <cstring>
+#include <string>
+#ifdef CYLOGGER_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Resolve the codec against what was compiled in, gzip falls back to the built-in LZ codec without zlib.
+*/
+ELogZipCodec CYLogFileCompressor::GetCodec(ELogZipCodec eCodec) noexcept
+{
+#ifndef CYLOGGER_HAVE_ZLIB
+    if (eCodec == ELogZipCodec::LOG_ZIP_GZIP)
+        return ELogZipCodec::LOG_ZIP_LZ;
+#endif
+    return eCodec;
+}
+
+/**
+ * @brief Extension appended to a compressed log file.
+*/
+const TChar* CYLogFileCompressor::GetFileExt(ELogZipCodec eCodec) noexcept
+{
+    switch (eCodec)
+    {
+    case ELogZipCodec::LOG_ZIP_LZ:
+        return TEXT(".lz");
+    case ELogZipCodec::LOG_ZIP_GZIP:
+        return TEXT(".gz");
+    default:
+        return TEXT("");
+    }
+}
+
+/**
+ * @brief Determine whether the file is a compressed log file.
+*/
+bool CYLogFileCompressor::IsCompressedFile(const TString& strFileName) noexcept
+{
+    size_t nIndex = strFileName.find_last_of(TEXT("."));
+    if (nIndex == TString::npos)
+        return false;
+
+    TString strExt = strFileName.substr(nIndex);
+    return strExt == GetFileExt(ELogZipCodec::LOG_ZIP_LZ) || strExt == GetFileExt(ELogZipCodec::LOG_ZIP_GZIP);
+}
+
+/**
+ * @brief Compress strSrc into strDst.
+*/
+bool CYLogFileCompressor::CompressFile(const TString& strSrc, const TString& strDst, ELogZipCodec eCodec, size_t nBlockSize)
+{
+    std::ifstream objSrc(strSrc.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!objSrc)
+        return false;
+
+    std::ofstream objDst(strDst.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!objDst)
+        return false;
+
+    bool bResult = false;
+    switch (GetCodec(eCodec))
+    {
+    case ELogZipCodec::LOG_ZIP_LZ:
+        bResult = CompressLz(objSrc, objDst, nBlockSize);
+        break;
+#ifdef CYLOGGER_HAVE_ZLIB
+    case ELogZipCodec::LOG_ZIP_GZIP:
+        bResult = CompressGzip(objSrc, objDst, nBlockSize);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    objDst.flush();
+    return bResult && objDst.good();
+}
+
+/**
+ * @brief Decompress strDst and compare it with strSrc byte by byte.
+*/
+bool CYLogFileCompressor::VerifyFile(const TString& strSrc, const TString& strDst, ELogZipCodec eCodec)
+{
+    std::ifstream objSrc(strSrc.c_str(), std::ios_base::in | std::ios_base::binary);
+    std::ifstream objDst(strDst.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!objSrc || !objDst)
+        return false;
+
+    bool bResult = false;
+    switch (GetCodec(eCodec))
+    {
+    case ELogZipCodec::LOG_ZIP_LZ:
+        bResult = VerifyLz(objSrc, objDst);
+        break;
+#ifdef CYLOGGER_HAVE_ZLIB
+    case ELogZipCodec::LOG_ZIP_GZIP:
+        bResult = VerifyGzip(objSrc, objDst);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    // The whole original must have been matched.
+    return bResult && objSrc.peek() == std::ifstream::traits_type::eof();
+}
+
+bool CYLogFileCompressor::CompressLz(std::ifstream& objSrc, std::ofstream& objDst, size_t nBlockSize)
+{
+    std::string strBlock(nBlockSize, '\0');
+    std::string strOut;
+    strOut.reserve(LOG_LZ_BLOCK_HEADER_SIZE + CYLzCodec::CompressBound(nBlockSize));
+
+    CYLzCodec::AppendFrameHeader(strOut);
+    while (objSrc)
+    {
+        objSrc.read(strBlock.data(), nBlockSize);
+        size_t nRead = static_cast<size_t>(objSrc.gcount());
+        if (nRead == 0)
+            break;
+
+        CYLzCodec::AppendFrameBlock(reinterpret_cast<const uint8_t*>(strBlock.data()), nRead, strOut);
+        objDst.write(strOut.data(), strOut.size());
+        strOut.clear();
+    }
+    CYLzCodec::AppendFrameEnd(strOut);
+    objDst.write(strOut.data(), strOut.size());
+
+    return !objSrc.bad() && objDst.good();
+}
+
+bool CYLogFileCompressor::VerifyLz(std::ifstream& objSrc, std::ifstream& objDst)
+{
+    if (!CYLzCodec::ReadFrameHeader(objDst))
+        return false;
+
+    std::string strPacked, strBlock, strCompare;
+    bool bEnd = false;
+    while (CYLzCodec::ReadFrameBlock(objDst, strPacked, strBlock, bEnd))
+    {
+        if (bEnd)
+            return true;
+
+        if (!CompareBlock(objSrc, strBlock.data(), strBlock.size(), strCompare))
+            return false;
+    }
+    return false;
+}
+
+#ifdef CYLOGGER_HAVE_ZLIB
+bool CYLogFileCompressor::CompressGzip(std::ifstream& objSrc, std::ofstream& objDst, size_t nBlockSize)
+{
+    z_stream objStream;
+    std::memset(&objStream, 0, sizeof(objStream));
+
+    // 15 window bits + 16 selects the gzip wrapper.
+    if (deflateInit2(&objStream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return false;
+
+    std::string strIn(nBlockSize, '\0');
+    std::string strOut(nBlockSize, '\0');
+    int nFlush = Z_NO_FLUSH;
+    int nRet = Z_OK;
+    do
+    {
+        objSrc.read(strIn.data(), nBlockSize);
+        if (objSrc.bad())
+            break;
+        nFlush = objSrc.eof() ? Z_FINISH : Z_NO_FLUSH;
+
+        objStream.next_in = reinterpret_cast<Bytef*>(strIn.data());
+        objStream.avail_in = static_cast<uInt>(objSrc.gcount());
+        do
+        {
+            objStream.next_out = reinterpret_cast<Bytef*>(strOut.data());
+            objStream.avail_out = static_cast<uInt>(nBlockSize);
+            nRet = deflate(&objStream, nFlush);
+            objDst.write(strOut.data(), nBlockSize - objStream.avail_out);
+        } while (objStream.avail_out == 0 && nRet != Z_STREAM_ERROR);
+    } while (nFlush != Z_FINISH && nRet != Z_STREAM_ERROR);
+
+    deflateEnd(&objStream);
+    return nRet == Z_STREAM_END && objDst.good();
+}
+
+bool CYLogFileCompressor::VerifyGzip(std::ifstream& objSrc, std::ifstream& objDst)
+{
+    constexpr size_t nBlockSize = LOG_ZIP_BLOCK_SIZE;
+
+    z_stream objStream;
+    std::memset(&objStream, 0, sizeof(objStream));
+    if (inflateInit2(&objStream, 15 + 16) != Z_OK)
+        return false;
+
+    std::string strIn(nBlockSize, '\0');
+    std::string strOut(nBlockSize, '\0');
+    std::string strCompare;
+    int nRet = Z_OK;
+    bool bMatch = true;
+    while (bMatch && nRet != Z_STREAM_END)
+    {
+        objDst.read(strIn.data(), nBlockSize);
+        objStream.next_in = reinterpret_cast<Bytef*>(strIn.data());
+        objStream.avail_in = static_cast<uInt>(objDst.gcount());
+        if (objStream.avail_in == 0)
+            break;
+
+        do
+        {
+            objStream.next_out = reinterpret_cast<Bytef*>(strOut.data());
+            objStream.avail_out = static_cast<uInt>(nBlockSize);
+            nRet = inflate(&objStream, Z_NO_FLUSH);
+
+            // Z_BUF_ERROR only means that no progress was possible, the next read supplies more input.
+            if (nRet != Z_OK && nRet != Z_STREAM_END && nRet != Z_BUF_ERROR)
+            {
+                bMatch = false;
+                break;
+            }
+
+            if (!CompareBlock(objSrc, strOut.data(), nBlockSize - objStream.avail_out, strCompare))
+            {
+                bMatch = false;
+                break;
+            }
+        } while (objStream.avail_out == 0 && nRet != Z_STREAM_END);
+    }
+
+    inflateEnd(&objStream);
+    return bMatch && nRet == Z_STREAM_END;
+}
+#endif
+
+/**
+ * @brief Read the next nSize bytes of the original file and compare them.
+*/
+bool CYLogFileCompressor::CompareBlock(std::ifstream& objSrc, const char* pData, size_t nSize, std::string& strBuffer)
+{
+    if (nSize == 0)
+        return true;
+
+    strBuffer.resize(nSize);
+    if (!objSrc.read(strBuffer.data(), nSize))
+        return false;
+    return std::memcmp(strBuffer.data(), pData, nSize) == 0;
+}
+
+CYLOGGER_NAMESPACE_END
@@ -0,0 +1,101 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LOG_FILE_COMPRESSOR_HPP__
+#define __CY_LOG_FILE_COMPRESSOR_HPP__
+
+#include "Common/CYPrivateDefine.hpp"
+
+#include <fstream>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Streaming compression of closed log files, memory is bounded by the block size.
+*/
+class CYLogFileCompressor final
+{
+public:
+    /**
+     * @brief Resolve the codec against what was compiled in, gzip falls back to the built-in LZ codec without zlib.
+    */
+    static ELogZipCodec GetCodec(ELogZipCodec eCodec) noexcept;
+
+    /**
+     * @brief Extension appended to a compressed log file.
+    */
+    static const TChar* GetFileExt(ELogZipCodec eCodec) noexcept;
+
+    /**
+     * @brief Determine whether the file is a compressed log file.
+    */
+    static bool IsCompressedFile(const TString& strFileName) noexcept;
+
+    /**
+     * @brief Compress strSrc into strDst.
+    */
+    static bool CompressFile(const TString& strSrc, const TString& strDst, ELogZipCodec eCodec, size_t nBlockSize);
+
+    /**
+     * @brief Decompress strDst and compare it with strSrc byte by byte.
+    */
+    static bool VerifyFile(const TString& strSrc, const TString& strDst, ELogZipCodec eCodec);
+
+private:
+    static bool CompressLz(std::ifstream& objSrc, std::ofstream& objDst, size_t nBlockSize);
+    static bool VerifyLz(std::ifstream& objSrc, std::ifstream& objDst);
+
+#ifdef CYLOGGER_HAVE_ZLIB
+    static bool CompressGzip(std::ifstream& objSrc, std::ofstream& objDst, size_t nBlockSize);
+    static bool VerifyGzip(std::ifstream& objSrc, std::ifstream& objDst);
+#endif
+
+    /**
+     * @brief Read the next nSize bytes of the original file and compare them.
+    */
+    static bool CompareBlock(std::ifstream& objSrc, const char* pData, size_t nSize, std::string& strBuffer);
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LOG_FILE_COMPRESSOR_HPP__
@@ -0,0 +1,394 @@
+#include "Common/Compress/CYLzCodec.hpp"
+
+#include <array>
+#include <cstring>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+namespace
+{
+    constexpr int      LZ_HASH_BITS = 13;
+    constexpr size_t   LZ_MIN_MATCH = 4;
+    constexpr size_t   LZ_MAX_OFFSET = 65535;
+    constexpr size_t   LZ_LAST_LITERALS = 5;
+    constexpr size_t   LZ_MATCH_FIND_LIMIT = 12;
+
+    constexpr std::array<uint32_t, 256> MakeCrcTable()
+    {
+        std::array<uint32_t, 256> arrTable{};
+        for (uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t nValue = i;
+            for (int j = 0; j < 8; ++j)
+                nValue = (nValue & 1) ? (0xEDB88320u ^ (nValue >> 1)) : (nValue >> 1);
+            arrTable[i] = nValue;
+        }
+        return arrTable;
+    }
+
+    constexpr std::array<uint32_t, 256> LZ_CRC_TABLE = MakeCrcTable();
+
+    inline uint32_t Read32(const uint8_t* p) noexcept
+    {
+        uint32_t nValue;
+        std::memcpy(&nValue, p, sizeof(nValue));
+        return nValue;
+    }
+
+    inline uint32_t Hash(uint32_t nSequence) noexcept
+    {
+        return (nSequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+    }
+
+    inline void PutLE32(std::string& strOut, uint32_t nValue)
+    {
+        char szBuf[4] = { static_cast<char>(nValue), static_cast<char>(nValue >> 8), static_cast<char>(nValue >> 16), static_cast<char>(nValue >> 24) };
+        strOut.append(szBuf, sizeof(szBuf));
+    }
+
+    inline uint32_t GetLE32(const uint8_t* p) noexcept
+    {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    /**
+     * @brief Write a length continuation, 255-run bytes followed by the remainder.
+    */
+    inline uint8_t* PutLength(uint8_t* pOut, size_t nLength) noexcept
+    {
+        while (nLength >= 255)
+        {
+            *pOut++ = 255;
+            nLength -= 255;
+        }
+        *pOut++ = static_cast<uint8_t>(nLength);
+        return pOut;
+    }
+
+    /**
+     * @brief Read a length continuation.
+    */
+    inline bool GetLength(const uint8_t*& pIn, const uint8_t* pEnd, size_t& nLength) noexcept
+    {
+        uint8_t nByte = 0;
+        do
+        {
+            if (pIn >= pEnd) return false;
+            nByte = *pIn++;
+            nLength += nByte;
+        } while (nByte == 255);
+        return true;
+    }
+
+    /**
+     * @brief Emit one sequence, nMatch is the match length minus LZ_MIN_MATCH, nOffset 0 for the last literals.
+    */
+    inline bool EmitSequence(uint8_t*& pOut, const uint8_t* pOutEnd, const uint8_t* pLiteral, size_t nLiteral, size_t nOffset, size_t nMatch) noexcept
+    {
+        size_t nNeed = 1 + nLiteral + nLiteral / 255 + 1 + (nOffset ? 2 + nMatch / 255 + 1 : 0);
+        if (static_cast<size_t>(pOutEnd - pOut) < nNeed)
+            return false;
+
+        uint8_t* pToken = pOut++;
+        *pToken = static_cast<uint8_t>((nLiteral < 15 ? nLiteral : 15) << 4);
+        if (nLiteral >= 15)
+            pOut = PutLength(pOut, nLiteral - 15);
+
+        std::memcpy(pOut, pLiteral, nLiteral);
+        pOut += nLiteral;
+
+        if (nOffset == 0)
+            return true;
+
+        *pOut++ = static_cast<uint8_t>(nOffset);
+        *pOut++ = static_cast<uint8_t>(nOffset >> 8);
+
+        *pToken |= static_cast<uint8_t>(nMatch < 15 ? nMatch : 15);
+        if (nMatch >= 15)
+            pOut = PutLength(pOut, nMatch - 15);
+        return true;
+    }
+}
+
+/**
+ * @brief Worst case compressed size of a block of nSize bytes.
+*/
+size_t CYLzCodec::CompressBound(size_t nSize) noexcept
+{
+    return nSize + nSize / 255 + 16;
+}
+
+/**
+ * @brief Compress one block, return the compressed size or 0 if it does not fit in nCapacity.
+*/
+size_t CYLzCodec::Compress(const uint8_t* pSrc, size_t nSize, uint8_t* pDst, size_t nCapacity) noexcept
+{
+    if (nSize > LOG_LZ_MAX_BLOCK_SIZE)
+        return 0;
+
+    uint32_t arrTable[1 << LZ_HASH_BITS] = { 0 };
+
+    const uint8_t* pIn = pSrc;
+    const uint8_t* pAnchor = pSrc;
+    const uint8_t* pEnd = pSrc + nSize;
+    uint8_t* pOut = pDst;
+    const uint8_t* pOutEnd = pDst + nCapacity;
+
+    if (nSize > LZ_MATCH_FIND_LIMIT)
+    {
+        const uint8_t* pFindLimit = pEnd - LZ_MATCH_FIND_LIMIT;
+        const uint8_t* pMatchLimit = pEnd - LZ_LAST_LITERALS;
+        size_t nMiss = 0;
+
+        while (pIn < pFindLimit)
+        {
+            uint32_t nSequence = Read32(pIn);
+            uint32_t nHash = Hash(nSequence);
+            const uint8_t* pRef = pSrc + arrTable[nHash];
+            arrTable[nHash] = static_cast<uint32_t>(pIn - pSrc);
+
+            if (pRef >= pIn || static_cast<size_t>(pIn - pRef) > LZ_MAX_OFFSET || Read32(pRef) != nSequence)
+            {
+                // Skip faster through data that does not compress.
+                pIn += 1 + (nMiss++ >> 6);
+                continue;
+            }
+            nMiss = 0;
+
+            // Extend the match backwards over pending literals.
+            while (pIn > pAnchor && pRef > pSrc && pIn[-1] == pRef[-1])
+            {
+                --pIn;
+                --pRef;
+            }
+
+            const uint8_t* pMatchEnd = pIn + LZ_MIN_MATCH;
+            const uint8_t* pRefEnd = pRef + LZ_MIN_MATCH;
+            while (pMatchEnd < pMatchLimit && *pMatchEnd == *pRefEnd)
+            {
+                ++pMatchEnd;
+                ++pRefEnd;
+            }
+
+            if (!EmitSequence(pOut, pOutEnd, pAnchor, pIn - pAnchor, pIn - pRef, pMatchEnd - pIn - LZ_MIN_MATCH))
+                return 0;
+
+            pIn = pMatchEnd;
+            pAnchor = pIn;
+            if (pIn < pFindLimit)
+                arrTable[Hash(Read32(pIn - 2))] = static_cast<uint32_t>(pIn - 2 - pSrc);
+        }
+    }
+
+    if (!EmitSequence(pOut, pOutEnd, pAnchor, pEnd - pAnchor, 0, 0))
+        return 0;
+
+    return pOut - pDst;
+}
+
+/**
+ * @brief Decompress one block, which must expand to exactly nRawSize bytes.
+*/
+bool CYLzCodec::Decompress(const uint8_t* pSrc, size_t nSize, uint8_t* pDst, size_t nRawSize) noexcept
+{
+    const uint8_t* pIn = pSrc;
+    const uint8_t* pEnd = pSrc + nSize;
+    uint8_t* pOut = pDst;
+    uint8_t* pOutEnd = pDst + nRawSize;
+
+    while (pIn < pEnd)
+    {
+        uint8_t nToken = *pIn++;
+
+        size_t nLiteral = nToken >> 4;
+        if (nLiteral == 15 && !GetLength(pIn, pEnd, nLiteral))
+            return false;
+        if (nLiteral > static_cast<size_t>(pEnd - pIn) || nLiteral > static_cast<size_t>(pOutEnd - pOut))
+            return false;
+
+        std::memcpy(pOut, pIn, nLiteral);
+        pOut += nLiteral;
+        pIn += nLiteral;
+
+        // Last sequence.
+        if (pIn == pEnd)
+            break;
+
+        if (pEnd - pIn < 2)
+            return false;
+        size_t nOffset = static_cast<size_t>(pIn[0]) | (static_cast<size_t>(pIn[1]) << 8);
+        pIn += 2;
+        if (nOffset == 0 || nOffset > static_cast<size_t>(pOut - pDst))
+            return false;
+
+        size_t nMatch = nToken & 0x0F;
+        if (nMatch == 15 && !GetLength(pIn, pEnd, nMatch))
+            return false;
+        nMatch += LZ_MIN_MATCH;
+        if (nMatch > static_cast<size_t>(pOutEnd - pOut))
+            return false;
+
+        const uint8_t* pRef = pOut - nOffset;
+        if (nOffset >= nMatch)
+        {
+            std::memcpy(pOut, pRef, nMatch);
+            pOut += nMatch;
+        }
+        else
+        {
+            // Overlapping copy repeats the last nOffset bytes.
+            while (nMatch--)
+                *pOut++ = *pRef++;
+        }
+    }
+
+    return pOut == pOutEnd;
+}
+
+/**
+ * @brief CRC-32 (IEEE) of a buffer, pass the previous result to continue.
+*/
+uint32_t CYLzCodec::Crc32(const uint8_t* pData, size_t nSize, uint32_t nCrc) noexcept
+{
+    nCrc = ~nCrc;
+    for (size_t i = 0; i < nSize; ++i)
+        nCrc = LZ_CRC_TABLE[(nCrc ^ pData[i]) & 0xFF] ^ (nCrc >> 8);
+    return ~nCrc;
+}
+
+/**
+ * @brief Append the stream header.
+*/
+void CYLzCodec::AppendFrameHeader(std::string& strOut)
+{
+    strOut.append(LOG_LZ_MAGIC, sizeof(LOG_LZ_MAGIC));
+    strOut.push_back(static_cast<char>(LOG_LZ_VERSION));
+}
+
+/**
+ * @brief Append one framed block, stored raw if compression does not pay off.
+*/
+void CYLzCodec::AppendFrameBlock(const uint8_t* pSrc, size_t nSize, std::string& strOut)
+{
+    if (nSize == 0)
+        return;
+
+    size_t nHeader = strOut.size();
+    strOut.resize(nHeader + LOG_LZ_BLOCK_HEADER_SIZE + CompressBound(nSize));
+
+    uint8_t* pPayload = reinterpret_cast<uint8_t*>(strOut.data()) + nHeader + LOG_LZ_BLOCK_HEADER_SIZE;
+    size_t nPacked = Compress(pSrc, nSize, pPayload, nSize - 1);
+    uint32_t nPackedField = static_cast<uint32_t>(nPacked);
+    if (nPacked == 0)
+    {
+        std::memcpy(pPayload, pSrc, nSize);
+        nPacked = nSize;
+        nPackedField = static_cast<uint32_t>(nSize) | LOG_LZ_STORED_FLAG;
+    }
+    strOut.resize(nHeader + LOG_LZ_BLOCK_HEADER_SIZE + nPacked);
+
+    std::string strHeader;
+    PutLE32(strHeader, static_cast<uint32_t>(nSize));
+    PutLE32(strHeader, nPackedField);
+    PutLE32(strHeader, Crc32(pSrc, nSize));
+    strOut.replace(nHeader, LOG_LZ_BLOCK_HEADER_SIZE, strHeader);
+}
+
+/**
+ * @brief Append the end of stream marker.
+*/
+void CYLzCodec::AppendFrameEnd(std::string& strOut)
+{
+    PutLE32(strOut, 0);
+}
+
+/**
+ * @brief Read and check the stream header.
+*/
+bool CYLzCodec::ReadFrameHeader(std::istream& objStream)
+{
+    char szHeader[LOG_LZ_FRAME_HEADER_SIZE];
+    if (!objStream.read(szHeader, sizeof(szHeader)))
+        return false;
+    return std::memcmp(szHeader, LOG_LZ_MAGIC, sizeof(LOG_LZ_MAGIC)) == 0 && static_cast<uint8_t>(szHeader[4]) == LOG_LZ_VERSION;
+}
+
+/**
+ * @brief Read the next block header, the stream is left at the payload. bEnd is set on the end of stream marker.
+*/
+bool CYLzCodec::ReadFrameBlockHeader(std::istream& objStream, STLzBlockHeader& objHeader, bool& bEnd)
+{
+    bEnd = false;
+
+    uint8_t szSize[4];
+    if (!objStream.read(reinterpret_cast<char*>(szSize), sizeof(szSize)))
+        return false;
+
+    objHeader.nRawSize = GetLE32(szSize);
+    if (objHeader.nRawSize == 0)
+    {
+        bEnd = true;
+        return true;
+    }
+
+    uint8_t szHeader[8];
+    if (objHeader.nRawSize > LOG_LZ_MAX_BLOCK_SIZE || !objStream.read(reinterpret_cast<char*>(szHeader), sizeof(szHeader)))
+        return false;
+
+    uint32_t nPackedField = GetLE32(szHeader);
+    objHeader.nCrc = GetLE32(szHeader + 4);
+    objHeader.bStored = (nPackedField & LOG_LZ_STORED_FLAG) != 0;
+    objHeader.nPackedSize = nPackedField & ~LOG_LZ_STORED_FLAG;
+    return objHeader.nPackedSize <= CompressBound(objHeader.nRawSize) && (!objHeader.bStored || objHeader.nPackedSize == objHeader.nRawSize);
+}
+
+/**
+ * @brief Read the next framed block into strOut, checking its CRC. bEnd is set on the end of stream marker.
+*/
+bool CYLzCodec::ReadFrameBlock(std::istream& objStream, std::string& strPacked, std::string& strOut, bool& bEnd)
+{
+    strOut.clear();
+
+    STLzBlockHeader objHeader;
+    if (!ReadFrameBlockHeader(objStream, objHeader, bEnd))
+        return false;
+    if (bEnd)
+        return true;
+
+    strOut.resize(objHeader.nRawSize);
+    if (objHeader.bStored)
+    {
+        if (!objStream.read(strOut.data(), objHeader.nRawSize))
+            return false;
+    }
+    else
+    {
+        strPacked.resize(objHeader.nPackedSize);
+        if (!objStream.read(strPacked.data(), objHeader.nPackedSize))
+            return false;
+        if (!Decompress(reinterpret_cast<const uint8_t*>(strPacked.data()), objHeader.nPackedSize, reinterpret_cast<uint8_t*>(strOut.data()), objHeader.nRawSize))
+            return false;
+    }
+
+    return Crc32(reinterpret_cast<const uint8_t*>(strOut.data()), objHeader.nRawSize) == objHeader.nCrc;
+}
+
+/**
+ * @brief Length of the valid prefix of a framed stream, 0 if the header is wrong.
+*/
+uint64_t CYLzCodec::GetValidFrameLength(std::istream& objStream)
+{
+    if (!ReadFrameHeader(objStream))
+        return 0;
+
+    uint64_t nValidLength = LOG_LZ_FRAME_HEADER_SIZE;
+    std::string strPacked, strBlock;
+    bool bEnd = false;
+    while (ReadFrameBlock(objStream, strPacked, strBlock, bEnd) && !bEnd)
+    {
+        nValidLength = static_cast<uint64_t>(objStream.tellg());
+    }
+    return nValidLength;
+}
+
+CYLOGGER_NAMESPACE_END
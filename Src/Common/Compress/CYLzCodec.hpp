@@ -0,0 +1,146 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LZ_CODEC_HPP__
+#define __CY_LZ_CODEC_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+
+#include <string>
+#include <istream>
+#include <cstdint>
+#include <cstddef>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Built-in LZ77 block codec with no external dependency, LZ4-style sequences with a 64KB window.
+ *
+ * Sequence: TOKEN(1) [LITERAL_LENGTH+] LITERALS [OFFSET(2) [MATCH_LENGTH+]]
+ * The high nibble of TOKEN is the literal length, the low nibble the match length minus 4, a nibble of 15 is
+ * continued with 255-run bytes. The last sequence of a block carries literals only.
+ *
+ * Framed stream: MAGIC(4) VERSION(1) { RAW_SIZE(4) PACKED_SIZE(4) CRC32(4) PAYLOAD } RAW_SIZE=0
+ * PACKED_SIZE has LOG_LZ_STORED_FLAG set when the payload is the raw block. Sizes are little endian.
+*/
+static constexpr char     LOG_LZ_MAGIC[4] = { 'C', 'Y', 'L', 'Z' };
+static constexpr uint8_t  LOG_LZ_VERSION = 1;
+static constexpr uint32_t LOG_LZ_STORED_FLAG = 0x80000000u;
+static constexpr size_t   LOG_LZ_FRAME_HEADER_SIZE = 5;
+static constexpr size_t   LOG_LZ_BLOCK_HEADER_SIZE = 12;
+static constexpr size_t   LOG_LZ_MAX_BLOCK_SIZE = 4 * 1024 * 1024;
+
+/**
+ * @brief Header of one framed block.
+*/
+struct STLzBlockHeader
+{
+    uint32_t nRawSize = 0;
+    uint32_t nPackedSize = 0;
+    uint32_t nCrc = 0;
+    bool     bStored = false;
+};
+
+class CYLzCodec final
+{
+public:
+    /**
+     * @brief Worst case compressed size of a block of nSize bytes.
+    */
+    static size_t CompressBound(size_t nSize) noexcept;
+
+    /**
+     * @brief Compress one block, return the compressed size or 0 if it does not fit in nCapacity.
+    */
+    static size_t Compress(const uint8_t* pSrc, size_t nSize, uint8_t* pDst, size_t nCapacity) noexcept;
+
+    /**
+     * @brief Decompress one block, which must expand to exactly nRawSize bytes.
+    */
+    static bool Decompress(const uint8_t* pSrc, size_t nSize, uint8_t* pDst, size_t nRawSize) noexcept;
+
+    /**
+     * @brief CRC-32 (IEEE) of a buffer, pass the previous result to continue.
+    */
+    static uint32_t Crc32(const uint8_t* pData, size_t nSize, uint32_t nCrc = 0) noexcept;
+
+    /**
+     * @brief Append the stream header.
+    */
+    static void AppendFrameHeader(std::string& strOut);
+
+    /**
+     * @brief Append one framed block, stored raw if compression does not pay off.
+    */
+    static void AppendFrameBlock(const uint8_t* pSrc, size_t nSize, std::string& strOut);
+
+    /**
+     * @brief Append the end of stream marker.
+    */
+    static void AppendFrameEnd(std::string& strOut);
+
+    /**
+     * @brief Read and check the stream header.
+    */
+    static bool ReadFrameHeader(std::istream& objStream);
+
+    /**
+     * @brief Read the next block header, the stream is left at the payload. bEnd is set on the end of stream marker.
+    */
+    static bool ReadFrameBlockHeader(std::istream& objStream, STLzBlockHeader& objHeader, bool& bEnd);
+
+    /**
+     * @brief Read the next framed block into strOut, checking its CRC. bEnd is set on the end of stream marker.
+    */
+    static bool ReadFrameBlock(std::istream& objStream, std::string& strPacked, std::string& strOut, bool& bEnd);
+
+    /**
+     * @brief Length of the valid prefix of a framed stream, the header and the blocks up to the first torn or damaged
+     *        one, every block is decoded and its CRC checked. An end marker is not part of it. 0 if the header is wrong.
+    */
+    static uint64_t GetValidFrameLength(std::istream& objStream);
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LZ_CODEC_HPP__
@@ -10,7 +10,7 @@
 CYLOGGER_NAMESPACE_BEGIN
 
 CYEscapeMessage::CYEscapeMessage(const TString& strChannel, ELogType eMsgType, int nServerCode, const TString& strMsg, const TString& strFile, const TString& strFunction, int nLine) 
-: CYBaseMessage(strChannel, eMsgType, nServerCode, strMsg, strFile, strFunction, nLine)
+: CYLoggerMessage(strChannel, eMsgType, nServerCode, strMsg, strFile, strFunction, nLine)
 {
 	EXCEPTION_BEGIN
 	{
@@ -37,8 +37,9 @@ int32_t CYEscapeMessage::GetTypeIndex()
 */
 const TString CYEscapeMessage::GetFormatMessage() const
 {
-	CYTimeStamps objTimeStamp = GetTimeStamp();
-	return m_ptrTemplateLayout->GetFormatMessage(GetChannel(), static_cast<ELogType>(GetMsgType()), GetSeverCode(), GetMsg(), GetFile(), GetFunction(), GetLine(), m_nProcessId, GetThreadId(), objTimeStamp.GetYY(),objTimeStamp.GetMM(), objTimeStamp.GetDD(), objTimeStamp.GetHR(), objTimeStamp.GetMN(), objTimeStamp.GetSC(), objTimeStamp.GetMMN(), true);
+	int nYY, nMM, nDD, nHR, nMN, nSC, nMMN;
+	GetTimeFields(nYY, nMM, nDD, nHR, nMN, nSC, nMMN);
+	return m_ptrTemplateLayout->GetFormatMessage(GetChannel(), static_cast<ELogType>(GetMsgType()), GetSeverCode(), GetMsg(), GetFile(), GetFunction(), GetLine(), m_nProcessId, GetThreadId(), nYY, nMM, nDD, nHR, nMN, nSC, nMMN, true);
 }
 
 CYLOGGER_NAMESPACE_END
\ No newline at end of file
@@ -47,12 +47,12 @@
 #include <list>
 
 #include "Common/CYPublicFunction.hpp"
-#include "CYCommon/Common/Message/CYBaseMessage.hpp"
+#include "Common/Message/CYLoggerMessage.hpp"
 
 CYLOGGER_NAMESPACE_BEGIN
 
 class ICYLoggerTemplateLayout;
-class CYEscapeMessage : public CYBaseMessage
+class CYEscapeMessage : public CYLoggerMessage
 {
 public:
 	CYEscapeMessage(const TString& strChannel, ELogType eMsgType, int nServerCode, const TString& strMsg, const TString& strFile, const TString& strFunction, int nLine);
@@ -0,0 +1,492 @@
+#include "Common/Message/CYLogArgs.hpp"
+#include "Common/Binary/CYBinaryLogFormat.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+namespace
+{
+/**
+ * @brief Length modifier of a conversion.
+*/
+enum class ELength
+{
+    NONE,
+    CHAR,
+    SHORT,
+    LONG,
+    LONG_LONG,
+    INTMAX,
+    SIZE,
+    PTRDIFF,
+};
+
+/**
+ * @brief One parsed conversion, from the '%' to the conversion character.
+*/
+struct STSpec
+{
+    const char* pBegin = nullptr;
+    size_t      nLength = 0;
+    int         nStar = 0;
+    bool        bPrecisionStar = false;
+    int         nPrecision = -1;
+    ELength     eLength = ELength::NONE;
+    char        cConversion = 0;
+};
+
+/**
+ * @brief Read a decimal field, false when it is larger than LOG_ARGS_MAX_WIDTH.
+*/
+bool ParseNumber(const char*& p, int& nValue)
+{
+    nValue = 0;
+    while (*p >= '0' && *p <= '9')
+    {
+        nValue = nValue * 10 + (*p++ - '0');
+        if (nValue > LOG_ARGS_MAX_WIDTH)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Parse the conversion starting at the '%' p points to, p is left after it. False for conversions that are not
+ *        supported.
+*/
+bool ParseSpec(const char*& p, const char* pEnd, STSpec& objSpec)
+{
+    objSpec = STSpec();
+    objSpec.pBegin = p++;
+
+    while (p < pEnd && std::strchr("-+ #0'", *p) != nullptr)
+        ++p;
+
+    int nValue = 0;
+    if (p < pEnd && *p == '*')
+    {
+        ++objSpec.nStar;
+        ++p;
+    }
+    else if (!ParseNumber(p, nValue) || (p < pEnd && *p == '$'))
+    {
+        return false;
+    }
+
+    if (p < pEnd && *p == '.')
+    {
+        ++p;
+        if (p < pEnd && *p == '*')
+        {
+            ++objSpec.nStar;
+            objSpec.bPrecisionStar = true;
+            ++p;
+        }
+        else
+        {
+            if (!ParseNumber(p, objSpec.nPrecision))
+                return false;
+        }
+    }
+
+    if (p + 1 < pEnd && p[0] == 'h' && p[1] == 'h')
+    {
+        objSpec.eLength = ELength::CHAR;
+        p += 2;
+    }
+    else if (p + 1 < pEnd && p[0] == 'l' && p[1] == 'l')
+    {
+        objSpec.eLength = ELength::LONG_LONG;
+        p += 2;
+    }
+    else if (p < pEnd)
+    {
+        switch (*p)
+        {
+        case 'h': objSpec.eLength = ELength::SHORT; ++p; break;
+        case 'l': objSpec.eLength = ELength::LONG; ++p; break;
+        case 'j': objSpec.eLength = ELength::INTMAX; ++p; break;
+        case 'z': objSpec.eLength = ELength::SIZE; ++p; break;
+        case 't': objSpec.eLength = ELength::PTRDIFF; ++p; break;
+        default: break;
+        }
+    }
+
+    if (p >= pEnd)
+        return false;
+
+    objSpec.cConversion = *p++;
+    objSpec.nLength = static_cast<size_t>(p - objSpec.pBegin);
+    switch (objSpec.cConversion)
+    {
+    case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+        return true;
+    case 'c': case 's':
+        return objSpec.eLength == ELength::NONE;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        return objSpec.eLength == ELength::NONE || objSpec.eLength == ELength::LONG;
+    case 'p':
+        return objSpec.eLength == ELength::NONE;
+    default:
+        return false;
+    }
+}
+
+bool IsSigned(char cConversion)
+{
+    return cConversion == 'd' || cConversion == 'i' || cConversion == 'c';
+}
+
+bool IsDouble(char cConversion)
+{
+    return std::strchr("fFeEgGaA", cConversion) != nullptr;
+}
+
+/**
+ * @brief Cursor over a captured argument list.
+*/
+class CYArgsReader final
+{
+public:
+    explicit CYArgsReader(std::string_view strArgs)
+        : m_strArgs(strArgs)
+    {
+    }
+
+    bool GetType(EBinaryArgType eType)
+    {
+        if (m_nPos >= m_strArgs.size() || static_cast<uint8_t>(m_strArgs[m_nPos]) != eType)
+            return false;
+        ++m_nPos;
+        return true;
+    }
+
+    bool GetVarint(uint64_t& nValue)
+    {
+        nValue = 0;
+        for (int nShift = 0; nShift < 64 && m_nPos < m_strArgs.size(); nShift += 7)
+        {
+            uint8_t nByte = static_cast<uint8_t>(m_strArgs[m_nPos++]);
+            nValue |= static_cast<uint64_t>(nByte & 0x7F) << nShift;
+            if ((nByte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    bool GetZigZag(int64_t& nValue)
+    {
+        uint64_t nRaw = 0;
+        if (!GetVarint(nRaw))
+            return false;
+        nValue = static_cast<int64_t>(nRaw >> 1) ^ -static_cast<int64_t>(nRaw & 1);
+        return true;
+    }
+
+    bool GetFixed64(uint64_t& nValue)
+    {
+        if (m_strArgs.size() - m_nPos < 8)
+            return false;
+        nValue = 0;
+        for (int i = 0; i < 8; ++i)
+        {
+            nValue |= static_cast<uint64_t>(static_cast<uint8_t>(m_strArgs[m_nPos++])) << (i * 8);
+        }
+        return true;
+    }
+
+    bool GetString(std::string_view& strValue)
+    {
+        uint64_t nLen = 0;
+        if (!GetVarint(nLen) || nLen > m_strArgs.size() - m_nPos)
+            return false;
+        strValue = m_strArgs.substr(m_nPos, static_cast<size_t>(nLen));
+        m_nPos += static_cast<size_t>(nLen);
+        return true;
+    }
+
+    bool IsEnd() const
+    {
+        return m_nPos == m_strArgs.size();
+    }
+
+private:
+    std::string_view m_strArgs;
+    size_t m_nPos = 0;
+};
+
+/**
+ * @brief Append one printf conversion to strOut.
+*/
+template<typename... Args>
+void AppendPrintf(std::string& strOut, const char* szSpec, Args... args)
+{
+    constexpr size_t nGuess = 64;
+    size_t nPos = strOut.size();
+    strOut.resize(nPos + nGuess);
+    int nLen = std::snprintf(&strOut[nPos], nGuess, szSpec, args...);
+    if (nLen < 0)
+    {
+        strOut.resize(nPos);
+        return;
+    }
+
+    if (static_cast<size_t>(nLen) >= nGuess)
+    {
+        strOut.resize(nPos + static_cast<size_t>(nLen));
+        std::snprintf(&strOut[nPos], static_cast<size_t>(nLen) + 1, szSpec, args...);
+    }
+    strOut.resize(nPos + static_cast<size_t>(nLen));
+}
+
+template<typename T>
+void AppendValue(std::string& strOut, const char* szSpec, const int* pStar, int nStar, T value)
+{
+    if (nStar == 0)
+        AppendPrintf(strOut, szSpec, value);
+    else if (nStar == 1)
+        AppendPrintf(strOut, szSpec, pStar[0], value);
+    else
+        AppendPrintf(strOut, szSpec, pStar[0], pStar[1], value);
+}
+
+/**
+ * @brief Append a signed value converted back to the type of its length modifier.
+*/
+void AppendSigned(std::string& strOut, const STSpec& objSpec, const char* szSpec, const int* pStar, int64_t nValue)
+{
+    switch (objSpec.eLength)
+    {
+    case ELength::LONG: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<long>(nValue)); break;
+    case ELength::LONG_LONG: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<long long>(nValue)); break;
+    case ELength::INTMAX: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<intmax_t>(nValue)); break;
+    case ELength::SIZE: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<std::make_signed_t<size_t>>(nValue)); break;
+    case ELength::PTRDIFF: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<ptrdiff_t>(nValue)); break;
+    default: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<int>(nValue)); break;
+    }
+}
+
+/**
+ * @brief Append an unsigned value converted back to the type of its length modifier.
+*/
+void AppendUnsigned(std::string& strOut, const STSpec& objSpec, const char* szSpec, const int* pStar, uint64_t nValue)
+{
+    switch (objSpec.eLength)
+    {
+    case ELength::LONG: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<unsigned long>(nValue)); break;
+    case ELength::LONG_LONG: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<unsigned long long>(nValue)); break;
+    case ELength::INTMAX: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<uintmax_t>(nValue)); break;
+    case ELength::SIZE: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<size_t>(nValue)); break;
+    case ELength::PTRDIFF: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<std::make_unsigned_t<ptrdiff_t>>(nValue)); break;
+    default: AppendValue(strOut, szSpec, pStar, objSpec.nStar, static_cast<unsigned int>(nValue)); break;
+    }
+}
+}
+
+/**
+ * @brief Capture the arguments of szFormat.
+*/
+bool CYLogArgs::Capture(const char* szFormat, va_list args, std::string& strArgs)
+{
+    CYBinaryWriter objWriter(strArgs);
+    const char* pEnd = szFormat + std::strlen(szFormat);
+    for (const char* p = szFormat; p < pEnd; )
+    {
+        if (*p != '%')
+        {
+            ++p;
+            continue;
+        }
+
+        if (p + 1 < pEnd && p[1] == '%')
+        {
+            p += 2;
+            continue;
+        }
+
+        STSpec objSpec;
+        if (!ParseSpec(p, pEnd, objSpec))
+            return false;
+
+        int nPrecision = objSpec.nPrecision;
+        for (int i = 0; i < objSpec.nStar; ++i)
+        {
+            int nStar = va_arg(args, int);
+            if (nStar > LOG_ARGS_MAX_WIDTH || nStar < -LOG_ARGS_MAX_WIDTH)
+                return false;
+            if (objSpec.bPrecisionStar && i + 1 == objSpec.nStar)
+                nPrecision = nStar;
+            objWriter.PutByte(BINARY_ARG_SIGNED);
+            objWriter.PutZigZag(nStar);
+        }
+
+        if (IsSigned(objSpec.cConversion))
+        {
+            int64_t nValue = 0;
+            switch (objSpec.eLength)
+            {
+            case ELength::LONG: nValue = va_arg(args, long); break;
+            case ELength::LONG_LONG: nValue = va_arg(args, long long); break;
+            case ELength::INTMAX: nValue = va_arg(args, intmax_t); break;
+            case ELength::SIZE: nValue = va_arg(args, std::make_signed_t<size_t>); break;
+            case ELength::PTRDIFF: nValue = va_arg(args, ptrdiff_t); break;
+            default: nValue = va_arg(args, int); break;
+            }
+            objWriter.PutByte(BINARY_ARG_SIGNED);
+            objWriter.PutZigZag(nValue);
+        }
+        else if (IsDouble(objSpec.cConversion))
+        {
+            double fValue = va_arg(args, double);
+            uint64_t nBits = 0;
+            std::memcpy(&nBits, &fValue, sizeof(nBits));
+            objWriter.PutByte(BINARY_ARG_DOUBLE);
+            objWriter.PutFixed64(nBits);
+        }
+        else if (objSpec.cConversion == 's')
+        {
+            const char* pszValue = va_arg(args, const char*);
+            std::string_view strValue = "(null)";
+            if (pszValue != nullptr)
+            {
+                // A precision bounds the read, the argument need not be terminated.
+                strValue = nPrecision >= 0 ? std::string_view(pszValue, strnlen(pszValue, static_cast<size_t>(nPrecision))) : std::string_view(pszValue);
+            }
+            if (strValue.size() > LOG_BINARY_MAX_STRING)
+                return false;
+            objWriter.PutByte(BINARY_ARG_STRING);
+            objWriter.PutString(strValue);
+        }
+        else if (objSpec.cConversion == 'p')
+        {
+            objWriter.PutByte(BINARY_ARG_POINTER);
+            objWriter.PutVarint(reinterpret_cast<uintptr_t>(va_arg(args, void*)));
+        }
+        else
+        {
+            uint64_t nValue = 0;
+            switch (objSpec.eLength)
+            {
+            case ELength::LONG: nValue = va_arg(args, unsigned long); break;
+            case ELength::LONG_LONG: nValue = va_arg(args, unsigned long long); break;
+            case ELength::INTMAX: nValue = va_arg(args, uintmax_t); break;
+            case ELength::SIZE: nValue = va_arg(args, size_t); break;
+            case ELength::PTRDIFF: nValue = va_arg(args, std::make_unsigned_t<ptrdiff_t>); break;
+            default: nValue = va_arg(args, unsigned int); break;
+            }
+            objWriter.PutByte(BINARY_ARG_UNSIGNED);
+            objWriter.PutVarint(nValue);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Capture a text as the single argument of the format "%s".
+*/
+void CYLogArgs::CaptureText(std::string_view strText, std::string& strArgs)
+{
+    CYBinaryWriter objWriter(strArgs);
+    objWriter.PutByte(BINARY_ARG_STRING);
+    objWriter.PutString(strText);
+}
+
+/**
+ * @brief Render a format with captured arguments.
+*/
+bool CYLogArgs::Format(std::string_view strFormat, std::string_view strArgs, std::string& strOut)
+{
+    CYArgsReader objReader(strArgs);
+    const char* pEnd = strFormat.data() + strFormat.size();
+    const char* p = strFormat.data();
+    char szSpec[64];
+    std::string strTemp;
+
+    while (p < pEnd)
+    {
+        const char* pPercent = static_cast<const char*>(std::memchr(p, '%', static_cast<size_t>(pEnd - p)));
+        if (pPercent == nullptr)
+        {
+            strOut.append(p, pEnd);
+            break;
+        }
+
+        strOut.append(p, pPercent);
+        p = pPercent;
+        if (p + 1 < pEnd && p[1] == '%')
+        {
+            strOut.push_back('%');
+            p += 2;
+            continue;
+        }
+
+        STSpec objSpec;
+        if (!ParseSpec(p, pEnd, objSpec) || objSpec.nLength >= sizeof(szSpec))
+            return false;
+        std::memcpy(szSpec, objSpec.pBegin, objSpec.nLength);
+        szSpec[objSpec.nLength] = '\0';
+
+        int arrStar[2] = { 0, 0 };
+        for (int i = 0; i < objSpec.nStar; ++i)
+        {
+            int64_t nStar = 0;
+            if (!objReader.GetType(BINARY_ARG_SIGNED) || !objReader.GetZigZag(nStar) || nStar > LOG_ARGS_MAX_WIDTH || nStar < -LOG_ARGS_MAX_WIDTH)
+                return false;
+            arrStar[i] = static_cast<int>(nStar);
+        }
+
+        if (IsSigned(objSpec.cConversion))
+        {
+            int64_t nValue = 0;
+            if (!objReader.GetType(BINARY_ARG_SIGNED) || !objReader.GetZigZag(nValue))
+                return false;
+            AppendSigned(strOut, objSpec, szSpec, arrStar, nValue);
+        }
+        else if (IsDouble(objSpec.cConversion))
+        {
+            uint64_t nBits = 0;
+            if (!objReader.GetType(BINARY_ARG_DOUBLE) || !objReader.GetFixed64(nBits))
+                return false;
+            double fValue = 0.0;
+            std::memcpy(&fValue, &nBits, sizeof(fValue));
+            AppendValue(strOut, szSpec, arrStar, objSpec.nStar, fValue);
+        }
+        else if (objSpec.cConversion == 's')
+        {
+            std::string_view strValue;
+            if (!objReader.GetType(BINARY_ARG_STRING) || !objReader.GetString(strValue))
+                return false;
+            if (objSpec.nLength == 2)
+            {
+                strOut.append(strValue);
+            }
+            else
+            {
+                strTemp.assign(strValue);
+                AppendValue(strOut, szSpec, arrStar, objSpec.nStar, strTemp.c_str());
+            }
+        }
+        else if (objSpec.cConversion == 'p')
+        {
+            uint64_t nValue = 0;
+            if (!objReader.GetType(BINARY_ARG_POINTER) || !objReader.GetVarint(nValue))
+                return false;
+            AppendValue(strOut, szSpec, arrStar, objSpec.nStar, reinterpret_cast<const void*>(static_cast<uintptr_t>(nValue)));
+        }
+        else
+        {
+            uint64_t nValue = 0;
+            if (!objReader.GetType(BINARY_ARG_UNSIGNED) || !objReader.GetVarint(nValue))
+                return false;
+            AppendUnsigned(strOut, objSpec, szSpec, arrStar, nValue);
+        }
+    }
+    return objReader.IsEnd();
+}
+
+CYLOGGER_NAMESPACE_END
@@ -41,44 +41,43 @@
   * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
   */
 
-#ifndef __CY_FPS_COUNTER_HPP__
-#define __CY_FPS_COUNTER_HPP__
+#ifndef __CY_LOG_ARGS_HPP__
+#define __CY_LOG_ARGS_HPP__
 
 #include "Inc/ICYLoggerDefine.hpp"
 
-#include <iostream>
-#include <chrono>
-#include <thread>
-#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <cstdarg>
 
 CYLOGGER_NAMESPACE_BEGIN
 
-class CYFPSCounter
+static constexpr int LOG_ARGS_MAX_WIDTH = 4096;
+
+/**
+ * @brief Printf arguments captured by type on the caller thread and rendered later, by the log thread or by the
+ * decoder. The captured list is the ARGS field of the binary log format, so the binary appender stores it as it is.
+*/
+class CYLogArgs final
 {
 public:
-    CYFPSCounter(int nMeasureDuration);
-    virtual ~CYFPSCounter() noexcept = default;
-
-    void StartCounter();
-    void UpdateCounter();
-
-    double GetCurrentFPS() const;
-    double GetAverageFPS() const;
-
-private:
-    void UpdateAverageFPS(int nIndex);
-
-private:
-    int m_nFrameCount[2];
-    int m_nMeasureDuration;
+    /**
+     * @brief Capture the arguments of szFormat. Returns false for a format that cannot be deferred (%n, positional
+     *        arguments, long double, wide characters, widths over LOG_ARGS_MAX_WIDTH), the caller formats it at once.
+    */
+    static bool Capture(const char* szFormat, va_list args, std::string& strArgs);
 
-    double m_fCurrentFps;
-    double m_fAverageFps;
+    /**
+     * @brief Capture a text as the single argument of the format "%s".
+    */
+    static void CaptureText(std::string_view strText, std::string& strArgs);
 
-    std::chrono::time_point<std::chrono::high_resolution_clock> m_tpStartTime0;
-    std::chrono::time_point<std::chrono::high_resolution_clock> m_tpStartTime1;
+    /**
+     * @brief Render a format with captured arguments, false when they do not match the format.
+    */
+    static bool Format(std::string_view strFormat, std::string_view strArgs, std::string& strOut);
 };
 
 CYLOGGER_NAMESPACE_END
 
-#endif //__CY_FPS_COUNTER_HPP__
+#endif //__CY_LOG_ARGS_HPP__
@@ -0,0 +1,89 @@
+#include "Common/Message/CYLoggerMessage.hpp"
+#include "Common/Message/CYLogArgs.hpp"
+#include "CYCommon/Common/Structure/CYStringUtils.hpp"
+
+#if defined(CYLOGGER_WIN_OS)
+#include <windows.h>
+#elif defined(CYLOGGER_LINUX_OS)
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(CYLOGGER_MAC_OS) || defined(CYLOGGER_IOS_OS)
+#include <pthread.h>
+#else
+#include <thread>
+#include <functional>
+#endif
+
+CYLOGGER_NAMESPACE_BEGIN
+
+namespace
+{
+/**
+ * @brief Id of the calling thread, asked from the system once per thread.
+*/
+unsigned long GetCallerThreadId() noexcept
+{
+#if defined(CYLOGGER_WIN_OS)
+    return static_cast<unsigned long>(::GetCurrentThreadId());
+#else
+    static thread_local unsigned long s_nThreadId = []() {
+#if defined(CYLOGGER_LINUX_OS)
+        return static_cast<unsigned long>(::syscall(SYS_gettid));
+#elif defined(CYLOGGER_MAC_OS) || defined(CYLOGGER_IOS_OS)
+        uint64_t nThreadId = 0;
+        ::pthread_threadid_np(nullptr, &nThreadId);
+        return static_cast<unsigned long>(nThreadId);
+#else
+        return static_cast<unsigned long>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+    }();
+    return s_nThreadId;
+#endif
+}
+}
+
+CYLoggerMessage::CYLoggerMessage(const TString& strChannel, ELogType eMsgType, int nServerCode, const TString& strMsg, const TString& strFile, const TString& strFunction, int nLine)
+    : CYMessageTime()
+    , m_strChannel(strChannel)
+    , m_eMsgType(eMsgType)
+    , m_nServerCode(nServerCode)
+    , m_strMsg(strMsg)
+    , m_strFile(strFile)
+    , m_strFunction(strFunction)
+    , m_nLine(nLine)
+    , m_nThreadId(GetCallerThreadId())
+{
+}
+
+/**
+ * @brief Replace the text by its format and captured arguments.
+*/
+void CYLoggerMessage::SetArgs(std::string&& strArgs)
+{
+    m_strFormat.swap(m_strMsg);
+    m_strArgs = std::move(strArgs);
+    m_bHasArgs = true;
+}
+
+/**
+ * @brief Get the text, a deferred message is rendered on the first call.
+*/
+const TString& CYLoggerMessage::GetMsg() const
+{
+    if (m_bHasArgs)
+    {
+        std::call_once(m_objRender, [this]() {
+#if CY_USE_UNICODE
+            std::string strFormat = CYCOMMON_NAMESPACE::CYStringUtils::TString2String(m_strFormat.c_str());
+            std::string strMsg;
+            m_strMsg = CYLogArgs::Format(strFormat, m_strArgs, strMsg) ? CYCOMMON_NAMESPACE::CYStringUtils::String2TString(strMsg) : m_strFormat;
+#else
+            if (!CYLogArgs::Format(m_strFormat, m_strArgs, m_strMsg))
+                m_strMsg = m_strFormat;
+#endif
+            });
+    }
+    return m_strMsg;
+}
+
+CYLOGGER_NAMESPACE_END
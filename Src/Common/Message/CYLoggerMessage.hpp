@@ -0,0 +1,131 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+
+#ifndef __CY_LOGGER_MESSAGE_HPP__
+#define __CY_LOGGER_MESSAGE_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Common/Message/CYMessageTime.hpp"
+
+#include <mutex>
+#include <string>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Base of the queued log messages. It replaces CYBaseMessage inside the logger so that a message is stamped
+ * once, by CYMessageTime, instead of also taking the system clock and localtime of CYBaseMessage. A message written
+ * through a printf format may carry the format and its captured arguments instead of the text, the text is then
+ * rendered on the first GetMsg(), on a log thread.
+*/
+class CYLoggerMessage : public CYMessageTime
+{
+public:
+    CYLoggerMessage(const TString& strChannel, ELogType eMsgType, int nServerCode, const TString& strMsg, const TString& strFile, const TString& strFunction, int nLine);
+    virtual ~CYLoggerMessage() = default;
+
+public:
+    const TString& GetChannel() const { return m_strChannel; }
+    int GetMsgType() const { return m_eMsgType; }
+    int GetSeverCode() const { return m_nServerCode; }
+    const TString& GetMsg() const;
+    const TString& GetFile() const { return m_strFile; }
+    const TString& GetFunction() const { return m_strFunction; }
+    int GetLine() const { return m_nLine; }
+    unsigned long GetThreadId() const { return m_nThreadId; }
+
+    /**
+     * @brief Replace the text by its format, kept in the message, and the arguments captured by CYLogArgs. Caller
+     *        thread, before the message is queued.
+    */
+    void SetArgs(std::string&& strArgs);
+
+    /**
+     * @brief Whether the message carries a format and captured arguments, see GetFormat() and GetArgs().
+    */
+    bool HasArgs() const { return m_bHasArgs; }
+    const TString& GetFormat() const { return m_strFormat; }
+    const std::string& GetArgs() const { return m_strArgs; }
+
+    /**
+     * @brief Bytes the caller captured for the text, the format and arguments of a deferred message.
+    */
+    size_t GetMsgBytes() const { return (m_strMsg.size() + m_strFormat.size()) * sizeof(TChar) + m_strArgs.size(); }
+
+    /**
+     * @brief Get Formate Log Message.
+    */
+    virtual const TString GetFormatMessage() const = 0;
+
+    /**
+     * @brief Get Type Index
+    */
+    virtual int32_t GetTypeIndex() = 0;
+
+private:
+    TString m_strChannel;
+    ELogType m_eMsgType;
+    int m_nServerCode;
+    mutable TString m_strMsg;
+    TString m_strFile;
+    TString m_strFunction;
+    int m_nLine;
+
+    /**
+     * @brief Id of the thread that wrote the message.
+    */
+    unsigned long m_nThreadId;
+
+    /**
+     * @brief Deferred text, rendered once into m_strMsg by the first log thread that asks for it.
+    */
+    bool m_bHasArgs = false;
+    TString m_strFormat;
+    std::string m_strArgs;
+    mutable std::once_flag m_objRender;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LOGGER_MESSAGE_HPP__
@@ -0,0 +1,145 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_MESSAGE_TIME_HPP__
+#define __CY_MESSAGE_TIME_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Common/Time/CYTimeFormat.hpp"
+#include "Common/Time/CYTscClock.hpp"
+#include "CYCommon/Common/Time/CYTimeStamps.hpp"
+
+#include <type_traits>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Message capture time, the only time stamp a message takes, from the clock selected by LOG_TIME_CLOCK_MODE.
+ * LOG_CLOCK_SYSTEM keeps a CYTimeStamps broken down on the caller thread, the other modes keep only the raw clock value
+ * and leave the local time split to the log thread.
+*/
+template<ELogClockMode eClockMode>
+class CYMessageTimeT
+{
+public:
+    CYMessageTimeT()
+    {
+        if constexpr (eClockMode == ELogClockMode::LOG_CLOCK_TSC)
+        {
+            m_objTime = CYTscClock::Now();
+        }
+        else if constexpr (eClockMode == ELogClockMode::LOG_CLOCK_COARSE)
+        {
+            m_objTime = static_cast<uint64_t>(CYTimeFormat::Now());
+        }
+    }
+
+public:
+    /**
+     * @brief Get the message time in nanoseconds since epoch.
+    */
+    int64_t GetTimeNs() const
+    {
+        if constexpr (eClockMode == ELogClockMode::LOG_CLOCK_TSC)
+        {
+            return CYTscClock::ToNanoseconds(m_objTime);
+        }
+        else if constexpr (eClockMode == ELogClockMode::LOG_CLOCK_COARSE)
+        {
+            return static_cast<int64_t>(m_objTime);
+        }
+        else
+        {
+            return CYTimeFormat::Join(m_objTime.GetYY(), m_objTime.GetMM(), m_objTime.GetDD(), m_objTime.GetHR(), m_objTime.GetMN(), m_objTime.GetSC(), m_objTime.GetMMN());
+        }
+    }
+
+    /**
+     * @brief Get the raw capture value, it orders the messages of one process without converting them.
+    */
+    int64_t GetSortTime() const
+    {
+        if constexpr (eClockMode == ELogClockMode::LOG_CLOCK_SYSTEM)
+        {
+            return m_objTime.GetTime();
+        }
+        else
+        {
+            return static_cast<int64_t>(m_objTime);
+        }
+    }
+
+    /**
+     * @brief Get the local time fields of the message.
+    */
+    void GetTimeFields(int& nYY, int& nMM, int& nDD, int& nHR, int& nMN, int& nSC, int& nMMN) const
+    {
+        if constexpr (eClockMode == ELogClockMode::LOG_CLOCK_SYSTEM)
+        {
+            nYY = m_objTime.GetYY();
+            nMM = m_objTime.GetMM();
+            nDD = m_objTime.GetDD();
+            nHR = m_objTime.GetHR();
+            nMN = m_objTime.GetMN();
+            nSC = m_objTime.GetSC();
+            nMMN = m_objTime.GetMMN();
+        }
+        else
+        {
+            CYTimeFormat::Split(GetTimeNs(), nYY, nMM, nDD, nHR, nMN, nSC, nMMN);
+        }
+    }
+
+private:
+    /**
+     * @brief Capture time, CYTimeStamps in LOG_CLOCK_SYSTEM mode, raw TSC in LOG_CLOCK_TSC mode, nanoseconds since epoch
+     * in LOG_CLOCK_COARSE mode.
+    */
+    std::conditional_t<eClockMode == ELogClockMode::LOG_CLOCK_SYSTEM, CYTimeStamps, uint64_t> m_objTime{};
+};
+
+using CYMessageTime = CYMessageTimeT<LOG_TIME_CLOCK_MODE>;
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_MESSAGE_TIME_HPP__
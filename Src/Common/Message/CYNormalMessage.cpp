@@ -8,7 +8,7 @@
 CYLOGGER_NAMESPACE_BEGIN
 
 CYNormalMessage::CYNormalMessage(const TString& strChannel, ELogType eMsgType, int nServerCode, const TString& strMsg, const TString& strFile, const TString& strFunction, int nLine)
-	: CYBaseMessage(strChannel, eMsgType, nServerCode, strMsg, strFile, strFunction, nLine)
+	: CYLoggerMessage(strChannel, eMsgType, nServerCode, strMsg, strFile, strFunction, nLine)
 {
     EXCEPTION_BEGIN
     {
@@ -35,8 +35,9 @@ int32_t CYNormalMessage::GetTypeIndex()
 */
 const TString CYNormalMessage::GetFormatMessage() const 
 {
-    CYTimeStamps objTimeStamp = GetTimeStamp();
-    return m_ptrTemplateLayout->GetFormatMessage(GetChannel(), static_cast<ELogType>(GetMsgType()), GetSeverCode(), GetMsg(), GetFile(), GetFunction(), GetLine(), m_nProcessId, GetThreadId(), objTimeStamp.GetYY(), objTimeStamp.GetMM(), objTimeStamp.GetDD(), objTimeStamp.GetHR(), objTimeStamp.GetMN(), objTimeStamp.GetSC(), objTimeStamp.GetMMN(), false);
+    int nYY, nMM, nDD, nHR, nMN, nSC, nMMN;
+    GetTimeFields(nYY, nMM, nDD, nHR, nMN, nSC, nMMN);
+    return m_ptrTemplateLayout->GetFormatMessage(GetChannel(), static_cast<ELogType>(GetMsgType()), GetSeverCode(), GetMsg(), GetFile(), GetFunction(), GetLine(), m_nProcessId, GetThreadId(), nYY, nMM, nDD, nHR, nMN, nSC, nMMN, false);
 }
 
 CYLOGGER_NAMESPACE_END
\ No newline at end of file
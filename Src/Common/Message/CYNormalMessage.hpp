@@ -45,12 +45,12 @@
 #define __CY_NORMAL_MESSAGE_HPP__
 
 #include "Inc/ICYLoggerDefine.hpp"
-#include "CYCommon/Common/Message/CYBaseMessage.hpp"
+#include "Common/Message/CYLoggerMessage.hpp"
 
 CYLOGGER_NAMESPACE_BEGIN
 
 class ICYLoggerTemplateLayout;
-class CYNormalMessage : public CYBaseMessage
+class CYNormalMessage : public CYLoggerMessage
 {
 public:
 	CYNormalMessage(const TString& strChannel, ELogType eMsgType, int nServerCode, const TString& strMsg, const TString& strFile, const TString& strFunction, int nLine);
@@ -6,7 +6,7 @@
 CYLOGGER_NAMESPACE_BEGIN
 
 CYStrMessage::CYStrMessage(const TString& strChannel, ELogType eMsgType, int nServerCode, const TString& strMsg)
-: CYBaseMessage(strChannel, eMsgType, nServerCode, strMsg)
+: CYLoggerMessage(strChannel, eMsgType, nServerCode, strMsg, TString(), TString(), 0)
 , CYLoggerTemplateLayoutEscape()
 {
 #ifdef _WIN32
@@ -33,8 +33,11 @@ const TString CYStrMessage::GetFormatMessage() const
 	TString delimiters;
 	GetDelimiters(delimiters, escapeChar);
 	TString s;
+	int nYY, nMM, nDD, nHR, nMN, nSC, nMMN;
+	GetTimeFields(nYY, nMM, nDD, nHR, nMN, nSC, nMMN);
+	TChar szTimeStamp[LOG_TIME_STAMP_LENGTH];
 	TOStringStream ss;
-	ss << delimiters[TYPE_HEADER_START] << GetTimeStamp().ToString();
+	ss << delimiters[TYPE_HEADER_START] << TStringView(szTimeStamp, CYTimeFormat::Format(szTimeStamp, nYY, nMM, nDD, nHR, nMN, nSC, nMMN));
 	TChar cMsgType = { 0, };
 
     switch (GetMsgType())
@@ -45,12 +45,12 @@
 #define __CY_STR_MESSAGE_HPP__
 
 #include "Inc/ICYLogger.hpp"
-#include "CYCommon/Common/Message/CYBaseMessage.hpp"
+#include "Common/Message/CYLoggerMessage.hpp"
 #include "Entity/Layout/CYLoggerTemplateLayoutEscape.hpp"
 
 CYLOGGER_NAMESPACE_BEGIN
 
-class CYStrMessage : public CYBaseMessage, public CYLoggerTemplateLayoutEscape
+class CYStrMessage : public CYLoggerMessage, public CYLoggerTemplateLayoutEscape
 {
 public:
 	CYStrMessage(const TString& strChannel, ELogType eMsgType, int nServerCode, const TString& strMsg);
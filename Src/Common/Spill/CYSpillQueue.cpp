@@ -0,0 +1,266 @@
+#include "Common/Spill/CYSpillQueue.hpp"
+#include "Common/CYPublicFunction.hpp"
+#include "Common/CYFormatDefine.hpp"
+
+#ifdef CYLOGGER_WIN_OS
+#include <windows.h>
+#else
+#include <dirent.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+namespace
+{
+    constexpr const TChar* SPILL_FILE_EXT = TEXT(".spill");
+}
+
+CYSpillQueue::CYSpillQueue(const TString& strDir, const TString& strName, uint64_t nBudget, uint64_t nSegmentSize)
+    : m_strDir(strDir)
+    , m_strName(strName)
+    , m_nBudget(nBudget)
+    , m_nSegmentSize(nSegmentSize)
+    , m_nTotalSize(0)
+    , m_nWriteSequence(0)
+{
+}
+
+CYSpillQueue::~CYSpillQueue()
+{
+    m_objReader.close();
+    m_objWriter.close();
+}
+
+/**
+ * @brief Create the directory and pick up the segments of a previous run.
+*/
+void CYSpillQueue::Open()
+{
+    CYPublicFunction::CreateDirectory(m_strDir);
+
+    const TString strPrefix = m_strName + TEXT("_");
+    const TString strExt = SPILL_FILE_EXT;
+    std::vector<uint64_t> vecSequence;
+    auto funAddFile = [&](const TString& strFile) {
+        if (strFile.size() <= strPrefix.size() + strExt.size()
+            || strFile.compare(0, strPrefix.size(), strPrefix) != 0
+            || strFile.compare(strFile.size() - strExt.size(), strExt.size(), strExt) != 0)
+            return;
+
+        const TString strSequence = strFile.substr(strPrefix.size(), strFile.size() - strPrefix.size() - strExt.size());
+        if (std::all_of(strSequence.begin(), strSequence.end(), [](TChar c) { return c >= TEXT('0') && c <= TEXT('9'); }))
+        {
+            vecSequence.push_back(std::stoull(strSequence));
+        }
+    };
+
+#ifdef CYLOGGER_WIN_OS
+    WIN32_FIND_DATA struFindFileData;
+    HANDLE hFindFile = FindFirstFile((m_strDir + strPrefix + TEXT("*")).c_str(), &struFindFileData);
+    if (hFindFile != INVALID_HANDLE_VALUE)
+    {
+        do
+        {
+            if ((struFindFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0)
+                funAddFile(struFindFileData.cFileName);
+        } while (FindNextFile(hFindFile, &struFindFileData));
+        FindClose(hFindFile);
+    }
+#else
+    DIR* pDir = opendir(m_strDir.c_str());
+    if (pDir != nullptr)
+    {
+        struct dirent* pEntry = nullptr;
+        while ((pEntry = readdir(pDir)) != nullptr)
+        {
+            funAddFile(pEntry->d_name);
+        }
+        closedir(pDir);
+    }
+#endif
+
+    std::sort(vecSequence.begin(), vecSequence.end());
+    for (uint64_t nSequence : vecSequence)
+    {
+        uint64_t nSize = CYPublicFunction::GetFileSize(GetSegmentName(nSequence));
+        m_lstSegment.push_back({ nSequence, nSize, 0 });
+        m_nTotalSize += nSize;
+    }
+}
+
+/**
+ * @brief Whether there is no record to read.
+*/
+bool CYSpillQueue::IsEmpty() const
+{
+    return m_lstSegment.empty();
+}
+
+/**
+ * @brief Bytes of all segment files.
+*/
+uint64_t CYSpillQueue::GetSize() const
+{
+    return m_nTotalSize;
+}
+
+/**
+ * @brief Append whole records at the tail, false if the disk budget would be exceeded.
+*/
+bool CYSpillQueue::Push(const char* pData, size_t nLength)
+{
+    if (m_nTotalSize + nLength > m_nBudget)
+        return false;
+
+    // Segments of a previous run are never appended to, their tail may be torn.
+    if (!m_objWriter.is_open() || m_lstSegment.empty() || m_lstSegment.back().nSequence != m_nWriteSequence || m_lstSegment.back().nSize >= m_nSegmentSize)
+    {
+        m_objWriter.close();
+        m_nWriteSequence = m_lstSegment.empty() ? LOG_SPILL_FIRST_SEQUENCE : m_lstSegment.back().nSequence + 1;
+        m_objWriter.open(GetSegmentName(m_nWriteSequence).c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        if (!m_objWriter)
+            return false;
+        m_lstSegment.push_back({ m_nWriteSequence, 0, 0 });
+    }
+
+    m_objWriter.write(pData, static_cast<std::streamsize>(nLength));
+    if (m_objWriter.fail())
+        return false;
+
+    m_lstSegment.back().nSize += nLength;
+    m_nTotalSize += nLength;
+    return true;
+}
+
+/**
+ * @brief Insert whole records before all queued records, used to keep unsent records on shutdown.
+*/
+bool CYSpillQueue::PushFront(const char* pData, size_t nLength)
+{
+    if (m_lstSegment.empty())
+        return Push(pData, nLength);
+
+    const uint64_t nSequence = m_lstSegment.front().nSequence - 1;
+    if (nLength == 0 || m_nTotalSize + nLength > m_nBudget || nSequence == 0)
+        return false;
+
+    std::ofstream objFile(GetSegmentName(nSequence).c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    objFile.write(pData, static_cast<std::streamsize>(nLength));
+    objFile.close();
+    if (objFile.fail())
+        return false;
+
+    // The old head is reopened at its read offset once the new head is drained.
+    m_objReader.close();
+    m_lstSegment.push_front({ nSequence, nLength, 0 });
+    m_nTotalSize += nLength;
+    return true;
+}
+
+/**
+ * @brief Append whole records from the head to strOut, at least one record and at most nMaxBytes after the first.
+ * @return bytes appended
+*/
+size_t CYSpillQueue::Pop(std::string& strOut, size_t nMaxBytes)
+{
+    size_t nAppended = 0;
+    while (!m_lstSegment.empty())
+    {
+        STSegment& objHead = m_lstSegment.front();
+        if (m_objWriter.is_open() && objHead.nSequence == m_nWriteSequence)
+        {
+            m_objWriter.flush();
+        }
+
+        if (!m_objReader.is_open())
+        {
+            m_objReader.clear();
+            m_objReader.open(GetSegmentName(objHead.nSequence).c_str(), std::ios_base::in | std::ios_base::binary);
+            m_objReader.seekg(static_cast<std::streamoff>(objHead.nReadOffset));
+        }
+
+        unsigned char arrayHeader[LOG_SPILL_RECORD_HEADER_SIZE];
+        if (!m_objReader || objHead.nReadOffset + LOG_SPILL_RECORD_HEADER_SIZE > objHead.nSize
+            || !m_objReader.read(reinterpret_cast<char*>(arrayHeader), LOG_SPILL_RECORD_HEADER_SIZE))
+        {
+            DropHead();
+            continue;
+        }
+
+        const size_t nLength = (static_cast<size_t>(arrayHeader[0]) << 24) | (static_cast<size_t>(arrayHeader[1]) << 16)
+            | (static_cast<size_t>(arrayHeader[2]) << 8) | arrayHeader[3];
+        const size_t nRecordSize = LOG_SPILL_RECORD_HEADER_SIZE + nLength;
+        if (objHead.nReadOffset + nRecordSize > objHead.nSize)
+        {
+            // Torn record of a crashed run.
+            DropHead();
+            continue;
+        }
+
+        if (nAppended > 0 && nAppended + nRecordSize > nMaxBytes)
+        {
+            m_objReader.seekg(static_cast<std::streamoff>(objHead.nReadOffset));
+            break;
+        }
+
+        const size_t nStart = strOut.size();
+        strOut.append(reinterpret_cast<const char*>(arrayHeader), LOG_SPILL_RECORD_HEADER_SIZE);
+        strOut.resize(nStart + nRecordSize);
+        if (nLength > 0 && !m_objReader.read(&strOut[nStart + LOG_SPILL_RECORD_HEADER_SIZE], static_cast<std::streamsize>(nLength)))
+        {
+            strOut.resize(nStart);
+            DropHead();
+            continue;
+        }
+
+        objHead.nReadOffset += nRecordSize;
+        nAppended += nRecordSize;
+        if (objHead.nReadOffset == objHead.nSize)
+        {
+            // A drained tail segment is deleted as well, the next Push starts a new one.
+            DropHead();
+        }
+    }
+    return nAppended;
+}
+
+/**
+ * @brief Flush the tail segment to the file.
+*/
+void CYSpillQueue::Flush()
+{
+    if (m_objWriter.is_open())
+    {
+        m_objWriter.flush();
+    }
+}
+
+/**
+ * @brief Segment file name.
+*/
+TString CYSpillQueue::GetSegmentName(uint64_t nSequence) const
+{
+    return fmtx::format(TEXT("{}{}_{:020}{}"), m_strDir, m_strName, nSequence, SPILL_FILE_EXT);
+}
+
+/**
+ * @brief Close the reader and delete the head segment.
+*/
+void CYSpillQueue::DropHead()
+{
+    const STSegment objHead = m_lstSegment.front();
+    m_objReader.close();
+    if (m_objWriter.is_open() && objHead.nSequence == m_nWriteSequence)
+    {
+        m_objWriter.close();
+    }
+    CYPublicFunction::Remove(GetSegmentName(objHead.nSequence));
+
+    m_nTotalSize -= (std::min)(m_nTotalSize, objHead.nSize);
+    m_lstSegment.pop_front();
+}
+
+CYLOGGER_NAMESPACE_END
@@ -0,0 +1,168 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_SPILL_QUEUE_HPP__
+#define __CY_SPILL_QUEUE_HPP__
+
+#include "Common/CYPrivateDefine.hpp"
+
+#include <deque>
+#include <fstream>
+#include <string>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Records are a 4 byte big endian payload length followed by the payload, the same layout as stream remote frames.
+*/
+static constexpr int LOG_SPILL_RECORD_HEADER_SIZE = 4;
+
+/**
+ * @brief First segment sequence of a new queue, lower numbers are left for PushFront.
+*/
+static constexpr uint64_t LOG_SPILL_FIRST_SEQUENCE = 1ULL << 32;
+
+/**
+ * @brief FIFO of length prefixed records kept in segment files <dir><name>_<sequence>.spill, strDir ends with the separator.
+ * Whole segments are deleted once read, so the disk usage shrinks while the queue drains. Segments left by a previous
+ * run are picked up by Open and read first; a torn record at the end of a segment is skipped.
+*/
+class CYSpillQueue
+{
+public:
+    CYSpillQueue(const TString& strDir, const TString& strName, uint64_t nBudget, uint64_t nSegmentSize);
+    ~CYSpillQueue();
+
+public:
+    /**
+     * @brief Create the directory and pick up the segments of a previous run.
+    */
+    void Open();
+
+    /**
+     * @brief Whether there is no record to read.
+    */
+    bool IsEmpty() const;
+
+    /**
+     * @brief Bytes of all segment files.
+    */
+    uint64_t GetSize() const;
+
+    /**
+     * @brief Append whole records at the tail, false if the disk budget would be exceeded.
+    */
+    bool Push(const char* pData, size_t nLength);
+
+    /**
+     * @brief Insert whole records before all queued records, used to keep unsent records on shutdown.
+    */
+    bool PushFront(const char* pData, size_t nLength);
+
+    /**
+     * @brief Append whole records from the head to strOut, at least one record and at most nMaxBytes after the first.
+     * @return bytes appended
+    */
+    size_t Pop(std::string& strOut, size_t nMaxBytes);
+
+    /**
+     * @brief Flush the tail segment to the file.
+    */
+    void Flush();
+
+private:
+    /**
+     * @brief One segment file.
+    */
+    struct STSegment
+    {
+        uint64_t nSequence;
+        uint64_t nSize;
+        uint64_t nReadOffset;
+    };
+
+    /**
+     * @brief Segment file name.
+    */
+    TString GetSegmentName(uint64_t nSequence) const;
+
+    /**
+     * @brief Close the reader and delete the head segment.
+    */
+    void DropHead();
+
+private:
+    TString m_strDir;
+    TString m_strName;
+    uint64_t m_nBudget;
+    uint64_t m_nSegmentSize;
+
+    /**
+     * @brief Segments in read order.
+    */
+    std::deque<STSegment> m_lstSegment;
+
+    /**
+     * @brief Bytes of all segment files.
+    */
+    uint64_t m_nTotalSize;
+
+    /**
+     * @brief Reader of the head segment.
+    */
+    std::ifstream m_objReader;
+
+    /**
+     * @brief Writer of the tail segment, only segments created by this process are appended to.
+    */
+    std::ofstream m_objWriter;
+
+    /**
+     * @brief Sequence of the segment m_objWriter appends to.
+    */
+    uint64_t m_nWriteSequence;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_SPILL_QUEUE_HPP__
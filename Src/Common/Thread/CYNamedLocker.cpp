@@ -1,15 +1,20 @@
 #include "Common/Thread/CYNamedLocker.hpp"
 #include "Common/CYPrivateDefine.hpp"
+#include "Statistics/CYLockProfile.hpp"
 
 CYLOGGER_NAMESPACE_BEGIN
 
 CYNamedLocker::CYNamedLocker(const TChar* pszName)
-	: std::mutex()
 {
 	if (pszName != nullptr)
 	{
 		cy_strcpy(m_szName, pszName);
 	}
+
+	if constexpr (LOG_LOCK_PROFILE)
+	{
+		m_pProfile = CYLockProfile::Get(m_szName);
+	}
 }
 
 CYNamedLocker::~CYNamedLocker()
@@ -17,4 +22,44 @@ CYNamedLocker::~CYNamedLocker()
 
 }
 
+/**
+ * @brief Only a failed try_lock reads the clock before waiting, an uncontended lock records no wait.
+*/
+void CYNamedLocker::ProfileLock()
+{
+	bool bContend = !m_mutex.try_lock();
+	int64_t nWait = 0;
+	if (bContend)
+	{
+		int64_t nStart = CYLatencyHistogram::Now();
+		m_mutex.lock();
+		m_nLockTime = CYLatencyHistogram::Now();
+		nWait = m_nLockTime - nStart;
+	}
+	else
+	{
+		m_nLockTime = CYLatencyHistogram::Now();
+	}
+	m_pProfile->AddAcquire(bContend, static_cast<uint64_t>(nWait));
+}
+
+bool CYNamedLocker::ProfileTryLock()
+{
+	if (!m_mutex.try_lock())
+		return false;
+
+	m_nLockTime = CYLatencyHistogram::Now();
+	m_pProfile->AddAcquire(false, 0);
+	return true;
+}
+
+/**
+ * @brief The hold time is recorded while the lock is still held, m_nLockTime belongs to the holder.
+*/
+void CYNamedLocker::ProfileUnlock()
+{
+	m_pProfile->AddHold(static_cast<uint64_t>(CYLatencyHistogram::Now() - m_nLockTime));
+	m_mutex.unlock();
+}
+
 CYLOGGER_NAMESPACE_END
\ No newline at end of file
@@ -50,14 +50,63 @@
 
 CYLOGGER_NAMESPACE_BEGIN
 
-class CYNamedLocker : public std::mutex
+class CYLockProfile;
+
+/**
+ * @brief Mutex carrying a name. With LOG_LOCK_PROFILE set, lock, try_lock and unlock record into the profile of the
+ *        name, otherwise they forward to the std::mutex. The mutex is a member, so no conversion to std::mutex& can
+ *        bypass the profile.
+*/
+class CYNamedLocker
 {
 public:
 	CYNamedLocker(const TChar* pszName);
 	virtual ~CYNamedLocker();
 
+public:
+	void lock()
+	{
+		if constexpr (LOG_LOCK_PROFILE)
+			ProfileLock();
+		else
+			m_mutex.lock();
+	}
+
+	bool try_lock()
+	{
+		if constexpr (LOG_LOCK_PROFILE)
+			return ProfileTryLock();
+		else
+			return m_mutex.try_lock();
+	}
+
+	void unlock()
+	{
+		if constexpr (LOG_LOCK_PROFILE)
+			ProfileUnlock();
+		else
+			m_mutex.unlock();
+	}
+
+	std::mutex::native_handle_type native_handle()
+	{
+		return m_mutex.native_handle();
+	}
+
+private:
+	void ProfileLock();
+	bool ProfileTryLock();
+	void ProfileUnlock();
+
 private:
+	std::mutex m_mutex;
 	TChar  m_szName[512] = { 0 };
+
+	/**
+	 * @brief Profile of m_szName and the time the holder acquired the lock, only used with LOG_LOCK_PROFILE.
+	*/
+	CYLockProfile* m_pProfile = nullptr;
+	int64_t m_nLockTime = 0;
 };
 
 CYLOGGER_NAMESPACE_END
@@ -0,0 +1,191 @@
+#include "Common/Time/CYTimeFormat.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#if defined(CYLOGGER_LINUX_OS) || defined(CYLOGGER_ANDROID_OS)
+#include <time.h>
+#endif
+
+CYLOGGER_NAMESPACE_BEGIN
+
+namespace
+{
+    /**
+     * @brief Two digit lookup table, "00" ~ "99".
+    */
+    constexpr char g_szDigits2[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    /**
+     * @brief Rendered "YYYY-MM-DD HH:MM:SS." of the last formatted second on this thread.
+    */
+    struct STTimePrefixCache
+    {
+        int64_t nKey = -1;
+        TChar   szPrefix[LOG_TIME_PREFIX_LENGTH] = { 0, };
+    };
+
+    /**
+     * @brief Broken-down local time of the last split second on this thread.
+    */
+    struct STTimeSplitCache
+    {
+        int64_t nSeconds = INT64_MIN;
+        std::tm objTm = {};
+    };
+
+    /**
+     * @brief Epoch seconds of the last joined second on this thread.
+    */
+    struct STTimeJoinCache
+    {
+        int64_t nKey = -1;
+        int64_t nSeconds = 0;
+    };
+
+    /**
+     * @brief Pack the date and second fields into one key, 6 bits for each of MM..SC is enough.
+    */
+    inline int64_t PackTimeKey(int nYY, int nMM, int nDD, int nHR, int nMN, int nSC) noexcept
+    {
+        return (static_cast<int64_t>(nYY) << 30) | (nMM << 24) | (nDD << 18) | (nHR << 12) | (nMN << 6) | nSC;
+    }
+
+    thread_local STTimePrefixCache g_objPrefixCache;
+    thread_local STTimeSplitCache g_objSplitCache;
+    thread_local STTimeJoinCache g_objJoinCache;
+}
+
+/**
+ * @brief Capture the current wall clock time in nanoseconds since epoch. Uses CLOCK_REALTIME_COARSE in LOG_CLOCK_COARSE mode.
+*/
+int64_t CYTimeFormat::Now() noexcept
+{
+#if defined(CLOCK_REALTIME_COARSE)
+    if constexpr (LOG_TIME_CLOCK_MODE == CYLOGGER_NAMESPACE::ELogClockMode::LOG_CLOCK_COARSE)
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+        return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+#endif
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Split nanoseconds since epoch into local time fields, localtime is only called when the second changes.
+*/
+void CYTimeFormat::Split(int64_t nTimeNs, int& nYY, int& nMM, int& nDD, int& nHR, int& nMN, int& nSC, int& nMMN) noexcept
+{
+    int64_t nSeconds = nTimeNs / 1000000000;
+    STTimeSplitCache& objCache = g_objSplitCache;
+    if (objCache.nSeconds != nSeconds)
+    {
+        time_t tTime = static_cast<time_t>(nSeconds);
+#ifdef CYLOGGER_WIN_OS
+        localtime_s(&objCache.objTm, &tTime);
+#else
+        localtime_r(&tTime, &objCache.objTm);
+#endif
+        objCache.nSeconds = nSeconds;
+    }
+
+    nYY = objCache.objTm.tm_year + 1900;
+    nMM = objCache.objTm.tm_mon + 1;
+    nDD = objCache.objTm.tm_mday;
+    nHR = objCache.objTm.tm_hour;
+    nMN = objCache.objTm.tm_min;
+    nSC = objCache.objTm.tm_sec;
+    nMMN = static_cast<int>((nTimeNs / 1000000) % 1000);
+}
+
+/**
+ * @brief Join local time fields into nanoseconds since epoch, mktime is only called when the second changes.
+*/
+int64_t CYTimeFormat::Join(int nYY, int nMM, int nDD, int nHR, int nMN, int nSC, int nMMN) noexcept
+{
+    int64_t nKey = PackTimeKey(nYY, nMM, nDD, nHR, nMN, nSC);
+    STTimeJoinCache& objCache = g_objJoinCache;
+    if (objCache.nKey != nKey)
+    {
+        std::tm objTm = {};
+        objTm.tm_year = nYY - 1900;
+        objTm.tm_mon = nMM - 1;
+        objTm.tm_mday = nDD;
+        objTm.tm_hour = nHR;
+        objTm.tm_min = nMN;
+        objTm.tm_sec = nSC;
+        objTm.tm_isdst = -1;
+        objCache.nSeconds = static_cast<int64_t>(std::mktime(&objTm));
+        objCache.nKey = nKey;
+    }
+    return objCache.nSeconds * 1000000000 + static_cast<int64_t>(nMMN) * 1000000;
+}
+
+/**
+ * @brief Write two digits from the lookup table.
+*/
+TChar* CYTimeFormat::WriteDigits2(TChar* pBuffer, int nValue) noexcept
+{
+    const char* pDigits = g_szDigits2 + (static_cast<unsigned>(nValue) % 100) * 2;
+    pBuffer[0] = static_cast<TChar>(pDigits[0]);
+    pBuffer[1] = static_cast<TChar>(pDigits[1]);
+    return pBuffer + 2;
+}
+
+/**
+ * @brief Write "YYYY-MM-DD HH:MM:SS.mmm" into pBuffer (at least LOG_TIME_STAMP_LENGTH chars), return the length written.
+ * The date and seconds prefix is cached per thread and only rendered again when the second changes.
+*/
+size_t CYTimeFormat::Format(TChar* pBuffer, int nYY, int nMM, int nDD, int nHR, int nMN, int nSC, int nMMN) noexcept
+{
+    int64_t nKey = PackTimeKey(nYY, nMM, nDD, nHR, nMN, nSC);
+
+    STTimePrefixCache& objCache = g_objPrefixCache;
+    if (objCache.nKey != nKey)
+    {
+        TChar* p = objCache.szPrefix;
+        p = WriteDigits2(p, nYY / 100);
+        p = WriteDigits2(p, nYY);
+        *p++ = TEXT('-');
+        p = WriteDigits2(p, nMM);
+        *p++ = TEXT('-');
+        p = WriteDigits2(p, nDD);
+        *p++ = TEXT(' ');
+        p = WriteDigits2(p, nHR);
+        *p++ = TEXT(':');
+        p = WriteDigits2(p, nMN);
+        *p++ = TEXT(':');
+        p = WriteDigits2(p, nSC);
+        *p++ = TEXT('.');
+        objCache.nKey = nKey;
+    }
+
+    std::memcpy(pBuffer, objCache.szPrefix, sizeof(objCache.szPrefix));
+
+    unsigned nMilli = static_cast<unsigned>(nMMN) % 1000;
+    pBuffer[LOG_TIME_PREFIX_LENGTH] = static_cast<TChar>(TEXT('0') + nMilli / 100);
+    WriteDigits2(pBuffer + LOG_TIME_PREFIX_LENGTH + 1, nMilli % 100);
+    return LOG_TIME_STAMP_LENGTH;
+}
+
+/**
+ * @brief Format time fields to string.
+*/
+const TString CYTimeFormat::ToString(int nYY, int nMM, int nDD, int nHR, int nMN, int nSC, int nMMN)
+{
+    TChar szBuffer[LOG_TIME_STAMP_LENGTH];
+    return TString(szBuffer, Format(szBuffer, nYY, nMM, nDD, nHR, nMN, nSC, nMMN));
+}
+
+CYLOGGER_NAMESPACE_END
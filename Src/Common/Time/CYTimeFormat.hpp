@@ -0,0 +1,102 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_TIME_FORMAT_HPP__
+#define __CY_TIME_FORMAT_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+
+#include <ctime>
+#include <cstdint>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Length of "YYYY-MM-DD HH:MM:SS.mmm".
+*/
+static constexpr size_t LOG_TIME_STAMP_LENGTH = 23;
+
+/**
+ * @brief Length of the cached "YYYY-MM-DD HH:MM:SS." prefix.
+*/
+static constexpr size_t LOG_TIME_PREFIX_LENGTH = 20;
+
+class CYTimeFormat final
+{
+public:
+    /**
+     * @brief Capture the current wall clock time in nanoseconds since epoch. Uses CLOCK_REALTIME_COARSE in LOG_CLOCK_COARSE mode.
+    */
+    static int64_t Now() noexcept;
+
+    /**
+     * @brief Split nanoseconds since epoch into local time fields, localtime is only called when the second changes.
+    */
+    static void Split(int64_t nTimeNs, int& nYY, int& nMM, int& nDD, int& nHR, int& nMN, int& nSC, int& nMMN) noexcept;
+
+    /**
+     * @brief Join local time fields into nanoseconds since epoch, mktime is only called when the second changes.
+    */
+    static int64_t Join(int nYY, int nMM, int nDD, int nHR, int nMN, int nSC, int nMMN) noexcept;
+
+    /**
+     * @brief Write "YYYY-MM-DD HH:MM:SS.mmm" into pBuffer (at least LOG_TIME_STAMP_LENGTH chars), return the length written.
+     * The date and seconds prefix is cached per thread and only rendered again when the second changes.
+    */
+    static size_t Format(TChar* pBuffer, int nYY, int nMM, int nDD, int nHR, int nMN, int nSC, int nMMN) noexcept;
+
+    /**
+     * @brief Format time fields to string.
+    */
+    static const TString ToString(int nYY, int nMM, int nDD, int nHR, int nMN, int nSC, int nMMN);
+
+private:
+    /**
+     * @brief Write two digits from the lookup table.
+    */
+    static TChar* WriteDigits2(TChar* pBuffer, int nValue) noexcept;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_TIME_FORMAT_HPP__
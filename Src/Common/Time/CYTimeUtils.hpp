@@ -47,6 +47,7 @@
 #include <iostream>
 #include <cstdlib>
 #include <stdint.h>
+#include <chrono>
 
 #ifdef CYLOGGER_WIN_OS
 #include <windows.h>
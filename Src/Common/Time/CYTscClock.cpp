@@ -0,0 +1,167 @@
+#include "Common/Time/CYTscClock.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <thread>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+std::atomic<uint32_t> CYTscClock::m_nSequence{ 0 };
+std::atomic<uint64_t> CYTscClock::m_nBaseTsc{ 0 };
+std::atomic<int64_t>  CYTscClock::m_nBaseNs{ 0 };
+std::atomic<double>   CYTscClock::m_fNsPerTick{ 1.0 };
+uint64_t CYTscClock::m_nLastTsc = 0;
+int64_t  CYTscClock::m_nLastNs = 0;
+double   CYTscClock::m_fRate = 1.0;
+std::atomic_flag CYTscClock::m_objCalibrating = ATOMIC_FLAG_INIT;
+std::atomic<uint64_t> CYTscClock::m_nCalibrateTsc{ 0 };
+std::atomic<uint64_t> CYTscClock::m_nCalibrateTicks{ 0 };
+
+/**
+ * @brief Take a (tsc, realtime) sample pair.
+*/
+void CYTscClock::Sample(uint64_t& nTsc, int64_t& nTimeNs) noexcept
+{
+    // Bracket the realtime read and keep the counter midpoint.
+    uint64_t nBefore = rdtsc();
+    nTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    uint64_t nAfter = rdtsc();
+    nTsc = nBefore + (nAfter - nBefore) / 2;
+}
+
+/**
+ * @brief Publish a new mapping.
+*/
+void CYTscClock::Publish(uint64_t nBaseTsc, int64_t nBaseNs, double fNsPerTick) noexcept
+{
+    uint32_t nSequence = m_nSequence.load(std::memory_order_relaxed);
+    m_nSequence.store(nSequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_nBaseTsc.store(nBaseTsc, std::memory_order_relaxed);
+    m_nBaseNs.store(nBaseNs, std::memory_order_relaxed);
+    m_fNsPerTick.store(fNsPerTick, std::memory_order_relaxed);
+
+    m_nSequence.store(nSequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Initial calibration, blocks for about LOG_TSC_INIT_CALIBRATE_TIME milliseconds.
+*/
+void CYTscClock::Init()
+{
+    uint64_t nTsc0 = 0;
+    int64_t nTimeNs0 = 0;
+    Sample(nTsc0, nTimeNs0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(LOG_TSC_INIT_CALIBRATE_TIME));
+
+    uint64_t nTsc1 = 0;
+    int64_t nTimeNs1 = 0;
+    Sample(nTsc1, nTimeNs1);
+
+    double fNsPerTick = nTsc1 > nTsc0 ? static_cast<double>(nTimeNs1 - nTimeNs0) / static_cast<double>(nTsc1 - nTsc0) : 1.0;
+    Publish(nTsc1, nTimeNs1, fNsPerTick);
+
+    m_nLastTsc = nTsc1;
+    m_nLastNs = nTimeNs1;
+    m_fRate = fNsPerTick;
+    m_nCalibrateTicks.store(static_cast<uint64_t>(LOG_TSC_CALIBRATE_TIME * 1e9 / fNsPerTick), std::memory_order_relaxed);
+    m_nCalibrateTsc.store(nTsc1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Recalibrate the mapping against the realtime clock once LOG_TSC_CALIBRATE_TIME has passed, backend threads.
+*/
+void CYTscClock::CalibrateIfDue() noexcept
+{
+    // Unsigned difference, a counter that went backwards is due at once.
+    if (rdtsc() - m_nCalibrateTsc.load(std::memory_order_relaxed) < m_nCalibrateTicks.load(std::memory_order_relaxed))
+        return;
+
+    if (m_objCalibrating.test_and_set(std::memory_order_acquire))
+        return;
+
+    Calibrate();
+    m_objCalibrating.clear(std::memory_order_release);
+}
+
+/**
+ * @brief Recalibrate the mapping against the realtime clock, under m_objCalibrating.
+*/
+void CYTscClock::Calibrate() noexcept
+{
+    uint64_t nTsc = 0;
+    int64_t nTimeNs = 0;
+    Sample(nTsc, nTimeNs);
+
+    // Counter went backwards (migration to an unsynchronized core, suspend...), restart from this sample.
+    if (nTsc <= m_nLastTsc)
+    {
+        Publish(nTsc, nTimeNs, m_fRate);
+    }
+    else
+    {
+        // A realtime step (NTP step, settimeofday...) in the interval does not measure the counter rate, keep the old one.
+        double fRate = static_cast<double>(nTimeNs - m_nLastNs) / static_cast<double>(nTsc - m_nLastTsc);
+        if (std::fabs(fRate - m_fRate) <= m_fRate * LOG_TSC_MAX_DRIFT)
+            m_fRate = fRate;
+
+        int64_t nMappedNs = ToNanoseconds(nTsc);
+        int64_t nOffsetNs = nTimeNs - nMappedNs;
+        if (std::llabs(nOffsetNs) > static_cast<int64_t>(LOG_TSC_MAX_SLEW) * 1000000)
+        {
+            // The realtime clock was stepped, follow it.
+            Publish(nTsc, nTimeNs, m_fRate);
+        }
+        else
+        {
+            // Continue from the current mapping and catch up with the realtime clock over the next interval, the slew
+            // is bounded like the rate so that the mapping never runs backwards.
+            double fSlew = static_cast<double>(nOffsetNs) / (LOG_TSC_CALIBRATE_TIME * 1e9 / m_fRate);
+            fSlew = std::clamp(fSlew, -m_fRate * LOG_TSC_MAX_DRIFT, m_fRate * LOG_TSC_MAX_DRIFT);
+            Publish(nTsc, nMappedNs, m_fRate + fSlew);
+        }
+    }
+
+    m_nLastTsc = nTsc;
+    m_nLastNs = nTimeNs;
+    m_nCalibrateTicks.store(static_cast<uint64_t>(LOG_TSC_CALIBRATE_TIME * 1e9 / m_fRate), std::memory_order_relaxed);
+    m_nCalibrateTsc.store(nTsc, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Convert a raw counter value to nanoseconds since epoch.
+*/
+int64_t CYTscClock::ToNanoseconds(uint64_t nTsc) noexcept
+{
+    uint32_t nSequence = 0;
+    uint64_t nBaseTsc = 0;
+    int64_t nBaseNs = 0;
+    double fNsPerTick = 0.0;
+
+    do
+    {
+        nSequence = m_nSequence.load(std::memory_order_acquire);
+        nBaseTsc = m_nBaseTsc.load(std::memory_order_relaxed);
+        nBaseNs = m_nBaseNs.load(std::memory_order_relaxed);
+        fNsPerTick = m_fNsPerTick.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((nSequence & 1) != 0 || nSequence != m_nSequence.load(std::memory_order_relaxed));
+
+    // Signed delta, the counter may predate the current base.
+    int64_t nDelta = static_cast<int64_t>(nTsc - nBaseTsc);
+    return nBaseNs + static_cast<int64_t>(static_cast<double>(nDelta) * fNsPerTick);
+}
+
+/**
+ * @brief Get the calibrated number of nanoseconds per tick.
+*/
+double CYTscClock::GetNsPerTick() noexcept
+{
+    return m_fNsPerTick.load(std::memory_order_relaxed);
+}
+
+CYLOGGER_NAMESPACE_END
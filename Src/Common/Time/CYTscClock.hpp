@@ -0,0 +1,139 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_TSC_CLOCK_HPP__
+#define __CY_TSC_CLOCK_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Common/Time/CYTimeUtils.hpp"
+
+#include <atomic>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief TSC based clock. Producers read the time stamp counter, the backend converts it to wall clock time through a
+ * TSC-to-realtime mapping. The log threads and the schedule thread recalibrate it once LOG_TSC_CALIBRATE_TIME has
+ * passed, so the mapping keeps up whether or not the schedule thread was started. A recalibration continues from the
+ * current mapping and slews it towards the realtime clock, it only jumps when the realtime clock itself was stepped by
+ * more than LOG_TSC_MAX_SLEW.
+*/
+class CYTscClock final
+{
+public:
+    /**
+     * @brief Read the raw time stamp counter.
+    */
+    static inline uint64_t Now() noexcept
+    {
+        return rdtsc();
+    }
+
+    /**
+     * @brief Initial calibration, blocks for about LOG_TSC_INIT_CALIBRATE_TIME milliseconds.
+    */
+    static void Init();
+
+    /**
+     * @brief Recalibrate the mapping against the realtime clock once LOG_TSC_CALIBRATE_TIME has passed, backend threads.
+     *        Only one thread calibrates at a time, the others return at once.
+    */
+    static void CalibrateIfDue() noexcept;
+
+    /**
+     * @brief Convert a raw counter value to nanoseconds since epoch.
+    */
+    static int64_t ToNanoseconds(uint64_t nTsc) noexcept;
+
+    /**
+     * @brief Get the calibrated number of nanoseconds per tick.
+    */
+    static double GetNsPerTick() noexcept;
+
+private:
+    /**
+     * @brief Recalibrate the mapping against the realtime clock, under m_objCalibrating.
+    */
+    static void Calibrate() noexcept;
+
+    /**
+     * @brief Take a (tsc, realtime) sample pair.
+    */
+    static void Sample(uint64_t& nTsc, int64_t& nTimeNs) noexcept;
+
+    /**
+     * @brief Publish a new mapping.
+    */
+    static void Publish(uint64_t nBaseTsc, int64_t nBaseNs, double fNsPerTick) noexcept;
+
+private:
+    /**
+     * @brief Seqlock sequence of the published mapping, odd while being written.
+    */
+    static std::atomic<uint32_t> m_nSequence;
+
+    /**
+     * @brief Published mapping.
+    */
+    static std::atomic<uint64_t> m_nBaseTsc;
+    static std::atomic<int64_t>  m_nBaseNs;
+    static std::atomic<double>   m_fNsPerTick;
+
+    /**
+     * @brief Last calibration sample and measured counter rate without slew, only touched by the calibrating thread.
+    */
+    static uint64_t m_nLastTsc;
+    static int64_t  m_nLastNs;
+    static double   m_fRate;
+
+    /**
+     * @brief Held by the calibrating thread, and the counter value and tick interval the next calibration is due at.
+    */
+    static std::atomic_flag m_objCalibrating;
+    static std::atomic<uint64_t> m_nCalibrateTsc;
+    static std::atomic<uint64_t> m_nCalibrateTicks;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_TSC_CLOCK_HPP__
@@ -50,8 +50,21 @@
 
 CYLOGGER_NAMESPACE_BEGIN
 
+/**
+ * @brief Time constant of the average lines per second, in seconds.
+*/
 static constexpr int LOG_FPS_CHECK_DURATION = 5;
 
+/**
+ * @brief Window of the current lines per second, in milliseconds.
+*/
+static constexpr int LOG_FPS_WINDOW = 1000;
+
+/**
+ * @brief Stream remote frames are a 4 byte big endian payload length followed by the UTF-8 line.
+*/
+static constexpr int LOG_STREAM_FRAME_HEADER_SIZE = 4;
+
 class CYLoggerBaseAppender;
 
 /**
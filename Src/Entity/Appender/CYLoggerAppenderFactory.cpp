@@ -1,9 +1,15 @@
 #include "Entity/Appender/CYLoggerAppenderFactory.hpp"
 #include "Entity/Appender/CYLoggerFileAppender.hpp"
+#include "Entity/Appender/CYLoggerBinaryAppender.hpp"
+#include "Entity/Appender/CYLoggerCompressAppender.hpp"
 #include "Entity/Appender/CYLoggerMainAppender.hpp"
 #include "Entity/Appender/CYLoggerConsoleAppender.hpp"
 #include "Entity/Appender/CYLoggerRemoteAppender.hpp"
+#include "Entity/Appender/CYLoggerStreamAppender.hpp"
 #include "Entity/Appender/CYLoggerSystemAppender.hpp"
+#include "Entity/Appender/CYLoggerJournalAppender.hpp"
+#include "Entity/Appender/CYLoggerNullAppender.hpp"
+#include "Entity/Appender/CYLoggerMemoryAppender.hpp"
 #include "Config/CYLoggerConfig.hpp"
 #include "CYCommon/Common/Exception/CYException.hpp"
 
@@ -12,6 +18,26 @@ CYLOGGER_NAMESPACE_BEGIN
 SharePtr<CYLoggerBaseAppender> CYLoggerAppenderFactory::CreateFileAppender(const TString& strFileName, ELogFileMode eFileMode, ELogType eLogType)
 {
 	SharePtr<CYLoggerBaseAppender> ptrAppender;
+	const int nFileFormat = eFileMode & ~LOG_MODE_FILE_NAME_MASK;
+	eFileMode = static_cast<ELogFileMode>(eFileMode & LOG_MODE_FILE_NAME_MASK);
+	if (nFileFormat != 0 && eLogType != LOG_TYPE_NONE)
+	{
+		if ((nFileFormat & LOG_MODE_FILE_NULL) != 0)
+			return MakeShared<CYLoggerNullAppender>(strFileName, eLogType);
+
+		if ((nFileFormat & LOG_MODE_FILE_MEMORY) != 0)
+			return MakeShared<CYLoggerMemoryAppender>(strFileName, eLogType);
+	}
+
+	if (nFileFormat != 0 && eLogType >= LOG_TYPE_TRACE && eLogType <= LOG_TYPE_FATAL)
+	{
+		if ((nFileFormat & LOG_MODE_FILE_BINARY) != 0)
+			return MakeShared<CYLoggerBinaryAppender>(strFileName, eFileMode, eLogType);
+
+		if ((nFileFormat & LOG_MODE_FILE_COMPRESS) != 0)
+			return MakeShared<CYLoggerCompressAppender>(strFileName, eFileMode, eLogType);
+	}
+
 	switch (eLogType)
 	{
 	case LOG_TYPE_NONE:
@@ -39,10 +65,16 @@ SharePtr<CYLoggerBaseAppender> CYLoggerAppenderFactory::CreateFileAppender(const
         ptrAppender = MakeShared<CYLoggerMainAppender>(strFileName, eFileMode, eLogType);
         break;
 	case LOG_TYPE_REMOTE:
-		ptrAppender = MakeShared<CYLoggerRemoteAppender>(strFileName);
+		if (CYLoggerStreamAppender::IsStreamAddress(strFileName))
+			ptrAppender = MakeShared<CYLoggerStreamAppender>(strFileName);
+		else
+			ptrAppender = MakeShared<CYLoggerRemoteAppender>(strFileName);
 		break;
 	case LOG_TYPE_SYS:
-		ptrAppender = MakeShared<CYLoggerSystemAppender>(strFileName);
+		if (CYLoggerJournalAppender::IsJournalAddress(strFileName))
+			ptrAppender = MakeShared<CYLoggerJournalAppender>(strFileName);
+		else
+			ptrAppender = MakeShared<CYLoggerSystemAppender>(strFileName);
 		break;
 	default:
 		IfTrueThrow(true, TEXT("eLogType wrong type!"));
@@ -3,6 +3,8 @@
 #include "Entity/Appender/CYLoggerAppenderDefine.hpp"
 #include "Statistics/CYStatistics.hpp"
 #include "Common/Exception/CYExceptionLogFile.hpp"
+#include "Common/CYTraceProbe.hpp"
+#include "Common/Time/CYTscClock.hpp"
 #if CYLOGGER_USE_CYCOROUTINE
 #include "CYCoroutine/CYCoroutine.hpp"
 #endif
@@ -16,9 +18,8 @@ CYLOGGER_NAMESPACE_BEGIN
 
 CYLoggerBaseAppender::CYLoggerBaseAppender(std::string_view strName) noexcept
     : CYNamedThread(strName)
-    , CYFPSCounter(LOG_FPS_CHECK_DURATION)
+    , m_objRate(LOG_FPS_WINDOW, LOG_FPS_CHECK_DURATION)
 {
-    CYFPSCounter::StartCounter();
 }
 
 CYLoggerBaseAppender::~CYLoggerBaseAppender() noexcept
@@ -41,6 +42,14 @@ void CYLoggerBaseAppender::StopLogThread()
     CYNamedThread::StopThread();
 }
 
+/**
+ * @brief Whether the caller is the log thread, appenders whose batch state is owned by it skip a Flush from other threads.
+*/
+bool CYLoggerBaseAppender::IsLogThread() const
+{
+    return CYNamedThread::GetId() == std::this_thread::get_id();
+}
+
 #if CYLOGGER_USE_CYCOROUTINE
 /**
  * @brief Coroutine work funciton.
@@ -81,13 +90,174 @@ std::tuple<int, int> CYLoggerBaseAppender::DoWork(std::function<std::tuple<int,
 #endif
 }
 
+/**
+ * @brief Outputs one drained message, default implementation renders it through the layout and calls Log.
+*/
+int CYLoggerBaseAppender::LogMessage(const SharePtr<CYLoggerMessage>& ptrMessage)
+{
+    const TString&& strMsg = ptrMessage->GetFormatMessage();
+    Log(strMsg, ptrMessage->GetTypeIndex(), false);
+    return static_cast<int>(strMsg.size() + TEXT_BYTE_LEN);
+}
+
+/**
+ * @brief Queue a new log file request, the log thread handles it in order with the messages. Any thread, never blocks.
+*/
+std::future<bool> CYLoggerBaseAppender::ForceNewFile(std::function<void(bool)> fnDone)
+{
+    std::future<bool> objFuture;
+    {
+        LockGuard locker(m_mutexNewFile);
+        m_lstNewFile.push_back({ std::promise<bool>(), std::move(fnDone) });
+        objFuture = m_lstNewFile.back().objPromise.get_future();
+        m_bNewFilePending.store(true, std::memory_order_release);
+    }
+
+    // Wake the log thread without latching the condition.
+    m_objCondition.SignalOne(true);
+    return objFuture;
+}
+
+/**
+ * @brief Handle the requests taken before the last flip, or fail them once the log thread stops.
+*/
+void CYLoggerBaseAppender::ProcessNewFile(std::list<STNewFileRequest>& lstRequest, bool bRun)
+{
+    while (!lstRequest.empty())
+    {
+        STNewFileRequest objRequest = std::move(lstRequest.front());
+        lstRequest.pop_front();
+
+        bool bRet = false;
+        if (bRun)
+        {
+            EXCEPTION_BEGIN
+            {
+                bRet = this->OnNewFile();
+            }
+            EXCEPTION_END
+        }
+
+        if (objRequest.fnDone)
+        {
+            EXCEPTION_BEGIN
+            {
+                objRequest.fnDone(bRet);
+            }
+            EXCEPTION_END
+        }
+        objRequest.objPromise.set_value(bRet);
+    }
+}
+
+/**
+ * @brief Record the latency of the messages written by the last batch, the batch counts as written once OnBatchDone returns.
+*/
+void CYLoggerBaseAppender::RecordLatency()
+{
+    if (m_vecEnqueueTime.empty())
+        return;
+
+    const int64_t nNow = CYLatencyHistogram::Now();
+    for (int64_t nEnqueueTime : m_vecEnqueueTime)
+    {
+        m_objLatency.Record(nNow > nEnqueueTime ? static_cast<uint64_t>(nNow - nEnqueueTime) : 0);
+    }
+    m_vecEnqueueTime.clear();
+}
+
+/**
+ * @brief Enqueue to write latency percentiles of this appender, any thread.
+*/
+void CYLoggerBaseAppender::GetLatency(STLatencyStats& objStats, bool bReset)
+{
+    m_objLatency.GetLatency(objStats, bReset);
+}
+
+/**
+ * @brief Statistics record of this appender, any thread.
+*/
+void CYLoggerBaseAppender::GetStats(STAppenderStats& objStats)
+{
+    objStats.eLogType = this->GetId();
+    m_strName.copy(objStats.szName, sizeof(objStats.szName) - 1);
+    m_objStats.Read(objStats);
+    m_objLatency.GetLatency(objStats.objLatency, false);
+}
+
+/**
+ * @brief Count lines the sink dropped, any thread.
+*/
+void CYLoggerBaseAppender::AddDropLines(uint64_t nLine)
+{
+    CY_PROBE_DROP(this->GetId(), nLine);
+    m_objStats.AddDrop(nLine);
+}
+
+/**
+ * @brief Count one written line in the Statistics of the appender type, log thread.
+*/
+void CYLoggerBaseAppender::AddLineStats(size_t nBytes)
+{
+    switch (this->GetId())
+    {
+    case LOG_TYPE_NONE:
+        Statistics()->AddConsoleLine(1);
+        Statistics()->AddConsoleBytes(nBytes);
+        break;
+    case LOG_TYPE_TRACE:
+        Statistics()->AddTraceLine(1);
+        Statistics()->AddTraceBytes(nBytes);
+        break;
+    case LOG_TYPE_DEBUG:
+        Statistics()->AddDebugLine(1);
+        Statistics()->AddDebugBytes(nBytes);
+        break;
+    case LOG_TYPE_INFO:
+        Statistics()->AddInfoLine(1);
+        Statistics()->AddInfoBytes(nBytes);
+        break;
+    case LOG_TYPE_WARN:
+        Statistics()->AddWarnLine(1);
+        Statistics()->AddWarnBytes(nBytes);
+        break;
+    case LOG_TYPE_ERROR:
+        Statistics()->AddErrorLine(1);
+        Statistics()->AddErrorBytes(nBytes);
+        break;
+    case LOG_TYPE_FATAL:
+        Statistics()->AddFatalLine(1);
+        Statistics()->AddFatalBytes(nBytes);
+        break;
+    case LOG_TYPE_MAIN:
+        Statistics()->AddMainLine(1);
+        Statistics()->AddMainBytes(nBytes);
+        break;
+    case LOG_TYPE_REMOTE:
+        Statistics()->AddRemoteLine(1);
+        Statistics()->AddRemoteBytes(nBytes);
+        break;
+    case LOG_TYPE_SYS:
+        Statistics()->AddSysLine(1);
+        Statistics()->AddSysBytes(nBytes);
+        break;
+    default:
+        break;
+    }
+}
+
 /**
  * @brief Flip buffering.
 */
 void CYLoggerBaseAppender::FlipBuffer()
 {
-    LockGuard locker(m_mutexPublicMessage);
-    std::swap(m_lstPublicMessage, m_lstPrivMessage);
+    {
+        LockGuard locker(m_mutexPublicMessage);
+        std::swap(m_lstPublicMessage, m_lstPrivMessage);
+    }
+
+    // The producers never touch the statistics, the public queue depth is what the flip took over.
+    UpdatePublicStats();
 }
 
 /**
@@ -102,31 +272,29 @@ void CYLoggerBaseAppender::UpdatePublicStats()
         assert(0);
         break;
     case LOG_TYPE_TRACE:
-        Statistics()->AddTracePublicQueue(static_cast<uint32_t>(m_lstPublicMessage.size()));
+        Statistics()->AddTracePublicQueue(static_cast<uint32_t>(m_lstPrivMessage.size()));
         break;
     case LOG_TYPE_DEBUG:
-        Statistics()->AddDebugPublicQueue(static_cast<uint32_t>(m_lstPublicMessage.size()));
+        Statistics()->AddDebugPublicQueue(static_cast<uint32_t>(m_lstPrivMessage.size()));
         break;
     case LOG_TYPE_INFO:
-        Statistics()->AddInfoPublicQueue(static_cast<uint32_t>(m_lstPublicMessage.size()));
+        Statistics()->AddInfoPublicQueue(static_cast<uint32_t>(m_lstPrivMessage.size()));
         break;
     case LOG_TYPE_WARN:
-        Statistics()->AddWarnPublicQueue(static_cast<uint32_t>(m_lstPublicMessage.size()));
+        Statistics()->AddWarnPublicQueue(static_cast<uint32_t>(m_lstPrivMessage.size()));
         break;
     case LOG_TYPE_ERROR:
-        Statistics()->AddErrorPublicQueue(static_cast<uint32_t>(m_lstPublicMessage.size()));
+        Statistics()->AddErrorPublicQueue(static_cast<uint32_t>(m_lstPrivMessage.size()));
         break;
     case LOG_TYPE_FATAL:
-        Statistics()->AddFatalPublicQueue(static_cast<uint32_t>(m_lstPublicMessage.size()));
+        Statistics()->AddFatalPublicQueue(static_cast<uint32_t>(m_lstPrivMessage.size()));
         break;
     case LOG_TYPE_MAIN:
-        assert(0);
-        break;
     case LOG_TYPE_REMOTE:
-        assert(0);
+        // Only a null or memory sink gets here, the statistics keep no single queue for these types.
         break;
     case LOG_TYPE_SYS:
-        Statistics()->AddSysPublicQueue(static_cast<uint32_t>(m_lstPublicMessage.size()));
+        Statistics()->AddSysPublicQueue(static_cast<uint32_t>(m_lstPrivMessage.size()));
         break;
     case LOG_TYPE_MAX:
         assert(0);
@@ -180,6 +348,60 @@ void CYLoggerBaseAppender::UpdatePrivateStats()
     }
 }
 
+/**
+ * @brief Update the lines per second Statistics, once per wake up of the log thread.
+*/
+void CYLoggerBaseAppender::UpdateRateStats()
+{
+    const double fCurrentRate = m_objRate.GetCurrentRate();
+    const double fAverageRate = m_objRate.GetAverageRate();
+    switch (this->GetId())
+    {
+    case LOG_TYPE_NONE:
+        Statistics()->AddConsoleCurrentFPS(fCurrentRate);
+        Statistics()->AddConsoleAverageFPS(fAverageRate);
+        break;
+    case LOG_TYPE_TRACE:
+        Statistics()->AddTraceCurrentFPS(fCurrentRate);
+        Statistics()->AddTraceAverageFPS(fAverageRate);
+        break;
+    case LOG_TYPE_DEBUG:
+        Statistics()->AddDebugCurrentFPS(fCurrentRate);
+        Statistics()->AddDebugAverageFPS(fAverageRate);
+        break;
+    case LOG_TYPE_INFO:
+        Statistics()->AddInfoCurrentFPS(fCurrentRate);
+        Statistics()->AddInfoAverageFPS(fAverageRate);
+        break;
+    case LOG_TYPE_WARN:
+        Statistics()->AddWarnCurrentFPS(fCurrentRate);
+        Statistics()->AddWarnAverageFPS(fAverageRate);
+        break;
+    case LOG_TYPE_ERROR:
+        Statistics()->AddErrorCurrentFPS(fCurrentRate);
+        Statistics()->AddErrorAverageFPS(fAverageRate);
+        break;
+    case LOG_TYPE_FATAL:
+        Statistics()->AddFatalCurrentFPS(fCurrentRate);
+        Statistics()->AddFatalAverageFPS(fAverageRate);
+        break;
+    case LOG_TYPE_MAIN:
+        Statistics()->AddMainCurrentFPS(fCurrentRate);
+        Statistics()->AddMainAverageFPS(fAverageRate);
+        break;
+    case LOG_TYPE_REMOTE:
+        Statistics()->AddRemoteCurrentFPS(fCurrentRate);
+        Statistics()->AddRemoteAverageFPS(fAverageRate);
+        break;
+    case LOG_TYPE_SYS:
+        Statistics()->AddSysCurrentFPS(fCurrentRate);
+        Statistics()->AddSysAverageFPS(fAverageRate);
+        break;
+    default:
+        break;
+    }
+}
+
 /**
 * @brief Run function of NamedThread.
 */
@@ -190,13 +412,31 @@ void CYLoggerBaseAppender::Run()
         if (m_objTimeElapsed.Elapsed() < 100 && m_lstPublicMessage.empty())
         {
             m_objCondition.WaitForEvent(static_cast<unsigned>(abs(100 - m_objTimeElapsed.Elapsed())), [&]()->bool {
-                return m_lstPublicMessage.size() > 10;
+                return m_lstPublicMessage.size() > 10 || m_bNewFilePending.load(std::memory_order_relaxed);
                 });
         }
         m_objTimeElapsed.Reset();
 
+        // The schedule thread may not run, so the log threads keep the TSC mapping calibrated too.
+        if constexpr (LOG_TIME_CLOCK_MODE == ELogClockMode::LOG_CLOCK_TSC)
+        {
+            CYTscClock::CalibrateIfDue();
+        }
+
+        // Requests are taken before the flip, so every message queued ahead of them is drained first.
+        std::list<STNewFileRequest> lstNewFile;
+        if (m_bNewFilePending.load(std::memory_order_acquire))
+        {
+            LockGuard locker(m_mutexNewFile);
+            lstNewFile.swap(m_lstNewFile);
+            m_bNewFilePending.store(false, std::memory_order_relaxed);
+        }
+
         // flip double buffering.
         FlipBuffer();
+        UpdatePrivateStats();
+        const uint32_t nQueueDepth = static_cast<uint32_t>(m_lstPrivMessage.size());
+        CY_PROBE_FLIP(this->GetId(), nQueueDepth);
 
         if (!m_bActivate)
         {
@@ -212,18 +452,49 @@ void CYLoggerBaseAppender::Run()
         auto objTuple = DoWork([&] {
             int nTotalLine = 0;
             int nTotalBytes = 0;
+            const int64_t nWriteBegin = CYLatencyHistogram::Now();
+            CY_PROBE_DRAIN_START(this->GetId(), nQueueDepth);
             while (!m_lstPrivMessage.empty())
             {
-                SharePtr<CYBaseMessage> ptrMessage = m_lstPrivMessage.front();
+                STQueuedMessage objMessage = std::move(m_lstPrivMessage.front());
                 m_lstPrivMessage.pop_front();
 
                 nTotalLine++;
-                const TString&& strMsg = ptrMessage->GetFormatMessage();
-                nTotalBytes += static_cast<int>(strMsg.size() + TEXT_BYTE_LEN);
-                Log(strMsg, ptrMessage->GetTypeIndex(), false);
+                nTotalBytes += LogMessage(objMessage.ptrMessage);
 
-                UpdatePrivateStats();
+                if constexpr (LOG_LATENCY_STATS)
+                {
+                    m_vecEnqueueTime.push_back(objMessage.nEnqueueTime);
+                }
             }
+            const int64_t nWriteEnd = CYLatencyHistogram::Now();
+            const int64_t nWriteTime = nWriteEnd - nWriteBegin;
+            CY_PROBE_BATCH_WRITE(this->GetId(), nTotalLine, nTotalBytes, nWriteTime);
+            UpdatePrivateStats();
+
+            int64_t nFlushTime = 0;
+            if (nTotalLine > 0)
+            {
+                const int64_t nFlushBegin = CYLatencyHistogram::Now();
+                OnBatchDone();
+                nFlushTime = CYLatencyHistogram::Now() - nFlushBegin;
+                CY_PROBE_FLUSH(this->GetId(), nFlushTime);
+                RecordLatency();
+            }
+            else
+                OnIdle();
+
+            // The new file starts after the batch has been sent or flushed, a buffering appender would otherwise carry
+            // the tail of the batch into the next file.
+            if (!lstNewFile.empty())
+                ProcessNewFile(lstNewFile, true);
+
+            // The rate is fed per batch with the clock already read, idle wake ups let it decay.
+            m_objRate.Update(static_cast<uint64_t>(nTotalLine), nWriteEnd);
+            UpdateRateStats();
+
+            CY_PROBE_DRAIN_END(this->GetId(), nTotalLine, nTotalBytes, nWriteTime + nFlushTime);
+            m_objStats.Publish(nQueueDepth, static_cast<uint32_t>(nTotalLine), static_cast<uint64_t>(nTotalBytes), static_cast<uint64_t>(nWriteTime), static_cast<uint64_t>(nFlushTime), m_objRate.GetCurrentRate(), m_objRate.GetAverageRate());
             return  std::tuple<int, int>(nTotalLine, nTotalBytes);
             });
 
@@ -234,9 +505,21 @@ void CYLoggerBaseAppender::Run()
             Statistics()->AddTotalBytes(get<1>(objTuple));
         }
             EXCEPTION_END
+
+        // A request left behind by an exception in the batch is still answered.
+        if (!lstNewFile.empty())
+            ProcessNewFile(lstNewFile, true);
     }
 
     this->Flush();
+
+    std::list<STNewFileRequest> lstNewFile;
+    {
+        LockGuard locker(m_mutexNewFile);
+        lstNewFile.swap(m_lstNewFile);
+        m_bNewFilePending.store(false, std::memory_order_relaxed);
+    }
+    ProcessNewFile(lstNewFile, false);
 }
 
 CYLOGGER_NAMESPACE_END
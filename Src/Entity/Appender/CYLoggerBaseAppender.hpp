@@ -48,7 +48,10 @@
 #include "Common/Thread/CYNamedLocker.hpp"
 #include "Common/Thread/CYNamedCondition.hpp"
 #include "Common/Time/CYTimeElapsed.hpp"
-#include "Common/CYFPSCounter.hpp"
+#include "Common/CYRateEstimator.hpp"
+#include "Common/Message/CYLoggerMessage.hpp"
+#include "Statistics/CYLatencyHistogram.hpp"
+#include "Statistics/CYAppenderStats.hpp"
 
 #include "CYCommon/Common/Exception/CYException.hpp"
 
@@ -56,12 +59,26 @@
 #include "CYCoroutine/Results/CYResult.hpp"
 #endif
 
+#include <atomic>
 #include <deque>
+#include <functional>
+#include <future>
+#include <list>
 #include <mutex>
+#include <vector>
 
 CYLOGGER_NAMESPACE_BEGIN
 
-class CYLoggerBaseAppender : public CYNamedThread, public CYNoCopy, public CYFPSCounter
+/**
+ * @brief A queued message with the steady clock time it was queued at, 0 when LOG_LATENCY_STATS is off.
+*/
+struct STQueuedMessage
+{
+	SharePtr<CYLoggerMessage> ptrMessage;
+	int64_t nEnqueueTime;
+};
+
+class CYLoggerBaseAppender : public CYNamedThread, public CYNoCopy
 {
 public:
 	/**
@@ -86,6 +103,35 @@ public:
 	*/
 	virtual void Log(const TStringView& strMsg, int nTypeIndex, bool bFlush) = 0;
 
+	/**
+	* Outputs one drained message, default implementation renders it through the layout and calls Log.
+	* @return bytes written
+	*/
+	virtual int LogMessage(const SharePtr<CYLoggerMessage>& ptrMessage);
+
+	/**
+	* Get called after a drained batch has been passed to LogMessage - default implementation does nothing
+	*/
+	virtual void OnBatchDone()
+	{
+	}
+
+	/**
+	* Get called when a wake up of the log thread drained nothing, at least every 100 ms - default implementation does nothing
+	*/
+	virtual void OnIdle()
+	{
+	}
+
+	/**
+	* Get called on the log thread for a ForceNewFile request, after the messages queued before it - default implementation does nothing
+	* @returns true if a new file was opened
+	*/
+	virtual bool OnNewFile()
+	{
+		return false;
+	}
+
 	/**
 	* Get called when this appender become active through attaching to a CYLLoggerImpl object, and it was not active before
 	*/
@@ -102,9 +148,50 @@ public:
 	virtual const TString& GetLogName() = 0;
 
 	/**
-	 * @brief Force new log file.
+	 * @brief Queue a new log file request, the log thread handles it in order with the messages. Any thread, never blocks.
+	 * @param fnDone optional, called on the log thread with the result of OnNewFile.
+	 * @returns a future set to the result of OnNewFile, or to false if the log thread stopped first.
+	*/
+	std::future<bool> ForceNewFile(std::function<void(bool)> fnDone = nullptr);
+
+	/**
+	* Get called on the schedule thread at every wake up, for file work kept off the log thread - default implementation does nothing
+	*/
+	virtual void OnSchedule()
+	{
+	}
+
+	/**
+	* Set the rotation policy of a rotating file appender, any thread - default implementation does nothing
+	*/
+	virtual void SetRotation(const STRotationPolicy& objPolicy)
+	{
+	}
+
+	/**
+	 * @brief Files owned by the appender besides the log file, the clean and compress passes leave them alone.
+	*/
+	virtual void GetReservedFiles(std::list<TString>& lstFile)
+	{
+	}
+
+	/**
+	 * @brief Copy the lines kept in memory, any thread - default implementation keeps nothing and returns 0
+	*/
+	virtual size_t ReadMemory(TChar* pszBuffer, size_t nSize, bool bClear)
+	{
+		return 0;
+	}
+
+	/**
+	 * @brief Enqueue to write latency percentiles of this appender, any thread.
+	*/
+	void GetLatency(STLatencyStats& objStats, bool bReset);
+
+	/**
+	 * @brief Statistics record of this appender, any thread.
 	*/
-	virtual void ForceNewFile() = 0;
+	void GetStats(STAppenderStats& objStats);
 
 	/**
 	* Returns the actual size of data on a physical device - default implementation does not respect this and throws an exception
@@ -136,12 +223,12 @@ public:
 	/**
 	* @brief Put message to the Log
 	*/
-	virtual void WriteLog(const SharePtr<CYBaseMessage>& ptrMessage)
+	virtual void WriteLog(const SharePtr<CYLoggerMessage>& ptrMessage)
 	{
-        LockGuard locker(m_mutexPublicMessage);
-        m_lstPublicMessage.push_back(ptrMessage);
+        const int64_t nEnqueueTime = LOG_LATENCY_STATS ? CYLatencyHistogram::Now() : 0;
 
-		UpdatePublicStats();
+        LockGuard locker(m_mutexPublicMessage);
+        m_lstPublicMessage.push_back(STQueuedMessage{ ptrMessage, nEnqueueTime });
 	}
 
 	/**
@@ -159,26 +246,67 @@ public:
 	*/
 	void StopLogThread();
 
+	/**
+	 * @brief Whether the caller is the log thread, appenders whose batch state is owned by it skip a Flush from other threads.
+	*/
+	bool IsLogThread() const;
+
 	/**
 	 * @brief Run function of NamedThread.
 	*/
 	void Run() override;
 
 	/**
-	 * @brief Update Public Statistics.
+	 * @brief Update Public Statistics, sampled by the log thread at each flip.
 	*/
 	virtual void UpdatePublicStats();
 
 	/**
-	 * @brief Update Private Statistics.
+	 * @brief Update Private Statistics, sampled by the log thread before and after each drain.
 	*/
 	virtual void UpdatePrivateStats();
 
+	/**
+	 * @brief Update the lines per second Statistics, once per wake up of the log thread.
+	*/
+	virtual void UpdateRateStats();
+
     /**
      * @brief Work function.
     */
     std::tuple<int, int> DoWork(std::function<std::tuple<int, int>()>&& fun);
 
+private:
+	/**
+	 * @brief A queued ForceNewFile request.
+	*/
+	struct STNewFileRequest
+	{
+		std::promise<bool> objPromise;
+		std::function<void(bool)> fnDone;
+	};
+
+	/**
+	 * @brief Handle the requests taken before the last flip, or fail them once the log thread stops.
+	*/
+	void ProcessNewFile(std::list<STNewFileRequest>& lstRequest, bool bRun);
+
+	/**
+	 * @brief Record the latency of the messages written by the last batch.
+	*/
+	void RecordLatency();
+
+protected:
+	/**
+	 * @brief Count lines the sink dropped, any thread.
+	*/
+	void AddDropLines(uint64_t nLine);
+
+	/**
+	 * @brief Count one written line in the Statistics of the appender type, log thread.
+	*/
+	void AddLineStats(size_t nBytes);
+
 protected:
 	/**
 	 * @brief Private mutex.
@@ -188,7 +316,7 @@ protected:
 	/**
 	 * @brief Private message list.
 	*/
-	std::deque<SharePtr<CYBaseMessage>> m_lstPublicMessage;
+	std::deque<STQueuedMessage> m_lstPublicMessage;
 
 
 	bool m_bActivate = false;
@@ -201,12 +329,48 @@ protected:
 	/**
 	 * @brief Private message list.
 	*/
-	std::deque<SharePtr<CYBaseMessage>> m_lstPrivMessage;
+	std::deque<STQueuedMessage> m_lstPrivMessage;
 
 	/**
 	 * @brief Record log processing time.
 	*/
 	CYTimeElapsed m_objTimeElapsed;
+
+private:
+	/**
+	 * @brief Guards m_lstNewFile.
+	*/
+	CYNamedLocker m_mutexNewFile{ TEXT("CYLoggerBaseAppenderNewFile") };
+
+	/**
+	 * @brief Queued ForceNewFile requests.
+	*/
+	std::list<STNewFileRequest> m_lstNewFile;
+
+	/**
+	 * @brief m_lstNewFile is not empty, read by the log thread without the lock.
+	*/
+	std::atomic<bool> m_bNewFilePending{ false };
+
+	/**
+	 * @brief Enqueue times of the messages in the current batch, log thread only.
+	*/
+	std::vector<int64_t> m_vecEnqueueTime;
+
+	/**
+	 * @brief Enqueue to write latency of this appender.
+	*/
+	CYLatencyHistogram m_objLatency;
+
+	/**
+	 * @brief Counters of this appender, published by the log thread once per wake up.
+	*/
+	CYAppenderStats m_objStats;
+
+	/**
+	 * @brief Lines per second of this appender, fed once per wake up of the log thread.
+	*/
+	CYRateEstimator m_objRate;
 };
 
 CYLOGGER_NAMESPACE_END
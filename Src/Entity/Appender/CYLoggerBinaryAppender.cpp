@@ -0,0 +1,341 @@
+#include "Entity/Appender/CYLoggerBinaryAppender.hpp"
+#include "Common/Binary/CYBinaryLogFormat.hpp"
+#include "Common/Message/CYLoggerMessage.hpp"
+#include "Common/Message/CYLogArgs.hpp"
+#include "Common/CYPublicFunction.hpp"
+#include "Statistics/CYStatistics.hpp"
+#include "Common/CYTraceProbe.hpp"
+#include "CYCommon/Common/Structure/CYStringUtils.hpp"
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Append a text field as UTF-8.
+*/
+static void PutText(CYBinaryWriter& objWriter, const TStringView& strText)
+{
+#if CY_USE_UNICODE
+    objWriter.PutString(CYCOMMON_NAMESPACE::CYStringUtils::TString2String(TString(strText).c_str()));
+#else
+    objWriter.PutString(std::string_view(strText.data(), strText.size()));
+#endif
+}
+
+CYLoggerBinaryAppender::CYLoggerBinaryAppender(const TString& strFileName, ELogFileMode eFileMode, ELogType eLogType)
+    : CYLoggerBaseAppender("CYLoggerBinaryAppender")
+    , CYFileRestriction()
+    , m_eLogType(eLogType)
+    , m_eFileMode(eFileMode)
+{
+    IfTrueThrow(strFileName.length() == 0, TEXT("fileName cannot be empty"));
+
+    UniquePtr<TChar> ptrFileName;
+    TChar* p = cy_fullpath(nullptr, strFileName.c_str(), 0);
+    ptrFileName.reset(p);
+    IfTrueThrow(p == nullptr, TEXT("_fullpath() failed"));
+    this->m_strFileName = p;
+
+    switch (m_eLogType)
+    {
+    case LOG_TYPE_TRACE:
+        SetThreadName("TraceThread");
+        break;
+    case LOG_TYPE_DEBUG:
+        SetThreadName("DebugThread");
+        break;
+    case LOG_TYPE_INFO:
+        SetThreadName("InfoThread");
+        break;
+    case LOG_TYPE_WARN:
+        SetThreadName("WarnThread");
+        break;
+    case LOG_TYPE_ERROR:
+        SetThreadName("ErrorThread");
+        break;
+    case LOG_TYPE_FATAL:
+        SetThreadName("FatalThread");
+        break;
+    default:
+        IfTrueThrow(true, TEXT("eLogType not supported by the binary appender"));
+        break;
+    }
+
+    StartLogThread();
+}
+
+CYLoggerBinaryAppender::~CYLoggerBinaryAppender()
+{
+    StopLogThread();
+}
+
+/**
+* @brief Implementation of a pure virtual method from CYLoggerBaseAppender
+*/
+void CYLoggerBinaryAppender::OnActivate()
+{
+    if (m_objLogFile.is_open()) m_objLogFile.close();
+    CYPublicFunction::CreateDirectory(m_strFileName);
+
+    std::ios_base::openmode nFlags = std::ios_base::out | std::ios_base::binary;
+    if (ELogFileMode::LOG_MODE_FILE_APPEND == m_eFileMode)
+        nFlags |= std::ios_base::app;
+
+    m_objLogFile.open(m_strFileName.c_str(), nFlags);
+    IfTrueThrow(!m_objLogFile, TString(TEXT("cannot open file ")) += m_strFileName);
+
+    // Appending starts a new segment with its own header and dictionary.
+    WriteHeader();
+}
+
+/**
+ * @brief Write the file header and reset the call site dictionary.
+*/
+void CYLoggerBinaryAppender::WriteHeader()
+{
+    m_mapCallSite.clear();
+    m_nNextCallSiteId = 0;
+    m_nSequence = 0;
+    m_nLastTimeNs = CYTimeFormat::Now();
+
+    m_strRecord.clear();
+    CYBinaryWriter objWriter(m_strRecord);
+    m_strRecord.append(LOG_BINARY_MAGIC, sizeof(LOG_BINARY_MAGIC));
+    objWriter.PutByte(LOG_BINARY_VERSION);
+#ifdef CYLOGGER_WIN_OS
+    objWriter.PutVarint(GetCurrentProcessId());
+#else
+    objWriter.PutVarint(static_cast<uint64_t>(getpid()));
+#endif
+    objWriter.PutFixed64(static_cast<uint64_t>(m_nLastTimeNs));
+
+    m_objLogFile.write(m_strRecord.data(), static_cast<std::streamsize>(m_strRecord.size()));
+    IfTrueThrow(m_objLogFile.fail(), TString(TEXT("write() failed for file ")) += m_strFileName);
+    CYFileRestriction::AddFileSize(m_strRecord.size());
+    m_strRecord.clear();
+}
+
+/**
+ * @brief Get the call site id, the dictionary entry is appended to m_strRecord the first time.
+*/
+uint32_t CYLoggerBinaryAppender::GetCallSite(const TString& strFile, const TString& strFunction, int nLine, const TStringView& strFormat)
+{
+    std::vector<STCallSite>& vecCallSite = m_mapCallSite[nLine];
+    for (const STCallSite& objCallSite : vecCallSite)
+    {
+        if (objCallSite.strFile == strFile && objCallSite.strFunction == strFunction && objCallSite.strFormat == strFormat)
+            return objCallSite.nId;
+    }
+
+    uint32_t nId = m_nNextCallSiteId++;
+    vecCallSite.push_back({ strFile, strFunction, TString(strFormat), nId });
+
+    CYBinaryWriter objWriter(m_strRecord);
+    objWriter.PutByte(BINARY_TAG_CALLSITE);
+    objWriter.PutVarint(nId);
+    PutText(objWriter, strFile);
+    PutText(objWriter, strFunction);
+    objWriter.PutVarint(static_cast<uint64_t>(nLine));
+    PutText(objWriter, strFormat);
+    return nId;
+}
+
+/**
+ * @brief Encode one record into m_strRecord.
+*/
+void CYLoggerBinaryAppender::EncodeRecord(int64_t nTimeNs, uint32_t nCallSite, int nLevel, int nServerCode, uint64_t nThreadId, const TStringView& strChannel, std::string_view strArgs)
+{
+    CYBinaryWriter objWriter(m_strRecord);
+    objWriter.PutByte(BINARY_TAG_LOG);
+    objWriter.PutVarint(m_nSequence++);
+    objWriter.PutZigZag(nTimeNs - m_nLastTimeNs);
+    objWriter.PutVarint(nCallSite);
+    objWriter.PutByte(static_cast<uint8_t>(nLevel));
+    objWriter.PutZigZag(nServerCode);
+    objWriter.PutVarint(nThreadId);
+    PutText(objWriter, strChannel);
+    objWriter.PutString(strArgs);
+    m_nLastTimeNs = nTimeNs;
+}
+
+/**
+ * @brief Capture a text without format into m_strArgs.
+*/
+std::string_view CYLoggerBinaryAppender::CaptureText(const TStringView& strText)
+{
+    m_strArgs.clear();
+#if CY_USE_UNICODE
+    CYLogArgs::CaptureText(CYCOMMON_NAMESPACE::CYStringUtils::TString2String(TString(strText).c_str()), m_strArgs);
+#else
+    CYLogArgs::CaptureText(std::string_view(strText.data(), strText.size()), m_strArgs);
+#endif
+    return m_strArgs;
+}
+
+/**
+ * @brief Write m_strRecord to the file and apply rotation.
+*/
+int CYLoggerBinaryAppender::WriteRecord()
+{
+    int nBytes = static_cast<int>(m_strRecord.size());
+    m_objLogFile.write(m_strRecord.data(), nBytes);
+    IfTrueThrow(m_objLogFile.fail(), TString(TEXT("write() failed for file ")) += m_strFileName);
+    m_strRecord.clear();
+
+    switch (m_eLogType)
+    {
+    case LOG_TYPE_TRACE:
+        Statistics()->AddTraceLine(1);
+        Statistics()->AddTraceBytes(nBytes);
+        break;
+    case LOG_TYPE_DEBUG:
+        Statistics()->AddDebugLine(1);
+        Statistics()->AddDebugBytes(nBytes);
+        break;
+    case LOG_TYPE_INFO:
+        Statistics()->AddInfoLine(1);
+        Statistics()->AddInfoBytes(nBytes);
+        break;
+    case LOG_TYPE_WARN:
+        Statistics()->AddWarnLine(1);
+        Statistics()->AddWarnBytes(nBytes);
+        break;
+    case LOG_TYPE_ERROR:
+        Statistics()->AddErrorLine(1);
+        Statistics()->AddErrorBytes(nBytes);
+        break;
+    case LOG_TYPE_FATAL:
+        Statistics()->AddFatalLine(1);
+        Statistics()->AddFatalBytes(nBytes);
+        break;
+    default:
+        break;
+    }
+
+    if (this->m_eFileMode == ELogFileMode::LOG_MODE_FILE_TIME)
+    {
+        CYFileRestriction::AddFileSize(nBytes);
+        CYFileRestriction::AddFileLine(1);
+        if (CYFileRestriction::IsCreateNewLog())
+        {
+            ReOpenFile(CYFileRestriction::GetNewLogName(this->m_strFileName));
+        }
+    }
+
+    return nBytes;
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
+*/
+void CYLoggerBinaryAppender::OnBatchDone()
+{
+    if (this->m_eFileMode == ELogFileMode::LOG_MODE_FILE_TIME && CYFileRestriction::IsRotateTimeDue())
+    {
+        ReOpenFile(CYFileRestriction::GetNewLogName(this->m_strFileName));
+    }
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
+*/
+void CYLoggerBinaryAppender::OnIdle()
+{
+    OnBatchDone();
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender
+*/
+void CYLoggerBinaryAppender::SetRotation(const STRotationPolicy& objPolicy)
+{
+    CYFileRestriction::SetRotation(objPolicy);
+}
+
+/**
+ * @brief Switch to a new file.
+*/
+void CYLoggerBinaryAppender::ReOpenFile(const TString& strNewFile)
+{
+    Flush();
+    CY_PROBE_ROTATE(this->GetId());
+    CYFileRestriction::ResetFileSize();
+    if (ELogFileMode::LOG_MODE_FILE_APPEND == m_eFileMode)
+    {
+        // Keep the append target name, move the current content aside.
+        m_objLogFile.close();
+        CYPublicFunction::CopyFile(m_strFileName, strNewFile, false, false);
+        m_objLogFile.open(m_strFileName.c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+        IfTrueThrow(!m_objLogFile, TString(TEXT("cannot open file ")) += m_strFileName);
+        WriteHeader();
+        return;
+    }
+
+    this->m_strFileName = strNewFile;
+    OnActivate();
+}
+
+/**
+* @brief Encode the message fields and captured arguments directly, neither the layout nor the format is rendered.
+*/
+int CYLoggerBinaryAppender::LogMessage(const SharePtr<CYLoggerMessage>& ptrMessage)
+{
+    const int64_t nTimeNs = ptrMessage->GetTimeNs();
+    uint32_t nCallSite = 0;
+    std::string_view strArgs;
+    if (ptrMessage->HasArgs())
+    {
+        nCallSite = GetCallSite(ptrMessage->GetFile(), ptrMessage->GetFunction(), ptrMessage->GetLine(), ptrMessage->GetFormat());
+        strArgs = ptrMessage->GetArgs();
+    }
+    else
+    {
+        nCallSite = GetCallSite(ptrMessage->GetFile(), ptrMessage->GetFunction(), ptrMessage->GetLine(), TEXT("%s"));
+        strArgs = CaptureText(ptrMessage->GetMsg());
+    }
+
+    EncodeRecord(nTimeNs, nCallSite, ptrMessage->GetMsgType(), ptrMessage->GetSeverCode(), static_cast<uint64_t>(ptrMessage->GetThreadId()), ptrMessage->GetChannel(), strArgs);
+    return WriteRecord();
+}
+
+/**
+* @brief Implementation of a pure virtual method from CYLoggerBaseAppender, writes the text as a record without call site.
+*/
+void CYLoggerBinaryAppender::Log(const TStringView& strMsg, int nTypeIndex, bool bFlush)
+{
+    uint32_t nCallSite = GetCallSite(TString(), TString(), 0, TEXT("%s"));
+    EncodeRecord(CYTimeFormat::Now(), nCallSite, m_eLogType, UNKNOWN_SEVER_CODE, 0, TStringView(), CaptureText(strMsg));
+    WriteRecord();
+
+    if (bFlush)
+        Flush();
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender
+*/
+void CYLoggerBinaryAppender::Flush()
+{
+    if (m_objLogFile.is_open()) m_objLogFile.flush();
+    IfTrueThrow(m_objLogFile.fail(), TString(TEXT("Flush() failed for file ")) += m_strFileName);
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender
+*/
+int64_t CYLoggerBinaryAppender::GetSize()
+{
+    int64_t nSize = m_objLogFile.tellp();
+    IfTrueThrow(m_objLogFile.fail(), TString(TEXT("tellp() failed for file ")) += m_strFileName);
+    return nSize;
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, switches to a new file.
+*/
+bool CYLoggerBinaryAppender::OnNewFile()
+{
+    ReOpenFile(CYFileRestriction::GetNewLogName(this->m_strFileName));
+    return true;
+}
+
+CYLOGGER_NAMESPACE_END
@@ -0,0 +1,198 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LOGGER_BINARY_APPENDER_HPP__
+#define __CY_LOGGER_BINARY_APPENDER_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Entity/Appender/CYLoggerBaseAppender.hpp"
+#include "Common/CYFileRestriction.hpp"
+
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Writes compact binary records (see CYBinaryLogFormat.hpp) instead of rendered text, decode with cylog-decode.
+ * A message written through a printf format is stored as its call site, which holds the format, and the arguments the
+ * caller captured, the text is never rendered by the logger.
+*/
+class CYLoggerBinaryAppender : public CYLoggerBaseAppender, public CYFileRestriction
+{
+public:
+	CYLoggerBinaryAppender(const TString& strFileName, ELogFileMode eFileMode, ELogType eLogType);
+	virtual ~CYLoggerBinaryAppender();
+
+	/**
+	* @brief Implementation of a pure virtual method from CYLoggerBaseAppender
+	*/
+	const ELogType GetId() const
+	{
+		return m_eLogType;
+	}
+
+	/**
+	* @brief Implementation of a pure virtual method from CYLoggerBaseAppender, writes the text as a record without call site.
+	*/
+	virtual void Log(const TStringView& strMsg, int nTypeIndex, bool bFlush) override;
+
+	/**
+	* @brief Encode the message fields and captured arguments directly, neither the layout nor the format is rendered.
+	*/
+	virtual int LogMessage(const SharePtr<CYLoggerMessage>& ptrMessage) override;
+
+	/**
+	* @brief Implementation of a pure virtual method from CYLoggerBaseAppender
+	*/
+	virtual void OnActivate() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender
+	*/
+	virtual void Flush() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender
+	*/
+	virtual int64_t GetSize() override;
+
+	/**
+	 * @brief Get log file name.
+	*/
+	virtual const TString& GetLogName() override
+	{
+		return m_strFileName;
+	}
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, switches to a new file.
+	*/
+	virtual bool OnNewFile() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
+	*/
+	virtual void OnBatchDone() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
+	*/
+	virtual void OnIdle() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender
+	*/
+	virtual void SetRotation(const STRotationPolicy& objPolicy) override;
+
+private:
+	/**
+	 * @brief Write the file header and reset the call site dictionary.
+	*/
+	void WriteHeader();
+
+	/**
+	 * @brief Get the call site id, the dictionary entry is appended to m_strRecord the first time.
+	*/
+	uint32_t GetCallSite(const TString& strFile, const TString& strFunction, int nLine, const TStringView& strFormat);
+
+	/**
+	 * @brief Encode one record into m_strRecord.
+	*/
+	void EncodeRecord(int64_t nTimeNs, uint32_t nCallSite, int nLevel, int nServerCode, uint64_t nThreadId, const TStringView& strChannel, std::string_view strArgs);
+
+	/**
+	 * @brief Capture a text without format into m_strArgs, as the argument of the format "%s".
+	*/
+	std::string_view CaptureText(const TStringView& strText);
+
+	/**
+	 * @brief Write m_strRecord to the file and apply rotation.
+	*/
+	int WriteRecord();
+
+	/**
+	 * @brief Switch to a new file.
+	*/
+	void ReOpenFile(const TString& strNewFile);
+
+private:
+	/**
+	 * @brief Call site dictionary entry.
+	*/
+	struct STCallSite
+	{
+		TString  strFile;
+		TString  strFunction;
+		TString  strFormat;
+		uint32_t nId;
+	};
+
+	ELogType m_eLogType;
+	TString  m_strFileName;
+	std::ofstream m_objLogFile;
+	ELogFileMode m_eFileMode;
+
+	/**
+	 * @brief Encoding buffer, reused for every record.
+	*/
+	std::string m_strRecord;
+	std::string m_strArgs;
+
+	/**
+	 * @brief Record sequence and time of the previous record in the current file.
+	*/
+	uint64_t m_nSequence = 0;
+	int64_t  m_nLastTimeNs = 0;
+
+	/**
+	 * @brief Call sites of the current file, keyed by line.
+	*/
+	std::unordered_map<int, std::vector<STCallSite>> m_mapCallSite;
+	uint32_t m_nNextCallSiteId = 0;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LOGGER_BINARY_APPENDER_HPP__
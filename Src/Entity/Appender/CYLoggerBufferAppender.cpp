@@ -27,8 +27,10 @@ CYLoggerBufferAppender::~CYLoggerBufferAppender() noexcept
 /**
 * @brief Put message to the Log
 */
-void CYLoggerBufferAppender::WriteLog(const SharePtr<CYBaseMessage>& ptrMessage)
+void CYLoggerBufferAppender::WriteLog(const SharePtr<CYLoggerMessage>& ptrMessage)
 {
+    const int64_t nEnqueueTime = LOG_LATENCY_STATS ? CYLatencyHistogram::Now() : 0;
+
     EXCEPTION_BEGIN
     {
         switch (ptrMessage->GetMsgType())
@@ -36,37 +38,37 @@ void CYLoggerBufferAppender::WriteLog(const SharePtr<CYBaseMessage>& ptrMessage)
         case LOG_TYPE_DEBUG:
         {
             LockGuard locker(m_mutexPublicDebugMessage);
-            m_lstPublicDebugMessage.push_back(ptrMessage);
+            m_lstPublicDebugMessage.push_back(STQueuedMessage{ ptrMessage, nEnqueueTime });
             break;
         }
         case LOG_TYPE_TRACE:
         {
             LockGuard locker(m_mutexPublicTraceMessage);
-            m_lstPublicTraceMessage.push_back(ptrMessage);
+            m_lstPublicTraceMessage.push_back(STQueuedMessage{ ptrMessage, nEnqueueTime });
             break;
         }
         case LOG_TYPE_INFO:
         {
             LockGuard locker(m_mutexPublicInfoMessage);
-            m_lstPublicInfoMessage.push_back(ptrMessage);
+            m_lstPublicInfoMessage.push_back(STQueuedMessage{ ptrMessage, nEnqueueTime });
             break;
         }
         case LOG_TYPE_WARN:
         {
             LockGuard locker(m_mutexPublicWarnMessage);
-            m_lstPublicWarnMessage.push_back(ptrMessage);
+            m_lstPublicWarnMessage.push_back(STQueuedMessage{ ptrMessage, nEnqueueTime });
             break;
         }
         case LOG_TYPE_ERROR:
         {
             LockGuard locker(m_mutexPublicErrMessage);
-            m_lstPublicErrMessage.push_back(ptrMessage);
+            m_lstPublicErrMessage.push_back(STQueuedMessage{ ptrMessage, nEnqueueTime });
             break;
         }
         case LOG_TYPE_FATAL:
         {
             LockGuard locker(m_mutexPublicFatalMessage);
-            m_lstPublicFatalMessage.push_back(ptrMessage);
+            m_lstPublicFatalMessage.push_back(STQueuedMessage{ ptrMessage, nEnqueueTime });
             break;
         }
         default:
@@ -75,8 +77,6 @@ void CYLoggerBufferAppender::WriteLog(const SharePtr<CYBaseMessage>& ptrMessage)
         }
     }
     EXCEPTION_END
-
-    UpdatePublicStats();
 }
 
 /**
@@ -88,12 +88,12 @@ void CYLoggerBufferAppender::UpdatePublicStats()
     switch (eLogType)
     {
     case LOG_TYPE_NONE:
-        Statistics()->AddConsolePublicDQueue(static_cast<uint32_t>(m_lstPublicDebugMessage.size()));
-        Statistics()->AddConsolePublicTQueue(static_cast<uint32_t>(m_lstPublicTraceMessage.size()));
-        Statistics()->AddConsolePublicIQueue(static_cast<uint32_t>(m_lstPublicInfoMessage.size()));
-        Statistics()->AddConsolePublicWQueue(static_cast<uint32_t>(m_lstPublicWarnMessage.size()));
-        Statistics()->AddConsolePublicEQueue(static_cast<uint32_t>(m_lstPublicErrMessage.size()));
-        Statistics()->AddConsolePublicFQueue(static_cast<uint32_t>(m_lstPublicFatalMessage.size()));
+        Statistics()->AddConsolePublicDQueue(static_cast<uint32_t>(m_lstPrivateDebugMessage.size()));
+        Statistics()->AddConsolePublicTQueue(static_cast<uint32_t>(m_lstPrivateTraceMessage.size()));
+        Statistics()->AddConsolePublicIQueue(static_cast<uint32_t>(m_lstPrivateInfoMessage.size()));
+        Statistics()->AddConsolePublicWQueue(static_cast<uint32_t>(m_lstPrivateWarnMessage.size()));
+        Statistics()->AddConsolePublicEQueue(static_cast<uint32_t>(m_lstPrivateErrMessage.size()));
+        Statistics()->AddConsolePublicFQueue(static_cast<uint32_t>(m_lstPrivateFatalMessage.size()));
         break;
     case LOG_TYPE_TRACE:
         assert(0);
@@ -114,20 +114,20 @@ void CYLoggerBufferAppender::UpdatePublicStats()
         assert(0);
         break;
     case LOG_TYPE_MAIN:
-        Statistics()->AddMainPublicDQueue(static_cast<uint32_t>(m_lstPublicDebugMessage.size()));
-        Statistics()->AddMainPublicTQueue(static_cast<uint32_t>(m_lstPublicTraceMessage.size()));
-        Statistics()->AddMainPublicIQueue(static_cast<uint32_t>(m_lstPublicInfoMessage.size()));
-        Statistics()->AddMainPublicWQueue(static_cast<uint32_t>(m_lstPublicWarnMessage.size()));
-        Statistics()->AddMainPublicEQueue(static_cast<uint32_t>(m_lstPublicErrMessage.size()));
-        Statistics()->AddMainPublicFQueue(static_cast<uint32_t>(m_lstPublicFatalMessage.size()));
+        Statistics()->AddMainPublicDQueue(static_cast<uint32_t>(m_lstPrivateDebugMessage.size()));
+        Statistics()->AddMainPublicTQueue(static_cast<uint32_t>(m_lstPrivateTraceMessage.size()));
+        Statistics()->AddMainPublicIQueue(static_cast<uint32_t>(m_lstPrivateInfoMessage.size()));
+        Statistics()->AddMainPublicWQueue(static_cast<uint32_t>(m_lstPrivateWarnMessage.size()));
+        Statistics()->AddMainPublicEQueue(static_cast<uint32_t>(m_lstPrivateErrMessage.size()));
+        Statistics()->AddMainPublicFQueue(static_cast<uint32_t>(m_lstPrivateFatalMessage.size()));
         break;
     case LOG_TYPE_REMOTE:
-        Statistics()->AddRemotePublicDQueue(static_cast<uint32_t>(m_lstPublicDebugMessage.size()));
-        Statistics()->AddRemotePublicTQueue(static_cast<uint32_t>(m_lstPublicTraceMessage.size()));
-        Statistics()->AddRemotePublicIQueue(static_cast<uint32_t>(m_lstPublicInfoMessage.size()));
-        Statistics()->AddRemotePublicWQueue(static_cast<uint32_t>(m_lstPublicWarnMessage.size()));
-        Statistics()->AddRemotePublicEQueue(static_cast<uint32_t>(m_lstPublicErrMessage.size()));
-        Statistics()->AddRemotePublicFQueue(static_cast<uint32_t>(m_lstPublicFatalMessage.size()));
+        Statistics()->AddRemotePublicDQueue(static_cast<uint32_t>(m_lstPrivateDebugMessage.size()));
+        Statistics()->AddRemotePublicTQueue(static_cast<uint32_t>(m_lstPrivateTraceMessage.size()));
+        Statistics()->AddRemotePublicIQueue(static_cast<uint32_t>(m_lstPrivateInfoMessage.size()));
+        Statistics()->AddRemotePublicWQueue(static_cast<uint32_t>(m_lstPrivateWarnMessage.size()));
+        Statistics()->AddRemotePublicEQueue(static_cast<uint32_t>(m_lstPrivateErrMessage.size()));
+        Statistics()->AddRemotePublicFQueue(static_cast<uint32_t>(m_lstPrivateFatalMessage.size()));
         break;
     case LOG_TYPE_SYS:
         assert(0);
@@ -262,55 +262,56 @@ void CYLoggerBufferAppender::FlipBuffer()
             std::swap(m_lstPublicFatalMessage, m_lstPrivateFatalMessage);
         }
 
+        // The producers never touch the statistics, the public queue depths are what the flip took over.
+        UpdatePublicStats();
+
         while (!m_lstPrivateDebugMessage.empty())
         {
-            auto ptrMessage = m_lstPrivateDebugMessage.front();
-            m_mapPrivateMessage.emplace(ptrMessage->GetTimeStamp().GetTime(), ptrMessage);
+            auto& objMessage = m_lstPrivateDebugMessage.front();
+            m_mapPrivateMessage.emplace(objMessage.ptrMessage->GetSortTime(), std::move(objMessage));
             m_lstPrivateDebugMessage.pop_front();
         }
 
         while (!m_lstPrivateTraceMessage.empty())
         {
-            auto ptrMessage = m_lstPrivateTraceMessage.front();
-            m_mapPrivateMessage.emplace(ptrMessage->GetTimeStamp().GetTime(), ptrMessage);
+            auto& objMessage = m_lstPrivateTraceMessage.front();
+            m_mapPrivateMessage.emplace(objMessage.ptrMessage->GetSortTime(), std::move(objMessage));
             m_lstPrivateTraceMessage.pop_front();
         }
 
         while (!m_lstPrivateInfoMessage.empty())
         {
-            auto ptrMessage = m_lstPrivateInfoMessage.front();
-            m_mapPrivateMessage.emplace(ptrMessage->GetTimeStamp().GetTime(), ptrMessage);
+            auto& objMessage = m_lstPrivateInfoMessage.front();
+            m_mapPrivateMessage.emplace(objMessage.ptrMessage->GetSortTime(), std::move(objMessage));
             m_lstPrivateInfoMessage.pop_front();
         }
 
         while (!m_lstPrivateWarnMessage.empty())
         {
-            auto ptrMessage = m_lstPrivateWarnMessage.front();
-            m_mapPrivateMessage.emplace(ptrMessage->GetTimeStamp().GetTime(), ptrMessage);
+            auto& objMessage = m_lstPrivateWarnMessage.front();
+            m_mapPrivateMessage.emplace(objMessage.ptrMessage->GetSortTime(), std::move(objMessage));
             m_lstPrivateWarnMessage.pop_front();
         }
 
         while (!m_lstPrivateErrMessage.empty())
         {
-            auto ptrMessage = m_lstPrivateErrMessage.front();
-            m_mapPrivateMessage.emplace(ptrMessage->GetTimeStamp().GetTime(), ptrMessage);
+            auto& objMessage = m_lstPrivateErrMessage.front();
+            m_mapPrivateMessage.emplace(objMessage.ptrMessage->GetSortTime(), std::move(objMessage));
             m_lstPrivateErrMessage.pop_front();
         }
 
         while (!m_lstPrivateFatalMessage.empty())
         {
-            auto ptrMessage = m_lstPrivateFatalMessage.front();
-            m_mapPrivateMessage.emplace(ptrMessage->GetTimeStamp().GetTime(), ptrMessage);
+            auto& objMessage = m_lstPrivateFatalMessage.front();
+            m_mapPrivateMessage.emplace(objMessage.ptrMessage->GetSortTime(), std::move(objMessage));
             m_lstPrivateFatalMessage.pop_front();
         }
 
-        for (auto iterElem : m_mapPrivateMessage)
+        for (auto& iterElem : m_mapPrivateMessage)
         {
-            this->m_lstPrivMessage.push_back(iterElem.second);
+            this->m_lstPrivMessage.push_back(std::move(iterElem.second));
         }
 
-        UpdatePrivateStats();
-
         m_mapPrivateMessage.clear();
 
         return 0;
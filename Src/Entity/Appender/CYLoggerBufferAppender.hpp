@@ -68,7 +68,7 @@ public:
     /**
     * @brief Put message to the Log
     */
-	virtual void WriteLog(const SharePtr<CYBaseMessage>& ptrMessage) override;
+	virtual void WriteLog(const SharePtr<CYLoggerMessage>& ptrMessage) override;
 
 	/**
 	 * @brief Flip buffering.
@@ -92,31 +92,31 @@ protected:
 	virtual void UpdatePrivateStats();
 
 private:
-    std::deque<SharePtr<CYBaseMessage>> m_lstPrivateDebugMessage;
-    std::deque<SharePtr<CYBaseMessage>> m_lstPrivateTraceMessage;
-    std::deque<SharePtr<CYBaseMessage>> m_lstPrivateInfoMessage;
-    std::deque<SharePtr<CYBaseMessage>> m_lstPrivateWarnMessage;
-    std::deque<SharePtr<CYBaseMessage>> m_lstPrivateErrMessage;
-    std::deque<SharePtr<CYBaseMessage>> m_lstPrivateFatalMessage;
-    std::multimap<int64_t, SharePtr<CYBaseMessage>> m_mapPrivateMessage;
+    std::deque<STQueuedMessage> m_lstPrivateDebugMessage;
+    std::deque<STQueuedMessage> m_lstPrivateTraceMessage;
+    std::deque<STQueuedMessage> m_lstPrivateInfoMessage;
+    std::deque<STQueuedMessage> m_lstPrivateWarnMessage;
+    std::deque<STQueuedMessage> m_lstPrivateErrMessage;
+    std::deque<STQueuedMessage> m_lstPrivateFatalMessage;
+    std::multimap<int64_t, STQueuedMessage> m_mapPrivateMessage;
 
     CYNamedLocker m_mutexPublicDebugMessage{ TEXT("Trace_PublicDebugMessage") };
-    std::deque<SharePtr<CYBaseMessage>> m_lstPublicDebugMessage;
+    std::deque<STQueuedMessage> m_lstPublicDebugMessage;
 
     CYNamedLocker m_mutexPublicTraceMessage{ TEXT("Trace_PublicTraceMessage") };
-    std::deque<SharePtr<CYBaseMessage>> m_lstPublicTraceMessage;
+    std::deque<STQueuedMessage> m_lstPublicTraceMessage;
 
     CYNamedLocker m_mutexPublicInfoMessage{ TEXT("Trace_PublicInfoMessage") };
-    std::deque<SharePtr<CYBaseMessage>> m_lstPublicInfoMessage;
+    std::deque<STQueuedMessage> m_lstPublicInfoMessage;
 
     CYNamedLocker m_mutexPublicWarnMessage{ TEXT("Trace_PublicWarnMessage") };
-    std::deque<SharePtr<CYBaseMessage>> m_lstPublicWarnMessage;
+    std::deque<STQueuedMessage> m_lstPublicWarnMessage;
 
     CYNamedLocker m_mutexPublicErrMessage{ TEXT("Trace_PublicErrMessage") };
-    std::deque<SharePtr<CYBaseMessage>> m_lstPublicErrMessage;
+    std::deque<STQueuedMessage> m_lstPublicErrMessage;
 
     CYNamedLocker m_mutexPublicFatalMessage{ TEXT("Trace_PublicFatalMessage") };
-    std::deque<SharePtr<CYBaseMessage>> m_lstPublicFatalMessage;
+    std::deque<STQueuedMessage> m_lstPublicFatalMessage;
 };
 
 
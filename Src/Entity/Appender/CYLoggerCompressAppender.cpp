@@ -0,0 +1,274 @@
+#include "Entity/Appender/CYLoggerCompressAppender.hpp"
+#include "Common/Compress/CYLzCodec.hpp"
+#include "Common/Compress/CYLogFileCompressor.hpp"
+#include "Common/CYPublicFunction.hpp"
+#include "Statistics/CYStatistics.hpp"
+#include "Common/CYTraceProbe.hpp"
+#include "CYCommon/Common/Structure/CYStringUtils.hpp"
+
+CYLOGGER_NAMESPACE_BEGIN
+
+CYLoggerCompressAppender::CYLoggerCompressAppender(const TString& strFileName, ELogFileMode eFileMode, ELogType eLogType)
+    : CYLoggerBaseAppender("CYLoggerCompressAppender")
+    , CYFileRestriction()
+    , m_eLogType(eLogType)
+    , m_eFileMode(eFileMode)
+{
+    IfTrueThrow(strFileName.length() == 0, TEXT("fileName cannot be empty"));
+
+    UniquePtr<TChar> ptrFileName;
+    TChar* p = cy_fullpath(nullptr, strFileName.c_str(), 0);
+    ptrFileName.reset(p);
+    IfTrueThrow(p == nullptr, TEXT("_fullpath() failed"));
+    this->m_strFileName = p;
+    this->m_strZipFileName = m_strFileName + CYLogFileCompressor::GetFileExt(ELogZipCodec::LOG_ZIP_LZ);
+
+    switch (m_eLogType)
+    {
+    case LOG_TYPE_TRACE:
+        SetThreadName("TraceThread");
+        break;
+    case LOG_TYPE_DEBUG:
+        SetThreadName("DebugThread");
+        break;
+    case LOG_TYPE_INFO:
+        SetThreadName("InfoThread");
+        break;
+    case LOG_TYPE_WARN:
+        SetThreadName("WarnThread");
+        break;
+    case LOG_TYPE_ERROR:
+        SetThreadName("ErrorThread");
+        break;
+    case LOG_TYPE_FATAL:
+        SetThreadName("FatalThread");
+        break;
+    default:
+        IfTrueThrow(true, TEXT("eLogType not supported by the compress appender"));
+        break;
+    }
+
+    m_strBlock.reserve(LOG_ZIP_BLOCK_SIZE);
+    StartLogThread();
+}
+
+CYLoggerCompressAppender::~CYLoggerCompressAppender()
+{
+    StopLogThread();
+}
+
+/**
+* @brief Implementation of a pure virtual method from CYLoggerBaseAppender
+*/
+void CYLoggerCompressAppender::OnActivate()
+{
+    if (m_objLogFile.is_open()) m_objLogFile.close();
+    CYPublicFunction::CreateDirectory(m_strZipFileName);
+    OpenFile();
+}
+
+/**
+ * @brief Open the compressed file, an appended file is checked and a torn last block is cut off.
+*/
+void CYLoggerCompressAppender::OpenFile()
+{
+    uint64_t nValidLength = 0;
+    if (ELogFileMode::LOG_MODE_FILE_APPEND == m_eFileMode)
+    {
+        uint64_t nFileLength = CYPublicFunction::GetFileSize(m_strZipFileName);
+        nValidLength = nFileLength > 0 ? GetValidLength() : 0;
+        if (nFileLength > 0 && nValidLength == 0)
+        {
+            // Not a compressed log, keep it aside instead of appending blocks to it.
+            CYPublicFunction::Rename(m_strZipFileName, CYFileRestriction::GetNewLogName(m_strFileName) + CYLogFileCompressor::GetFileExt(ELogZipCodec::LOG_ZIP_LZ));
+        }
+        else if (nValidLength < nFileLength)
+        {
+            CYPublicFunction::ResizeFile(m_strZipFileName, nValidLength);
+        }
+    }
+
+    std::ios_base::openmode nFlags = std::ios_base::out | std::ios_base::binary;
+    nFlags |= nValidLength > 0 ? std::ios_base::app : std::ios_base::trunc;
+    m_objLogFile.open(m_strZipFileName.c_str(), nFlags);
+    IfTrueThrow(!m_objLogFile, TString(TEXT("cannot open file ")) += m_strZipFileName);
+
+    if (nValidLength == 0)
+    {
+        m_strFrame.clear();
+        CYLzCodec::AppendFrameHeader(m_strFrame);
+        m_objLogFile.write(m_strFrame.data(), static_cast<std::streamsize>(m_strFrame.size()));
+        IfTrueThrow(m_objLogFile.fail(), TString(TEXT("write() failed for file ")) += m_strZipFileName);
+        nValidLength = m_strFrame.size();
+    }
+
+    CYFileRestriction::ResetFileSize();
+    CYFileRestriction::AddFileSize(nValidLength);
+}
+
+/**
+ * @brief Length of the valid prefix of an existing compressed file, 0 if it is not a compressed log.
+*/
+uint64_t CYLoggerCompressAppender::GetValidLength()
+{
+    std::ifstream objFile(m_strZipFileName.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (!objFile)
+        return 0;
+
+    // Blocks are decoded and their CRC checked, so a tail that is complete but damaged is cut off too.
+    return CYLzCodec::GetValidFrameLength(objFile);
+}
+
+/**
+ * @brief Compress the pending text into one block and write it.
+*/
+void CYLoggerCompressAppender::WriteBlock()
+{
+    if (m_strBlock.empty())
+        return;
+
+    m_strFrame.clear();
+    CYLzCodec::AppendFrameBlock(reinterpret_cast<const uint8_t*>(m_strBlock.data()), m_strBlock.size(), m_strFrame);
+    m_strBlock.clear();
+
+    // Hand the whole block to the OS at once, so a crash never leaves part of it behind the previous one.
+    m_objLogFile.write(m_strFrame.data(), static_cast<std::streamsize>(m_strFrame.size()));
+    m_objLogFile.flush();
+    IfTrueThrow(m_objLogFile.fail(), TString(TEXT("write() failed for file ")) += m_strZipFileName);
+
+    CYFileRestriction::AddFileSize(m_strFrame.size());
+}
+
+/**
+* @brief Implementation of a pure virtual method from CYLoggerBaseAppender, the line is added to the pending block.
+*/
+void CYLoggerCompressAppender::Log(const TStringView& strMsg, int nTypeIndex, bool bFlush)
+{
+    size_t nBytes = m_strBlock.size();
+#if CY_USE_UNICODE
+    m_strBlock += CYCOMMON_NAMESPACE::CYStringUtils::TString2String(TString(strMsg).c_str());
+#else
+    m_strBlock.append(strMsg.data(), strMsg.size());
+#endif
+    m_strBlock.push_back('\n');
+    nBytes = m_strBlock.size() - nBytes;
+    CYFileRestriction::AddFileLine(1);
+
+    switch (m_eLogType)
+    {
+    case LOG_TYPE_TRACE:
+        Statistics()->AddTraceLine(1);
+        Statistics()->AddTraceBytes(nBytes);
+        break;
+    case LOG_TYPE_DEBUG:
+        Statistics()->AddDebugLine(1);
+        Statistics()->AddDebugBytes(nBytes);
+        break;
+    case LOG_TYPE_INFO:
+        Statistics()->AddInfoLine(1);
+        Statistics()->AddInfoBytes(nBytes);
+        break;
+    case LOG_TYPE_WARN:
+        Statistics()->AddWarnLine(1);
+        Statistics()->AddWarnBytes(nBytes);
+        break;
+    case LOG_TYPE_ERROR:
+        Statistics()->AddErrorLine(1);
+        Statistics()->AddErrorBytes(nBytes);
+        break;
+    case LOG_TYPE_FATAL:
+        Statistics()->AddFatalLine(1);
+        Statistics()->AddFatalBytes(nBytes);
+        break;
+    default:
+        break;
+    }
+
+    if (bFlush || m_strBlock.size() >= static_cast<size_t>(LOG_ZIP_BLOCK_SIZE))
+        WriteBlock();
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, compresses the pending block.
+*/
+void CYLoggerCompressAppender::OnBatchDone()
+{
+    WriteBlock();
+
+    // Rotation is decided on the compressed size.
+    if (this->m_eFileMode == ELogFileMode::LOG_MODE_FILE_TIME && (CYFileRestriction::IsCreateNewLog() || CYFileRestriction::IsRotateTimeDue()))
+    {
+        ReOpenFile(CYFileRestriction::GetNewLogName(this->m_strFileName));
+    }
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
+*/
+void CYLoggerCompressAppender::OnIdle()
+{
+    OnBatchDone();
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender
+*/
+void CYLoggerCompressAppender::SetRotation(const STRotationPolicy& objPolicy)
+{
+    CYFileRestriction::SetRotation(objPolicy);
+}
+
+/**
+ * @brief Switch to a new file.
+*/
+void CYLoggerCompressAppender::ReOpenFile(const TString& strNewFile)
+{
+    Flush();
+    CY_PROBE_ROTATE(this->GetId());
+    m_objLogFile.close();
+
+    if (ELogFileMode::LOG_MODE_FILE_APPEND == m_eFileMode)
+    {
+        // Keep the append target name, move the current content aside.
+        CYPublicFunction::Rename(m_strZipFileName, strNewFile + CYLogFileCompressor::GetFileExt(ELogZipCodec::LOG_ZIP_LZ));
+    }
+    else
+    {
+        this->m_strFileName = strNewFile;
+        this->m_strZipFileName = m_strFileName + CYLogFileCompressor::GetFileExt(ELogZipCodec::LOG_ZIP_LZ);
+    }
+
+    OpenFile();
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender
+*/
+void CYLoggerCompressAppender::Flush()
+{
+    if (!m_objLogFile.is_open())
+        return;
+
+    WriteBlock();
+    m_objLogFile.flush();
+    IfTrueThrow(m_objLogFile.fail(), TString(TEXT("Flush() failed for file ")) += m_strZipFileName);
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender
+*/
+int64_t CYLoggerCompressAppender::GetSize()
+{
+    return static_cast<int64_t>(CYFileRestriction::GetFileSize());
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, compresses the pending block and switches to a new file.
+*/
+bool CYLoggerCompressAppender::OnNewFile()
+{
+    ReOpenFile(CYFileRestriction::GetNewLogName(this->m_strFileName));
+    return true;
+}
+
+CYLOGGER_NAMESPACE_END
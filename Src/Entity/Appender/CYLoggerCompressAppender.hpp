@@ -0,0 +1,162 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LOGGER_COMPRESS_APPENDER_HPP__
+#define __CY_LOGGER_COMPRESS_APPENDER_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Entity/Appender/CYLoggerBaseAppender.hpp"
+#include "Common/CYFileRestriction.hpp"
+
+#include <fstream>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Writes text logs as a stream of independently decodable compressed blocks (see CYLzCodec.hpp).
+ * Each drained batch becomes at least one block, so a crash loses at most the block being built.
+*/
+class CYLoggerCompressAppender : public CYLoggerBaseAppender, public CYFileRestriction
+{
+public:
+	CYLoggerCompressAppender(const TString& strFileName, ELogFileMode eFileMode, ELogType eLogType);
+	virtual ~CYLoggerCompressAppender();
+
+	/**
+	* @brief Implementation of a pure virtual method from CYLoggerBaseAppender
+	*/
+	const ELogType GetId() const
+	{
+		return m_eLogType;
+	}
+
+	/**
+	* @brief Implementation of a pure virtual method from CYLoggerBaseAppender, the line is added to the pending block.
+	*/
+	virtual void Log(const TStringView& strMsg, int nTypeIndex, bool bFlush) override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, compresses the pending block.
+	*/
+	virtual void OnBatchDone() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
+	*/
+	virtual void OnIdle() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender
+	*/
+	virtual void SetRotation(const STRotationPolicy& objPolicy) override;
+
+	/**
+	* @brief Implementation of a pure virtual method from CYLoggerBaseAppender
+	*/
+	virtual void OnActivate() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender
+	*/
+	virtual void Flush() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender
+	*/
+	virtual int64_t GetSize() override;
+
+	/**
+	 * @brief Get log file name.
+	*/
+	virtual const TString& GetLogName() override
+	{
+		return m_strZipFileName;
+	}
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, compresses the pending block and switches to a new file.
+	*/
+	virtual bool OnNewFile() override;
+
+private:
+	/**
+	 * @brief Open the compressed file, an appended file is checked and a torn last block is cut off.
+	*/
+	void OpenFile();
+
+	/**
+	 * @brief Length of the valid prefix of an existing compressed file, 0 if it is not a compressed log.
+	*/
+	uint64_t GetValidLength();
+
+	/**
+	 * @brief Compress the pending text into one block and write it.
+	*/
+	void WriteBlock();
+
+	/**
+	 * @brief Switch to a new file.
+	*/
+	void ReOpenFile(const TString& strNewFile);
+
+private:
+	ELogType m_eLogType;
+	ELogFileMode m_eFileMode;
+
+	/**
+	 * @brief Log file name used for rotation naming, and the compressed file actually written.
+	*/
+	TString  m_strFileName;
+	TString  m_strZipFileName;
+	std::ofstream m_objLogFile;
+
+	/**
+	 * @brief Pending UTF-8 text and the encoded block.
+	*/
+	std::string m_strBlock;
+	std::string m_strFrame;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LOGGER_COMPRESS_APPENDER_HPP__
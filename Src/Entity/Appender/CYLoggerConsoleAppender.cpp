@@ -1,6 +1,18 @@
 #include "Entity/Appender/CYLoggerConsoleAppender.hpp"
 #include "Entity/Appender/CYLoggerAppenderDefine.hpp"
 #include "Statistics/CYStatistics.hpp"
+#include "Common/Exception/CYExceptionLogFile.hpp"
+#include "CYCommon/Common/Structure/CYStringUtils.hpp"
+
+#ifndef CYLOGGER_WIN_OS
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <climits>
+#include <cerrno>
+#include <algorithm>
+#endif
 
 CYLOGGER_NAMESPACE_BEGIN
 
@@ -9,6 +21,13 @@ CYLoggerConsoleAppender::CYLoggerConsoleAppender(const TStringView& strConsoleTi
     , m_bWindow(bWindow)
     , m_strTitle(strConsoleTile)
     , m_bForceNewFile(false)
+#ifndef CYLOGGER_WIN_OS
+    , m_nOutput(STDOUT_FILENO)
+    , m_bColor(false)
+    , m_bNonBlock(false)
+    , m_bTornLine(false)
+    , m_nDropBytes(0)
+#endif
 {
     if (m_bWindow)
     {
@@ -31,6 +50,13 @@ CYLoggerConsoleAppender::~CYLoggerConsoleAppender()
         FreeConsole();
 #endif
     }
+
+#ifndef CYLOGGER_WIN_OS
+    if (m_nOutput != STDOUT_FILENO)
+    {
+        close(m_nOutput);
+    }
+#endif
 }
 
 /**
@@ -48,10 +74,8 @@ const ELogType CYLoggerConsoleAppender::GetId() const
 */
 void CYLoggerConsoleAppender::Log(const TStringView& strMsg, int nTypeIndex, bool bFlush)
 {
-    CYFPSCounter::UpdateCounter();
-
-    ClearConsole();
 #ifdef CYLOGGER_WIN_OS
+    ClearConsole();
     if (m_bWindow)
     {
         DWORD color = TWHITE;
@@ -68,8 +92,8 @@ void CYLoggerConsoleAppender::Log(const TStringView& strMsg, int nTypeIndex, boo
 
         unsigned long dwWrittenSize = 0;
         SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), (WORD)color);
-        WriteConsole(GetStdHandle(STD_OUTPUT_HANDLE), strMsg.data(), (DWORD)cy_strlen(strMsg.data()), &dwWrittenSize, nullptr);
-        WriteConsole(GetStdHandle(STD_OUTPUT_HANDLE), TEXT("\r\n"), (DWORD)cy_strlen(TEXT("\r\n")), &dwWrittenSize, nullptr);
+        WriteConsole(GetStdHandle(STD_OUTPUT_HANDLE), strMsg.data(), (DWORD)strMsg.size(), &dwWrittenSize, nullptr);
+        WriteConsole(GetStdHandle(STD_OUTPUT_HANDLE), TEXT("\r\n"), 2, &dwWrittenSize, nullptr);
     }
     else
     {
@@ -77,15 +101,50 @@ void CYLoggerConsoleAppender::Log(const TStringView& strMsg, int nTypeIndex, boo
         OutputDebugString(TEXT("\r\n"));
     }
 #else
-    printf("%s", strMsg.data());
-    printf("\n");
+    // Lines are only collected here, OnBatchDone writes the whole batch at once.
+    const char* szColor = nullptr;
+    if (m_bColor && nTypeIndex >= 0 && static_cast<size_t>(nTypeIndex) < strMsg.size())
+    {
+        switch (strMsg[nTypeIndex])
+        {
+        case 'D': szColor = "\033[32m";   break;
+        case 'T': szColor = "\033[34m";   break;
+        case 'W': szColor = "\033[33m";   break;
+        case 'E': szColor = "\033[31m";   break;
+        case 'F': szColor = "\033[1;31m"; break;
+        default:  break;
+        }
+    }
+
+    if (szColor != nullptr)
+        m_strBatch.append(szColor);
+#if CY_USE_UNICODE
+    m_strBatch.append(CYCOMMON_NAMESPACE::CYStringUtils::TString2String(TString(strMsg).c_str()));
+#else
+    m_strBatch.append(strMsg.data(), strMsg.size());
+#endif
+    if (szColor != nullptr)
+        m_strBatch.append("\033[0m");
+    m_strBatch.push_back('\n');
+
+    if (bFlush)
+    {
+        WriteBatch();
+    }
 #endif
 
     Statistics()->AddConsoleLine(1);
     Statistics()->AddConsoleBytes(strMsg.size() + TEXT_BYTE_LEN + TEXT_BYTE_LEN);
+}
 
-    Statistics()->AddConsoleCurrentFPS(CYFPSCounter::GetCurrentFPS());
-    Statistics()->AddConsoleAverageFPS(CYFPSCounter::GetAverageFPS());
+/**
+* Get called after a drained batch has been passed to LogMessage, writes the batch with one write call
+*/
+void CYLoggerConsoleAppender::OnBatchDone()
+{
+#ifndef CYLOGGER_WIN_OS
+    WriteBatch();
+#endif
 }
 
 /**
@@ -93,7 +152,24 @@ void CYLoggerConsoleAppender::Log(const TStringView& strMsg, int nTypeIndex, boo
 */
 void CYLoggerConsoleAppender::OnActivate()
 {
-    return;
+#ifndef CYLOGGER_WIN_OS
+    m_bColor = LOG_CONSOLE_COLOR && isatty(STDOUT_FILENO) == 1;
+
+    struct stat objStat;
+    if (LOG_CONSOLE_NONBLOCK && fstat(STDOUT_FILENO, &objStat) == 0 && !S_ISREG(objStat.st_mode))
+    {
+        m_bNonBlock = true;
+#if defined(CYLOGGER_LINUX_OS) || defined(CYLOGGER_ANDROID_OS)
+        // A reopen of a pipe or terminal is a new open file description, O_NONBLOCK on it does not leak into the stdout of the process.
+        if (!S_ISSOCK(objStat.st_mode))
+        {
+            const int nOutput = open("/proc/self/fd/1", O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+            if (nOutput >= 0)
+                m_nOutput = nOutput;
+        }
+#endif
+    }
+#endif
 }
 
 /**
@@ -101,7 +177,13 @@ void CYLoggerConsoleAppender::OnActivate()
 */
 void CYLoggerConsoleAppender::Flush()
 {
-    return;
+#ifndef CYLOGGER_WIN_OS
+    // The batch is owned by the log thread.
+    if (IsLogThread())
+    {
+        WriteBatch();
+    }
+#endif
 }
 
 /**
@@ -138,11 +220,12 @@ const TString& CYLoggerConsoleAppender::GetLogName()
 }
 
 /**
- * @brief Force new log file.
+* @brief Inherited from CYLoggerBaseAppender, clears the console with the next write.
 */
-void CYLoggerConsoleAppender::ForceNewFile()
+bool CYLoggerConsoleAppender::OnNewFile()
 {
     m_bForceNewFile = true;
+    return true;
 }
 
 /**
@@ -181,9 +264,66 @@ void CYLoggerConsoleAppender::ClearConsole()
     }
 
 #else
-    printf("\033[2J\033[H");
-    fflush(stdout);
+    m_strBatch.insert(0, "\033[2J\033[H");
 #endif
 }
 
+#ifndef CYLOGGER_WIN_OS
+/**
+ * @brief Write the batch to stdout, in non-blocking mode what does not fit is dropped.
+*/
+void CYLoggerConsoleAppender::WriteBatch()
+{
+    if (m_bTornLine && !m_strBatch.empty())
+    {
+        m_strBatch.insert(m_strBatch.begin(), '\n');
+        m_bTornLine = false;
+    }
+
+    ClearConsole();
+    if (m_strBatch.empty())
+        return;
+
+    const char* pData = m_strBatch.data();
+    const size_t nSize = m_strBatch.size();
+    size_t nOffset = 0;
+    while (nOffset < nSize)
+    {
+        size_t nLength = nSize - nOffset;
+        if (m_bNonBlock && m_nOutput == STDOUT_FILENO)
+        {
+            // Shared stdout stays blocking, a ready descriptor takes at least PIPE_BUF bytes without waiting.
+            struct pollfd objPoll = { m_nOutput, POLLOUT, 0 };
+            if (poll(&objPoll, 1, 0) <= 0 || (objPoll.revents & POLLOUT) == 0)
+                break;
+            nLength = (std::min)(nLength, static_cast<size_t>(PIPE_BUF));
+        }
+
+        const ssize_t nWritten = write(m_nOutput, pData + nOffset, nLength);
+        if (nWritten > 0)
+        {
+            nOffset += static_cast<size_t>(nWritten);
+            continue;
+        }
+        if (nWritten < 0 && errno == EINTR)
+            continue;
+        // EAGAIN in non-blocking mode, or stdout is gone.
+        break;
+    }
+
+    if (nOffset < nSize)
+    {
+        m_bTornLine = nOffset > 0 && pData[nOffset - 1] != '\n';
+        m_nDropBytes += nSize - nOffset;
+        AddDropLines(static_cast<uint64_t>(std::count(pData + nOffset, pData + nSize, '\n')));
+    }
+    else if (m_nDropBytes > 0)
+    {
+        ExceptionLog((std::string("Console appender dropped ") + std::to_string(m_nDropBytes) + " bytes while stdout was full.").c_str());
+        m_nDropBytes = 0;
+    }
+    m_strBatch.clear();
+}
+#endif
+
 CYLOGGER_NAMESPACE_END
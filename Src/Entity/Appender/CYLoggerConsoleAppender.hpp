@@ -48,6 +48,7 @@
 #include "Entity/Appender/CYLoggerBufferAppender.hpp"
 
 #include <map>
+#include <string>
 
 CYLOGGER_NAMESPACE_BEGIN
 
@@ -70,6 +71,11 @@ public:
 	*/
 	virtual void Log(const TStringView& strMsg, int nTypeIndex, bool bFlush) override;
 
+	/**
+	* Get called after a drained batch has been passed to LogMessage, writes the batch with one write call
+	*/
+	virtual void OnBatchDone() override;
+
 	/**
 	* Get called when this appender become active through attaching to a CYLLoggerImpl object, and it was not active before
 	*/
@@ -103,9 +109,9 @@ public:
 	virtual const TString& GetLogName() override;
 
 	/**
-	 * @brief Force new log file.
+	* @brief Inherited from CYLoggerBaseAppender, clears the console with the next write.
 	*/
-	virtual void ForceNewFile() override;
+	virtual bool OnNewFile() override;
 
 private:
 	/**
@@ -113,11 +119,18 @@ private:
 	*/
 	void ClearConsole();
 
+#ifndef CYLOGGER_WIN_OS
+	/**
+	 * @brief Write the batch to stdout, in non-blocking mode what does not fit is dropped.
+	*/
+	void WriteBatch();
+#endif
+
 private:
 	/**
-	 * @brief Force new log file.
+	 * @brief Clear the console with the next write.
 	*/
-	std::atomic_bool m_bForceNewFile;
+	bool m_bForceNewFile;
 
 	/**
 	 * @brief Whether the console displays a window.
@@ -133,6 +146,38 @@ private:
 	 * @brief Log file name.
 	*/
 	TString m_strLogName;
+
+#ifndef CYLOGGER_WIN_OS
+	/**
+	 * @brief Lines of the current batch, with color escapes and '\n'.
+	*/
+	std::string m_strBatch;
+
+	/**
+	 * @brief Descriptor written to, stdout or a private non-blocking reopen of it.
+	*/
+	int m_nOutput;
+
+	/**
+	 * @brief Color lines by level, LOG_CONSOLE_COLOR and stdout is a terminal.
+	*/
+	bool m_bColor;
+
+	/**
+	 * @brief Drop output instead of waiting for stdout, LOG_CONSOLE_NONBLOCK and stdout is not a regular file.
+	*/
+	bool m_bNonBlock;
+
+	/**
+	 * @brief The last write stopped inside a line, the next batch starts on a new line.
+	*/
+	bool m_bTornLine;
+
+	/**
+	 * @brief Bytes dropped because stdout was full.
+	*/
+	uint64_t m_nDropBytes;
+#endif
 };
 
 CYLOGGER_NAMESPACE_END
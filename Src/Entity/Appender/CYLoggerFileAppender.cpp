@@ -1,13 +1,14 @@
 #include "Entity/Appender/CYLoggerFileAppender.hpp"
 #include "Statistics/CYStatistics.hpp"
 #include "Common/CYFormatDefine.hpp"
+#include "Entity/Schedule/CYLoggerSchedule.hpp"
+#include "Common/CYTraceProbe.hpp"
 
 CYLOGGER_NAMESPACE_BEGIN
 
 CYLoggerFileAppender::CYLoggerFileAppender(const TString& strFileName, ELogFileMode eFileMode, ELogType eLogType)
     : CYLoggerBaseAppender("CYLoggerFileAppender")
     , CYFileRestriction()
-    , m_bForceNewFile(false)
 {
     this->m_eFileMode = eFileMode;
     IfTrueThrow(strFileName.length() == 0, TEXT("fileName cannot be empty"));
@@ -66,6 +67,13 @@ CYLoggerFileAppender::CYLoggerFileAppender(const TString& strFileName, ELogFileM
 CYLoggerFileAppender::~CYLoggerFileAppender()
 {
     StopLogThread();
+
+    // The last file may be a preallocated standby file.
+    if constexpr (LOG_FILE_STANDBY)
+    {
+        if (ELogFileMode::LOG_MODE_FILE_TIME == m_eFileMode)
+            CYFileStandby::Close(m_objLogFile, m_strFileName);
+    }
 }
 
 void CYLoggerFileAppender::OpenFile(int nFlags)
@@ -90,19 +98,20 @@ void CYLoggerFileAppender::OpenFile(int nFlags)
 void CYLoggerFileAppender::ReOpenFile(const TString& strNewFile)
 {
     Flush();
+    // The current file may be a swapped in standby file, its reserved tail is given back when the schedule thread closes it.
+    m_objStandby.Retire(m_objLogFile, m_strFileName);
     this->m_strFileName = strNewFile;
     OnActivate();
 }
 
 /**
- * @brief Create New Log File.
+* @brief Inherited from CYLoggerBaseAppender, opens a new file or copies the append file aside.
 */
-void CYLoggerFileAppender::CreateNewLogFile()
+bool CYLoggerFileAppender::OnNewFile()
 {
-    if (!m_bForceNewFile)
-        return;
-
-    m_bForceNewFile = false;
+    // Nothing was written since the file was opened, it already is a new file.
+    if (m_objLogFile.is_open() && m_objLogFile.tellp() <= 0)
+        return true;
 
     TString strData = CYTimeStamps().GetTimeStr();
     TString strFileExt = CYPublicFunction::GetFileExt(this->m_strFileName);
@@ -123,11 +132,8 @@ void CYLoggerFileAppender::CreateNewLogFile()
     }
 
     CYFileRestriction::ResetFileSize();
-
-    {
-        LockGuard locker(m_mutex);
-        m_objNewFilePromise.set_value(true);
-    }
+    CY_PROBE_ROTATE(this->GetId());
+    return true;
 }
 
 /**
@@ -135,7 +141,6 @@ void CYLoggerFileAppender::CreateNewLogFile()
 */
 void CYLoggerFileAppender::Log(const TStringView& strMsg, int nTypeIndex, bool bFlush)
 {
-    CYFPSCounter::UpdateCounter();
     m_objLogFile << strMsg << TEXT("\n");
     IfTrueThrow(m_objLogFile.fail(), TString(TEXT("operator<<() failed for file ")) += m_strFileName);
 
@@ -147,62 +152,42 @@ void CYLoggerFileAppender::Log(const TStringView& strMsg, int nTypeIndex, bool b
     case LOG_TYPE_NONE:
         Statistics()->AddConsoleLine(1);
         Statistics()->AddConsoleBytes(strMsg.size() + TEXT_BYTE_LEN);
-        Statistics()->AddConsoleCurrentFPS(CYFPSCounter::GetCurrentFPS());
-        Statistics()->AddConsoleAverageFPS(CYFPSCounter::GetAverageFPS());
         break;
     case LOG_TYPE_TRACE:
         Statistics()->AddTraceLine(1);
         Statistics()->AddTraceBytes(strMsg.size() + TEXT_BYTE_LEN);
-        Statistics()->AddTraceCurrentFPS(CYFPSCounter::GetCurrentFPS());
-        Statistics()->AddTraceAverageFPS(CYFPSCounter::GetAverageFPS());
         break;
     case LOG_TYPE_DEBUG:
         Statistics()->AddDebugLine(1);
         Statistics()->AddDebugBytes(strMsg.size() + TEXT_BYTE_LEN);
-        Statistics()->AddDebugCurrentFPS(CYFPSCounter::GetCurrentFPS());
-        Statistics()->AddDebugAverageFPS(CYFPSCounter::GetAverageFPS());
         break;
     case LOG_TYPE_INFO:
         Statistics()->AddInfoLine(1);
         Statistics()->AddInfoBytes(strMsg.size() + TEXT_BYTE_LEN);
-        Statistics()->AddInfoCurrentFPS(CYFPSCounter::GetCurrentFPS());
-        Statistics()->AddInfoAverageFPS(CYFPSCounter::GetAverageFPS());
         break;
     case LOG_TYPE_WARN:
         Statistics()->AddWarnLine(1);
         Statistics()->AddWarnBytes(strMsg.size() + TEXT_BYTE_LEN);
-        Statistics()->AddWarnCurrentFPS(CYFPSCounter::GetCurrentFPS());
-        Statistics()->AddWarnAverageFPS(CYFPSCounter::GetAverageFPS());
         break;
     case LOG_TYPE_ERROR:
         Statistics()->AddErrorLine(1);
         Statistics()->AddErrorBytes(strMsg.size() + TEXT_BYTE_LEN);
-        Statistics()->AddErrorCurrentFPS(CYFPSCounter::GetCurrentFPS());
-        Statistics()->AddErrorAverageFPS(CYFPSCounter::GetAverageFPS());
         break;
     case LOG_TYPE_FATAL:
         Statistics()->AddFatalLine(1);
         Statistics()->AddFatalBytes(strMsg.size() + TEXT_BYTE_LEN);
-        Statistics()->AddFatalCurrentFPS(CYFPSCounter::GetCurrentFPS());
-        Statistics()->AddFatalAverageFPS(CYFPSCounter::GetAverageFPS());
         break;
     case LOG_TYPE_MAIN:
         Statistics()->AddMainLine(1);
         Statistics()->AddMainBytes(strMsg.size() + TEXT_BYTE_LEN);
-        Statistics()->AddMainCurrentFPS(CYFPSCounter::GetCurrentFPS());
-        Statistics()->AddMainAverageFPS(CYFPSCounter::GetAverageFPS());
         break;
     case LOG_TYPE_REMOTE:
         Statistics()->AddRemoteLine(1);
         Statistics()->AddRemoteBytes(strMsg.size() + TEXT_BYTE_LEN);
-        Statistics()->AddRemoteCurrentFPS(CYFPSCounter::GetCurrentFPS());
-        Statistics()->AddRemoteAverageFPS(CYFPSCounter::GetAverageFPS());
         break;
     case LOG_TYPE_SYS:
         Statistics()->AddSysLine(1);
         Statistics()->AddSysBytes(strMsg.size() + TEXT_BYTE_LEN);
-        Statistics()->AddSysCurrentFPS(CYFPSCounter::GetCurrentFPS());
-        Statistics()->AddSysAverageFPS(CYFPSCounter::GetAverageFPS());
         break;
     case LOG_TYPE_MAX:
         assert(0);
@@ -214,29 +199,83 @@ void CYLoggerFileAppender::Log(const TStringView& strMsg, int nTypeIndex, bool b
     if (this->m_eFileMode == ELogFileMode::LOG_MODE_FILE_TIME)
     {
         CYFileRestriction::AddFileSize(strMsg.length() + 1);
+        CYFileRestriction::AddFileLine(1);
         if (CYFileRestriction::IsCreateNewLog())
         {
-            ReOpenFile(CYFileRestriction::GetNewLogName(this->m_strFileName));
-            CYFileRestriction::ResetFileSize();
+            RotateFile();
         }
     }
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, closes the rotated file and prepares the standby file.
+*/
+void CYLoggerFileAppender::OnSchedule()
+{
+    m_objStandby.Process(LOG_FILE_STANDBY && ELogFileMode::LOG_MODE_FILE_TIME == m_eFileMode);
+}
 
-    CreateNewLogFile();
+/**
+* @brief Inherited from CYLoggerBaseAppender
+*/
+void CYLoggerFileAppender::GetReservedFiles(std::list<TString>& lstFile)
+{
+    m_objStandby.GetReservedFiles(lstFile);
 }
 
 /**
- * @brief Force new log file.
+* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
 */
-void CYLoggerFileAppender::ForceNewFile()
+void CYLoggerFileAppender::OnBatchDone()
 {
-    LockGuard locker(m_mutex);
-    std::promise<bool> objNewFilePromise;
-    m_objNewFilePromise.swap(objNewFilePromise);
-    m_objNewFileFuture = m_objNewFilePromise.get_future();
+    CheckRotateTime();
+}
 
-    m_bForceNewFile = true;
+/**
+* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
+*/
+void CYLoggerFileAppender::OnIdle()
+{
+    CheckRotateTime();
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender
+*/
+void CYLoggerFileAppender::SetRotation(const STRotationPolicy& objPolicy)
+{
+    CYFileRestriction::SetRotation(objPolicy);
+}
+
+/**
+ * @brief Swap in the standby file, or reopen inline when none is ready, and restart the limits.
+*/
+void CYLoggerFileAppender::RotateFile()
+{
+    // Both paths name the new file now, so it carries the rotation time.
+    if (!LOG_FILE_STANDBY || !m_objStandby.Swap(m_objLogFile, m_strFileName))
+    {
+        ReOpenFile(CYFileRestriction::GetNewLogName(this->m_strFileName));
+    }
+    CYFileRestriction::ResetFileSize();
+    m_objStandby.SetFileSize(CYFileRestriction::GetMaxSize());
+    CY_PROBE_ROTATE(this->GetId());
+
+    if constexpr (LOG_FILE_STANDBY)
+    {
+        CYLoggerSchedule::WakeUp();
+    }
+}
+
+/**
+ * @brief Rotate once the time boundary has passed.
+*/
+void CYLoggerFileAppender::CheckRotateTime()
+{
+    if (this->m_eFileMode != ELogFileMode::LOG_MODE_FILE_TIME || !CYFileRestriction::IsRotateTimeDue())
+        return;
 
-    m_objNewFileFuture.get();
+    RotateFile();
 }
 
 CYLOGGER_NAMESPACE_END
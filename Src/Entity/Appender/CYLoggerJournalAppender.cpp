@@ -0,0 +1,516 @@
+#include "Entity/Appender/CYLoggerJournalAppender.hpp"
+#include "Entity/Appender/CYLoggerAppenderDefine.hpp"
+#include "Statistics/CYStatistics.hpp"
+#include "Common/Exception/CYExceptionLogFile.hpp"
+#include "CYCommon/Common/Structure/CYStringUtils.hpp"
+
+#if defined(CYLOGGER_LINUX_OS)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#endif
+
+CYLOGGER_NAMESPACE_BEGIN
+
+namespace
+{
+    constexpr const char* JOURNAL_SCHEME = "journal";
+    constexpr const char* JOURNAL_PATH_PREFIX = "://";
+    constexpr const char* JOURNAL_DEFAULT_PATH = "/run/systemd/journal/socket";
+
+    /**
+     * @brief journald ignores fields longer than 64 characters.
+    */
+    constexpr size_t JOURNAL_FIELD_NAME_MAX = 64;
+
+    /**
+     * @brief Position after "@journal" in the name, npos when the name does not select the journal.
+    */
+    size_t FindJournalScheme(const std::string& strName)
+    {
+        const size_t nAt = strName.find('@');
+        if (nAt == std::string::npos || strName.compare(nAt + 1, strlen(JOURNAL_SCHEME), JOURNAL_SCHEME) != 0)
+            return std::string::npos;
+
+        const size_t nEnd = nAt + 1 + strlen(JOURNAL_SCHEME);
+        if (nEnd < strName.size() && strName[nEnd] != ':' && strName[nEnd] != '?')
+            return std::string::npos;
+        return nEnd;
+    }
+
+    /**
+     * @brief Field names are upper case letters, digits and '_', not starting with '_' or a digit.
+    */
+    bool IsValidFieldName(const std::string& strKey)
+    {
+        if (strKey.empty() || strKey.size() > JOURNAL_FIELD_NAME_MAX || strKey[0] == '_' || (strKey[0] >= '0' && strKey[0] <= '9'))
+            return false;
+        return std::all_of(strKey.begin(), strKey.end(), [](char c) { return (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'; });
+    }
+
+    /**
+     * @brief syslog(3) priority of the message type.
+    */
+    char GetPriority(int nMsgType)
+    {
+        switch (nMsgType)
+        {
+        case LOG_TYPE_TRACE: return '7';
+        case LOG_TYPE_DEBUG: return '7';
+        case LOG_TYPE_INFO:  return '6';
+        case LOG_TYPE_WARN:  return '4';
+        case LOG_TYPE_ERROR: return '3';
+        case LOG_TYPE_FATAL: return '2';
+        default:             return '6';
+        }
+    }
+
+    /**
+     * @brief syslog(3) priority of the level character of a formatted line.
+    */
+    char GetPriority(TChar cType)
+    {
+        switch (cType)
+        {
+        case 'T': return '7';
+        case 'D': return '7';
+        case 'I': return '6';
+        case 'W': return '4';
+        case 'E': return '3';
+        case 'F': return '2';
+        default:  return '6';
+        }
+    }
+
+    /**
+     * @brief UTF-8 view of the text, strTemp keeps the converted copy when TChar is wide.
+    */
+    std::string_view ToUtf8(const TStringView& strText, std::string& strTemp)
+    {
+#if CY_USE_UNICODE
+        strTemp = CYCOMMON_NAMESPACE::CYStringUtils::TString2String(TString(strText).c_str());
+        return strTemp;
+#else
+        (void)strTemp;
+        return std::string_view(strText.data(), strText.size());
+#endif
+    }
+
+#if defined(CYLOGGER_LINUX_OS)
+    /**
+     * @brief Socket address of the journal path.
+    */
+    bool MakeAddress(const std::string& strPath, sockaddr_un& objAddr)
+    {
+        memset(&objAddr, 0, sizeof(objAddr));
+        objAddr.sun_family = AF_UNIX;
+        if (strPath.empty() || strPath.size() >= sizeof(objAddr.sun_path))
+            return false;
+        memcpy(objAddr.sun_path, strPath.c_str(), strPath.size());
+        return true;
+    }
+#endif
+}
+
+CYLoggerJournalAppender::CYLoggerJournalAppender(const TString& strName) noexcept
+    : CYLoggerBaseAppender("SysThread")
+    , m_strPath(JOURNAL_DEFAULT_PATH)
+    , m_socket(-1)
+    , m_nDropLines(0)
+{
+    EXCEPTION_BEGIN
+    {
+        const std::string strFullName = CYCOMMON_NAMESPACE::CYStringUtils::TString2String(strName.c_str());
+        const size_t nEnd = FindJournalScheme(strFullName);
+        IfTrueThrow(nEnd == std::string::npos, TEXT("Journal appender name must be AppName@journal."));
+
+        std::string strRest = strFullName.substr(nEnd);
+        std::string strQuery;
+        const size_t nQuery = strRest.find('?');
+        if (nQuery != std::string::npos)
+        {
+            strQuery = strRest.substr(nQuery + 1);
+            strRest.erase(nQuery);
+        }
+        if (!strRest.empty())
+        {
+            IfTrueThrow(strRest.compare(0, strlen(JOURNAL_PATH_PREFIX), JOURNAL_PATH_PREFIX) != 0, TEXT("Journal appender path must follow journal://."));
+            m_strPath = strRest.substr(strlen(JOURNAL_PATH_PREFIX));
+        }
+
+        const std::string strIdentifier = strFullName.substr(0, strFullName.find('@'));
+        if (!strIdentifier.empty())
+        {
+            m_strStaticFields.append("SYSLOG_IDENTIFIER=").append(strIdentifier).push_back('\n');
+        }
+
+        // Extra fields are encoded once and appended to every entry.
+        size_t nStart = 0;
+        while (nStart < strQuery.size())
+        {
+            size_t nStop = strQuery.find('&', nStart);
+            if (nStop == std::string::npos)
+                nStop = strQuery.size();
+            const std::string strField = strQuery.substr(nStart, nStop - nStart);
+            const size_t nEqual = strField.find('=');
+            IfTrueThrow(nEqual == std::string::npos || !IsValidFieldName(strField.substr(0, nEqual)), TEXT("Journal appender field must be NAME=value with an upper case name."));
+            m_strStaticFields.append(strField).push_back('\n');
+            nStart = nStop + 1;
+        }
+
+        StartLogThread();
+    }
+    EXCEPTION_END
+}
+
+CYLoggerJournalAppender::~CYLoggerJournalAppender() noexcept
+{
+EXCEPTION_BEGIN
+{
+    StopLogThread();
+#if defined(CYLOGGER_LINUX_OS)
+    if (m_socket >= 0)
+    {
+        ::close(m_socket);
+        m_socket = -1;
+    }
+#endif
+}
+EXCEPTION_END
+}
+
+/**
+ * @brief Whether the system log name selects the journal, always false outside Linux.
+*/
+bool CYLoggerJournalAppender::IsJournalAddress(const TString& strName)
+{
+#if defined(CYLOGGER_LINUX_OS)
+    return FindJournalScheme(CYCOMMON_NAMESPACE::CYStringUtils::TString2String(strName.c_str())) != std::string::npos;
+#else
+    return false;
+#endif
+}
+
+/**
+* @return the unique id for this appender
+*/
+const ELogType CYLoggerJournalAppender::GetId() const
+{
+    return ELogType::LOG_TYPE_SYS;
+}
+
+/**
+* @brief Writes the layout formatted text as MESSAGE without code location.
+*/
+void CYLoggerJournalAppender::Log(const TStringView& strMsg, int nTypeIndex, bool bFlush)
+{
+#if defined(CYLOGGER_LINUX_OS)
+    std::string strTemp;
+    const size_t nOffset = m_strBatch.size();
+    const char szPriority[1] = { GetPriority(strMsg[nTypeIndex]) };
+    AppendField("MESSAGE", ToUtf8(strMsg, strTemp));
+    AppendField("PRIORITY", std::string_view(szPriority, 1));
+    EndEntry(nOffset);
+
+    if (bFlush || m_vecEntry.size() >= static_cast<size_t>(LOG_SYSLOG_BATCH_COUNT))
+    {
+        SendBatch();
+    }
+#endif
+
+    Statistics()->AddSysLine(1);
+    Statistics()->AddSysBytes(strMsg.size() + TEXT_BYTE_LEN);
+}
+
+/**
+* @brief Encode the message fields directly, the layout is never invoked.
+*/
+int CYLoggerJournalAppender::LogMessage(const SharePtr<CYLoggerMessage>& ptrMessage)
+{
+#if defined(CYLOGGER_LINUX_OS)
+    std::string strTemp;
+    const size_t nOffset = m_strBatch.size();
+    const char szPriority[1] = { GetPriority(ptrMessage->GetMsgType()) };
+    AppendField("MESSAGE", ToUtf8(ptrMessage->GetMsg(), strTemp));
+    AppendField("PRIORITY", std::string_view(szPriority, 1));
+    if (!ptrMessage->GetFile().empty())
+    {
+        AppendField("CODE_FILE", ToUtf8(ptrMessage->GetFile(), strTemp));
+        AppendField("CODE_LINE", std::to_string(ptrMessage->GetLine()));
+        AppendField("CODE_FUNC", ToUtf8(ptrMessage->GetFunction(), strTemp));
+    }
+    AppendField("TID", std::to_string(ptrMessage->GetThreadId()));
+    if (!ptrMessage->GetChannel().empty())
+    {
+        AppendField("CYLOGGER_CHANNEL", ToUtf8(ptrMessage->GetChannel(), strTemp));
+    }
+    AppendField("CYLOGGER_SERVER_CODE", std::to_string(ptrMessage->GetSeverCode()));
+    EndEntry(nOffset);
+
+    if (m_vecEntry.size() >= static_cast<size_t>(LOG_SYSLOG_BATCH_COUNT))
+    {
+        SendBatch();
+    }
+#endif
+
+    const int nBytes = static_cast<int>(ptrMessage->GetMsg().size() + TEXT_BYTE_LEN);
+    Statistics()->AddSysLine(1);
+    Statistics()->AddSysBytes(nBytes);
+
+    return nBytes;
+}
+
+/**
+* Get called after a drained batch has been passed to LogMessage, sends the batched entries
+*/
+void CYLoggerJournalAppender::OnBatchDone()
+{
+#if defined(CYLOGGER_LINUX_OS)
+    SendBatch();
+#endif
+}
+
+/**
+* Get called when this appender become active through attaching to a CYLLoggerImpl object, and it was not active before
+*/
+void CYLoggerJournalAppender::OnActivate()
+{
+#if defined(CYLOGGER_LINUX_OS)
+    OpenSocket(true);
+#endif
+}
+
+/**
+* Send the batched entries, only on the log thread
+*/
+void CYLoggerJournalAppender::Flush()
+{
+#if defined(CYLOGGER_LINUX_OS)
+    if (IsLogThread())
+    {
+        SendBatch();
+    }
+#endif
+}
+
+/**
+* Returns the bytes waiting to be sent
+*/
+int64_t CYLoggerJournalAppender::GetSize()
+{
+    return static_cast<int64_t>(m_strBatch.size());
+}
+
+/**
+* Attempt to physically copy data - nothing to copy for the journal
+*/
+void CYLoggerJournalAppender::Copy(const TString& strTarget)
+{
+
+}
+
+/**
+* Attempt to physically clear data - nothing to clear for the journal
+*/
+void CYLoggerJournalAppender::ClearContents()
+{
+
+}
+
+/**
+ * @brief Get log file name.
+*/
+const TString& CYLoggerJournalAppender::GetLogName()
+{
+    return m_strLogName;
+}
+
+#if defined(CYLOGGER_LINUX_OS)
+/**
+ * @brief Append "KEY=value\n", or the length prefixed binary form when the value contains a newline.
+*/
+void CYLoggerJournalAppender::AppendField(std::string_view strKey, std::string_view strValue)
+{
+    m_strBatch.append(strKey);
+    if (strValue.find('\n') == std::string_view::npos)
+    {
+        m_strBatch.push_back('=');
+        m_strBatch.append(strValue);
+        m_strBatch.push_back('\n');
+        return;
+    }
+
+    // KEY\n, the value size as 64 bit little endian, the value and \n.
+    m_strBatch.push_back('\n');
+    uint64_t nSize = strValue.size();
+    for (int i = 0; i < 8; ++i)
+    {
+        m_strBatch.push_back(static_cast<char>((nSize >> (i * 8)) & 0xFF));
+    }
+    m_strBatch.append(strValue);
+    m_strBatch.push_back('\n');
+}
+
+/**
+ * @brief Append the per appender fields and close the entry started at nOffset.
+*/
+void CYLoggerJournalAppender::EndEntry(size_t nOffset)
+{
+    m_strBatch.append(m_strStaticFields);
+    m_vecEntry.push_back({ nOffset, m_strBatch.size() - nOffset });
+}
+
+/**
+ * @brief Open the datagram socket, at most once per LOG_SYSLOG_RECONNECT unless bForce.
+*/
+bool CYLoggerJournalAppender::OpenSocket(bool bForce)
+{
+    if (m_socket >= 0)
+        return true;
+    if (!bForce && m_objRetryElapsed.Elapsed() < LOG_SYSLOG_RECONNECT)
+        return false;
+    m_objRetryElapsed.Reset();
+
+    m_socket = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (m_socket < 0)
+        return false;
+
+    // A large send buffer lets most entries go as datagrams, larger ones take the memfd path.
+    int nBufferSize = 8 * 1024 * 1024;
+    setsockopt(m_socket, SOL_SOCKET, SO_SNDBUF, &nBufferSize, sizeof(nBufferSize));
+    timeval objTimeout{ LOG_SYSLOG_SEND_TIMEOUT / 1000, (LOG_SYSLOG_SEND_TIMEOUT % 1000) * 1000 };
+    setsockopt(m_socket, SOL_SOCKET, SO_SNDTIMEO, &objTimeout, sizeof(objTimeout));
+    return true;
+}
+
+/**
+ * @brief Send the batched entries and clear the batch.
+*/
+void CYLoggerJournalAppender::SendBatch()
+{
+    if (m_vecEntry.empty())
+        return;
+
+    // A socket that could not be opened on activation (descriptor limit reached) is retried here, like the syslog
+    // appender reconnects, its entries are counted as dropped meanwhile.
+    sockaddr_un objAddr;
+    size_t nSent = 0;
+    if (OpenSocket(false) && MakeAddress(m_strPath, objAddr))
+    {
+        // One sendmmsg call per LOG_SYSLOG_BATCH_COUNT entries, each addressed to the journal socket.
+        mmsghdr arrayMsg[LOG_SYSLOG_BATCH_COUNT];
+        iovec arrayIov[LOG_SYSLOG_BATCH_COUNT];
+        while (nSent < m_vecEntry.size())
+        {
+            unsigned int nCount = static_cast<unsigned int>((std::min)(m_vecEntry.size() - nSent, static_cast<size_t>(LOG_SYSLOG_BATCH_COUNT)));
+            memset(arrayMsg, 0, sizeof(mmsghdr) * nCount);
+            for (unsigned int i = 0; i < nCount; ++i)
+            {
+                const STEntry& objEntry = m_vecEntry[nSent + i];
+                arrayIov[i].iov_base = m_strBatch.data() + objEntry.nOffset;
+                arrayIov[i].iov_len = objEntry.nLength;
+                arrayMsg[i].msg_hdr.msg_name = &objAddr;
+                arrayMsg[i].msg_hdr.msg_namelen = sizeof(objAddr);
+                arrayMsg[i].msg_hdr.msg_iov = &arrayIov[i];
+                arrayMsg[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            int nRet = sendmmsg(m_socket, arrayMsg, nCount, MSG_NOSIGNAL);
+            if (nRet > 0)
+            {
+                nSent += static_cast<size_t>(nRet);
+                continue;
+            }
+
+            const int nError = nRet < 0 ? errno : 0;
+            if (nError == EINTR)
+                continue;
+            if (nError != EMSGSIZE && nError != ENOBUFS)
+                break;
+
+            // Too large for a datagram, journald reads the entry from the passed memfd.
+            const STEntry& objEntry = m_vecEntry[nSent];
+            if (!SendMemfd(m_strBatch.data() + objEntry.nOffset, objEntry.nLength))
+            {
+                ++m_nDropLines;
+                AddDropLines(1);
+            }
+            ++nSent;
+        }
+    }
+
+    if (nSent > 0 && m_nDropLines > 0)
+    {
+        ExceptionLog((std::string("Journal appender dropped ") + std::to_string(m_nDropLines) + " entries while the journal socket was unavailable.").c_str());
+        m_nDropLines = 0;
+    }
+    m_nDropLines += m_vecEntry.size() - nSent;
+    AddDropLines(m_vecEntry.size() - nSent);
+    m_strBatch.clear();
+    m_vecEntry.clear();
+}
+
+/**
+ * @brief Send one entry through a sealed memfd, used when it does not fit a datagram.
+*/
+bool CYLoggerJournalAppender::SendMemfd(const char* pData, size_t nLength)
+{
+    sockaddr_un objAddr;
+    if (!MakeAddress(m_strPath, objAddr))
+        return false;
+
+    int nFd = memfd_create("cylogger-journal", MFD_ALLOW_SEALING | MFD_CLOEXEC);
+    if (nFd < 0)
+        return false;
+
+    size_t nWritten = 0;
+    while (nWritten < nLength)
+    {
+        ssize_t nRet = write(nFd, pData + nWritten, nLength - nWritten);
+        if (nRet < 0 && errno == EINTR)
+            continue;
+        if (nRet <= 0)
+        {
+            ::close(nFd);
+            return false;
+        }
+        nWritten += static_cast<size_t>(nRet);
+    }
+
+    // journald only accepts a memfd that can no longer change.
+    bool bSent = false;
+    if (fcntl(nFd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) == 0)
+    {
+        union
+        {
+            cmsghdr objHeader;
+            char arrayBuffer[CMSG_SPACE(sizeof(int))];
+        } objControl;
+        memset(&objControl, 0, sizeof(objControl));
+
+        msghdr objMsg;
+        memset(&objMsg, 0, sizeof(objMsg));
+        objMsg.msg_name = &objAddr;
+        objMsg.msg_namelen = sizeof(objAddr);
+        objMsg.msg_control = objControl.arrayBuffer;
+        objMsg.msg_controllen = sizeof(objControl.arrayBuffer);
+
+        cmsghdr* pHeader = CMSG_FIRSTHDR(&objMsg);
+        pHeader->cmsg_level = SOL_SOCKET;
+        pHeader->cmsg_type = SCM_RIGHTS;
+        pHeader->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(pHeader), &nFd, sizeof(int));
+        bSent = sendmsg(m_socket, &objMsg, MSG_NOSIGNAL) >= 0;
+    }
+    ::close(nFd);
+    return bSent;
+}
+#endif
+
+CYLOGGER_NAMESPACE_END
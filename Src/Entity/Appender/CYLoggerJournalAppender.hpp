@@ -0,0 +1,207 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LOGGER_JOURNAL_APPENDER_HPP__
+#define __CY_LOGGER_JOURNAL_APPENDER_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Entity/Appender/CYLoggerBaseAppender.hpp"
+#include "Common/Time/CYTimeElapsed.hpp"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief systemd-journald appender speaking the native journal protocol, selected by a LOG_TYPE_SYS name of
+ * "AppName@journal", "AppName@journal:///path/to/socket" or either followed by "?FIELD=value&FIELD2=value".
+ * Each entry carries MESSAGE, PRIORITY, CODE_FILE, CODE_LINE, CODE_FUNC, TID, SYSLOG_IDENTIFIER, CYLOGGER_CHANNEL,
+ * CYLOGGER_SERVER_CODE and the extra fields of the name. A drained batch is sent with sendmmsg, an entry too large
+ * for a datagram is written to a sealed memfd whose descriptor is passed instead.
+*/
+class CYLoggerJournalAppender : public CYLoggerBaseAppender
+{
+public:
+    CYLoggerJournalAppender(const TString& strName) noexcept;
+    virtual ~CYLoggerJournalAppender() noexcept;
+
+public:
+    /**
+     * @brief Whether the system log name selects the journal, always false outside Linux.
+    */
+    static bool IsJournalAddress(const TString& strName);
+
+    /**
+    * @return the unique id for this appender
+    */
+    virtual const ELogType GetId() const override;
+
+    /**
+    * @brief Writes the layout formatted text as MESSAGE without code location.
+    */
+    virtual void Log(const TStringView& strMsg, int nTypeIndex, bool bFlush) override;
+
+    /**
+    * @brief Encode the message fields directly, the layout is never invoked.
+    */
+    virtual int LogMessage(const SharePtr<CYLoggerMessage>& ptrMessage) override;
+
+    /**
+    * Get called after a drained batch has been passed to LogMessage, sends the batched entries
+    */
+    virtual void OnBatchDone() override;
+
+    /**
+    * Get called when this appender become active through attaching to a CYLLoggerImpl object, and it was not active before
+    */
+    virtual void OnActivate() override;
+
+    /**
+    * Send the batched entries, only on the log thread
+    */
+    virtual void Flush() override;
+
+    /**
+    * Returns the bytes waiting to be sent
+    */
+    virtual int64_t GetSize() override;
+
+    /**
+    * Attempt to physically copy data - nothing to copy for the journal
+    */
+    virtual void Copy(const TString& strTarget) override;
+
+    /**
+    * Attempt to physically clear data - nothing to clear for the journal
+    */
+    virtual void ClearContents() override;
+
+    /**
+     * @brief Get log file name.
+    */
+    virtual const TString& GetLogName() override;
+
+#if defined(CYLOGGER_LINUX_OS)
+protected:
+    /**
+     * @brief Append "KEY=value\n", or the length prefixed binary form when the value contains a newline.
+    */
+    void AppendField(std::string_view strKey, std::string_view strValue);
+
+    /**
+     * @brief Append the per appender fields and close the entry started at nOffset.
+    */
+    void EndEntry(size_t nOffset);
+
+    /**
+     * @brief Open the datagram socket, at most once per LOG_SYSLOG_RECONNECT unless bForce.
+    */
+    bool OpenSocket(bool bForce);
+
+    /**
+     * @brief Send the batched entries and clear the batch.
+    */
+    void SendBatch();
+
+    /**
+     * @brief Send one entry through a sealed memfd, used when it does not fit a datagram.
+    */
+    bool SendMemfd(const char* pData, size_t nLength);
+#endif
+
+private:
+    /**
+     * @brief One entry, a slice of the batch buffer.
+    */
+    struct STEntry
+    {
+        size_t nOffset;
+        size_t nLength;
+    };
+
+    /**
+     * @brief Path of the journal socket.
+    */
+    std::string m_strPath;
+
+    /**
+     * @brief SYSLOG_IDENTIFIER and the extra fields of the name, encoded once.
+    */
+    std::string m_strStaticFields;
+
+    /**
+     * @brief Entries of the current batch.
+    */
+    std::string m_strBatch;
+
+    /**
+     * @brief Entry slices of m_strBatch.
+    */
+    std::vector<STEntry> m_vecEntry;
+
+    /**
+     * @brief Unconnected datagram socket, each batch is addressed to m_strPath so a journald restart needs no reconnect.
+    */
+    int m_socket;
+
+    /**
+     * @brief Entries dropped because the journal socket was unreachable or full.
+    */
+    uint64_t m_nDropLines;
+
+    /**
+     * @brief Time since the last attempt to open the socket.
+    */
+    CYTimeElapsed m_objRetryElapsed;
+
+    /**
+     * @brief Log file name.
+    */
+    TString m_strLogName;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LOGGER_JOURNAL_APPENDER_HPP__
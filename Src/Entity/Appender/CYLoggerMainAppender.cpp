@@ -1,6 +1,8 @@
 #include "Entity/Appender/CYLoggerMainAppender.hpp"
 #include "Statistics/CYStatistics.hpp"
 #include "Common/CYFormatDefine.hpp"
+#include "Entity/Schedule/CYLoggerSchedule.hpp"
+#include "Common/CYTraceProbe.hpp"
 #if CYLOGGER_USE_CYCOROUTINE
 #include "CYCoroutine/CYCoroutine.hpp"
 #endif
@@ -10,7 +12,6 @@ CYLOGGER_NAMESPACE_BEGIN
 CYLoggerMainAppender::CYLoggerMainAppender(const TString& strFileName, ELogFileMode eFileMode, ELogType eLogType)
     : CYLoggerBufferAppender("MainThread")
     , CYFileRestriction()
-    , m_bForceNewFile(false)
 {
     this->m_eFileMode = eFileMode;
     IfTrueThrow(strFileName.length() == 0, TEXT("fileName cannot be empty"));
@@ -28,6 +29,13 @@ CYLoggerMainAppender::CYLoggerMainAppender(const TString& strFileName, ELogFileM
 CYLoggerMainAppender::~CYLoggerMainAppender()
 {
     StopLogThread();
+
+    // The last file may be a preallocated standby file.
+    if constexpr (LOG_FILE_STANDBY)
+    {
+        if (ELogFileMode::LOG_MODE_FILE_TIME == m_eFileMode)
+            CYFileStandby::Close(m_objLogFile, m_strFileName);
+    }
 }
 
 /**
@@ -55,19 +63,20 @@ void CYLoggerMainAppender::OpenFile(int flags)
 void CYLoggerMainAppender::ReOpenFile(const TString& strNewFile)
 {
     Flush();
+    // The current file may be a swapped in standby file, its reserved tail is given back when the schedule thread closes it.
+    m_objStandby.Retire(m_objLogFile, m_strFileName);
     this->m_strFileName = strNewFile;
     OnActivate();
 }
 
 /**
- * @brief Create New Log File.
+* @brief Inherited from CYLoggerBaseAppender, opens a new file or copies the append file aside.
 */
-void CYLoggerMainAppender::CreateNewLogFile()
+bool CYLoggerMainAppender::OnNewFile()
 {
-    if (!m_bForceNewFile)
-        return;
-
-    m_bForceNewFile = false;
+    // Nothing was written since the file was opened, it already is a new file.
+    if (m_objLogFile.is_open() && m_objLogFile.tellp() <= 0)
+        return true;
 
     TString strData = CYTimeStamps().GetTimeStr();
     TString strFileExt = CYPublicFunction::GetFileExt(this->m_strFileName);
@@ -87,10 +96,9 @@ void CYLoggerMainAppender::CreateNewLogFile()
         break;
     }
 
-    {
-        LockGuard locker(m_mutex);
-        m_objNewFilePromise.set_value(true);
-    }
+    CYFileRestriction::ResetFileSize();
+    CY_PROBE_ROTATE(this->GetId());
+    return true;
 }
 
 /**
@@ -98,7 +106,6 @@ void CYLoggerMainAppender::CreateNewLogFile()
 */
 void CYLoggerMainAppender::Log(const TStringView& strMsg, int nTypeIndex, bool bFlush)
 {
-    CYFPSCounter::UpdateCounter();
     m_objLogFile << strMsg << TEXT("\n");
     IfTrueThrow(m_objLogFile.fail(), TString(TEXT("operator<<() failed for file ")) += m_strFileName);
 
@@ -108,35 +115,86 @@ void CYLoggerMainAppender::Log(const TStringView& strMsg, int nTypeIndex, bool b
     Statistics()->AddMainLine(1);
     Statistics()->AddMainBytes(strMsg.size() + TEXT_BYTE_LEN);
 
-    Statistics()->AddMainCurrentFPS(CYFPSCounter::GetCurrentFPS());
-    Statistics()->AddMainAverageFPS(CYFPSCounter::GetAverageFPS());
-
     if (this->m_eFileMode == ELogFileMode::LOG_MODE_FILE_TIME)
     {
         CYFileRestriction::AddFileSize(strMsg.length() + 1);
+        CYFileRestriction::AddFileLine(1);
         if (CYFileRestriction::IsCreateNewLog())
         {
-            ReOpenFile(CYFileRestriction::GetNewLogName(this->m_strFileName));
-            CYFileRestriction::ResetFileSize();
+            RotateFile();
         }
     }
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, closes the rotated file and prepares the standby file.
+*/
+void CYLoggerMainAppender::OnSchedule()
+{
+    m_objStandby.Process(LOG_FILE_STANDBY && ELogFileMode::LOG_MODE_FILE_TIME == m_eFileMode);
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender
+*/
+void CYLoggerMainAppender::GetReservedFiles(std::list<TString>& lstFile)
+{
+    m_objStandby.GetReservedFiles(lstFile);
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
+*/
+void CYLoggerMainAppender::OnBatchDone()
+{
+    CheckRotateTime();
+}
 
-    CreateNewLogFile();
+/**
+* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
+*/
+void CYLoggerMainAppender::OnIdle()
+{
+    CheckRotateTime();
 }
 
 /**
- * @brief Force new log file.
+* @brief Inherited from CYLoggerBaseAppender
 */
-void CYLoggerMainAppender::ForceNewFile()
+void CYLoggerMainAppender::SetRotation(const STRotationPolicy& objPolicy)
 {
-    LockGuard locker(m_mutex);
-    std::promise<bool> objNewFilePromise;
-    m_objNewFilePromise.swap(objNewFilePromise);
-    m_objNewFileFuture = m_objNewFilePromise.get_future();
+    CYFileRestriction::SetRotation(objPolicy);
+}
 
-    m_bForceNewFile = true;
+/**
+ * @brief Swap in the standby file, or reopen inline when none is ready, and restart the limits.
+*/
+void CYLoggerMainAppender::RotateFile()
+{
+    // Both paths name the new file now, so it carries the rotation time.
+    if (!LOG_FILE_STANDBY || !m_objStandby.Swap(m_objLogFile, m_strFileName))
+    {
+        ReOpenFile(CYFileRestriction::GetNewLogName(this->m_strFileName));
+    }
+    CYFileRestriction::ResetFileSize();
+    m_objStandby.SetFileSize(CYFileRestriction::GetMaxSize());
+    CY_PROBE_ROTATE(this->GetId());
+
+    if constexpr (LOG_FILE_STANDBY)
+    {
+        CYLoggerSchedule::WakeUp();
+    }
+}
+
+/**
+ * @brief Rotate once the time boundary has passed.
+*/
+void CYLoggerMainAppender::CheckRotateTime()
+{
+    if (this->m_eFileMode != ELogFileMode::LOG_MODE_FILE_TIME || !CYFileRestriction::IsRotateTimeDue())
+        return;
 
-    m_objNewFileFuture.get();
+    RotateFile();
 }
 
 CYLOGGER_NAMESPACE_END
\ No newline at end of file
@@ -48,10 +48,10 @@
 #include "Entity/Appender/CYLoggerBufferAppender.hpp"
 #include "Common/CYPublicFunction.hpp"
 #include "Common/CYFileRestriction.hpp"
+#include "Common/CYFileStandby.hpp"
 #include "Common/Thread/CYNamedLocker.hpp"
 
 #include <map>
-#include <future>
 
 CYLOGGER_NAMESPACE_BEGIN
 
@@ -80,9 +80,11 @@ public:
 	*/
 	void OnActivate()
 	{
-		if (m_objLogFile) m_objLogFile.close();
+		CYFileStandby::Close(m_objLogFile, m_strFileName);
 		CYPublicFunction::CreateDirectory(m_strFileName);
 		OpenFile(ELogFileMode::LOG_MODE_FILE_APPEND == m_eFileMode ? TIos::out | TIos::app : TIos::out);
+		m_objStandby.SetFileName(m_strFileName);
+		m_objStandby.SetFileSize(CYFileRestriction::GetMaxSize());
 	}
 
 	/**
@@ -117,7 +119,7 @@ public:
 	*/
 	virtual void Copy(const TString& strTarget) override
 	{
-		if (m_objLogFile) m_objLogFile.close();
+		CYFileStandby::Close(m_objLogFile, m_strFileName);
 		CYPublicFunction::CopyFile(m_strFileName, strTarget, false, false);
 		OpenFile(TIos::out | TIos::app);
 	}
@@ -127,7 +129,7 @@ public:
 	*/
 	virtual void ClearContents() override
 	{
-		if (m_objLogFile) m_objLogFile.close();
+		CYFileStandby::Close(m_objLogFile, m_strFileName);
 		OpenFile(TIos::out);
 	}
 
@@ -140,9 +142,34 @@ public:
 	}
 
 	/**
-	 * @brief Force new log file.
+	* @brief Inherited from CYLoggerBaseAppender, opens a new file or copies the append file aside.
 	*/
-	virtual void ForceNewFile() override;
+	virtual bool OnNewFile() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, closes the rotated file and prepares the standby file.
+	*/
+	virtual void OnSchedule() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
+	*/
+	virtual void OnBatchDone() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, checks the time boundary of the rotation policy.
+	*/
+	virtual void OnIdle() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender
+	*/
+	virtual void SetRotation(const STRotationPolicy& objPolicy) override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender
+	*/
+	virtual void GetReservedFiles(std::list<TString>& lstFile) override;
 
 private:
 	/**
@@ -156,27 +183,25 @@ private:
 	void ReOpenFile(const TString& strNewFile);
 
 	/**
-	 * @brief Create New Log File.
+	 * @brief Swap in the standby file, or reopen inline when none is ready, and restart the limits.
 	*/
-	void CreateNewLogFile();
+	void RotateFile();
+
+	/**
+	 * @brief Rotate once the time boundary has passed.
+	*/
+	void CheckRotateTime();
 
 private:
 	ELogType m_eLogType;
 	TString m_strFileName;
 	TOfStream m_objLogFile;
 	ELogFileMode m_eFileMode;
-	CYNamedLocker m_mutex{TEXT("CYLoggerMainAppender")};
-	
-	/**
-	 * @brief Force new log file.
-	*/
-	std::atomic_bool m_bForceNewFile;
 
 	/**
-	 * @brief Promise.
+	 * @brief Standby file of the size rotation.
 	*/
-	std::promise<bool> m_objNewFilePromise;
-	std::future<bool>  m_objNewFileFuture;
+	CYFileStandby m_objStandby;
 };
 
 CYLOGGER_NAMESPACE_END
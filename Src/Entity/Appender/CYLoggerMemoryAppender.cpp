@@ -0,0 +1,150 @@
+#include "Entity/Appender/CYLoggerMemoryAppender.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+CYLoggerMemoryAppender::CYLoggerMemoryAppender(const TString& strLogName, ELogType eLogType, size_t nCapacity)
+    : CYLoggerNullAppender(strLogName, eLogType, false)
+    , m_vecRing(nCapacity)
+    , m_nHead(0)
+    , m_nLength(0)
+{
+    IfTrueThrow(nCapacity == 0, TEXT("nCapacity cannot be 0"));
+    StartLogThread();
+}
+
+CYLoggerMemoryAppender::~CYLoggerMemoryAppender()
+{
+    // The log thread touches the ring, stop it before the members go away.
+    StopLogThread();
+}
+
+/**
+* @brief Implementation of a pure virtual method from CYLoggerBaseAppender, collects the line for the ring.
+*/
+void CYLoggerMemoryAppender::Log(const TStringView& strMsg, int nTypeIndex, bool bFlush)
+{
+    CYLoggerNullAppender::Log(strMsg, nTypeIndex, bFlush);
+
+    m_strBatch.append(strMsg.data(), strMsg.size());
+    m_strBatch.push_back(TEXT('\n'));
+
+    if (bFlush)
+        Commit();
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, copies the batch into the ring.
+*/
+void CYLoggerMemoryAppender::OnBatchDone()
+{
+    Commit();
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, copies the batch into the ring when called on the log thread.
+*/
+void CYLoggerMemoryAppender::Flush()
+{
+    // The batch is owned by the log thread.
+    if (IsLogThread())
+    {
+        Commit();
+    }
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, bytes held by the ring.
+*/
+int64_t CYLoggerMemoryAppender::GetSize()
+{
+    LockGuard locker(m_mutexRing);
+    return static_cast<int64_t>(m_nLength * sizeof(TChar));
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, empties the ring.
+*/
+void CYLoggerMemoryAppender::ClearContents()
+{
+    LockGuard locker(m_mutexRing);
+    m_nHead = 0;
+    m_nLength = 0;
+}
+
+/**
+ * @brief Copy the lines of the ring oldest first and a terminating 0 when nSize is larger than their length, any thread.
+*/
+size_t CYLoggerMemoryAppender::ReadMemory(TChar* pszBuffer, size_t nSize, bool bClear)
+{
+    LockGuard locker(m_mutexRing);
+    const size_t nLength = m_nLength;
+    if (pszBuffer == nullptr || nSize <= nLength)
+        return nLength;
+
+    const size_t nFirst = (std::min)(nLength, m_vecRing.size() - m_nHead);
+    std::memcpy(pszBuffer, m_vecRing.data() + m_nHead, nFirst * sizeof(TChar));
+    std::memcpy(pszBuffer + nFirst, m_vecRing.data(), (nLength - nFirst) * sizeof(TChar));
+    pszBuffer[nLength] = TEXT('\0');
+
+    if (bClear)
+    {
+        m_nHead = 0;
+        m_nLength = 0;
+    }
+    return nLength;
+}
+
+/**
+ * @brief Copy the collected batch into the ring, log thread.
+*/
+void CYLoggerMemoryAppender::Commit()
+{
+    if (m_strBatch.empty())
+        return;
+
+    const size_t nCapacity = m_vecRing.size();
+    const TChar* pData = m_strBatch.data();
+    size_t nSize = m_strBatch.size();
+    if (nSize > nCapacity)
+    {
+        // Only the newest whole lines of a batch larger than the ring are kept.
+        const TChar* pEnd = std::find(pData + (nSize - nCapacity - 1), pData + nSize, TEXT('\n'));
+        const size_t nSkip = (pEnd == pData + nSize) ? nSize : static_cast<size_t>(pEnd - pData) + 1;
+        pData += nSkip;
+        nSize -= nSkip;
+    }
+
+    {
+        LockGuard locker(m_mutexRing);
+        if (m_nLength + nSize > nCapacity)
+            Evict(m_nLength + nSize - nCapacity);
+
+        const size_t nTail = (m_nHead + m_nLength) % nCapacity;
+        const size_t nFirst = (std::min)(nSize, nCapacity - nTail);
+        std::memcpy(m_vecRing.data() + nTail, pData, nFirst * sizeof(TChar));
+        std::memcpy(m_vecRing.data(), pData + nFirst, (nSize - nFirst) * sizeof(TChar));
+        m_nLength += nSize;
+    }
+    m_strBatch.clear();
+}
+
+/**
+ * @brief Drop at least nSize characters of the oldest whole lines, m_mutexRing is held.
+*/
+void CYLoggerMemoryAppender::Evict(size_t nSize)
+{
+    const size_t nCapacity = m_vecRing.size();
+    size_t nDrop = (std::min)(nSize, m_nLength);
+    while (nDrop < m_nLength && m_vecRing[(m_nHead + nDrop - 1) % nCapacity] != TEXT('\n'))
+    {
+        ++nDrop;
+    }
+
+    m_nHead = (m_nHead + nDrop) % nCapacity;
+    m_nLength -= nDrop;
+}
+
+CYLOGGER_NAMESPACE_END
@@ -0,0 +1,125 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LOGGER_MEMORY_APPENDER_HPP__
+#define __CY_LOGGER_MEMORY_APPENDER_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Entity/Appender/CYLoggerNullAppender.hpp"
+#include "Common/Thread/CYNamedLocker.hpp"
+
+#include <vector>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Sink of LOG_MODE_FILE_MEMORY: the formatted lines of a batch are collected on the log thread and copied into a
+ *        bounded ring once per batch, where the oldest whole lines make room for new ones. Any thread reads them back.
+*/
+class CYLoggerMemoryAppender : public CYLoggerNullAppender
+{
+public:
+	CYLoggerMemoryAppender(const TString& strLogName, ELogType eLogType, size_t nCapacity = LOG_MEMORY_SINK_SIZE);
+	virtual ~CYLoggerMemoryAppender();
+
+public:
+	/**
+	* @brief Implementation of a pure virtual method from CYLoggerBaseAppender, collects the line for the ring.
+	*/
+	virtual void Log(const TStringView& strMsg, int nTypeIndex, bool bFlush) override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, copies the batch into the ring.
+	*/
+	virtual void OnBatchDone() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, copies the batch into the ring when called on the log thread.
+	*/
+	virtual void Flush() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, bytes held by the ring.
+	*/
+	virtual int64_t GetSize() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, empties the ring.
+	*/
+	virtual void ClearContents() override;
+
+	/**
+	 * @brief Copy the lines of the ring oldest first and a terminating 0 when nSize is larger than their length, any thread.
+	 * @return length of the lines in the ring, in characters.
+	*/
+	virtual size_t ReadMemory(TChar* pszBuffer, size_t nSize, bool bClear) override;
+
+private:
+	/**
+	 * @brief Copy the collected batch into the ring, log thread.
+	*/
+	void Commit();
+
+	/**
+	 * @brief Drop at least nSize characters of the oldest whole lines, m_mutexRing is held.
+	*/
+	void Evict(size_t nSize);
+
+private:
+	/**
+	 * @brief Lines of the current batch, owned by the log thread.
+	*/
+	TString m_strBatch;
+
+	/**
+	 * @brief Ring of lines, each ended by '\n'.
+	*/
+	CYNamedLocker m_mutexRing{ TEXT("CYLoggerMemoryAppender") };
+	std::vector<TChar> m_vecRing;
+	size_t m_nHead;
+	size_t m_nLength;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LOGGER_MEMORY_APPENDER_HPP__
@@ -0,0 +1,119 @@
+#include "Entity/Appender/CYLoggerNullAppender.hpp"
+#include "Entity/Appender/CYLoggerAppenderDefine.hpp"
+
+CYLOGGER_NAMESPACE_BEGIN
+
+CYLoggerNullAppender::CYLoggerNullAppender(const TString& strLogName, ELogType eLogType)
+    : CYLoggerNullAppender(strLogName, eLogType, true)
+{
+}
+
+CYLoggerNullAppender::CYLoggerNullAppender(const TString& strLogName, ELogType eLogType, bool bStart)
+    : CYLoggerBaseAppender("CYLoggerNullAppender")
+    , m_eLogType(eLogType)
+    , m_strLogName(strLogName)
+{
+    switch (m_eLogType)
+    {
+    case LOG_TYPE_TRACE:
+        SetThreadName("TraceThread");
+        break;
+    case LOG_TYPE_DEBUG:
+        SetThreadName("DebugThread");
+        break;
+    case LOG_TYPE_INFO:
+        SetThreadName("InfoThread");
+        break;
+    case LOG_TYPE_WARN:
+        SetThreadName("WarnThread");
+        break;
+    case LOG_TYPE_ERROR:
+        SetThreadName("ErrorThread");
+        break;
+    case LOG_TYPE_FATAL:
+        SetThreadName("FatalThread");
+        break;
+    case LOG_TYPE_MAIN:
+        SetThreadName("MainThread");
+        break;
+    case LOG_TYPE_REMOTE:
+        SetThreadName("RemoteThread");
+        break;
+    case LOG_TYPE_SYS:
+        SetThreadName("SysThread");
+        break;
+    default:
+        IfTrueThrow(true, TEXT("eLogType not supported by the null appender"));
+        break;
+    }
+
+    if (bStart)
+        StartLogThread();
+}
+
+CYLoggerNullAppender::~CYLoggerNullAppender()
+{
+    StopLogThread();
+}
+
+/**
+* @brief Implementation of a pure virtual method from CYLoggerBaseAppender
+*/
+const ELogType CYLoggerNullAppender::GetId() const
+{
+    return m_eLogType;
+}
+
+/**
+* @brief Implementation of a pure virtual method from CYLoggerBaseAppender, counts the line.
+*/
+void CYLoggerNullAppender::Log(const TStringView& strMsg, int nTypeIndex, bool bFlush)
+{
+    AddLineStats(strMsg.size() + TEXT_BYTE_LEN);
+}
+
+/**
+* @brief Implementation of a pure virtual method from CYLoggerBaseAppender
+*/
+void CYLoggerNullAppender::OnActivate()
+{
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender
+*/
+void CYLoggerNullAppender::Flush()
+{
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender
+*/
+int64_t CYLoggerNullAppender::GetSize()
+{
+    return 0;
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, nothing to copy
+*/
+void CYLoggerNullAppender::Copy(const TString& strTarget)
+{
+}
+
+/**
+* @brief Inherited from CYLoggerBaseAppender, nothing to clear
+*/
+void CYLoggerNullAppender::ClearContents()
+{
+}
+
+/**
+ * @brief Get log file name.
+*/
+const TString& CYLoggerNullAppender::GetLogName()
+{
+    return m_strLogName;
+}
+
+CYLOGGER_NAMESPACE_END
@@ -0,0 +1,116 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LOGGER_NULL_APPENDER_HPP__
+#define __CY_LOGGER_NULL_APPENDER_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Entity/Appender/CYLoggerBaseAppender.hpp"
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Sink of LOG_MODE_FILE_NULL: messages are queued, drained and formatted like in any other appender, then
+ *        counted and thrown away, so the cost of the pipeline can be measured without I/O.
+*/
+class CYLoggerNullAppender : public CYLoggerBaseAppender
+{
+public:
+	CYLoggerNullAppender(const TString& strLogName, ELogType eLogType);
+	virtual ~CYLoggerNullAppender();
+
+public:
+	/**
+	* @brief Implementation of a pure virtual method from CYLoggerBaseAppender
+	*/
+	virtual const ELogType GetId() const override;
+
+	/**
+	* @brief Implementation of a pure virtual method from CYLoggerBaseAppender, counts the line.
+	*/
+	virtual void Log(const TStringView& strMsg, int nTypeIndex, bool bFlush) override;
+
+	/**
+	* @brief Implementation of a pure virtual method from CYLoggerBaseAppender
+	*/
+	virtual void OnActivate() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender
+	*/
+	virtual void Flush() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender
+	*/
+	virtual int64_t GetSize() override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, nothing to copy
+	*/
+	virtual void Copy(const TString& strTarget) override;
+
+	/**
+	* @brief Inherited from CYLoggerBaseAppender, nothing to clear
+	*/
+	virtual void ClearContents() override;
+
+	/**
+	 * @brief Get log file name.
+	*/
+	virtual const TString& GetLogName() override;
+
+protected:
+	/**
+	 * @brief Constructor of a derived sink, which starts the log thread once its own members are constructed.
+	*/
+	CYLoggerNullAppender(const TString& strLogName, ELogType eLogType, bool bStart);
+
+private:
+	ELogType m_eLogType;
+	TString m_strLogName;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LOGGER_NULL_APPENDER_HPP__
@@ -8,27 +8,84 @@
 
 #ifdef CYLOGGER_WIN_OS
 #include <winsock2.h>
+#include <ws2tcpip.h>
 #else
 #include <netdb.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <sys/uio.h>
+#include <unistd.h>
 #endif
 
 #include <locale>
 #include <codecvt>
 #include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <string>
 
 CYLOGGER_NAMESPACE_BEGIN
 
+namespace
+{
+#if CY_USE_UNICODE
+    /**
+     * @brief Append the text as UTF-8, straight into the batch so a line is not copied through a temporary string.
+    */
+    void AppendUtf8(const TStringView& strText, std::string& strOut)
+    {
+        for (size_t i = 0; i < strText.size(); ++i)
+        {
+            uint32_t nCode = static_cast<uint32_t>(strText[i]);
+            if constexpr (sizeof(TChar) == 2)
+            {
+                if (nCode >= 0xD800 && nCode <= 0xDBFF && i + 1 < strText.size())
+                {
+                    uint32_t nLow = static_cast<uint32_t>(strText[i + 1]);
+                    if (nLow >= 0xDC00 && nLow <= 0xDFFF)
+                    {
+                        nCode = 0x10000 + ((nCode - 0xD800) << 10) + (nLow - 0xDC00);
+                        ++i;
+                    }
+                }
+            }
+
+            if (nCode < 0x80)
+            {
+                strOut.push_back(static_cast<char>(nCode));
+            }
+            else if (nCode < 0x800)
+            {
+                strOut.push_back(static_cast<char>(0xC0 | (nCode >> 6)));
+                strOut.push_back(static_cast<char>(0x80 | (nCode & 0x3F)));
+            }
+            else if (nCode < 0x10000)
+            {
+                strOut.push_back(static_cast<char>(0xE0 | (nCode >> 12)));
+                strOut.push_back(static_cast<char>(0x80 | ((nCode >> 6) & 0x3F)));
+                strOut.push_back(static_cast<char>(0x80 | (nCode & 0x3F)));
+            }
+            else
+            {
+                strOut.push_back(static_cast<char>(0xF0 | (nCode >> 18)));
+                strOut.push_back(static_cast<char>(0x80 | ((nCode >> 12) & 0x3F)));
+                strOut.push_back(static_cast<char>(0x80 | ((nCode >> 6) & 0x3F)));
+                strOut.push_back(static_cast<char>(0x80 | (nCode & 0x3F)));
+            }
+        }
+    }
+#endif
+}
+
 CYLoggerRemoteAppender::CYLoggerRemoteAppender(const TString& strHost) noexcept
     : CYLoggerBufferAppender("RemoteThread")
+    , m_nPort(0)
     , m_bSocketInit(false)
-    , m_ipAddr(0)
 #ifdef CYLOGGER_WIN_OS
     , m_socket(INVALID_SOCKET)
 #else
-    , m_socket(0)
+    , m_socket(-1)
 #endif
 {
     EXCEPTION_BEGIN
@@ -77,14 +134,30 @@ const ELogType CYLoggerRemoteAppender::GetId() const
 */
 void CYLoggerRemoteAppender::Log(const TStringView& strMsg, int nTypeIndex, bool bFlush)
 {
-    CYFPSCounter::UpdateCounter();
     Statistics()->AddRemoteLine(1);
     Statistics()->AddRemoteBytes(strMsg.size() + TEXT_BYTE_LEN);
 
-    Statistics()->AddRemoteCurrentFPS(CYFPSCounter::GetCurrentFPS());
-    Statistics()->AddRemoteAverageFPS(CYFPSCounter::GetAverageFPS());
+    size_t nOffset = m_strBatch.size();
+#if CY_USE_UNICODE
+    AppendUtf8(strMsg, m_strBatch);
+#else
+    m_strBatch.append(strMsg.data(), strMsg.size());
+#endif
+    m_strBatch.push_back('\n');
+    PackLine(nOffset);
+
+    if (bFlush || m_vecDatagram.size() >= static_cast<size_t>(LOG_REMOTE_BATCH_COUNT))
+    {
+        SendBatch();
+    }
+}
 
-    WriteSocket(CYCOMMON_NAMESPACE::CYStringUtils::TString2String(strMsg.data()));
+/**
+* Get called after a drained batch has been passed to LogMessage, sends the packed datagrams
+*/
+void CYLoggerRemoteAppender::OnBatchDone()
+{
+    SendBatch();
 }
 
 /**
@@ -100,7 +173,11 @@ void CYLoggerRemoteAppender::OnActivate()
 */
 void CYLoggerRemoteAppender::Flush()
 {
-
+    // The batch is sent at the end of every drained batch, only the log thread touches it.
+    if (IsLogThread())
+    {
+        SendBatch();
+    }
 }
 
 /**
@@ -137,14 +214,6 @@ const TString& CYLoggerRemoteAppender::GetLogName()
     return m_strLogName;
 }
 
-/**
- * @brief Force new log file.
-*/
-void CYLoggerRemoteAppender::ForceNewFile()
-{
-
-}
-
 /**
  * @brief Open Socket.
 */
@@ -152,51 +221,41 @@ void CYLoggerRemoteAppender::OpenSocket()
 {
     IfTrueThrow(m_strHost.empty(), TEXT("Remote appender host cannot empty."));
     IfTrueThrow(m_nPort == 0, TEXT("Remote appender port is zero."));
-    if (!m_ipAddr)
-    {
-        struct hostent* pHostent = gethostbyname(m_strHost.c_str());
 #ifdef CYLOGGER_WIN_OS
-        if (pHostent == nullptr)
-        {
-            if (WSAGetLastError() == WSANOTINITIALISED)
-            {
-                WSADATA wsaData;
-                int err = WSAStartup(0x101, &wsaData);
-                if (err)
-                {
-                    return;
-                }
-                pHostent = gethostbyname(m_strHost.c_str());
-                m_bSocketInit = true;
-            }
-            else
-            {
-                return;
-            }
-        }
-#endif
-        if (pHostent == nullptr)
+    if (!m_bSocketInit)
+    {
+        WSADATA wsaData;
+        if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
         {
-            in_addr_t ip = inet_addr(m_strHost.c_str());
-            pHostent = gethostbyaddr((const char*)&ip, sizeof(in_addr_t), AF_INET);
-            if (pHostent == nullptr)
-            {
-                return;
-            }
+            return;
         }
-        m_ipAddr = *(in_addr_t*)(pHostent->h_addr);
+        m_bSocketInit = true;
     }
-    // Get a datagram socket.
-    m_socket = socket(AF_INET, SOCK_DGRAM, 0);
-    if
-#ifdef CYLOGGER_WIN_OS
-    (m_socket == INVALID_SOCKET)
-#else
-        (m_socket < 0)
 #endif
+
+    // getaddrinfo takes host names, IPv4 and IPv6 literals alike, the first address a datagram socket opens for is kept.
+    addrinfo objHints;
+    memset(&objHints, 0, sizeof(objHints));
+    objHints.ai_family = AF_UNSPEC;
+    objHints.ai_socktype = SOCK_DGRAM;
+    objHints.ai_flags = AI_NUMERICSERV;
+    addrinfo* pResult = nullptr;
+    const std::string strPort = std::to_string(m_nPort);
+    if (getaddrinfo(m_strHost.c_str(), strPort.c_str(), &objHints, &pResult) != 0)
     {
         return;
     }
+
+    for (addrinfo* pInfo = pResult; pInfo != nullptr; pInfo = pInfo->ai_next)
+    {
+        m_socket = socket(pInfo->ai_family, pInfo->ai_socktype, pInfo->ai_protocol);
+        if (IsSocketValid())
+        {
+            m_strAddress.assign(reinterpret_cast<const char*>(pInfo->ai_addr), static_cast<size_t>(pInfo->ai_addrlen));
+            break;
+        }
+    }
+    freeaddrinfo(pResult);
 }
 
 /**
@@ -204,64 +263,144 @@ void CYLoggerRemoteAppender::OpenSocket()
 */
 void CYLoggerRemoteAppender::CloseSocket()
 {
-    if (m_socket)
+    if (IsSocketValid())
     {
 #ifdef CYLOGGER_WIN_OS
         closesocket(m_socket);
+        m_socket = INVALID_SOCKET;
 #else
         ::close(m_socket);
+        m_socket = -1;
 #endif
-        m_socket = 0;
     }
 }
 
 /**
- * @brief Write Socket.
+ * @brief Is the socket opened.
 */
-void CYLoggerRemoteAppender::WriteSocket(std::string strMsg)
+bool CYLoggerRemoteAppender::IsSocketValid() const
 {
-    if
 #ifdef CYLOGGER_WIN_OS
-    (m_socket == INVALID_SOCKET)
+    return m_socket != INVALID_SOCKET;
 #else
-        (m_socket < 0)
+    return m_socket >= 0;
 #endif
+}
+
+/**
+ * @brief Pack one line into the batch, lines share a datagram up to LOG_REMOTE_MTU bytes.
+*/
+void CYLoggerRemoteAppender::PackLine(size_t nOffset)
+{
+    size_t nSize = m_strBatch.size() - nOffset;
+
+    // The batch is contiguous, so a line that fits is added to the open datagram by growing its slice.
+    if (!m_vecDatagram.empty() && m_vecDatagram.back().nLength + nSize <= static_cast<size_t>(LOG_REMOTE_MTU))
     {
+        m_vecDatagram.back().nLength += nSize;
+        ++m_vecDatagram.back().nLines;
         return;
     }
 
-    size_t nMsgLen = strMsg.length();
-    m_buffer.resize(nMsgLen);
-    memcpy(&m_buffer[0], strMsg.data(), nMsgLen);
+    // Lines longer than the MTU are cut into MTU sized slices, the line is counted on its last slice.
+    while (nSize > 0)
+    {
+        size_t nSlice = (std::min)(nSize, static_cast<size_t>(LOG_REMOTE_MTU));
+        nSize -= nSlice;
+        m_vecDatagram.push_back({ nOffset, nSlice, nSize == 0 ? 1u : 0u });
+        nOffset += nSlice;
+    }
+}
 
-    sockaddr_in sain;
-    sain.sin_family = AF_INET;
-    sain.sin_port = htons(m_nPort);
-    sain.sin_addr.s_addr = m_ipAddr;
+/**
+ * @brief Count the lines of the datagrams [nBegin, nEnd) as dropped.
+*/
+void CYLoggerRemoteAppender::DropDatagrams(size_t nBegin, size_t nEnd)
+{
+    uint64_t nLines = 0;
+    for (size_t i = nBegin; i < nEnd; ++i)
+    {
+        nLines += m_vecDatagram[i].nLines;
+    }
+    if (nLines > 0)
+    {
+        AddDropLines(nLines);
+    }
+}
 
-    while (nMsgLen > 0)
+/**
+ * @brief Send the packed datagrams and clear the batch.
+*/
+void CYLoggerRemoteAppender::SendBatch()
+{
+    if (m_vecDatagram.empty())
+        return;
+
+    if (!IsSocketValid())
     {
-        if (nMsgLen > 900)
+        DropDatagrams(0, m_vecDatagram.size());
+    }
+    else
+    {
+        const sockaddr* pAddr = reinterpret_cast<const sockaddr*>(m_strAddress.data());
+        const socklen_t nAddrLen = static_cast<socklen_t>(m_strAddress.size());
+
+#if defined(CYLOGGER_LINUX_OS) || defined(CYLOGGER_ANDROID_OS)
+        // One sendmmsg call per LOG_REMOTE_BATCH_COUNT datagrams, each iovec points into the batch buffer.
+        mmsghdr arrayMsg[LOG_REMOTE_BATCH_COUNT];
+        iovec arrayIov[LOG_REMOTE_BATCH_COUNT];
+        size_t nSent = 0;
+        bool bFailed = false;
+        while (nSent < m_vecDatagram.size())
         {
-            sendto(m_socket, &m_buffer[0], 900, 0, (struct sockaddr*)&sain, sizeof(sain));
-            nMsgLen -= 900;
-            std::memmove(&m_buffer[0], &m_buffer[900], nMsgLen);
+            unsigned int nCount = static_cast<unsigned int>((std::min)(m_vecDatagram.size() - nSent, static_cast<size_t>(LOG_REMOTE_BATCH_COUNT)));
+            memset(arrayMsg, 0, sizeof(mmsghdr) * nCount);
+            for (unsigned int i = 0; i < nCount; ++i)
+            {
+                const STDatagram& objDatagram = m_vecDatagram[nSent + i];
+                arrayIov[i].iov_base = m_strBatch.data() + objDatagram.nOffset;
+                arrayIov[i].iov_len = objDatagram.nLength;
+                arrayMsg[i].msg_hdr.msg_name = const_cast<sockaddr*>(pAddr);
+                arrayMsg[i].msg_hdr.msg_namelen = nAddrLen;
+                arrayMsg[i].msg_hdr.msg_iov = &arrayIov[i];
+                arrayMsg[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            int nRet = sendmmsg(m_socket, arrayMsg, nCount, 0);
+            if (nRet < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                // The datagram at nSent failed (ENOBUFS, unreachable network), it is dropped and
+                // the rest retried once, a second failure in a row drops the remainder of the batch.
+                if (bFailed)
+                {
+                    DropDatagrams(nSent, m_vecDatagram.size());
+                    break;
+                }
+                DropDatagrams(nSent, nSent + 1);
+                ++nSent;
+                bFailed = true;
+                continue;
+            }
+            nSent += static_cast<size_t>(nRet);
+            bFailed = false;
         }
-        else
+#else
+        for (size_t i = 0; i < m_vecDatagram.size(); ++i)
         {
-            sendto(m_socket, &m_buffer[0], static_cast<int>(nMsgLen), 0, (struct sockaddr*)&sain, sizeof(sain));
-            break;
+            const STDatagram& objDatagram = m_vecDatagram[i];
+            if (sendto(m_socket, m_strBatch.data() + objDatagram.nOffset, static_cast<int>(objDatagram.nLength), 0, pAddr, nAddrLen) < 0)
+            {
+                DropDatagrams(i, i + 1);
+            }
         }
+#endif
     }
-}
 
-/**
- * @brief ReOpen Socket.
-*/
-void CYLoggerRemoteAppender::ReOpenSocket()
-{
-    OpenSocket();
-    CloseSocket();
+    m_strBatch.clear();
+    m_vecDatagram.clear();
 }
 
 CYLOGGER_NAMESPACE_END
\ No newline at end of file
@@ -48,6 +48,7 @@
 #include "Entity/Appender/CYLoggerAppenderDefine.hpp"
 
 #include <map>
+#include <vector>
 
 CYLOGGER_NAMESPACE_BEGIN
 
@@ -70,6 +71,11 @@ public:
 	*/
 	virtual void Log(const TStringView& strMsg, int nTypeIndex, bool bFlush) override;
 
+	/**
+	* Get called after a drained batch has been passed to LogMessage, sends the packed datagrams
+	*/
+	virtual void OnBatchDone() override;
+
 	/**
 	* Get called when this appender become active through attaching to a CYLLoggerImpl object, and it was not active before
 	*/
@@ -102,11 +108,6 @@ public:
 	*/
 	virtual const TString& GetLogName() override;
 
-	/**
-	 * @brief Force new log file.
-	*/
-	virtual void ForceNewFile() override;
-
 protected:
 	/**
 	 * @brief Open Socket.
@@ -119,20 +120,45 @@ protected:
 	void CloseSocket();
 
 	/**
-	 * @brief ReOpen Socket.
+	 * @brief Pack the line appended to the batch at nOffset, lines share a datagram up to LOG_REMOTE_MTU bytes.
+	*/
+	void PackLine(size_t nOffset);
+
+	/**
+	 * @brief Count the lines of the datagrams [nBegin, nEnd) as dropped.
 	*/
-	void ReOpenSocket();
+	void DropDatagrams(size_t nBegin, size_t nEnd);
 
 	/**
-	 * @brief Write Socket.
+	 * @brief Send the packed datagrams and clear the batch.
 	*/
-	void WriteSocket(std::string strMsg);
+	void SendBatch();
+
+	/**
+	 * @brief Is the socket opened.
+	*/
+	bool IsSocketValid() const;
 
 private:
 	/**
-	 * @brief message buffer.
+	 * @brief One datagram, a slice of the batch buffer.
+	*/
+	struct STDatagram
+	{
+		size_t nOffset;
+		size_t nLength;
+		uint32_t nLines;	///< Lines that end in this datagram.
+	};
+
+	/**
+	 * @brief Lines of the current batch, each terminated by '\n'.
+	*/
+	std::string m_strBatch;
+
+	/**
+	 * @brief Datagram slices of m_strBatch.
 	*/
-	std::vector<char> m_buffer;
+	std::vector<STDatagram> m_vecDatagram;
 
     /**
      * @brief host.
@@ -145,9 +171,9 @@ private:
     int m_nPort;
 
     /**
-     * @brief Remote IP.
+     * @brief Resolved remote address, raw sockaddr bytes from getaddrinfo.
     */
-    in_addr_t m_ipAddr;
+    std::string m_strAddress;
 
     /**
      * @brief Is Socket Init.
@@ -0,0 +1,630 @@
+#include "Src/Entity/Appender/CYLoggerStreamAppender.hpp"
+#include "Src/Statistics/CYStatistics.hpp"
+#include "Src/Config/CYLoggerConfig.hpp"
+#include "Src/Common/CYPathConvert.hpp"
+#include "Src/Common/Exception/CYExceptionLogFile.hpp"
+#include "CYCommon/Common/Structure/CYStringUtils.hpp"
+#if CYLOGGER_USE_CYCOROUTINE
+#include "CYCoroutine/CYCoroutine.hpp"
+#endif
+
+#ifdef CYLOGGER_WIN_OS
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+#include <string>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+namespace
+{
+    constexpr const char* STREAM_TCP_PREFIX = "tcp://";
+    constexpr const char* STREAM_UNIX_PREFIX = "unix://";
+    constexpr const TChar* STREAM_SPILL_NAME = TEXT("Remote");
+
+    /**
+     * @brief Last socket error of the calling thread.
+    */
+    int GetSocketError()
+    {
+#ifdef CYLOGGER_WIN_OS
+        return WSAGetLastError();
+#else
+        return errno;
+#endif
+    }
+
+    /**
+     * @brief Whether the error means the operation would block or is still in progress.
+    */
+    bool IsWouldBlock(int nError)
+    {
+#ifdef CYLOGGER_WIN_OS
+        return nError == WSAEWOULDBLOCK || nError == WSAEINPROGRESS;
+#else
+        return nError == EAGAIN || nError == EWOULDBLOCK || nError == EINPROGRESS || nError == EINTR;
+#endif
+    }
+}
+
+CYLoggerStreamAppender::CYLoggerStreamAppender(const TString& strAddress) noexcept
+    : CYLoggerBufferAppender("RemoteThread")
+    , m_nAddressCursor(0)
+#ifdef CYLOGGER_WIN_OS
+    , m_socket(INVALID_SOCKET)
+#else
+    , m_socket(-1)
+#endif
+    , m_bConnecting(false)
+    , m_bStalled(false)
+    , m_nHead(0)
+    , m_nSent(0)
+    , m_nDropLines(0)
+    , m_nBackoff(0)
+{
+    EXCEPTION_BEGIN
+    {
+        std::string strUrl = CYCOMMON_NAMESPACE::CYStringUtils::TString2String(strAddress.c_str());
+        if (strUrl.compare(0, strlen(STREAM_UNIX_PREFIX), STREAM_UNIX_PREFIX) == 0)
+        {
+            m_strPath = strUrl.substr(strlen(STREAM_UNIX_PREFIX));
+#ifdef CYLOGGER_WIN_OS
+            IfTrueThrow(true, TEXT("Unix domain sockets are not supported by the remote appender on Windows."));
+#else
+            IfTrueThrow(m_strPath.empty() || m_strPath.size() >= sizeof(sockaddr_un::sun_path), TEXT("Remote appender unix socket path is empty or too long."));
+#endif
+        }
+        else
+        {
+            m_strHost = strUrl.substr(strlen(STREAM_TCP_PREFIX));
+            size_t index = m_strHost.rfind(':');
+            IfTrueThrow(index == std::string::npos, TEXT("Remote appender tcp address has no port."));
+            m_strPort = m_strHost.substr(index + 1);
+            m_strHost = m_strHost.substr(0, index);
+            IfTrueThrow(m_strHost.empty() || atoi(m_strPort.c_str()) == 0, TEXT("Remote appender tcp host is empty or port is zero."));
+        }
+
+#ifdef CYLOGGER_WIN_OS
+        WSADATA wsaData;
+        WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+        StartLogThread();
+    }
+    EXCEPTION_END
+}
+
+CYLoggerStreamAppender::~CYLoggerStreamAppender() noexcept
+{
+EXCEPTION_BEGIN
+{
+    StopLogThread();
+    Disconnect();
+#ifdef CYLOGGER_WIN_OS
+    WSACleanup();
+#endif
+}
+EXCEPTION_END
+}
+
+/**
+ * @brief Whether the remote address selects a stream transport.
+*/
+bool CYLoggerStreamAppender::IsStreamAddress(const TString& strAddress)
+{
+    std::string strUrl = CYCOMMON_NAMESPACE::CYStringUtils::TString2String(strAddress.c_str());
+    return strUrl.compare(0, strlen(STREAM_TCP_PREFIX), STREAM_TCP_PREFIX) == 0
+        || strUrl.compare(0, strlen(STREAM_UNIX_PREFIX), STREAM_UNIX_PREFIX) == 0;
+}
+
+/**
+* @return the unique id for this appender
+*/
+const ELogType CYLoggerStreamAppender::GetId() const
+{
+    return ELogType::LOG_TYPE_REMOTE;
+}
+
+/**
+* Outputs message on the physical device
+* @param msg message to output
+* @bFlush if true flushing may be done right after the output. It's for concrete implementation to respect this parameter
+*/
+void CYLoggerStreamAppender::Log(const TStringView& strMsg, int nTypeIndex, bool bFlush)
+{
+    Statistics()->AddRemoteLine(1);
+    Statistics()->AddRemoteBytes(strMsg.size() + TEXT_BYTE_LEN);
+
+#if CY_USE_UNICODE
+    const std::string strUtf8 = CYCOMMON_NAMESPACE::CYStringUtils::TString2String(TString(strMsg).c_str());
+    AppendFrame(strUtf8.data(), strUtf8.size());
+#else
+    AppendFrame(strMsg.data(), strMsg.size());
+#endif
+
+    if (bFlush)
+    {
+        Pump();
+    }
+}
+
+/**
+* Get called after a drained batch has been passed to LogMessage, sends the pending frames
+*/
+void CYLoggerStreamAppender::OnBatchDone()
+{
+    m_bStalled = false;
+    Pump();
+    if (m_ptrSpill)
+    {
+        m_ptrSpill->Flush();
+    }
+}
+
+/**
+* Get called when a wake up drained nothing, retries the connection and the pending frames
+*/
+void CYLoggerStreamAppender::OnIdle()
+{
+    if (m_nHead < m_strPending.size() || (m_ptrSpill && !m_ptrSpill->IsEmpty()) || m_bConnecting || !IsSocketValid())
+    {
+        Pump();
+    }
+}
+
+/**
+* Get called when this appender become active through attaching to a CYLLoggerImpl object, and it was not active before
+*/
+void CYLoggerStreamAppender::OnActivate()
+{
+    if (LOG_REMOTE_SPILL_SIZE > 0)
+    {
+        EXCEPTION_BEGIN
+        {
+            m_ptrSpill = MakeShared<CYSpillQueue>(CYPathConvert::ConvertFilePath(TEXT(""), LoggerConfig()->GetLogPath().c_str(), LOG_SPILL_DIR), STREAM_SPILL_NAME, LOG_REMOTE_SPILL_SIZE, LOG_REMOTE_SPILL_SEGMENT);
+            m_ptrSpill->Open();
+        }
+        EXCEPTION_END
+    }
+    Pump();
+}
+
+/**
+* Send the pending frames, waits up to LOG_REMOTE_FLUSH_TIMEOUT for a slow collector
+*/
+void CYLoggerStreamAppender::Flush()
+{
+    // The pending buffer and the socket belong to the log thread, it flushes when it stops.
+    if (!IsLogThread())
+        return;
+
+    CYTimeElapsed objElapsed;
+    Pump();
+    while (m_nHead < m_strPending.size() && objElapsed.Elapsed() < LOG_REMOTE_FLUSH_TIMEOUT)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        Pump();
+    }
+
+    if (m_ptrSpill)
+    {
+        // On stop the unsent frames go before the spilled ones, the next run replays them first.
+        if (!IsRunning() && m_nHead < m_strPending.size())
+        {
+            Disconnect();
+            if (m_ptrSpill->PushFront(m_strPending.data() + m_nHead, m_strPending.size() - m_nHead))
+            {
+                m_strPending.clear();
+                m_nSent = m_nHead = 0;
+            }
+        }
+        m_ptrSpill->Flush();
+    }
+}
+
+/**
+* Returns the bytes waiting to be sent
+*/
+int64_t CYLoggerStreamAppender::GetSize()
+{
+    return static_cast<int64_t>(m_strPending.size() - m_nHead + (m_ptrSpill ? m_ptrSpill->GetSize() : 0));
+}
+
+/**
+* Attempt to physically copy data - nothing to copy for a remote appender
+*/
+void CYLoggerStreamAppender::Copy(const TString& strTarget)
+{
+
+}
+
+/**
+* Attempt to physically clear data - nothing to clear for a remote appender
+*/
+void CYLoggerStreamAppender::ClearContents()
+{
+
+}
+
+/**
+ * @brief Get log file name.
+*/
+const TString& CYLoggerStreamAppender::GetLogName()
+{
+    return m_strLogName;
+}
+
+/**
+ * @brief Append one frame to the pending buffer or the spill queue, the line is dropped when both are full.
+*/
+void CYLoggerStreamAppender::AppendFrame(const char* pData, size_t nLength)
+{
+    const size_t nFrameSize = LOG_STREAM_FRAME_HEADER_SIZE + nLength;
+    const uint32_t nFrameLength = static_cast<uint32_t>(nLength);
+    const char arrayHeader[LOG_STREAM_FRAME_HEADER_SIZE] = {
+        static_cast<char>((nFrameLength >> 24) & 0xFF),
+        static_cast<char>((nFrameLength >> 16) & 0xFF),
+        static_cast<char>((nFrameLength >> 8) & 0xFF),
+        static_cast<char>(nFrameLength & 0xFF)
+    };
+
+    const bool bFull = m_strPending.size() - m_nHead + nFrameSize > static_cast<size_t>(LOG_REMOTE_RETRY_BUFFER);
+    if (m_ptrSpill && (bFull || !m_ptrSpill->IsEmpty()))
+    {
+        // Once spilling, later frames queue behind the spilled ones until Refill has drained the segments.
+        m_strSpillFrame.assign(arrayHeader, LOG_STREAM_FRAME_HEADER_SIZE);
+        m_strSpillFrame.append(pData, nLength);
+        if (m_ptrSpill->Push(m_strSpillFrame.data(), m_strSpillFrame.size()))
+            return;
+        if (!m_ptrSpill->IsEmpty())
+        {
+            ++m_nDropLines;
+            AddDropLines(1);
+            return;
+        }
+    }
+
+    if (bFull)
+    {
+        // A connected but slow collector gets one bounded wait per batch, an unreachable one none.
+        if (m_bStalled || !WaitForRoom(nFrameSize))
+        {
+            m_bStalled = true;
+            ++m_nDropLines;
+            AddDropLines(1);
+            return;
+        }
+    }
+
+    m_strPending.append(arrayHeader, LOG_STREAM_FRAME_HEADER_SIZE);
+    m_strPending.append(pData, nLength);
+}
+
+/**
+ * @brief Move spilled frames to the pending buffer while it is less than half full.
+*/
+void CYLoggerStreamAppender::Refill()
+{
+    const size_t nHalf = static_cast<size_t>(LOG_REMOTE_RETRY_BUFFER) / 2;
+    while (m_ptrSpill && !m_ptrSpill->IsEmpty() && IsSocketValid() && !m_bConnecting && m_strPending.size() - m_nHead < nHalf)
+    {
+        if (m_ptrSpill->Pop(m_strPending, nHalf) == 0)
+            break;
+        SendPending();
+    }
+}
+
+/**
+ * @brief Send on a connected socket until nFrameSize bytes fit the pending buffer, waits up to LOG_REMOTE_FLUSH_TIMEOUT.
+*/
+bool CYLoggerStreamAppender::WaitForRoom(size_t nFrameSize)
+{
+    CYTimeElapsed objElapsed;
+    while (m_strPending.size() - m_nHead + nFrameSize > static_cast<size_t>(LOG_REMOTE_RETRY_BUFFER))
+    {
+        const int64_t nRemain = LOG_REMOTE_FLUSH_TIMEOUT - objElapsed.Elapsed();
+        if (!IsSocketValid() || m_bConnecting || nRemain <= 0)
+            return false;
+
+#ifdef CYLOGGER_WIN_OS
+        WSAPOLLFD objPoll{ m_socket, POLLOUT, 0 };
+        WSAPoll(&objPoll, 1, static_cast<INT>(nRemain));
+#else
+        pollfd objPoll{ m_socket, POLLOUT, 0 };
+        poll(&objPoll, 1, static_cast<int>(nRemain));
+#endif
+        SendPending();
+    }
+    return true;
+}
+
+/**
+ * @brief Connect if needed and send as much of the pending buffer as the socket takes.
+*/
+void CYLoggerStreamAppender::Pump()
+{
+    if (!IsSocketValid() || m_bConnecting)
+    {
+        if (!Connect())
+            return;
+    }
+    SendPending();
+    Refill();
+}
+
+/**
+ * @brief Start or complete a non-blocking connect, true once connected.
+*/
+bool CYLoggerStreamAppender::Connect()
+{
+    if (!m_bConnecting)
+    {
+        if (m_objResolve.valid())
+        {
+            // The resolve is polled without waiting, a slow DNS server never holds up the log thread.
+            if (m_objResolve.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                return false;
+            m_vecAddress = m_objResolve.get();
+            m_nAddressCursor = 0;
+            if (m_vecAddress.empty())
+                return false;
+        }
+        else if (m_nAddressCursor == 0 || m_nAddressCursor >= m_vecAddress.size())
+        {
+            // The backoff applies per round, the remaining addresses of a round are tried without waiting.
+            if (m_objRetryElapsed.Elapsed() < m_nBackoff)
+                return false;
+            m_nBackoff = m_nBackoff == 0 ? LOG_REMOTE_RECONNECT_MIN : (std::min)(m_nBackoff * 2, LOG_REMOTE_RECONNECT_MAX);
+
+            // The addresses are cached and only resolved again once every one of them failed, which also picks up a
+            // changed DNS record. getaddrinfo runs on its own thread, the result is picked up by a later call.
+            if (m_strPath.empty() && m_nAddressCursor >= m_vecAddress.size())
+            {
+                m_vecAddress.clear();
+                m_nAddressCursor = 0;
+                m_objResolve = std::async(std::launch::async, &CYLoggerStreamAppender::Resolve, m_strHost, m_strPort);
+                return false;
+            }
+        }
+        m_objRetryElapsed.Reset();
+
+        int nRet = -1;
+#ifndef CYLOGGER_WIN_OS
+        if (!m_strPath.empty())
+        {
+            sockaddr_un objAddr;
+            memset(&objAddr, 0, sizeof(objAddr));
+            objAddr.sun_family = AF_UNIX;
+            memcpy(objAddr.sun_path, m_strPath.c_str(), m_strPath.size());
+
+            m_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (!IsSocketValid())
+                return false;
+            fcntl(m_socket, F_SETFL, fcntl(m_socket, F_GETFL, 0) | O_NONBLOCK);
+            nRet = connect(m_socket, (struct sockaddr*)&objAddr, sizeof(objAddr));
+        }
+        else
+#endif
+        {
+            const std::string& strAddr = m_vecAddress[m_nAddressCursor];
+            sockaddr_storage objAddr;
+            memcpy(&objAddr, strAddr.data(), (std::min)(strAddr.size(), sizeof(objAddr)));
+            m_socket = socket(objAddr.ss_family, SOCK_STREAM, IPPROTO_TCP);
+            if (!IsSocketValid())
+            {
+                ++m_nAddressCursor;
+                return false;
+            }
+#ifdef CYLOGGER_WIN_OS
+            u_long nNonBlocking = 1;
+            ioctlsocket(m_socket, FIONBIO, &nNonBlocking);
+#else
+            fcntl(m_socket, F_SETFL, fcntl(m_socket, F_GETFL, 0) | O_NONBLOCK);
+#endif
+            int nNoDelay = 1;
+            setsockopt(m_socket, IPPROTO_TCP, TCP_NODELAY, (const char*)&nNoDelay, sizeof(nNoDelay));
+            nRet = connect(m_socket, (struct sockaddr*)&objAddr, static_cast<int>(strAddr.size()));
+        }
+
+#if defined(CYLOGGER_MAC_OS) || defined(CYLOGGER_IOS_OS)
+        int nNoSigPipe = 1;
+        setsockopt(m_socket, SOL_SOCKET, SO_NOSIGPIPE, &nNoSigPipe, sizeof(nNoSigPipe));
+#endif
+
+        if (nRet != 0)
+        {
+            if (!IsWouldBlock(GetSocketError()))
+            {
+                Disconnect();
+                ++m_nAddressCursor;
+                return false;
+            }
+            m_bConnecting = true;
+        }
+    }
+
+    if (m_bConnecting)
+    {
+        // Completion is polled without waiting, a slow connect never holds up the log thread. An address that does not
+        // answer within LOG_REMOTE_CONNECT_TIMEOUT gives way to the next one.
+#ifdef CYLOGGER_WIN_OS
+        WSAPOLLFD objPoll{ m_socket, POLLOUT, 0 };
+        if (WSAPoll(&objPoll, 1, 0) <= 0)
+#else
+        pollfd objPoll{ m_socket, POLLOUT, 0 };
+        if (poll(&objPoll, 1, 0) <= 0)
+#endif
+        {
+            if (m_objRetryElapsed.Elapsed() >= LOG_REMOTE_CONNECT_TIMEOUT)
+            {
+                Disconnect();
+                ++m_nAddressCursor;
+            }
+            return false;
+        }
+        int nError = 0;
+        socklen_t nLength = sizeof(nError);
+        getsockopt(m_socket, SOL_SOCKET, SO_ERROR, (char*)&nError, &nLength);
+        if (nError != 0)
+        {
+            Disconnect();
+            ++m_nAddressCursor;
+            return false;
+        }
+        m_bConnecting = false;
+    }
+
+    m_nBackoff = 0;
+    if (m_nDropLines > 0)
+    {
+        ExceptionLog((std::string("Remote appender dropped ") + std::to_string(m_nDropLines) + " lines while the collector was unreachable.").c_str());
+        m_nDropLines = 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Resolve the TCP host, raw sockaddr bytes in getaddrinfo order, empty if nothing resolved. Runs off the log thread.
+*/
+std::vector<std::string> CYLoggerStreamAppender::Resolve(const std::string& strHost, const std::string& strPort)
+{
+    std::vector<std::string> vecAddress;
+    addrinfo objHints;
+    memset(&objHints, 0, sizeof(objHints));
+    objHints.ai_family = AF_UNSPEC;
+    objHints.ai_socktype = SOCK_STREAM;
+    addrinfo* pResult = nullptr;
+    if (getaddrinfo(strHost.c_str(), strPort.c_str(), &objHints, &pResult) != 0)
+        return vecAddress;
+
+    for (addrinfo* pInfo = pResult; pInfo != nullptr; pInfo = pInfo->ai_next)
+    {
+        vecAddress.emplace_back(reinterpret_cast<const char*>(pInfo->ai_addr), static_cast<size_t>(pInfo->ai_addrlen));
+    }
+    freeaddrinfo(pResult);
+    return vecAddress;
+}
+
+/**
+ * @brief Offset just past the frame that starts at nOffset of the pending buffer.
+*/
+size_t CYLoggerStreamAppender::GetFrameEnd(size_t nOffset) const
+{
+    const unsigned char* pHeader = reinterpret_cast<const unsigned char*>(m_strPending.data() + nOffset);
+    return nOffset + LOG_STREAM_FRAME_HEADER_SIZE
+        + ((static_cast<size_t>(pHeader[0]) << 24) | (static_cast<size_t>(pHeader[1]) << 16) | (static_cast<size_t>(pHeader[2]) << 8) | pHeader[3]);
+}
+
+/**
+ * @brief Send pending bytes until the socket would block.
+*/
+void CYLoggerStreamAppender::SendPending()
+{
+    while (m_nSent < m_strPending.size())
+    {
+        const size_t nLength = m_strPending.size() - m_nSent;
+#ifdef CYLOGGER_WIN_OS
+        int nRet = send(m_socket, m_strPending.data() + m_nSent, static_cast<int>(nLength), 0);
+#elif defined(CYLOGGER_LINUX_OS) || defined(CYLOGGER_ANDROID_OS)
+        ssize_t nRet = send(m_socket, m_strPending.data() + m_nSent, nLength, MSG_NOSIGNAL);
+#else
+        ssize_t nRet = send(m_socket, m_strPending.data() + m_nSent, nLength, 0);
+#endif
+        if (nRet > 0)
+        {
+            m_nSent += static_cast<size_t>(nRet);
+            continue;
+        }
+        if (nRet < 0 && IsWouldBlock(GetSocketError()))
+            break;
+
+        Disconnect();
+        return;
+    }
+    ReleaseSent();
+}
+
+/**
+ * @brief Release the completely sent frames and compact the pending buffer.
+*/
+void CYLoggerStreamAppender::ReleaseSent()
+{
+    while (m_nHead + LOG_STREAM_FRAME_HEADER_SIZE <= m_nSent)
+    {
+        const size_t nFrameEnd = GetFrameEnd(m_nHead);
+        if (nFrameEnd > m_nSent)
+            break;
+        m_nHead = nFrameEnd;
+    }
+
+    if (m_nHead == m_strPending.size())
+    {
+        m_strPending.clear();
+        m_nSent = m_nHead = 0;
+    }
+    else if (m_nHead >= m_strPending.size() / 2)
+    {
+        // Compact once the released prefix is the larger half, each byte is moved at most once on average.
+        m_strPending.erase(0, m_nHead);
+        m_nSent -= m_nHead;
+        m_nHead = 0;
+    }
+}
+
+/**
+ * @brief Close the socket, a partially sent frame is dropped so the next connection starts on a frame boundary.
+*/
+void CYLoggerStreamAppender::Disconnect()
+{
+    if (IsSocketValid())
+    {
+#ifdef CYLOGGER_WIN_OS
+        closesocket(m_socket);
+        m_socket = INVALID_SOCKET;
+#else
+        ::close(m_socket);
+        m_socket = -1;
+#endif
+    }
+    m_bConnecting = false;
+
+    // The collector has seen the head of the frame at m_nHead on the old connection, resuming its tail on a new one
+    // would break the framing and resending it whole could deliver the line twice, so it is dropped and counted.
+    ReleaseSent();
+    if (m_nSent > m_nHead)
+    {
+        m_nSent = m_nHead = GetFrameEnd(m_nHead);
+        ++m_nDropLines;
+        AddDropLines(1);
+        ReleaseSent();
+    }
+    m_nSent = m_nHead;
+}
+
+/**
+ * @brief Is the socket opened.
+*/
+bool CYLoggerStreamAppender::IsSocketValid() const
+{
+#ifdef CYLOGGER_WIN_OS
+    return m_socket != INVALID_SOCKET;
+#else
+    return m_socket >= 0;
+#endif
+}
+
+CYLOGGER_NAMESPACE_END
@@ -0,0 +1,283 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LOGGER_STREAM_APPENDER_HPP__
+#define __CY_LOGGER_STREAM_APPENDER_HPP__
+
+#include "Entity/Appender/CYLoggerBufferAppender.hpp"
+#include "Entity/Appender/CYLoggerAppenderDefine.hpp"
+#include "Common/Time/CYTimeElapsed.hpp"
+#include "Common/Spill/CYSpillQueue.hpp"
+
+#include <string>
+#include <vector>
+#include <future>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Remote appender over a stream socket, the address is "tcp://host:port" or "unix:///path/to/socket".
+ * Lines are sent as length prefixed frames from a non-blocking socket. While the collector is unreachable the frames
+ * are kept in a bounded pending buffer and the connection is retried with exponential backoff on the log thread.
+ * Frames overflowing the pending buffer are spilled to segment files under <LogPath>/Spill/ and replayed in order after
+ * the pending buffer, frames still unsent when the appender stops are kept there for the next run.
+*/
+class CYLoggerStreamAppender : public CYLoggerBufferAppender
+{
+public:
+    CYLoggerStreamAppender(const TString& strAddress) noexcept;
+    virtual ~CYLoggerStreamAppender() noexcept;
+
+public:
+    /**
+     * @brief Whether the remote address selects a stream transport.
+    */
+    static bool IsStreamAddress(const TString& strAddress);
+
+    /**
+    * @return the unique id for this appender
+    */
+    virtual const ELogType GetId() const override;
+
+    /**
+    * Outputs message on the physical device
+    * @param msg message to output
+    * @bFlush if true flushing may be done right after the output. It's for concrete implementation to respect this parameter
+    */
+    virtual void Log(const TStringView& strMsg, int nTypeIndex, bool bFlush) override;
+
+    /**
+    * Get called after a drained batch has been passed to LogMessage, sends the pending frames
+    */
+    virtual void OnBatchDone() override;
+
+    /**
+    * Get called when a wake up drained nothing, retries the connection and the pending frames
+    */
+    virtual void OnIdle() override;
+
+    /**
+    * Get called when this appender become active through attaching to a CYLLoggerImpl object, and it was not active before
+    */
+    virtual void OnActivate() override;
+
+    /**
+    * Send the pending frames, waits up to LOG_REMOTE_FLUSH_TIMEOUT for a slow collector
+    */
+    virtual void Flush() override;
+
+    /**
+    * Returns the bytes waiting to be sent
+    */
+    virtual int64_t GetSize() override;
+
+    /**
+    * Attempt to physically copy data - nothing to copy for a remote appender
+    */
+    virtual void Copy(const TString& strTarget) override;
+
+    /**
+    * Attempt to physically clear data - nothing to clear for a remote appender
+    */
+    virtual void ClearContents() override;
+
+    /**
+     * @brief Get log file name.
+    */
+    virtual const TString& GetLogName() override;
+
+protected:
+    /**
+     * @brief Append one frame to the pending buffer, the line is dropped when the buffer is full.
+    */
+    void AppendFrame(const char* pData, size_t nLength);
+
+    /**
+     * @brief Move spilled frames to the pending buffer while it is less than half full.
+    */
+    void Refill();
+
+    /**
+     * @brief Send on a connected socket until nFrameSize bytes fit the pending buffer, waits up to LOG_REMOTE_FLUSH_TIMEOUT.
+    */
+    bool WaitForRoom(size_t nFrameSize);
+
+    /**
+     * @brief Connect if needed and send as much of the pending buffer as the socket takes.
+    */
+    void Pump();
+
+    /**
+     * @brief Start or complete a non-blocking connect, true once connected.
+    */
+    bool Connect();
+
+    /**
+     * @brief Resolve the TCP host, raw sockaddr bytes in getaddrinfo order, empty if nothing resolved. Runs off the log thread.
+    */
+    static std::vector<std::string> Resolve(const std::string& strHost, const std::string& strPort);
+
+    /**
+     * @brief Offset just past the frame that starts at nOffset of the pending buffer.
+    */
+    size_t GetFrameEnd(size_t nOffset) const;
+
+    /**
+     * @brief Release the completely sent frames and compact the pending buffer.
+    */
+    void ReleaseSent();
+
+    /**
+     * @brief Send pending bytes until the socket would block.
+    */
+    void SendPending();
+
+    /**
+     * @brief Close the socket, a partially sent frame is dropped so the next connection starts on a frame boundary.
+    */
+    void Disconnect();
+
+    /**
+     * @brief Is the socket opened.
+    */
+    bool IsSocketValid() const;
+
+private:
+    /**
+     * @brief Unix domain socket path, empty for TCP.
+    */
+    std::string m_strPath;
+
+    /**
+     * @brief TCP host.
+    */
+    std::string m_strHost;
+
+    /**
+     * @brief TCP port.
+    */
+    std::string m_strPort;
+
+    /**
+     * @brief Resolved addresses of the TCP host, raw sockaddr bytes in getaddrinfo order.
+    */
+    std::vector<std::string> m_vecAddress;
+
+    /**
+     * @brief Address tried by the current or next connect attempt, the list is resolved again once it reaches the end.
+    */
+    size_t m_nAddressCursor;
+
+    /**
+     * @brief Resolve in flight, polled by Connect so getaddrinfo never blocks the log thread.
+    */
+    std::future<std::vector<std::string>> m_objResolve;
+
+    /**
+     * @brief socket handle.
+    */
+#ifdef	CYLOGGER_WIN_OS
+    SOCKET	m_socket;
+#else
+    int		m_socket;
+#endif
+
+    /**
+     * @brief A non-blocking connect is in progress.
+    */
+    bool m_bConnecting;
+
+    /**
+     * @brief The pending buffer stayed full during this batch, further lines of the batch are dropped without waiting.
+    */
+    bool m_bStalled;
+
+    /**
+     * @brief Framed lines, [m_nHead, size) is not yet acknowledged by a complete send.
+    */
+    std::string m_strPending;
+
+    /**
+     * @brief Offset of the first frame not completely sent.
+    */
+    size_t m_nHead;
+
+    /**
+     * @brief Offset of the first byte not sent on the current connection.
+    */
+    size_t m_nSent;
+
+    /**
+     * @brief Frames overflowing the pending buffer, null until activated or when LOG_REMOTE_SPILL_SIZE is 0.
+    */
+    SharePtr<CYSpillQueue> m_ptrSpill;
+
+    /**
+     * @brief Scratch buffer of the frame being spilled.
+    */
+    std::string m_strSpillFrame;
+
+    /**
+     * @brief Lines dropped because the pending buffer and the spill budget were full.
+    */
+    uint64_t m_nDropLines;
+
+    /**
+     * @brief Current reconnect delay in milliseconds, 0 after a successful connect.
+    */
+    int m_nBackoff;
+
+    /**
+     * @brief Time since the last connect attempt.
+    */
+    CYTimeElapsed m_objRetryElapsed;
+
+    /**
+     * @brief Log file name.
+    */
+    TString m_strLogName;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LOGGER_STREAM_APPENDER_HPP__
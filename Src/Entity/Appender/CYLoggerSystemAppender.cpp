@@ -1,49 +1,95 @@
 #include "Entity/Appender/CYLoggerSystemAppender.hpp"
 #include "Entity/Appender/CYLoggerAppenderDefine.hpp"
 #include "Statistics/CYStatistics.hpp"
+#include "Common/Message/CYLoggerMessage.hpp"
+#include "Common/Time/CYTimeFormat.hpp"
+#include "Common/Exception/CYExceptionLogFile.hpp"
+#include "CYCommon/Common/Structure/CYStringUtils.hpp"
 
 #if defined(CYLOGGER_LINUX_OS) || defined(CYLOGGER_MAC_OS)
 #include <syslog.h>
 #endif
 
+#if defined(CYLOGGER_LINUX_OS)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cstring>
+#include <cerrno>
+#include <ctime>
+#include <algorithm>
+#endif
+
 CYLOGGER_NAMESPACE_BEGIN
 
 namespace
 {
-#if defined(CYLOGGER_WIN_OS)
-	void WriteToEventLog(const TString& strName, LPCTSTR message, WORD eventType)
-	{
-		HANDLE hEventLog = RegisterEventSource(NULL, strName.c_str());
+#if defined(CYLOGGER_LINUX_OS)
+	constexpr const char* SYSLOG_DEFAULT_PATH = "/dev/log";
 
-		if (hEventLog != NULL)
-		{
-			LPCTSTR strings[2] = { message, NULL };
-
-			ReportEvent(hEventLog, eventType, 0, 0, NULL, 1, 0, strings, NULL);
+	/**
+	 * @brief RFC 5424 limits APP-NAME to 48 printable characters.
+	*/
+	constexpr size_t SYSLOG_APP_NAME_MAX = 48;
+#endif
 
-			DeregisterEventSource(hEventLog);
+#if defined(CYLOGGER_LINUX_OS) || defined(CYLOGGER_MAC_OS)
+	/**
+	 * @brief Syslog severity of the level character.
+	*/
+	int GetSeverity(TChar cType)
+	{
+		switch (cType)
+		{
+		case 'I': return LOG_INFO;
+		case 'D': return LOG_DEBUG;
+		case 'T': return LOG_DEBUG;
+		case 'W': return LOG_WARNING;
+		case 'E': return LOG_ERR;
+		case 'F': return LOG_ERR;
+		default:  return LOG_INFO;
 		}
 	}
-#else
-	void WriteToSyslog(const TString& strName, const TString& message, int eventType)
-	{
-		openlog(strName.c_str(), LOG_PID | LOG_CONS, LOG_USER);
-		syslog(eventType, "%s", message.c_str());
-		closelog();
-	}		
 #endif
 }
 
 CYLoggerSystemAppender::CYLoggerSystemAppender(const TString& strName) noexcept
 : CYLoggerBaseAppender("SysThread")
 , m_strAppName(strName)
+#if defined(CYLOGGER_WIN_OS)
+, m_hEventLog(NULL)
+#elif defined(CYLOGGER_LINUX_OS)
+, m_strPath(SYSLOG_DEFAULT_PATH)
+, m_nStampSecond(-1)
+, m_socket(-1)
+, m_nDropLines(0)
+#endif
 {
+    size_t nIndex = m_strAppName.find(TEXT('@'));
+    if (nIndex != TString::npos)
+    {
+#if defined(CYLOGGER_LINUX_OS)
+        m_strPath = CYCOMMON_NAMESPACE::CYStringUtils::TString2String(m_strAppName.substr(nIndex + 1).c_str());
+#endif
+        m_strAppName = m_strAppName.substr(0, nIndex);
+    }
     StartLogThread();
 }
 
 CYLoggerSystemAppender::~CYLoggerSystemAppender() noexcept
 {
     StopLogThread();
+#if defined(CYLOGGER_WIN_OS)
+    if (m_hEventLog != NULL)
+    {
+        DeregisterEventSource(m_hEventLog);
+    }
+#elif defined(CYLOGGER_LINUX_OS)
+    CloseSocket();
+#elif defined(CYLOGGER_MAC_OS)
+    closelog();
+#endif
 }
 
 /**
@@ -61,9 +107,6 @@ const ELogType CYLoggerSystemAppender::GetId() const
 */
 void CYLoggerSystemAppender::Log(const TStringView& strMsg, int nTypeIndex, bool bFlush)
 {
-	CYFPSCounter::UpdateCounter();
-	const TChar* logMessage = strMsg.data();
-
 #ifdef CYLOGGER_WIN_OS
 	WORD eventType = EVENTLOG_INFORMATION_TYPE;
 	switch (strMsg[nTypeIndex])
@@ -77,31 +120,57 @@ void CYLoggerSystemAppender::Log(const TStringView& strMsg, int nTypeIndex, bool
 	default:  eventType = EVENTLOG_INFORMATION_TYPE;	break;
 	}
 
-	WriteToEventLog(m_strAppName, logMessage, eventType);
-#elif defined(CYLOGGER_LINUX_OS) || defined(CYLOGGER_MAC_OS)
-    openlog("CYLogger", LOG_PID | LOG_CONS, LOG_USER);
-
-	int eventType = LOG_INFO;
-    switch (strMsg[nTypeIndex])
-    {
-    case 'I': eventType = LOG_INFO;			break;
-    case 'D': eventType = LOG_DEBUG;		break;
-    case 'T': eventType = LOG_DEBUG;		break;
-    case 'W': eventType = LOG_WARNING;		break;
-    case 'E': eventType = LOG_ERR;			break;
-    case 'F': eventType = LOG_ERR;			break;
-    default:  eventType = LOG_INFO;			break;
-    }
-
-    syslog(eventType, "%s", logMessage);
-    closelog();
+	if (m_hEventLog != NULL)
+	{
+		const TString strMessage(strMsg);
+		LPCTSTR strings[2] = { strMessage.c_str(), NULL };
+		ReportEvent(m_hEventLog, eventType, 0, 0, NULL, 1, 0, strings, NULL);
+	}
+#elif defined(CYLOGGER_LINUX_OS)
+	// Lines without a message, such as the ones written by the logger itself, are stamped now.
+	PackFrame(GetSeverity(strMsg[nTypeIndex]), CYTimeFormat::Now(), strMsg);
+	if (bFlush || m_vecFrame.size() >= static_cast<size_t>(LOG_SYSLOG_BATCH_COUNT))
+	{
+		SendBatch();
+	}
+#elif defined(CYLOGGER_MAC_OS)
+	syslog(GetSeverity(strMsg[nTypeIndex]), "%.*s", static_cast<int>(strMsg.size()), strMsg.data());
 #endif
 
     Statistics()->AddSysLine(1);
     Statistics()->AddSysBytes(strMsg.size() + TEXT_BYTE_LEN);
+}
+
+/**
+* Outputs one drained message, the RFC 5424 TIMESTAMP is the capture time of the message
+*/
+int CYLoggerSystemAppender::LogMessage(const SharePtr<CYLoggerMessage>& ptrMessage)
+{
+#if defined(CYLOGGER_LINUX_OS)
+	const TString&& strMsg = ptrMessage->GetFormatMessage();
+	PackFrame(GetSeverity(strMsg[ptrMessage->GetTypeIndex()]), ptrMessage->GetTimeNs(), strMsg);
+	if (m_vecFrame.size() >= static_cast<size_t>(LOG_SYSLOG_BATCH_COUNT))
+	{
+		SendBatch();
+	}
 
-    Statistics()->AddSysCurrentFPS(CYFPSCounter::GetCurrentFPS());
-    Statistics()->AddSysAverageFPS(CYFPSCounter::GetAverageFPS());
+	const int nBytes = static_cast<int>(strMsg.size() + TEXT_BYTE_LEN);
+	Statistics()->AddSysLine(1);
+	Statistics()->AddSysBytes(nBytes);
+	return nBytes;
+#else
+	return CYLoggerBaseAppender::LogMessage(ptrMessage);
+#endif
+}
+
+/**
+* Get called after a drained batch has been passed to LogMessage, sends the batched frames
+*/
+void CYLoggerSystemAppender::OnBatchDone()
+{
+#if defined(CYLOGGER_LINUX_OS)
+	SendBatch();
+#endif
 }
 
 /**
@@ -109,7 +178,29 @@ void CYLoggerSystemAppender::Log(const TStringView& strMsg, int nTypeIndex, bool
 */
 void CYLoggerSystemAppender::OnActivate()
 {
-	return;
+#if defined(CYLOGGER_WIN_OS)
+	m_hEventLog = RegisterEventSource(NULL, m_strAppName.c_str());
+#elif defined(CYLOGGER_LINUX_OS)
+	char szHostName[256] = { 0 };
+	if (gethostname(szHostName, sizeof(szHostName) - 1) != 0 || szHostName[0] == '\0')
+	{
+		strcpy(szHostName, "-");
+	}
+
+	// APP-NAME is printable US-ASCII without spaces.
+	std::string strAppName = CYCOMMON_NAMESPACE::CYStringUtils::TString2String(m_strAppName.c_str()).substr(0, SYSLOG_APP_NAME_MAX);
+	std::replace_if(strAppName.begin(), strAppName.end(), [](char c) { return c <= ' ' || c > '~'; }, '_');
+	if (strAppName.empty())
+	{
+		strAppName = "-";
+	}
+
+	m_strFrameHeader = std::string(" ") + szHostName + " " + strAppName + " " + std::to_string(getpid()) + " - - ";
+	Connect(true);
+#elif defined(CYLOGGER_MAC_OS)
+	// syslog(3) keeps the ident pointer, m_strAppName outlives the connection.
+	openlog(m_strAppName.c_str(), LOG_PID, LOG_USER);
+#endif
 }
 
 /**
@@ -117,7 +208,13 @@ void CYLoggerSystemAppender::OnActivate()
 */
 void CYLoggerSystemAppender::Flush()
 {
-	return;
+#if defined(CYLOGGER_LINUX_OS)
+	// The batch is sent at the end of every drained batch, only the log thread touches it.
+	if (IsLogThread())
+	{
+		SendBatch();
+	}
+#endif
 }
 
 /**
@@ -154,12 +251,170 @@ const TString& CYLoggerSystemAppender::GetLogName()
 	return m_strLogName;
 }
 
+#if defined(CYLOGGER_LINUX_OS)
 /**
- * @brief Force new log file.
+ * @brief Append one RFC 5424 frame stamped with nTimeNs (nanoseconds since epoch) to the batch.
 */
-void CYLoggerSystemAppender::ForceNewFile()
+void CYLoggerSystemAppender::PackFrame(int nSeverity, int64_t nTimeNs, const TStringView& strMsg)
 {
+	const int64_t nMicroseconds = nTimeNs / 1000;
+	const int64_t nSecond = nMicroseconds / 1000000;
+	if (nSecond != m_nStampSecond)
+	{
+		// localtime_r and strftime run once per second, the fraction is appended per frame.
+		const time_t nTime = static_cast<time_t>(nSecond);
+		struct tm objTm;
+		localtime_r(&nTime, &objTm);
+
+		char szBuffer[32];
+		m_strStampPrefix.assign(szBuffer, strftime(szBuffer, sizeof(szBuffer), "%Y-%m-%dT%H:%M:%S", &objTm));
+		const long nOffset = objTm.tm_gmtoff / 60;
+		snprintf(szBuffer, sizeof(szBuffer), "%c%02ld:%02ld", nOffset < 0 ? '-' : '+', labs(nOffset) / 60, labs(nOffset) % 60);
+		m_strStampZone = szBuffer;
+		m_nStampSecond = nSecond;
+	}
+
+	char szHeader[32];
+	const int nHeaderLength = snprintf(szHeader, sizeof(szHeader), "<%d>1 ", LOG_USER | nSeverity);
+	char szFraction[16];
+	snprintf(szFraction, sizeof(szFraction), ".%06d", static_cast<int>(nMicroseconds % 1000000));
 
+	const size_t nOffset = m_strBatch.size();
+	m_strBatch.append(szHeader, nHeaderLength);
+	m_strBatch.append(m_strStampPrefix);
+	m_strBatch.append(szFraction, 7);
+	m_strBatch.append(m_strStampZone);
+	m_strBatch.append(m_strFrameHeader);
+#if CY_USE_UNICODE
+	m_strBatch.append(CYCOMMON_NAMESPACE::CYStringUtils::TString2String(TString(strMsg).c_str()));
+#else
+	m_strBatch.append(strMsg.data(), strMsg.size());
+#endif
+	m_vecFrame.push_back({ nOffset, m_strBatch.size() - nOffset });
 }
 
+/**
+ * @brief Send the batched frames and clear the batch.
+*/
+void CYLoggerSystemAppender::SendBatch()
+{
+	if (m_vecFrame.empty())
+		return;
+
+	// One sendmmsg call per LOG_SYSLOG_BATCH_COUNT frames on the connected socket, each iovec points into the batch buffer.
+	mmsghdr arrayMsg[LOG_SYSLOG_BATCH_COUNT];
+	iovec arrayIov[LOG_SYSLOG_BATCH_COUNT];
+	size_t nSent = 0;
+	bool bReconnected = false;
+	while (nSent < m_vecFrame.size())
+	{
+		if (m_socket < 0 && !Connect(bReconnected))
+			break;
+
+		unsigned int nCount = static_cast<unsigned int>((std::min)(m_vecFrame.size() - nSent, static_cast<size_t>(LOG_SYSLOG_BATCH_COUNT)));
+		memset(arrayMsg, 0, sizeof(mmsghdr) * nCount);
+		for (unsigned int i = 0; i < nCount; ++i)
+		{
+			const STFrame& objFrame = m_vecFrame[nSent + i];
+			arrayIov[i].iov_base = m_strBatch.data() + objFrame.nOffset;
+			arrayIov[i].iov_len = objFrame.nLength;
+			arrayMsg[i].msg_hdr.msg_iov = &arrayIov[i];
+			arrayMsg[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		int nRet = sendmmsg(m_socket, arrayMsg, nCount, MSG_NOSIGNAL);
+		if (nRet > 0)
+		{
+			nSent += static_cast<size_t>(nRet);
+			continue;
+		}
+
+		const int nError = nRet < 0 ? errno : 0;
+		if (nError == EINTR)
+			continue;
+		if (nError == EMSGSIZE)
+		{
+			// A frame larger than the socket takes is dropped alone.
+			++nSent;
+			++m_nDropLines;
+			AddDropLines(1);
+			continue;
+		}
+		if (nError == EAGAIN || nError == EWOULDBLOCK || nError == ENOBUFS)
+		{
+			// The daemon did not drain the socket within LOG_SYSLOG_SEND_TIMEOUT. Unlike syslog(3), which blocks the
+			// caller until the daemon catches up, the rest of the batch is dropped so the log thread keeps draining.
+			break;
+		}
+
+		// The daemon went away or restarted, reconnect once per batch and resend the rest.
+		CloseSocket();
+		if (bReconnected)
+			break;
+		bReconnected = true;
+	}
+
+	// Frames left by a full socket or a failed reconnect are counted as dropped and reported on the next connect.
+	const size_t nDrop = m_vecFrame.size() - nSent;
+	if (nDrop > 0)
+	{
+		m_nDropLines += nDrop;
+		AddDropLines(nDrop);
+	}
+	m_strBatch.clear();
+	m_vecFrame.clear();
+}
+
+/**
+ * @brief Connect the datagram socket to the syslog path, at most once per LOG_SYSLOG_RECONNECT unless bForce.
+*/
+bool CYLoggerSystemAppender::Connect(bool bForce)
+{
+	if (m_socket >= 0)
+		return true;
+	if (!bForce && m_objRetryElapsed.Elapsed() < LOG_SYSLOG_RECONNECT)
+		return false;
+	m_objRetryElapsed.Reset();
+
+	sockaddr_un objAddr;
+	memset(&objAddr, 0, sizeof(objAddr));
+	objAddr.sun_family = AF_UNIX;
+	if (m_strPath.empty() || m_strPath.size() >= sizeof(objAddr.sun_path))
+		return false;
+	memcpy(objAddr.sun_path, m_strPath.c_str(), m_strPath.size());
+
+	m_socket = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+	if (m_socket < 0)
+		return false;
+
+	// A full socket blocks the log thread for at most LOG_SYSLOG_SEND_TIMEOUT per batch.
+	timeval objTimeout{ LOG_SYSLOG_SEND_TIMEOUT / 1000, (LOG_SYSLOG_SEND_TIMEOUT % 1000) * 1000 };
+	setsockopt(m_socket, SOL_SOCKET, SO_SNDTIMEO, &objTimeout, sizeof(objTimeout));
+	if (connect(m_socket, (struct sockaddr*)&objAddr, sizeof(objAddr)) != 0)
+	{
+		CloseSocket();
+		return false;
+	}
+
+	if (m_nDropLines > 0)
+	{
+		ExceptionLog((std::string("System appender dropped ") + std::to_string(m_nDropLines) + " lines while the syslog socket was unavailable.").c_str());
+		m_nDropLines = 0;
+	}
+	return true;
+}
+
+/**
+ * @brief Close Socket.
+*/
+void CYLoggerSystemAppender::CloseSocket()
+{
+	if (m_socket >= 0)
+	{
+		::close(m_socket);
+		m_socket = -1;
+	}
+}
+#endif
+
 CYLOGGER_NAMESPACE_END
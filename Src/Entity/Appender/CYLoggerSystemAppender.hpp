@@ -47,8 +47,19 @@
 #include "Inc/ICYLoggerDefine.hpp"
 #include "Entity/Appender/CYLoggerBaseAppender.hpp"
 
+#include <string>
+#include <vector>
+
 CYLOGGER_NAMESPACE_BEGIN
 
+/**
+ * @brief System log appender, the name is "AppName" or "AppName@/path/to/socket".
+ * On Linux RFC 5424 frames are sent over a persistent AF_UNIX datagram socket to /dev/log (or the given path), one
+ * sendmmsg call per drained batch, and the socket is reconnected when the syslog daemon restarts. Unlike glibc
+ * syslog(3), which blocks while the daemon is slow, a send waits at most LOG_SYSLOG_SEND_TIMEOUT and the rest of the
+ * batch is then dropped and counted in the appender statistics. Windows writes to the event log and macOS to
+ * syslog(3), both opened once on activation.
+*/
 class CYLoggerSystemAppender : public CYLoggerBaseAppender
 {
 public:
@@ -68,6 +79,16 @@ public:
 	*/
 	virtual void Log(const TStringView& strMsg, int nTypeIndex, bool bFlush) override;
 
+	/**
+	* Outputs one drained message, the RFC 5424 TIMESTAMP is the capture time of the message
+	*/
+	virtual int LogMessage(const SharePtr<CYLoggerMessage>& ptrMessage) override;
+
+	/**
+	* Get called after a drained batch has been passed to LogMessage, sends the batched frames
+	*/
+	virtual void OnBatchDone() override;
+
 	/**
 	* Get called when this appender become active through attaching to a CYLLoggerImpl object, and it was not active before
 	*/
@@ -100,10 +121,28 @@ public:
 	*/
 	virtual const TString& GetLogName() override;
 
+#if defined(CYLOGGER_LINUX_OS)
+protected:
+	/**
+	 * @brief Append one RFC 5424 frame stamped with nTimeNs (nanoseconds since epoch) to the batch.
+	*/
+	void PackFrame(int nSeverity, int64_t nTimeNs, const TStringView& strMsg);
+
+	/**
+	 * @brief Send the batched frames and clear the batch.
+	*/
+	void SendBatch();
+
 	/**
-	 * @brief Force new log file.
+	 * @brief Connect the datagram socket to the syslog path, at most once per LOG_SYSLOG_RECONNECT unless bForce.
 	*/
-	virtual void ForceNewFile() override;
+	bool Connect(bool bForce);
+
+	/**
+	 * @brief Close Socket.
+	*/
+	void CloseSocket();
+#endif
 
 private:
 	/**
@@ -111,6 +150,72 @@ private:
 	*/
 	TString m_strAppName;
 
+#if defined(CYLOGGER_WIN_OS)
+	/**
+	 * @brief Event source handle, registered on activation.
+	*/
+	HANDLE m_hEventLog;
+#elif defined(CYLOGGER_LINUX_OS)
+	/**
+	 * @brief One frame, a slice of the batch buffer.
+	*/
+	struct STFrame
+	{
+		size_t nOffset;
+		size_t nLength;
+	};
+
+	/**
+	 * @brief Path of the syslog socket.
+	*/
+	std::string m_strPath;
+
+	/**
+	 * @brief " HOSTNAME APP-NAME PROCID - - ", the part of the frame header after the timestamp.
+	*/
+	std::string m_strFrameHeader;
+
+	/**
+	 * @brief Second of the cached timestamp prefix.
+	*/
+	int64_t m_nStampSecond;
+
+	/**
+	 * @brief "YYYY-MM-DDThh:mm:ss" of m_nStampSecond.
+	*/
+	std::string m_strStampPrefix;
+
+	/**
+	 * @brief Local time offset "+hh:mm" of m_nStampSecond.
+	*/
+	std::string m_strStampZone;
+
+	/**
+	 * @brief Frames of the current batch.
+	*/
+	std::string m_strBatch;
+
+	/**
+	 * @brief Frame slices of m_strBatch.
+	*/
+	std::vector<STFrame> m_vecFrame;
+
+	/**
+	 * @brief socket handle.
+	*/
+	int m_socket;
+
+	/**
+	 * @brief Time since the last connect attempt.
+	*/
+	CYTimeElapsed m_objRetryElapsed;
+
+	/**
+	 * @brief Lines dropped because the syslog socket was unreachable or full.
+	*/
+	uint64_t m_nDropLines;
+#endif
+
 	/**
 	 * @brief Log file name.
 	*/
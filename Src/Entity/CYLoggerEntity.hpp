@@ -77,7 +77,7 @@ public:
 	/**
 	* @brief Put message to the Log
 	*/
-	virtual void WriteLog(const SharePtr<CYBaseMessage>& ptrMessage);
+	virtual void WriteLog(const SharePtr<CYLoggerMessage>& ptrMessage);
 
 	/**
 	* @return the unique id for this appender
@@ -90,9 +90,39 @@ public:
 	virtual const TString& GetLogName();
 
 	/**
-	 * @brief Force new log file.
+	 * @brief Queue a new log file request to the appender, never blocks.
 	*/
-	virtual void ForceNewFile();
+	virtual std::future<bool> ForceNewFile(std::function<void(bool)> fnDone = nullptr);
+
+	/**
+	 * @brief Set the rotation policy of the appender.
+	*/
+	virtual void SetRotation(const STRotationPolicy& objPolicy);
+
+	/**
+	 * @brief Get the enqueue to write latency percentiles of the appender.
+	*/
+	virtual void GetLatency(STLatencyStats& objStats, bool bReset);
+
+	/**
+	 * @brief Get the statistics record of the appender, false without an attached appender.
+	*/
+	virtual bool GetStats(STAppenderStats& objStats);
+
+	/**
+	 * @brief Read the lines kept by a memory appender, 0 for any other appender.
+	*/
+	virtual size_t ReadMemory(TChar* pszBuffer, size_t nSize, bool bClear);
+
+	/**
+	 * @brief Run the schedule thread work of the appender.
+	*/
+	virtual void OnSchedule();
+
+	/**
+	 * @brief Files owned by the appender besides the log file.
+	*/
+	virtual void GetReservedFiles(std::list<TString>& lstFile);
 
 private:
 	ELogType m_eLogType;
@@ -150,7 +180,7 @@ void CYLoggerEntity<APPEND>::DetachAppender()
 * @brief Put message to the Log
 */
 template<BaseOf APPEND>
-void CYLoggerEntity<APPEND>::WriteLog(const SharePtr<CYBaseMessage>& ptrMessage)
+void CYLoggerEntity<APPEND>::WriteLog(const SharePtr<CYLoggerMessage>& ptrMessage)
 {
 	m_ptrAppender->WriteLog(ptrMessage);
 }
@@ -183,14 +213,92 @@ const TString& CYLoggerEntity<APPEND>::GetLogName()
 }
 
 /**
- * @brief Force new log file.
+ * @brief Queue a new log file request to the appender, never blocks.
+*/
+template<BaseOf APPEND>
+std::future<bool> CYLoggerEntity<APPEND>::ForceNewFile(std::function<void(bool)> fnDone)
+{
+	if (m_ptrAppender)
+	{
+		return m_ptrAppender->ForceNewFile(std::move(fnDone));
+	}
+
+	std::promise<bool> objPromise;
+	objPromise.set_value(false);
+	if (fnDone) fnDone(false);
+	return objPromise.get_future();
+}
+
+/**
+ * @brief Set the rotation policy of the appender.
+*/
+template<BaseOf APPEND>
+void CYLoggerEntity<APPEND>::SetRotation(const STRotationPolicy& objPolicy)
+{
+	if (m_ptrAppender)
+	{
+		m_ptrAppender->SetRotation(objPolicy);
+	}
+}
+
+/**
+ * @brief Get the enqueue to write latency percentiles of the appender.
+*/
+template<BaseOf APPEND>
+void CYLoggerEntity<APPEND>::GetLatency(STLatencyStats& objStats, bool bReset)
+{
+	if (m_ptrAppender)
+	{
+		m_ptrAppender->GetLatency(objStats, bReset);
+	}
+}
+
+/**
+ * @brief Get the statistics record of the appender, false without an attached appender.
+*/
+template<BaseOf APPEND>
+bool CYLoggerEntity<APPEND>::GetStats(STAppenderStats& objStats)
+{
+	if (!m_ptrAppender)
+		return false;
+
+	m_ptrAppender->GetStats(objStats);
+	return true;
+}
+
+/**
+ * @brief Read the lines kept by a memory appender, 0 for any other appender.
+*/
+template<BaseOf APPEND>
+size_t CYLoggerEntity<APPEND>::ReadMemory(TChar* pszBuffer, size_t nSize, bool bClear)
+{
+	if (!m_ptrAppender)
+		return 0;
+
+	return m_ptrAppender->ReadMemory(pszBuffer, nSize, bClear);
+}
+
+/**
+ * @brief Run the schedule thread work of the appender.
+*/
+template<BaseOf APPEND>
+void CYLoggerEntity<APPEND>::OnSchedule()
+{
+	if (m_ptrAppender)
+	{
+		m_ptrAppender->OnSchedule();
+	}
+}
+
+/**
+ * @brief Files owned by the appender besides the log file.
 */
 template<BaseOf APPEND>
-void CYLoggerEntity<APPEND>::ForceNewFile()
+void CYLoggerEntity<APPEND>::GetReservedFiles(std::list<TString>& lstFile)
 {
 	if (m_ptrAppender)
 	{
-		m_ptrAppender->ForceNewFile();
+		m_ptrAppender->GetReservedFiles(lstFile);
 	}
 }
 
@@ -7,6 +7,9 @@
 #endif
 
 #include <assert.h>
+#include <chrono>
+#include <future>
+#include <list>
 
 CYLOGGER_NAMESPACE_BEGIN
 
@@ -108,17 +111,67 @@ void CYLoggerEntityFactory::ReleaseAllLoggerEntity()
 }
 
 /**
- * @brief Force new log file.
+ * @brief Ask every entity for a new log file and wait at most nTimeoutMs for all of them.
+ * @return false if an entity did not answer in time.
 */
-void CYLoggerEntityFactory::ForceEntityNewFile()
+bool CYLoggerEntityFactory::ForceEntityNewFile(unsigned int nTimeoutMs)
 {
+    // Queue all requests first, the appenders then rotate in parallel.
+    std::list<std::future<bool>> lstFuture;
     auto iter = m_mapRegisterEntity.begin();
     while (iter != m_mapRegisterEntity.end())
     {
         auto ptrLoggerEntity = iter->second;
-        ptrLoggerEntity->ForceNewFile();
+        lstFuture.push_back(ptrLoggerEntity->ForceNewFile());
         ++iter;
     }
+
+    bool bRet = true;
+    const auto tDeadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(nTimeoutMs);
+    for (auto& objFuture : lstFuture)
+    {
+        if (objFuture.wait_until(tDeadline) != std::future_status::ready)
+        {
+            bRet = false;
+            continue;
+        }
+
+        try
+        {
+            // An appender without a file answers false, that is not a failure.
+            objFuture.get();
+        }
+        catch (...)
+        {
+            bRet = false;
+        }
+    }
+    return bRet;
+}
+
+/**
+ * @brief Run the schedule thread work of all entities.
+*/
+void CYLoggerEntityFactory::ScheduleEntity()
+{
+    for (auto& [eLogType, ptrLoggerEntity] : m_mapRegisterEntity)
+    {
+        ptrLoggerEntity->OnSchedule();
+    }
+}
+
+/**
+ * @brief Get the statistics records of all entities, in ELogType order.
+*/
+void CYLoggerEntityFactory::GetEntityStats(std::vector<STAppenderStats>& vecStats)
+{
+    vecStats.clear();
+    for (auto& [eLogType, ptrLoggerEntity] : m_mapRegisterEntity)
+    {
+        STAppenderStats objStats;
+        if (ptrLoggerEntity->GetStats(objStats))
+            vecStats.push_back(objStats);
+    }
 }
 
 /**
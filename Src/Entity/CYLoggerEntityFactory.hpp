@@ -50,6 +50,7 @@
 
 #include <map>
 #include <mutex>
+#include <vector>
 
 CYLOGGER_NAMESPACE_BEGIN
 
@@ -83,9 +84,20 @@ public:
     void ReleaseAllLoggerEntity();
 
     /**
-	 * @brief Force new log file.
+	 * @brief Ask every entity for a new log file and wait at most nTimeoutMs for all of them.
+	 * @return false if an entity did not answer in time.
 	*/
-	void ForceEntityNewFile();
+	bool ForceEntityNewFile(unsigned int nTimeoutMs);
+
+    /**
+     * @brief Run the schedule thread work of all entities.
+    */
+    void ScheduleEntity();
+
+    /**
+     * @brief Get the statistics records of all entities, in ELogType order.
+    */
+    void GetEntityStats(std::vector<STAppenderStats>& vecStats);
 
     /**
      * @brief Get CYLoggerEntityFactory Instance.
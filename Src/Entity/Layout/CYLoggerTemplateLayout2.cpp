@@ -1,6 +1,7 @@
 #include "Entity/Layout/CYLoggerTemplateLayout2.hpp"
 #include "Entity/Filter/CYLoggerPatternFilterManager.hpp"
 #include "Common/CYFormatDefine.hpp"
+#include "Common/Time/CYTimeFormat.hpp"
 
 CYLOGGER_NAMESPACE_BEGIN
 
@@ -16,25 +17,7 @@ CYLoggerTemplateLayout2::~CYLoggerTemplateLayout2()
 
 const TString CYLoggerTemplateLayout2::GetTimeStamps(int nYY, int nMM, int nDD, int nHR, int nMN, int nSC, int nMMN)
 {
-#ifdef CYLOGGER_WIN_OS
-    return fmtx::format(TEXT("{:0>4}-{:0>2}-{:0>2} {:0>2}:{:0>2}:{:0>2}.{:0>3}"), nYY, nMM, nDD, nHR, nMN, nSC, nMMN);
-#else
-    TOStringStream ss;
-    ss << std::setw(4) << std::setfill(TEXT('0')) << nYY <<
-        std::setw(1) << TEXT('-') <<
-        std::setw(2) << std::setfill(TEXT('0')) << nMM <<
-        std::setw(1) << TEXT('-') <<
-        std::setw(2) << std::setfill(TEXT('0')) << nDD <<
-        std::setw(1) << TEXT(' ') <<
-        std::setw(2) << std::setfill(TEXT('0')) << nHR <<
-        std::setw(1) << TEXT(':') <<
-        std::setw(2) << std::setfill(TEXT('0')) << nMN <<
-        std::setw(1) << TEXT(':') <<
-        std::setw(2) << std::setfill(TEXT('0')) << nSC <<
-        std::setw(1) << TEXT('.') <<
-        std::setw(3) << std::setfill(TEXT('0')) << nMMN;
-    return ss.str();
-#endif
+    return CYTimeFormat::ToString(nYY, nMM, nDD, nHR, nMN, nSC, nMMN);
 }
 
 /**
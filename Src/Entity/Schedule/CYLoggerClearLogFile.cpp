@@ -7,16 +7,10 @@
 #include "Common/Exception/CYExceptionLogFile.hpp"
 #include "Common/CYPublicFunction.hpp"
 
-#include <filesystem>
 #include <chrono>
 #include <ctime>
-#ifdef CYLOGGER_WIN_OS
-#include <windows.h>
-#else
-#include <sys/stat.h>
-#include <dirent.h>
-#include <cstring>
-#endif
+#include <unordered_map>
+#include <unordered_set>
 
 CYLOGGER_NAMESPACE_BEGIN
 
@@ -51,13 +45,12 @@ void CYLoggerClearLogFile::SetRestriction(bool m_bClearUnLogFile, int nLimitTime
 void CYLoggerClearLogFile::ProcessClearLog(const std::list<ELogType>& lstLogType)
 {
     std::list<CYLogFileInfo> lstUsedLogFile;                                // Current Log File.
-    std::list<TString>       lstLogDirFile;                                 // All log files in the log directory.
     std::list<TString>       lstNotLogDirFile;                              // All non-log files in the log directory.
     FileClassMap             mapFileClass;
 
     ProcessRunningLogFile(lstLogType, lstUsedLogFile);                      // Get running log file information.
-    ProcessPublicLogInfo(lstLogType, lstLogDirFile, lstNotLogDirFile);      // Get log file information.
-    PreprocessData(lstUsedLogFile, lstLogDirFile, mapFileClass);
+    RefreshIndex();                                                         // Apply the directory changes since the last pass.
+    PreprocessData(lstUsedLogFile, mapFileClass, lstNotLogDirFile);
 
     if (m_bFirstProcess)
     {
@@ -77,6 +70,37 @@ void CYLoggerClearLogFile::ProcessClearLog(const std::list<ELogType>& lstLogType
     m_bFirstProcess = false;
 }
 
+/**
+ * @brief Get the log files that are no longer written by any appender.
+*/
+void CYLoggerClearLogFile::GetClosedLogFile(const std::list<ELogType>& lstLogType, std::list<TString>& lstClosedFile)
+{
+    std::list<CYLogFileInfo> lstUsedLogFile;                                // Current Log File.
+
+    ProcessRunningLogFile(lstLogType, lstUsedLogFile);
+    RefreshIndex();
+
+    std::unordered_set<TString> setUsedFile;
+    for (const auto& objFileInfo : lstUsedLogFile)
+    {
+        setUsedFile.insert(objFileInfo.strLogFilePath);
+    }
+
+    const TString& strErrorLogName = LoggerConfig()->GetErrorLogName();
+    lstClosedFile.clear();
+    for (const auto& objFile : m_objIndex.GetFiles())
+    {
+        if (!objFile.second.bLog || setUsedFile.count(objFile.first) != 0)
+            continue;
+
+        // filter Exception.log.
+        if (cy_strstr(objFile.first.c_str(), strErrorLogName.c_str()) != nullptr)
+            continue;
+
+        lstClosedFile.push_back(objFile.first);
+    }
+}
+
 /**
  * @brief Get running log file information.
 */
@@ -102,56 +126,64 @@ void CYLoggerClearLogFile::ProcessRunningLogFile(const std::list<ELogType>& lstL
         objFileInfo.strLogFilePath = strLogName;
         objFileInfo.strCheckName = GetCheckName(strLogName);
         lstUsedLogFile.emplace_back(objFileInfo);
+
+        // Standby and rotated files still open count as used.
+        std::list<TString> lstReservedFile;
+        ptrEntity->GetReservedFiles(lstReservedFile);
+        for (auto& strReservedFile : lstReservedFile)
+        {
+            objFileInfo.strLogFilePath = strReservedFile;
+            lstUsedLogFile.emplace_back(objFileInfo);
+        }
     }
 }
 
 /**
- * @brief Get log file information.
+ * @brief Bring the log directory index up to date.
 */
-void CYLoggerClearLogFile::ProcessPublicLogInfo(const std::list<ELogType>& lstLogType, std::list<TString>& lstLogFile, std::list<TString>& lstNotLogFile)
+void CYLoggerClearLogFile::RefreshIndex()
 {
-    // Get log path.
-    TString strLogPath = CYPathConvert::ConvertFilePath(TEXT(""), LoggerConfig()->GetLogPath().c_str(), LOG_DIR);
-
-    // Enum log file.
-    EnumLogFile(strLogPath, lstLogFile);
-
-    // Enum non-log file.
-    EnumNotLogFile(strLogPath, lstNotLogFile);
+    m_objIndex.Refresh(CYPathConvert::ConvertFilePath(TEXT(""), LoggerConfig()->GetLogPath().c_str(), LOG_DIR));
 }
 
 /**
- * @brief Preprocess some data.
+ * @brief Group the indexed log files that are not in use by type, and collect the non-log files.
 */
-void CYLoggerClearLogFile::PreprocessData(const std::list<CYLogFileInfo>& lstUsedLogFile, const std::list<TString>& lstLogFile, FileClassMap& mapLogFileInfo)
+void CYLoggerClearLogFile::PreprocessData(const std::list<CYLogFileInfo>& lstUsedLogFile, FileClassMap& mapLogFileInfo, std::list<TString>& lstNotLogFile)
 {
-    for (auto& strLogFile : lstLogFile)
+    std::unordered_set<TString> setUsedFile;
+    std::unordered_map<TString, ELogType> mapCheckType;
+    for (const auto& objFileInfo : lstUsedLogFile)
     {
-        bool bUsed = IsUsedLogFile(lstUsedLogFile, strLogFile);
-        if (bUsed) continue; // Filter out log files in use
+        setUsedFile.insert(objFileInfo.strLogFilePath);
+        mapCheckType.emplace(objFileInfo.strCheckName, objFileInfo.eLogType);
+    }
+
+    const TString& strErrorLogName = LoggerConfig()->GetErrorLogName();
+    for (const auto& objFile : m_objIndex.GetFiles())
+    {
+        const TString& strLogFile = objFile.first;
+        if (!objFile.second.bLog)
+        {
+            lstNotLogFile.push_back(strLogFile);
+            continue;
+        }
+
+        if (setUsedFile.count(strLogFile) != 0) continue; // Filter out log files in use
 
         // filter Exception.log.
-        if (cy_strstr(strLogFile.c_str(), LoggerConfig()->GetErrorLogName().c_str()) != nullptr)
+        if (cy_strstr(strLogFile.c_str(), strErrorLogName.c_str()) != nullptr)
             continue;
 
         CYLogFileInfo objFileInfo;
         objFileInfo.strLogFilePath = strLogFile;
         objFileInfo.strCheckName = GetCheckName(strLogFile);
-        objFileInfo.eLogType = GetLogFileType(lstUsedLogFile, objFileInfo.strCheckName);
-
-        GetFileInfomation(objFileInfo);
-
-        TString strFileName = CYPublicFunction::GetFileName(strLogFile);
-
-        std::map<TString, CYLogFileInfo> mapTypeLogFile;
-        auto iterFind = mapLogFileInfo.find(objFileInfo.eLogType);
-        if (iterFind != mapLogFileInfo.end())
-        {
-            mapTypeLogFile = iterFind->second;
-        }
+        auto iterType = mapCheckType.find(objFileInfo.strCheckName);
+        objFileInfo.eLogType = iterType != mapCheckType.end() ? iterType->second : ELogType::LOG_TYPE_NONE;
+        objFileInfo.nSize = objFile.second.nSize;
+        objFileInfo.tpCreateTime = objFile.second.tpWriteTime;
 
-        mapTypeLogFile[strFileName] = objFileInfo;
-        mapLogFileInfo[objFileInfo.eLogType] = mapTypeLogFile;
+        mapLogFileInfo[objFileInfo.eLogType][objFile.second.strName] = std::move(objFileInfo);
     }
 }
 
@@ -162,7 +194,7 @@ void CYLoggerClearLogFile::ProcessClearNonLog(const std::list<TString>& lstNotLo
 {
     for (auto& objFileInfo : lstNotLogFile)
     {
-        CYPublicFunction::Remove(objFileInfo.c_str());
+        m_objIndex.Remove(objFileInfo);
     }
 }
 
@@ -171,34 +203,15 @@ void CYLoggerClearLogFile::ProcessClearNonLog(const std::list<TString>& lstNotLo
 */
 void CYLoggerClearLogFile::ProcessClearLogCount(FileClassMap& mapLogFileInfo)
 {
-    FileClassMap mapLogFileInfo2 = mapLogFileInfo;
-    for (const auto& mapLog : mapLogFileInfo2)
+    for (auto& mapLog : mapLogFileInfo)
     {
-        // List of keys to delete
-        std::vector<TString> lstKeysToDelete;
-
-        // Log file map for each type.
-        std::map<TString, CYLogFileInfo> mapTypeFileInfo = mapLog.second;
-        if (mapTypeFileInfo.size() > m_nFileCountPerType)
+        // Log file map for each type, the oldest name comes first.
+        std::map<TString, CYLogFileInfo>& mapTypeFileInfo = mapLog.second;
+        auto iter = mapTypeFileInfo.begin();
+        while (mapTypeFileInfo.size() > static_cast<size_t>(m_nFileCountPerType) && iter != mapTypeFileInfo.end())
         {
-            unsigned nSize = static_cast<unsigned>(mapTypeFileInfo.size());
-            for (auto& objFileInfo : mapTypeFileInfo)
-            {
-                if (nSize <= static_cast<unsigned>(m_nFileCountPerType))
-                    break;
-
-                lstKeysToDelete.push_back(objFileInfo.first);
-                CYPublicFunction::Remove(objFileInfo.second.strLogFilePath);
-                nSize--;
-            }
-
-            // Delete key.
-            for (auto& strKey : lstKeysToDelete)
-            {
-                mapTypeFileInfo.erase(strKey);
-            }
-
-            mapLogFileInfo[mapLog.first] = mapTypeFileInfo;
+            m_objIndex.Remove(iter->second.strLogFilePath);
+            iter = mapTypeFileInfo.erase(iter);
         }
     }
 }
@@ -208,33 +221,24 @@ void CYLoggerClearLogFile::ProcessClearLogCount(FileClassMap& mapLogFileInfo)
 */
 void CYLoggerClearLogFile::ProcessClearLogExpired(FileClassMap& mapLogFileInfo)
 {
-    FileClassMap mapLogFileInfo2 = mapLogFileInfo;
-    for (const auto& mapLog : mapLogFileInfo2)
+    auto tpEndTime = std::chrono::system_clock::now();
+    for (auto& mapLog : mapLogFileInfo)
     {
-        // List of keys to delete
-        std::vector<TString> lstKeysToDelete;
-
         // Log file map for each type.
-        std::map<TString, CYLogFileInfo> mapTypeFileInfo = mapLog.second;
-        for (auto& objFileInfo : mapTypeFileInfo)
+        std::map<TString, CYLogFileInfo>& mapTypeFileInfo = mapLog.second;
+        auto iter = mapTypeFileInfo.begin();
+        while (iter != mapTypeFileInfo.end())
         {
-            auto tpEndTime = std::chrono::system_clock::now();
-            auto objDuration = std::chrono::duration_cast<std::chrono::hours>(tpEndTime - objFileInfo.second.tpCreateTime);
+            auto objDuration = std::chrono::duration_cast<std::chrono::hours>(tpEndTime - iter->second.tpCreateTime);
             int nHours = objDuration.count();
             if (nHours > m_nLimitTimeExpiredFile)
             {
-                lstKeysToDelete.push_back(objFileInfo.first);
-                CYPublicFunction::Remove(objFileInfo.second.strLogFilePath);
+                m_objIndex.Remove(iter->second.strLogFilePath);
+                iter = mapTypeFileInfo.erase(iter);
+                continue;
             }
+            ++iter;
         }
-
-        // Delete key.
-        for (auto& strKey : lstKeysToDelete)
-        {
-            mapTypeFileInfo.erase(strKey);
-        }
-
-        mapLogFileInfo[mapLog.first] = mapTypeFileInfo;
     }
 }
 
@@ -243,41 +247,23 @@ void CYLoggerClearLogFile::ProcessClearLogExpired(FileClassMap& mapLogFileInfo)
 */
 void CYLoggerClearLogFile::ProcessClearLogTypeSize(FileClassMap& mapLogFileInfo)
 {
-    FileClassMap mapLogFileInfo2 = mapLogFileInfo;
-    for (const auto& mapLog : mapLogFileInfo2)
+    for (auto& mapLog : mapLogFileInfo)
     {
         uint64_t nLogTotalBytes = 0;
-        std::map<TString, CYLogFileInfo> mapTypeFileInfo = mapLog.second;
+        std::map<TString, CYLogFileInfo>& mapTypeFileInfo = mapLog.second;
         for (auto& objFileInfo : mapTypeFileInfo)
         {
             nLogTotalBytes += objFileInfo.second.nSize;
         }
 
-        if (nLogTotalBytes < m_nCheckFileTypeSize)
-            continue;
-
-        // List of keys to delete
-        std::vector<TString> lstKeysToDelete;
-
-        // Log file map for each type.
-        for (auto& objFileInfo : mapTypeFileInfo)
+        // Log file map for each type, the oldest name comes first.
+        auto iter = mapTypeFileInfo.begin();
+        while (nLogTotalBytes >= static_cast<uint64_t>(m_nCheckFileTypeSize) && iter != mapTypeFileInfo.end())
         {
-            if (nLogTotalBytes < m_nCheckFileTypeSize)
-                break;
-
-            nLogTotalBytes -= objFileInfo.second.nSize;
-
-            lstKeysToDelete.push_back(objFileInfo.first);
-            CYPublicFunction::Remove(objFileInfo.second.strLogFilePath);
+            nLogTotalBytes -= iter->second.nSize;
+            m_objIndex.Remove(iter->second.strLogFilePath);
+            iter = mapTypeFileInfo.erase(iter);
         }
-
-        // Delete key.
-        for (auto& strKey : lstKeysToDelete)
-        {
-            mapTypeFileInfo.erase(strKey);
-        }
-
-        mapLogFileInfo[mapLog.first] = mapTypeFileInfo;
     }
 }
 
@@ -286,7 +272,7 @@ void CYLoggerClearLogFile::ProcessClearLogTypeSize(FileClassMap& mapLogFileInfo)
 */
 void CYLoggerClearLogFile::ProcessClearLogALLSize(FileClassMap& mapLogFileInfo)
 {
-    std::multimap<TString, CYLogFileInfo> mapALLFile;
+    std::multimap<TString, const CYLogFileInfo*> mapALLFile;
 
     uint64_t nALLSize = 0;
     for (const auto& mapLog : mapLogFileInfo)
@@ -294,7 +280,7 @@ void CYLoggerClearLogFile::ProcessClearLogALLSize(FileClassMap& mapLogFileInfo)
         for (const auto& fileInfo : mapLog.second)
         {
             nALLSize += fileInfo.second.nSize;
-            mapALLFile.insert(std::pair<TString, CYLogFileInfo>(fileInfo.first, fileInfo.second));
+            mapALLFile.emplace(fileInfo.first, &fileInfo.second);
         }
     }
 
@@ -304,167 +290,11 @@ void CYLoggerClearLogFile::ProcessClearLogALLSize(FileClassMap& mapLogFileInfo)
     {
         if (nALLSize < m_nCheckALLFileSize) break;
 
-        nALLSize -= objInfo.second.nSize;
-        CYPublicFunction::Remove(objInfo.second.strLogFilePath);
+        nALLSize -= objInfo.second->nSize;
+        m_objIndex.Remove(objInfo.second->strLogFilePath);
     }
 }
 
-/**
- * @brief Enumerate files in the specified directory.
-*/
-void CYLoggerClearLogFile::EnumLogFile(TString strLogPath, std::list<TString>& vecLogList)
-{
-#ifdef CYLOGGER_WIN_OS
-    HANDLE hFindFile = INVALID_HANDLE_VALUE;
-    WIN32_FIND_DATA struFindFileData;
-    hFindFile = FindFirstFile((strLogPath + TEXT("*")).c_str(), &struFindFileData);
-    if (hFindFile == INVALID_HANDLE_VALUE)
-    {
-        return;
-    }
-    do
-    {
-        if (!cy_tcscmp(struFindFileData.cFileName, TEXT(".")) || !cy_tcscmp(struFindFileData.cFileName, TEXT("..")))
-        {
-            continue;
-        }
-
-        if (0 != (struFindFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
-        {
-            EnumLogFile(strLogPath + LOG_SEPARATOR + struFindFileData.cFileName + LOG_SEPARATOR, vecLogList);
-        }
-        else
-        {
-            if (cy_strstr(struFindFileData.cFileName, TEXT(".log")))
-            {
-                vecLogList.push_back(strLogPath + struFindFileData.cFileName);
-            }
-        }
-    } while (FindNextFile(hFindFile, &struFindFileData));
-
-#else
-    DIR* dir = opendir(strLogPath.c_str());
-    if (!dir)
-    {
-        return;
-    }
-    dirent* p = nullptr;
-    while ((p = readdir(dir)) != nullptr)
-    {
-        // Skip "." and ".." directories
-        if (strcmp(p->d_name, ".") == 0 || strcmp(p->d_name, "..") == 0)
-        {
-            continue;
-        }
-
-        TString strFullPath = strLogPath + p->d_name;
-        struct stat s;
-        if (stat(strFullPath.c_str(), &s) == 0)
-        {
-            if (S_ISDIR(s.st_mode))
-            {
-                EnumLogFile(strFullPath + "/", vecLogList);
-            }
-            else
-            {
-                // Only add .log files
-                std::string strName = p->d_name;
-                if (strName.find(".log") != std::string::npos)
-                {
-                    vecLogList.push_back(strLogPath + p->d_name);
-                }
-            }
-        }
-    }
-    closedir(dir);
-#endif
-}
-
-/**
- * @brief Enumerate files in the specified directory.
-*/
-void CYLoggerClearLogFile::EnumNotLogFile(TString strLogPath, std::list<TString>& vecNotLogList)
-{
-#ifdef CYLOGGER_WIN_OS
-    HANDLE hFindFile = INVALID_HANDLE_VALUE;
-    WIN32_FIND_DATA struFindFileData;
-    hFindFile = FindFirstFile((strLogPath + TEXT("*")).c_str(), &struFindFileData);
-    if (hFindFile == INVALID_HANDLE_VALUE)
-    {
-        return;
-    }
-    do
-    {
-        if (!cy_tcscmp(struFindFileData.cFileName, TEXT(".")) || !cy_tcscmp(struFindFileData.cFileName, TEXT("..")))
-        {
-            continue;
-        }
-
-        if (0 != (struFindFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
-        {
-            EnumNotLogFile(strLogPath + LOG_SEPARATOR + struFindFileData.cFileName + LOG_SEPARATOR, vecNotLogList);
-        }
-        else
-        {
-            if (!cy_strstr(struFindFileData.cFileName, TEXT(".log")))
-            {
-                vecNotLogList.push_back(strLogPath + struFindFileData.cFileName);
-            }
-        }
-    } while (FindNextFile(hFindFile, &struFindFileData));
-#else
-    DIR* dir = opendir(strLogPath.c_str());
-    if (!dir)
-    {
-        return;
-    }
-    dirent* p = nullptr;
-    while ((p = readdir(dir)) != nullptr)
-    {
-        // Skip "." and ".." directories
-        if (strcmp(p->d_name, ".") == 0 || strcmp(p->d_name, "..") == 0)
-        {
-            continue;
-        }
-
-        TString strFullPath = strLogPath + p->d_name;
-        struct stat s;
-        if (stat(strFullPath.c_str(), &s) == 0)
-        {
-            if (S_ISDIR(s.st_mode))
-            {
-                EnumNotLogFile(strFullPath + "/", vecNotLogList);
-            }
-            else
-            {
-                std::string strName = p->d_name;
-                if (strName.find(".log") == std::string::npos)
-                {
-                    vecNotLogList.push_back(strLogPath + p->d_name);
-                }
-            }
-        }
-    }
-    closedir(dir);
-#endif
-}
-
-/**
- * @brief Get log file information.
-*/
-void CYLoggerClearLogFile::GetFileInfomation(CYLogFileInfo& objLogFileInfo)
-{
-    EXCEPTION_BEGIN
-    {
-        // Get file size
-        objLogFileInfo.nSize = CYPublicFunction::GetFileSize(objLogFileInfo.strLogFilePath);
-
-    // Get create time
-    objLogFileInfo.tpCreateTime = CYPublicFunction::GetLastWriteTime(objLogFileInfo.strLogFilePath);
-    }
-        EXCEPTION_END
-}
-
 /**
  * @brief Get Check Name.
 */
@@ -497,33 +327,4 @@ bool upperEqual(_Tp a, _Tp b)
     return ((islower(a) ? a - 32 : a) == (islower(b) ? b - 32 : b)) ? true : false;
 }
 
-/**
- * @brief Get Log file type.
-*/
-ELogType CYLoggerClearLogFile::GetLogFileType(const std::list<CYLogFileInfo>& lstLogFile, const TString& strCheckName)
-{
-    ELogType eLogType = ELogType::LOG_TYPE_NONE;
-    for (const auto& objFileInfo : lstLogFile)
-    {
-        if (strCheckName.compare(objFileInfo.strCheckName) == 0)
-            return objFileInfo.eLogType;;
-    }
-    return eLogType;
-}
-
-/**
- * @brief Determine whether the file is used.
-*/
-bool CYLoggerClearLogFile::IsUsedLogFile(const std::list<CYLogFileInfo>& lstUsedLogFile, const TString& strFileName)
-{
-    for (const auto& objFileInfo : lstUsedLogFile)
-    {
-        if (objFileInfo.strLogFilePath.compare(strFileName) == 0)
-        {
-            return true;
-        }
-    }
-    return false;
-}
-
 CYLOGGER_NAMESPACE_END
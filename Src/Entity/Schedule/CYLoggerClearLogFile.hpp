@@ -47,6 +47,7 @@
 #include "Common/CYPrivateDefine.hpp"
 #include "Entity/Schedule/CYLoggerScheduleDefine.hpp"
 #include "Common/Time/CYTimeElapsed.hpp"
+#include "Entity/Schedule/CYLoggerLogIndex.hpp"
 
 #include <map>
 #include <list>
@@ -72,21 +73,21 @@ public:
     */
     void ProcessClearLog(const std::list<ELogType>& lstLogType);
 
-private:
     /**
-     * @brief Get running log file information.
+     * @brief Get the log files that are no longer written by any appender.
     */
-    void ProcessRunningLogFile(const std::list<ELogType>& lstLogType, std::list<CYLogFileInfo>& lstLogFile);
+    void GetClosedLogFile(const std::list<ELogType>& lstLogType, std::list<TString>& lstClosedFile);
 
+private:
     /**
-     * @brief Get log file information.
+     * @brief Get running log file information.
     */
-    void ProcessPublicLogInfo(const std::list<ELogType>& lstLogType, std::list<TString>& lstLogFile, std::list<TString>& lstNotLogFile);
+    void ProcessRunningLogFile(const std::list<ELogType>& lstLogType, std::list<CYLogFileInfo>& lstLogFile);
 
     /**
-     * @brief Preprocess some data.
+     * @brief Group the indexed log files that are not in use by type, and collect the non-log files.
     */
-    void PreprocessData(const std::list<CYLogFileInfo>& lstUsedLogFile, const std::list<TString>& lstLogFile, FileClassMap& mapLogFileInfo);
+    void PreprocessData(const std::list<CYLogFileInfo>& lstUsedLogFile, FileClassMap& mapLogFileInfo, std::list<TString>& lstNotLogFile);
 
     /**
      * @brief Clean out all non-log files
@@ -114,36 +115,21 @@ private:
     void ProcessClearLogALLSize(FileClassMap& mapLogFileInfo);
 
     /**
-     * @brief Get log file information.
-    */
-    void GetFileInfomation(CYLogFileInfo& objLogFileInfo);
-
-    /**
-     * @brief Enumerate files in the specified directory.
+     * @brief Bring the log directory index up to date.
     */
-    void EnumLogFile(TString strLogPath, std::list<TString>& vecLogList);
-
-    /**
-     * @brief Enumerate files in the specified directory.
-    */
-    void EnumNotLogFile(TString strLogPath, std::list<TString>& vecNotLogList);
-
-    /**
-     * @brief Determine whether the file is used.
-    */
-    bool IsUsedLogFile(const std::list<CYLogFileInfo>& lstUsedLogFile, const TString& strFileName);
+    void RefreshIndex();
 
     /**
      * @brief Get Check Name.
     */
     TString GetCheckName(const TString& strFileName);
 
+private:
     /**
-     * @brief Get Log file type.
+     * @brief Files of the log directory, kept up to date between passes.
     */
-    ELogType GetLogFileType(const std::list<CYLogFileInfo>& lstLogFile, const TString& strCheckName);
+    CYLoggerLogIndex m_objIndex;
 
-private:
     /**
      * @brief first execution.
     */
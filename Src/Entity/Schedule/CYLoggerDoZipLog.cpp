@@ -1,8 +1,19 @@
 #include "Entity/Schedule/CYLoggerDoZipLog.hpp"
-#include "Entity/CYLoggerEntityFactory.hpp"
+#include "Common/Compress/CYLogFileCompressor.hpp"
+#include "Common/CYPublicFunction.hpp"
+
+#include <chrono>
 
 CYLOGGER_NAMESPACE_BEGIN
 
+namespace
+{
+    /**
+     * @brief Suffix of a compressed file that has not been verified yet.
+    */
+    constexpr const TChar* LOG_ZIP_PART_EXT = TEXT(".part");
+}
+
 CYLoggerDoZipLog::CYLoggerDoZipLog()
 {
 
@@ -13,19 +24,80 @@ CYLoggerDoZipLog::~CYLoggerDoZipLog()
 
 }
 
+/**
+ * @brief Load the compression settings.
+*/
 void CYLoggerDoZipLog::SetConfig()
 {
+    m_eCodec = CYLogFileCompressor::GetCodec(LOG_ZIP_CODEC);
+}
+
+/**
+ * @brief Compress closed log files, files written within LOG_ZIP_IDLE_TIME seconds are skipped unless bForce is set.
+*/
+bool CYLoggerDoZipLog::Process(const std::list<TString>& lstClosedFile, bool bForce)
+{
+    if (m_eCodec == ELogZipCodec::LOG_ZIP_NONE)
+        return false;
 
+    // Temporary files are only open inside CompressLogFile, the ones listed here were left by an interrupted compression
+    // or a failed removal, the original is still there.
+    for (const auto& strLogFile : lstClosedFile)
+    {
+        if (IsPartFile(strLogFile))
+            CYPublicFunction::Remove(strLogFile);
+    }
+
+    auto tpNow = std::chrono::system_clock::now();
+    long long nBytes = 0;
+    for (const auto& strLogFile : lstClosedFile)
+    {
+        if (IsPartFile(strLogFile) || CYLogFileCompressor::IsCompressedFile(strLogFile))
+            continue;
+
+        if (!bForce && std::chrono::duration_cast<std::chrono::seconds>(tpNow - CYPublicFunction::GetLastWriteTime(strLogFile)).count() < LOG_ZIP_IDLE_TIME)
+            continue;
+
+        // Bound the time the schedule thread spends here, the rest is compressed at the next call.
+        if (nBytes >= LOG_ZIP_MAX_BYTES)
+            return true;
+
+        nBytes += static_cast<long long>(CYPublicFunction::GetFileSize(strLogFile));
+        CompressLogFile(strLogFile);
+    }
+
+    return false;
 }
 
-void CYLoggerDoZipLog::Process()
+/**
+ * @brief Compress one log file into a temporary file, verify it, then replace the original.
+*/
+bool CYLoggerDoZipLog::CompressLogFile(const TString& strLogFile)
 {
-    // Before compressing the log file, force the creation of a new log file. The log file currently in use may have read permission issues.
-    LoggerEntityFactory()->ForceEntityNewFile();
+    TString strZipFile = strLogFile + CYLogFileCompressor::GetFileExt(m_eCodec);
+    TString strPartFile = strZipFile + LOG_ZIP_PART_EXT;
 
+    bool bSuccess = CYLogFileCompressor::CompressFile(strLogFile, strPartFile, m_eCodec, LOG_ZIP_BLOCK_SIZE)
+        && CYLogFileCompressor::VerifyFile(strLogFile, strPartFile, m_eCodec)
+        && CYPublicFunction::Rename(strPartFile, strZipFile);
 
+    if (!bSuccess)
+    {
+        CYPublicFunction::Remove(strPartFile);
+        return false;
+    }
 
+    CYPublicFunction::Remove(strLogFile);
+    return true;
+}
 
+/**
+ * @brief Determine whether the file was left by an interrupted compression.
+*/
+bool CYLoggerDoZipLog::IsPartFile(const TString& strLogFile)
+{
+    TString strExt = LOG_ZIP_PART_EXT;
+    return strLogFile.size() > strExt.size() && strLogFile.compare(strLogFile.size() - strExt.size(), strExt.size(), strExt) == 0;
 }
 
-CYLOGGER_NAMESPACE_END
\ No newline at end of file
+CYLOGGER_NAMESPACE_END
@@ -46,6 +46,8 @@
 
 #include "Common/CYPrivateDefine.hpp"
 
+#include <list>
+
 CYLOGGER_NAMESPACE_BEGIN
 
 class CYLoggerDoZipLog
@@ -55,8 +57,33 @@ public:
     virtual ~CYLoggerDoZipLog();
 
 public:
+    /**
+     * @brief Load the compression settings.
+    */
     void SetConfig();
-    void Process();
+
+    /**
+     * @brief Compress closed log files, files written within LOG_ZIP_IDLE_TIME seconds are skipped unless bForce is set.
+     *        Stops once LOG_ZIP_MAX_BYTES were compressed and returns true when files are left for the next call.
+    */
+    bool Process(const std::list<TString>& lstClosedFile, bool bForce = false);
+
+private:
+    /**
+     * @brief Compress one log file into a temporary file, verify it, then replace the original.
+    */
+    bool CompressLogFile(const TString& strLogFile);
+
+    /**
+     * @brief Determine whether the file was left by an interrupted compression.
+    */
+    bool IsPartFile(const TString& strLogFile);
+
+private:
+    /**
+     * @brief Codec in use, resolved against the codecs compiled in.
+    */
+    ELogZipCodec m_eCodec = ELogZipCodec::LOG_ZIP_NONE;
 };
 
 CYLOGGER_NAMESPACE_END
@@ -0,0 +1,338 @@
+#include "Entity/Schedule/CYLoggerLogIndex.hpp"
+#include "Common/CYPublicFunction.hpp"
+
+#ifdef CYLOGGER_WIN_OS
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#if defined(CYLOGGER_LINUX_OS)
+#include <sys/inotify.h>
+#endif
+
+CYLOGGER_NAMESPACE_BEGIN
+
+#if defined(CYLOGGER_LINUX_OS)
+/**
+ * @brief Events that change the set of files or their final size.
+*/
+static constexpr uint32_t LOG_INDEX_WATCH_MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+#endif
+
+/**
+ * @brief Whether the name ends in ".log", optionally followed by the suffixes the logger adds itself:
+ *        a compression codec or a standby placeholder, then an unfinished ".part".
+ *        They still count as logs, so clearing non-log files never deletes them.
+*/
+static bool IsLogName(TStringView strName)
+{
+    for (TStringView strSuffix : { TStringView(TEXT(".part")), TStringView(TEXT(".gz")), TStringView(TEXT(".lz")), TStringView(TEXT(".standby")) })
+    {
+        if (strName.ends_with(strSuffix))
+            strName.remove_suffix(strSuffix.size());
+    }
+    return strName.ends_with(TEXT(".log"));
+}
+
+CYLoggerLogIndex::CYLoggerLogIndex()
+    : m_bValid(false)
+    , m_nUTCOffsetHours(0)
+#if defined(CYLOGGER_LINUX_OS)
+    , m_nNotify(-1)
+#endif
+{
+}
+
+CYLoggerLogIndex::~CYLoggerLogIndex()
+{
+    Close();
+}
+
+/**
+ * @brief Bring the index of strLogPath up to date, a full scan is only done the first time, after a queue overflow or without inotify.
+*/
+void CYLoggerLogIndex::Refresh(const TString& strLogPath)
+{
+    if (strLogPath != m_strLogPath)
+    {
+        m_strLogPath = strLogPath;
+        m_bValid = false;
+    }
+
+#if defined(CYLOGGER_LINUX_OS)
+    if (m_bValid && m_nNotify >= 0 && ReadEvents())
+    {
+        for (const auto& objDirty : m_setDirty)
+        {
+            UpdateFile(objDirty.first, objDirty.second);
+        }
+        m_setDirty.clear();
+        return;
+    }
+#endif
+
+    Rescan();
+}
+
+/**
+ * @brief Indexed files by full path.
+*/
+const std::map<TString, CYLoggerLogIndex::STIndexFile>& CYLoggerLogIndex::GetFiles() const
+{
+    return m_mapFile;
+}
+
+/**
+ * @brief Delete an indexed file through the cached directory descriptor and drop it from the index.
+*/
+bool CYLoggerLogIndex::Remove(const TString& strFilePath)
+{
+    auto iter = m_mapFile.find(strFilePath);
+    if (iter == m_mapFile.end())
+        return CYPublicFunction::Remove(strFilePath);
+
+#ifdef CYLOGGER_WIN_OS
+    bool bRet = CYPublicFunction::Remove(strFilePath);
+#else
+    int nDirFd = GetDirFd(iter->second.strDir);
+    bool bRet = nDirFd >= 0 ? ::unlinkat(nDirFd, iter->second.strName.c_str(), 0) == 0 : CYPublicFunction::Remove(strFilePath);
+#endif
+    m_mapFile.erase(iter);
+    return bRet;
+}
+
+/**
+ * @brief Drop the index and scan the log directory again.
+*/
+void CYLoggerLogIndex::Rescan()
+{
+    Close();
+    m_mapFile.clear();
+    m_nUTCOffsetHours = CYPublicFunction::GetLocalUTCOffsetHours();
+
+#if defined(CYLOGGER_LINUX_OS)
+    // Changes made during the scan are applied by the next refresh, a failed watch clears m_bValid again.
+    m_nNotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    m_bValid = m_nNotify >= 0;
+#endif
+
+    if (!m_strLogPath.empty())
+        ScanDir(m_strLogPath);
+}
+
+/**
+ * @brief Watch and scan one directory and its sub directories.
+*/
+void CYLoggerLogIndex::ScanDir(const TString& strDir)
+{
+#ifdef CYLOGGER_WIN_OS
+    HANDLE hFindFile = INVALID_HANDLE_VALUE;
+    WIN32_FIND_DATA struFindFileData;
+    hFindFile = FindFirstFile((strDir + TEXT("*")).c_str(), &struFindFileData);
+    if (hFindFile == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+    do
+    {
+        if (!cy_tcscmp(struFindFileData.cFileName, TEXT(".")) || !cy_tcscmp(struFindFileData.cFileName, TEXT("..")))
+        {
+            continue;
+        }
+
+        if (0 != (struFindFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+        {
+            ScanDir(strDir + LOG_SEPARATOR + struFindFileData.cFileName + LOG_SEPARATOR);
+        }
+        else
+        {
+            STIndexFile objFile;
+            objFile.strDir = strDir;
+            objFile.strName = struFindFileData.cFileName;
+            objFile.bLog = IsLogName(struFindFileData.cFileName);
+            objFile.nSize = (static_cast<uint64_t>(struFindFileData.nFileSizeHigh) << 32) | struFindFileData.nFileSizeLow;
+            objFile.tpWriteTime = CYPublicFunction::GetLastWriteTime(strDir + struFindFileData.cFileName);
+            m_mapFile[strDir + struFindFileData.cFileName] = std::move(objFile);
+        }
+    } while (FindNextFile(hFindFile, &struFindFileData));
+    FindClose(hFindFile);
+#else
+#if defined(CYLOGGER_LINUX_OS)
+    // Watch before reading, so no file created during the scan is missed.
+    if (m_nNotify >= 0)
+    {
+        int nWatch = inotify_add_watch(m_nNotify, strDir.c_str(), LOG_INDEX_WATCH_MASK);
+        if (nWatch >= 0)
+            m_mapWatch[nWatch] = strDir;
+        else
+            m_bValid = false;
+    }
+#endif
+
+    int nDirFd = GetDirFd(strDir);
+    if (nDirFd < 0)
+        return;
+
+    // fdopendir takes over the descriptor it is given, the cached one stays open.
+    int nReadFd = ::dup(nDirFd);
+    DIR* dir = nReadFd >= 0 ? ::fdopendir(nReadFd) : nullptr;
+    if (!dir)
+    {
+        if (nReadFd >= 0) ::close(nReadFd);
+        return;
+    }
+
+    dirent* p = nullptr;
+    while ((p = readdir(dir)) != nullptr)
+    {
+        // Skip "." and ".." directories
+        if (strcmp(p->d_name, ".") == 0 || strcmp(p->d_name, "..") == 0)
+        {
+            continue;
+        }
+
+        struct stat s;
+        if (::fstatat(nDirFd, p->d_name, &s, 0) != 0)
+            continue;
+
+        if (S_ISDIR(s.st_mode))
+        {
+            ScanDir(strDir + p->d_name + "/");
+        }
+        else
+        {
+            STIndexFile objFile;
+            objFile.strDir = strDir;
+            objFile.strName = p->d_name;
+            objFile.bLog = IsLogName(objFile.strName);
+            objFile.nSize = static_cast<uint64_t>(s.st_size);
+            objFile.tpWriteTime = std::chrono::system_clock::from_time_t(s.st_mtime) + std::chrono::hours(m_nUTCOffsetHours);
+            m_mapFile[strDir + p->d_name] = std::move(objFile);
+        }
+    }
+    closedir(dir);
+#endif
+}
+
+/**
+ * @brief Stat one file again, the entry is added, updated or dropped.
+*/
+void CYLoggerLogIndex::UpdateFile(const TString& strDir, const TString& strName)
+{
+#ifndef CYLOGGER_WIN_OS
+    const TString strPath = strDir + strName;
+    int nDirFd = GetDirFd(strDir);
+    struct stat s;
+    if (nDirFd < 0 || ::fstatat(nDirFd, strName.c_str(), &s, 0) != 0 || !S_ISREG(s.st_mode))
+    {
+        m_mapFile.erase(strPath);
+        return;
+    }
+
+    STIndexFile& objFile = m_mapFile[strPath];
+    objFile.strDir = strDir;
+    objFile.strName = strName;
+    objFile.bLog = IsLogName(strName);
+    objFile.nSize = static_cast<uint64_t>(s.st_size);
+    objFile.tpWriteTime = std::chrono::system_clock::from_time_t(s.st_mtime) + std::chrono::hours(m_nUTCOffsetHours);
+#endif
+}
+
+/**
+ * @brief Drain the pending inotify events into m_setDirty, false if the index has to be rebuilt.
+*/
+bool CYLoggerLogIndex::ReadEvents()
+{
+#if defined(CYLOGGER_LINUX_OS)
+    alignas(struct inotify_event) char szBuffer[16 * 1024];
+    while (true)
+    {
+        ssize_t nRead = ::read(m_nNotify, szBuffer, sizeof(szBuffer));
+        if (nRead < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        if (nRead == 0)
+            return false;
+
+        for (char* p = szBuffer; p < szBuffer + nRead; )
+        {
+            const struct inotify_event* pEvent = reinterpret_cast<const struct inotify_event*>(p);
+            p += sizeof(struct inotify_event) + pEvent->len;
+
+            // Lost events, or a watched directory went away.
+            if (pEvent->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+                return false;
+
+            auto iterWatch = m_mapWatch.find(pEvent->wd);
+            if (iterWatch == m_mapWatch.end() || pEvent->len == 0)
+                continue;
+
+            if (pEvent->mask & IN_ISDIR)
+            {
+                // A sub directory moved away takes its files along, rebuild. A new one is scanned and watched.
+                if (pEvent->mask & (IN_DELETE | IN_MOVED_FROM))
+                    return false;
+                ScanDir(iterWatch->second + pEvent->name + "/");
+                continue;
+            }
+
+            m_setDirty.emplace(iterWatch->second, pEvent->name);
+        }
+    }
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Close the watches and the cached directory descriptors.
+*/
+void CYLoggerLogIndex::Close()
+{
+#if defined(CYLOGGER_LINUX_OS)
+    if (m_nNotify >= 0)
+    {
+        ::close(m_nNotify);
+        m_nNotify = -1;
+    }
+    m_mapWatch.clear();
+    m_setDirty.clear();
+#endif
+
+#ifndef CYLOGGER_WIN_OS
+    for (auto& objDirFd : m_mapDirFd)
+    {
+        ::close(objDirFd.second);
+    }
+    m_mapDirFd.clear();
+#endif
+    m_bValid = false;
+}
+
+#ifndef CYLOGGER_WIN_OS
+/**
+ * @brief Cached descriptor of a directory, opened on first use.
+*/
+int CYLoggerLogIndex::GetDirFd(const TString& strDir)
+{
+    auto iter = m_mapDirFd.find(strDir);
+    if (iter != m_mapDirFd.end())
+        return iter->second;
+
+    int nDirFd = ::open(strDir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (nDirFd >= 0)
+        m_mapDirFd[strDir] = nDirFd;
+    return nDirFd;
+}
+#endif
+
+CYLOGGER_NAMESPACE_END
@@ -0,0 +1,176 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LOGGER_LOG_INDEX_HPP__
+#define __CY_LOGGER_LOG_INDEX_HPP__
+
+#include "Common/CYPrivateDefine.hpp"
+
+#include <chrono>
+#include <map>
+#include <set>
+#include <utility>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief In-memory index of the files under the log directory. It is built by one scan and then kept up to date from
+ *        inotify events on Linux, so a cleanup pass only restats the files that changed. Other systems rescan on every refresh.
+*/
+class CYLoggerLogIndex
+{
+public:
+    /**
+     * @brief Indexed file.
+    */
+    struct STIndexFile
+    {
+        TString  strDir;                                        ///< Directory, ending with a separator.
+        TString  strName;                                       ///< File name.
+        bool     bLog = false;                                  ///< The name ends in ".log", a compression, standby or ".part" suffix may follow.
+        uint64_t nSize = 0;                                     ///< Size in bytes.
+        std::chrono::system_clock::time_point tpWriteTime;      ///< Last write time, in the clock of CYPublicFunction::GetLastWriteTime.
+    };
+
+public:
+    CYLoggerLogIndex();
+    virtual ~CYLoggerLogIndex();
+
+public:
+    /**
+     * @brief Bring the index of strLogPath up to date, a full scan is only done the first time, after a queue overflow or without inotify.
+    */
+    void Refresh(const TString& strLogPath);
+
+    /**
+     * @brief Indexed files by full path.
+    */
+    const std::map<TString, STIndexFile>& GetFiles() const;
+
+    /**
+     * @brief Delete an indexed file through the cached directory descriptor and drop it from the index.
+    */
+    bool Remove(const TString& strFilePath);
+
+private:
+    /**
+     * @brief Drop the index and scan the log directory again.
+    */
+    void Rescan();
+
+    /**
+     * @brief Watch and scan one directory and its sub directories.
+    */
+    void ScanDir(const TString& strDir);
+
+    /**
+     * @brief Stat one file again, the entry is added, updated or dropped.
+    */
+    void UpdateFile(const TString& strDir, const TString& strName);
+
+    /**
+     * @brief Drain the pending inotify events into m_setDirty, false if the index has to be rebuilt.
+    */
+    bool ReadEvents();
+
+    /**
+     * @brief Close the watches and the cached directory descriptors.
+    */
+    void Close();
+
+#ifndef CYLOGGER_WIN_OS
+    /**
+     * @brief Cached descriptor of a directory, opened on first use.
+    */
+    int GetDirFd(const TString& strDir);
+#endif
+
+private:
+    /**
+     * @brief Indexed log directory, ending with a separator.
+    */
+    TString m_strLogPath;
+
+    /**
+     * @brief Indexed files by full path.
+    */
+    std::map<TString, STIndexFile> m_mapFile;
+
+    /**
+     * @brief The index matches the directory apart from the pending events.
+    */
+    bool m_bValid;
+
+    /**
+     * @brief Local UTC offset applied to write times, taken at the last full scan.
+    */
+    int m_nUTCOffsetHours;
+
+#ifndef CYLOGGER_WIN_OS
+    /**
+     * @brief Directory descriptors used by fstatat and unlinkat.
+    */
+    std::map<TString, int> m_mapDirFd;
+#endif
+
+#if defined(CYLOGGER_LINUX_OS)
+    /**
+     * @brief inotify descriptor, -1 if not available.
+    */
+    int m_nNotify;
+
+    /**
+     * @brief Watched directory by watch descriptor.
+    */
+    std::map<int, TString> m_mapWatch;
+
+    /**
+     * @brief Directory and name of the files changed since the last refresh.
+    */
+    std::set<std::pair<TString, TString>> m_setDirty;
+#endif
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif // __CY_LOGGER_LOG_INDEX_HPP__
@@ -0,0 +1,437 @@
+#include "Entity/Schedule/CYLoggerMetricsExporter.hpp"
+#include "Entity/CYLoggerEntityFactory.hpp"
+#include "Common/CYPublicFunction.hpp"
+#include "Common/Exception/CYExceptionLogFile.hpp"
+#include "Statistics/CYLockProfile.hpp"
+#include "Common/Time/CYTimeElapsed.hpp"
+
+#ifndef CYLOGGER_WIN_OS
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief One metric family, rendered with one sample per appender.
+*/
+struct STMetricFamily
+{
+    const char* pszName;
+    const char* pszType;
+    const char* pszUnit;
+    const char* pszHelp;
+    double (*fnValue)(const STAppenderStats& objStats);
+};
+
+static const STMetricFamily g_arrFamily[] =
+{
+    { "cylogger_lines",             "counter",  "",         "Lines written.",                                       [](const STAppenderStats& s) { return static_cast<double>(s.nLine); } },
+    { "cylogger_bytes",             "counter",  "bytes",    "Bytes written.",                                       [](const STAppenderStats& s) { return static_cast<double>(s.nByte); } },
+    { "cylogger_dropped_lines",     "counter",  "",         "Lines dropped because the sink was full or unreachable.", [](const STAppenderStats& s) { return static_cast<double>(s.nDrop); } },
+    { "cylogger_batches",           "counter",  "",         "Batches written.",                                     [](const STAppenderStats& s) { return static_cast<double>(s.nBatchCount); } },
+    { "cylogger_write_seconds",     "counter",  "seconds",  "Time spent formatting and writing lines.",             [](const STAppenderStats& s) { return s.nWriteTime / 1e9; } },
+    { "cylogger_flush_seconds",     "counter",  "seconds",  "Time spent in the end of batch flush.",                [](const STAppenderStats& s) { return s.nFlushTime / 1e9; } },
+    { "cylogger_lines_per_second",  "gauge",    "",         "Current write rate.",                                  [](const STAppenderStats& s) { return s.fCurrentFps; } },
+    { "cylogger_queue_depth",       "gauge",    "",         "Messages taken over by the last flip of the queue.",   [](const STAppenderStats& s) { return static_cast<double>(s.nQueueDepth); } },
+    { "cylogger_queue_depth_max",   "gauge",    "",         "Largest queue depth seen.",                            [](const STAppenderStats& s) { return static_cast<double>(s.nQueueDepthMax); } },
+    { "cylogger_batch_lines_max",   "gauge",    "",         "Lines of the largest batch.",                          [](const STAppenderStats& s) { return static_cast<double>(s.nBatchMax); } },
+    { "cylogger_latency_max_seconds", "gauge",  "seconds",  "Largest enqueue to write latency.",                    [](const STAppenderStats& s) { return s.objLatency.nMax / 1e9; } },
+};
+
+static const char* g_arrTypeName[ELogType::LOG_TYPE_MAX] = { "console", "trace", "debug", "info", "warn", "error", "fatal", "main", "remote", "sys" };
+
+/**
+ * @brief Append a sample value, integers are written without exponent.
+*/
+static void AppendValue(std::string& strText, double fValue)
+{
+    char szValue[32];
+    if (fValue == std::floor(fValue) && std::fabs(fValue) < 9007199254740992.0)
+        std::snprintf(szValue, sizeof(szValue), "%.0f", fValue);
+    else
+        std::snprintf(szValue, sizeof(szValue), "%.9g", fValue);
+    strText += szValue;
+}
+
+/**
+ * @brief Append the labels identifying one appender.
+*/
+static void AppendLabels(std::string& strText, const STAppenderStats& objStats, const char* pszQuantile)
+{
+    strText += "{appender=\"";
+    strText += objStats.szName;
+    strText += "\",type=\"";
+    strText += (objStats.eLogType >= 0 && objStats.eLogType < ELogType::LOG_TYPE_MAX) ? g_arrTypeName[objStats.eLogType] : "unknown";
+    strText += "\"";
+    if (pszQuantile)
+    {
+        strText += ",quantile=\"";
+        strText += pszQuantile;
+        strText += "\"";
+    }
+    strText += "}";
+}
+
+/**
+ * @brief Append a summary of one latency per lock name, labelled by the lock.
+*/
+static void AppendLockSummary(std::string& strText, const std::vector<STLockStats>& vecStats, const char* pszName, STLatencyStats STLockStats::* pLatency)
+{
+    for (const STLockStats& objStats : vecStats)
+    {
+        const STLatencyStats& objLatency = objStats.*pLatency;
+        const std::string strLabel = std::string("{lock=\"") + objStats.szName + "\"";
+        const std::pair<const char*, uint64_t> arrQuantile[] =
+        {
+            { "0.5", objLatency.nP50 }, { "0.9", objLatency.nP90 }, { "0.99", objLatency.nP99 }, { "0.999", objLatency.nP999 },
+        };
+        for (const auto& [pszQuantile, nLatency] : arrQuantile)
+        {
+            strText += pszName + strLabel + ",quantile=\"" + pszQuantile + "\"} ";
+            AppendValue(strText, nLatency / 1e9);
+            strText += "\n";
+        }
+        strText += std::string(pszName) + "_count" + strLabel + "} ";
+        AppendValue(strText, static_cast<double>(objLatency.nCount));
+        strText += "\n";
+    }
+}
+
+/**
+ * @brief Append the TYPE, UNIT and HELP lines of a family. Prometheus 0.0.4 names a counter family after its _total sample.
+*/
+static void AppendHeader(std::string& strText, const char* pszName, const char* pszType, const char* pszUnit, const char* pszHelp, bool bOpenMetrics)
+{
+    const bool bCounter = std::strcmp(pszType, "counter") == 0;
+    const std::string strFamily = std::string(pszName) + ((bCounter && !bOpenMetrics) ? "_total" : "");
+
+    strText += "# TYPE " + strFamily + " " + pszType + "\n";
+    if (bOpenMetrics && pszUnit[0])
+        strText += "# UNIT " + strFamily + " " + pszUnit + "\n";
+    strText += "# HELP " + strFamily + " " + pszHelp + "\n";
+}
+
+CYLoggerMetricsExporter::CYLoggerMetricsExporter()
+{
+}
+
+CYLoggerMetricsExporter::~CYLoggerMetricsExporter()
+{
+    Close();
+}
+
+/**
+ * @brief Set the metrics file and HTTP port, any thread, applied by the next Process.
+*/
+void CYLoggerMetricsExporter::SetConfig(const TString& strFile, int nPort)
+{
+    IfTrueThrow(nPort < 0 || nPort > 65535, TEXT("nPort out of range."));
+
+    LockGuard locker(m_mutexConfig);
+    m_strPendingFile = strFile;
+    m_nPendingPort = nPort;
+    m_bPending = true;
+}
+
+/**
+ * @brief Answer the pending HTTP requests and rewrite the file once its interval has passed, schedule thread only.
+*/
+void CYLoggerMetricsExporter::Process()
+{
+    {
+        LockGuard locker(m_mutexConfig);
+        if (m_bPending)
+        {
+            if (m_nPendingPort != m_nPort)
+            {
+                Close();
+                m_bListenTried = false;
+            }
+            m_strFile = m_strPendingFile;
+            m_nPort = m_nPendingPort;
+            m_bFileWritten = false;
+            m_bPending = false;
+        }
+    }
+
+    if (m_nPort > 0 && m_nListen < 0 && (!m_bListenTried || m_objListenTime.ElapsedSeconds() >= LOG_METRICS_INTERVAL))
+    {
+        Listen();
+    }
+
+    if (m_nListen >= 0)
+    {
+        Serve();
+    }
+
+    if (!m_strFile.empty() && (!m_bFileWritten || m_objFileTime.ElapsedSeconds() >= LOG_METRICS_INTERVAL))
+    {
+        WriteFile();
+        m_bFileWritten = true;
+        m_objFileTime.Reset();
+    }
+}
+
+/**
+ * @brief Close the endpoint.
+*/
+void CYLoggerMetricsExporter::Close()
+{
+#ifndef CYLOGGER_WIN_OS
+    if (m_nListen >= 0)
+    {
+        ::close(m_nListen);
+        m_nListen = -1;
+    }
+#endif
+}
+
+/**
+ * @brief Render the statistics of all appenders.
+*/
+void CYLoggerMetricsExporter::Render(std::string& strText, bool bOpenMetrics)
+{
+    std::vector<STAppenderStats> vecStats;
+    LoggerEntityFactory()->GetEntityStats(vecStats);
+
+    strText.clear();
+    for (const STMetricFamily& objFamily : g_arrFamily)
+    {
+        AppendHeader(strText, objFamily.pszName, objFamily.pszType, objFamily.pszUnit, objFamily.pszHelp, bOpenMetrics);
+        const bool bCounter = std::strcmp(objFamily.pszType, "counter") == 0;
+        for (const STAppenderStats& objStats : vecStats)
+        {
+            strText += objFamily.pszName;
+            if (bCounter)
+                strText += "_total";
+            AppendLabels(strText, objStats, nullptr);
+            strText += " ";
+            AppendValue(strText, objFamily.fnValue(objStats));
+            strText += "\n";
+        }
+    }
+
+    // The quantiles are read from the latency histogram without resetting it.
+    AppendHeader(strText, "cylogger_latency_seconds", "summary", "seconds", "Enqueue to write latency.", bOpenMetrics);
+    for (const STAppenderStats& objStats : vecStats)
+    {
+        const std::pair<const char*, uint64_t> arrQuantile[] =
+        {
+            { "0.5", objStats.objLatency.nP50 }, { "0.9", objStats.objLatency.nP90 }, { "0.99", objStats.objLatency.nP99 }, { "0.999", objStats.objLatency.nP999 },
+        };
+        for (const auto& [pszQuantile, nLatency] : arrQuantile)
+        {
+            strText += "cylogger_latency_seconds";
+            AppendLabels(strText, objStats, pszQuantile);
+            strText += " ";
+            AppendValue(strText, nLatency / 1e9);
+            strText += "\n";
+        }
+        strText += "cylogger_latency_seconds_count";
+        AppendLabels(strText, objStats, nullptr);
+        strText += " ";
+        AppendValue(strText, static_cast<double>(objStats.objLatency.nCount));
+        strText += "\n";
+    }
+
+    if constexpr (LOG_LOCK_PROFILE)
+    {
+        std::vector<STLockStats> vecLock;
+        CYLockProfile::GetStats(vecLock, false);
+
+        const struct { const char* pszName; const char* pszHelp; uint64_t STLockStats::* pCounter; } arrCounter[] =
+        {
+            { "cylogger_lock_acquires",     "Acquisitions of the named lock.",                  &STLockStats::nAcquire },
+            { "cylogger_lock_contended",    "Acquisitions that found the named lock held.",     &STLockStats::nContend },
+        };
+        for (const auto& [pszName, pszHelp, pCounter] : arrCounter)
+        {
+            AppendHeader(strText, pszName, "counter", "", pszHelp, bOpenMetrics);
+            for (const STLockStats& objStats : vecLock)
+            {
+                strText += std::string(pszName) + "_total{lock=\"" + objStats.szName + "\"} ";
+                AppendValue(strText, static_cast<double>(objStats.*pCounter));
+                strText += "\n";
+            }
+        }
+
+        AppendHeader(strText, "cylogger_lock_wait_seconds", "summary", "seconds", "Wait of the contended acquisitions of the named lock.", bOpenMetrics);
+        AppendLockSummary(strText, vecLock, "cylogger_lock_wait_seconds", &STLockStats::objWait);
+        AppendHeader(strText, "cylogger_lock_hold_seconds", "summary", "seconds", "Time the named lock was held.", bOpenMetrics);
+        AppendLockSummary(strText, vecLock, "cylogger_lock_hold_seconds", &STLockStats::objHold);
+    }
+
+    if (bOpenMetrics)
+        strText += "# EOF\n";
+}
+
+/**
+ * @brief Rewrite the metrics file through a temporary file, so a collector never reads half a file.
+*/
+void CYLoggerMetricsExporter::WriteFile()
+{
+    Render(m_strText, false);
+
+    const TString strTempFile = m_strFile + TEXT(".tmp");
+    {
+        std::ofstream objFile(strTempFile.c_str(), std::ios::binary | std::ios::trunc);
+        objFile.write(m_strText.data(), static_cast<std::streamsize>(m_strText.size()));
+        if (!objFile)
+        {
+            ExceptionLog("Metrics exporter cannot write the metrics file.");
+            return;
+        }
+    }
+    CYPublicFunction::Rename(strTempFile, m_strFile);
+}
+
+/**
+ * @brief Open the listening socket for m_nPort.
+*/
+void CYLoggerMetricsExporter::Listen()
+{
+    const bool bFirstTry = !m_bListenTried;
+    m_bListenTried = true;
+    m_objListenTime.Reset();
+
+#ifdef CYLOGGER_WIN_OS
+    if (bFirstTry)
+        ExceptionLog("Metrics exporter HTTP endpoint is not supported on Windows, use the metrics file.");
+#else
+    int nSocket = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (nSocket < 0)
+        return;
+    ::fcntl(nSocket, F_SETFD, FD_CLOEXEC);
+    ::fcntl(nSocket, F_SETFL, ::fcntl(nSocket, F_GETFL, 0) | O_NONBLOCK);
+
+    int nReuse = 1;
+    ::setsockopt(nSocket, SOL_SOCKET, SO_REUSEADDR, &nReuse, sizeof(nReuse));
+
+    // Only the local host can scrape, the endpoint has no authentication.
+    sockaddr_in objAddr = {};
+    objAddr.sin_family = AF_INET;
+    objAddr.sin_port = htons(static_cast<uint16_t>(m_nPort));
+    objAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(nSocket, reinterpret_cast<sockaddr*>(&objAddr), sizeof(objAddr)) != 0 || ::listen(nSocket, 16) != 0)
+    {
+        if (bFirstTry)
+            ExceptionLog((std::string("Metrics exporter cannot listen on 127.0.0.1:") + std::to_string(m_nPort) + ", " + std::strerror(errno) + ".").c_str());
+        ::close(nSocket);
+        return;
+    }
+    m_nListen = nSocket;
+#endif
+}
+
+/**
+ * @brief Answer the connections waiting on the listening socket, at most LOG_METRICS_HTTP_CLIENTS of them.
+*/
+void CYLoggerMetricsExporter::Serve()
+{
+#ifndef CYLOGGER_WIN_OS
+    for (int nClient = 0; nClient < LOG_METRICS_HTTP_CLIENTS; ++nClient)
+    {
+        int nSocket = ::accept(m_nListen, nullptr, nullptr);
+        if (nSocket < 0)
+        {
+            if (errno == EINTR)
+            {
+                --nClient;
+                continue;
+            }
+            return;
+        }
+        ::fcntl(nSocket, F_SETFD, FD_CLOEXEC);
+        ::fcntl(nSocket, F_SETFL, ::fcntl(nSocket, F_GETFL, 0) | O_NONBLOCK);
+        Answer(nSocket);
+        ::close(nSocket);
+    }
+#endif
+}
+
+/**
+ * @brief Answer one HTTP request within LOG_METRICS_HTTP_TIMEOUT.
+*/
+void CYLoggerMetricsExporter::Answer(int nSocket)
+{
+#ifndef CYLOGGER_WIN_OS
+    // One deadline covers the whole exchange, so a client trickling bytes cannot hold up the schedule thread.
+    CYTimeElapsed objElapsed;
+    auto fnRemain = [&objElapsed]() { return static_cast<int>((std::max)(LOG_METRICS_HTTP_TIMEOUT - objElapsed.Elapsed(), int64_t(0))); };
+
+    char szRequest[4096];
+    size_t nRequest = 0;
+    while (nRequest < sizeof(szRequest) - 1)
+    {
+        struct pollfd objPoll = { nSocket, POLLIN, 0 };
+        const int nRemain = fnRemain();
+        if (nRemain == 0 || ::poll(&objPoll, 1, nRemain) <= 0)
+            return;
+        const ssize_t nRead = ::recv(nSocket, szRequest + nRequest, sizeof(szRequest) - 1 - nRequest, 0);
+        if (nRead <= 0)
+            return;
+        nRequest += static_cast<size_t>(nRead);
+        szRequest[nRequest] = '\0';
+        if (std::strstr(szRequest, "\r\n\r\n"))
+            break;
+    }
+    szRequest[nRequest] = '\0';
+
+    const bool bMetrics = std::strncmp(szRequest, "GET /metrics ", 13) == 0 || std::strncmp(szRequest, "GET / ", 6) == 0;
+    const bool bOpenMetrics = std::strstr(szRequest, "application/openmetrics-text") != nullptr;
+
+    std::string strBody;
+    std::string strHead;
+    if (bMetrics)
+    {
+        Render(strBody, bOpenMetrics);
+        strHead = "HTTP/1.1 200 OK\r\nContent-Type: ";
+        strHead += bOpenMetrics ? "application/openmetrics-text; version=1.0.0; charset=utf-8" : "text/plain; version=0.0.4; charset=utf-8";
+    }
+    else
+    {
+        strBody = "Not Found\n";
+        strHead = "HTTP/1.1 404 Not Found\r\nContent-Type: text/plain";
+    }
+    strHead += "\r\nContent-Length: " + std::to_string(strBody.size()) + "\r\nConnection: close\r\n\r\n";
+    strHead += strBody;
+
+#ifdef MSG_NOSIGNAL
+    const int nFlags = MSG_NOSIGNAL;
+#else
+    const int nFlags = 0;
+#endif
+    size_t nSent = 0;
+    while (nSent < strHead.size())
+    {
+        const ssize_t nRet = ::send(nSocket, strHead.data() + nSent, strHead.size() - nSent, nFlags);
+        if (nRet > 0)
+        {
+            nSent += static_cast<size_t>(nRet);
+            continue;
+        }
+        if (nRet < 0 && errno == EINTR)
+            continue;
+
+        struct pollfd objPoll = { nSocket, POLLOUT, 0 };
+        const int nRemain = fnRemain();
+        if (nRet < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && nRemain > 0 && ::poll(&objPoll, 1, nRemain) > 0)
+            continue;
+        return;
+    }
+#endif
+}
+
+CYLOGGER_NAMESPACE_END
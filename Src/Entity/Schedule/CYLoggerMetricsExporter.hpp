@@ -0,0 +1,151 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LOGGER_METRICS_EXPORTER_HPP__
+#define __CY_LOGGER_METRICS_EXPORTER_HPP__
+
+#include "Common/CYPrivateDefine.hpp"
+#include "Common/Thread/CYNamedLocker.hpp"
+#include "Common/Time/CYTimeElapsed.hpp"
+
+#include <string>
+#include <vector>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Renders the appender statistics as Prometheus/OpenMetrics text on the schedule thread. The text is written to
+ *        a file for a textfile collector and served on an optional HTTP endpoint bound to localhost.
+*/
+class CYLoggerMetricsExporter
+{
+public:
+    CYLoggerMetricsExporter();
+    virtual ~CYLoggerMetricsExporter();
+
+public:
+    /**
+     * @brief Set the metrics file and HTTP port, any thread, applied by the next Process.
+     * @param strFile file rewritten every LOG_METRICS_INTERVAL seconds, empty disables it.
+     * @param nPort port of the HTTP endpoint on 127.0.0.1, 0 disables it.
+    */
+    void SetConfig(const TString& strFile, int nPort);
+
+    /**
+     * @brief Answer the pending HTTP requests and rewrite the file once its interval has passed, schedule thread only.
+    */
+    void Process();
+
+    /**
+     * @brief Close the endpoint.
+    */
+    void Close();
+
+    /**
+     * @brief Render the statistics of all appenders.
+     * @param bOpenMetrics OpenMetrics 1.0 text, otherwise the Prometheus 0.0.4 text read by the node exporter textfile collector.
+    */
+    static void Render(std::string& strText, bool bOpenMetrics);
+
+private:
+    /**
+     * @brief Rewrite the metrics file through a temporary file, so a collector never reads half a file.
+    */
+    void WriteFile();
+
+    /**
+     * @brief Open the listening socket for m_nPort.
+    */
+    void Listen();
+
+    /**
+     * @brief Answer the connections waiting on the listening socket, at most LOG_METRICS_HTTP_CLIENTS of them.
+    */
+    void Serve();
+
+    /**
+     * @brief Answer one HTTP request within LOG_METRICS_HTTP_TIMEOUT.
+    */
+    void Answer(int nSocket);
+
+private:
+    /**
+     * @brief Guards the pending configuration.
+    */
+    CYNamedLocker m_mutexConfig{ TEXT("CYLoggerMetricsExporter") };
+    TString m_strPendingFile;
+    int m_nPendingPort = 0;
+    bool m_bPending = false;
+
+    /**
+     * @brief Configuration in use, schedule thread only.
+    */
+    TString m_strFile;
+    int m_nPort = 0;
+
+    /**
+     * @brief Listening socket of the HTTP endpoint, -1 when closed.
+    */
+    int m_nListen = -1;
+
+    /**
+     * @brief Time since the last attempt to listen, a failed attempt is retried every LOG_METRICS_INTERVAL seconds.
+    */
+    CYTimeElapsed m_objListenTime;
+    bool m_bListenTried = false;
+
+    /**
+     * @brief Time since the file was last written.
+    */
+    CYTimeElapsed m_objFileTime;
+    bool m_bFileWritten = false;
+
+    /**
+     * @brief Statistics of the last render, kept to reuse its storage.
+    */
+    std::string m_strText;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LOGGER_METRICS_EXPORTER_HPP__
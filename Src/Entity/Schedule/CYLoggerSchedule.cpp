@@ -1,26 +1,35 @@
 #include "Entity/Schedule/CYLoggerSchedule.hpp"
 #include "Entity/Schedule/CYLoggerDoZipLog.hpp"
 #include "Entity/Schedule/CYLoggerClearLogFile.hpp"
+#include "Entity/Schedule/CYLoggerMetricsExporter.hpp"
 #include "CYCommon/Common/Exception/CYException.hpp"
 #include "Common/Exception/CYExceptionLogFile.hpp"
 #include "Common/Time/CYTimeElapsed.hpp"
+#include "Common/Time/CYTscClock.hpp"
+#include "Entity/CYLoggerEntityFactory.hpp"
 
 CYLOGGER_NAMESPACE_BEGIN
 
+CYLoggerSchedule* CYLoggerSchedule::m_pRunning = nullptr;
+CYNamedLocker CYLoggerSchedule::m_mutexRunning{ TEXT("CYLoggerSchedule") };
+
 CYLoggerSchedule::CYLoggerSchedule(std::string_view strName)
     : CYNamedThread(strName)
 {
     m_ptrDoZipLog = MakeUnique<CYLoggerDoZipLog>();
     m_ptrClearLogFile = MakeUnique<CYLoggerClearLogFile>();
+    m_ptrMetrics = MakeUnique<CYLoggerMetricsExporter>();
 
     IfTrueThrow(nullptr == m_ptrDoZipLog, TEXT("m_ptrDoZipLog cannot be empty."));
     IfTrueThrow(nullptr == m_ptrClearLogFile, TEXT("m_ptrClearLogFile cannot be empty."));
+    IfTrueThrow(nullptr == m_ptrMetrics, TEXT("m_ptrMetrics cannot be empty."));
 }
 
 CYLoggerSchedule::~CYLoggerSchedule()
 {
     m_ptrDoZipLog.reset();
     m_ptrClearLogFile.reset();
+    m_ptrMetrics.reset();
 }
 
 /**
@@ -46,6 +55,9 @@ void CYLoggerSchedule::SetRestriction(bool bEnableCheck, bool m_bClearUnLogFile,
 void CYLoggerSchedule::StartSchedule()
 {
     CYNamedThread::StartThread();
+
+    LockGuard locker(m_mutexRunning);
+    m_pRunning = this;
 }
 
 /**
@@ -53,6 +65,12 @@ void CYLoggerSchedule::StartSchedule()
 */
 void CYLoggerSchedule::StopSchedule()
 {
+    {
+        LockGuard locker(m_mutexRunning);
+        if (m_pRunning == this)
+            m_pRunning = nullptr;
+    }
+
     m_objCondition.SignalOne();
     CYNamedThread::StopThread();
 }
@@ -73,6 +91,32 @@ void CYLoggerSchedule::AddLogType(ELogType eLogType)
     m_lstLogType.push_back(eLogType);
 }
 
+/**
+ * @brief Set the metrics file and HTTP port of the exporter, any thread.
+*/
+void CYLoggerSchedule::SetMetrics(const TString& strFile, int nPort)
+{
+    m_ptrMetrics->SetConfig(strFile, nPort);
+
+    // Apply it now rather than at the next interval.
+    m_bWakeUp = true;
+    m_objCondition.SignalOne(true);
+}
+
+/**
+ * @brief Wake the running schedule thread before its interval, used by appenders that need a new standby file.
+*/
+void CYLoggerSchedule::WakeUp()
+{
+    LockGuard locker(m_mutexRunning);
+    if (m_pRunning == nullptr)
+        return;
+
+    // Keep waiting state, the wait predicate consumes the request.
+    m_pRunning->m_bWakeUp = true;
+    m_pRunning->m_objCondition.SignalOne(true);
+}
+
 /**
  * @brief Thread Entry.
 */
@@ -89,13 +133,10 @@ void CYLoggerSchedule::Run()
         m_ptrClearLogFile->ProcessClearLog(m_lstLogType);
     }
 
-    if (m_bEnableUpLoad)
-    {
-        m_ptrDoZipLog->Process();
-        m_bEnableUpLoad = false;
-    }
-
     CYTimeElapsed objDetectionTime;     // Detection interval.
+    CYTimeElapsed objZipTime;           // Compression interval.
+    bool bZipPending = false;           // Files left by the byte limit of the last compression pass.
+    bool bZipForce = false;             // The pending files belong to a forced pass.
     while (CYNamedThread::IsRunning())
     {
         EXCEPTION_BEGIN
@@ -103,23 +144,50 @@ void CYLoggerSchedule::Run()
             // Upload Log File.
             if (m_bEnableUpLoad)
             {
-                m_ptrDoZipLog->Process();
+                // Before compressing the log file, force the creation of a new log file. The log file currently in use may have read permission issues.
+                // The wait is bounded, an appender stuck on its output never holds up the schedule thread.
+                LoggerEntityFactory()->ForceEntityNewFile(LOG_NEW_FILE_TIMEOUT);
+                bZipForce = ProcessZipLog(true);
+                bZipPending = bZipForce;
                 m_bEnableUpLoad = false;
             }
 
-            // Timeout detection.
-            if (m_objCondition.WaitForEvent(m_nLimitTimeClearLog * 1000) != RetCode::ERR_COND_TIMEOUT)
-                continue;
+            // Timeout detection, an appender wakes the thread early after a rotation.
+            m_objCondition.WaitForEvent(LOG_SCHEDULE_INTERVAL, [this]() { return m_bWakeUp.exchange(false); });
+
+            // Thread stopped.
+            if (!CYNamedThread::IsRunning()) break;
+
+            // Close rotated files and prepare standby files of the appenders.
+            LoggerEntityFactory()->ScheduleEntity();
+
+            // Export the statistics.
+            m_ptrMetrics->Process();
+
+            // Recalibrate TSC clock, unless a log thread just did.
+            if constexpr (LOG_TIME_CLOCK_MODE == CYLOGGER_NAMESPACE::ELogClockMode::LOG_CLOCK_TSC)
+            {
+                CYTscClock::CalibrateIfDue();
+            }
+
+            // Compress rotated log files.
+            if constexpr (LOG_ZIP_CODEC != CYLOGGER_NAMESPACE::ELogZipCodec::LOG_ZIP_NONE)
+            {
+                // A pass that hit LOG_ZIP_MAX_BYTES goes on at the next wake up.
+                if (bZipPending || objZipTime.ElapsedSeconds() >= LOG_ZIP_CHECK_TIME)
+                {
+                    bZipPending = ProcessZipLog(bZipForce);
+                    bZipForce = bZipForce && bZipPending;
+                    objZipTime.Reset();
+                }
+            }
 
             // Detection switch is off.
             if (!m_bEnableCheck)
                 continue;
 
-            // Thread stopped.
-            if (!CYNamedThread::IsRunning()) break;
-
             // Detection Log File.
-            if (objDetectionTime.Elapsed() >= m_nLimitTimeClearLog)
+            if (objDetectionTime.ElapsedSeconds() >= m_nLimitTimeClearLog)
             {
                 // Clear Log File.
                 m_ptrClearLogFile->ProcessClearLog(m_lstLogType);
@@ -129,6 +197,18 @@ void CYLoggerSchedule::Run()
         }
         EXCEPTION_END
     }
+
+    m_ptrMetrics->Close();
+}
+
+/**
+ * @brief Compress the rotated log files.
+*/
+bool CYLoggerSchedule::ProcessZipLog(bool bForce)
+{
+    std::list<TString> lstClosedFile;
+    m_ptrClearLogFile->GetClosedLogFile(m_lstLogType, lstClosedFile);
+    return m_ptrDoZipLog->Process(lstClosedFile, bForce);
 }
 
 CYLOGGER_NAMESPACE_END
\ No newline at end of file
@@ -47,13 +47,16 @@
 #include "Common/CYPrivateDefine.hpp"
 #include "Common/Thread/CYNamedThread.hpp"
 #include "Common/Thread/CYNamedCondition.hpp"
+#include "Common/Thread/CYNamedLocker.hpp"
 
 #include <list>
+#include <atomic>
 
 CYLOGGER_NAMESPACE_BEGIN
 
 class CYLoggerDoZipLog;
 class CYLoggerClearLogFile;
+class CYLoggerMetricsExporter;
 class CYLoggerSchedule : public CYNamedThread
 {
 public:
@@ -86,12 +89,27 @@ public:
     */
     void AddLogType(ELogType eLogType);
 
+    /**
+     * @brief Set the metrics file and HTTP port of the exporter, any thread.
+    */
+    void SetMetrics(const TString& strFile, int nPort);
+
+    /**
+     * @brief Wake the running schedule thread before its interval, used by appenders that need a new standby file.
+    */
+    static void WakeUp();
+
 private:
     /**
      * @brief Thread Entry.
     */
     virtual void Run() override;
 
+    /**
+     * @brief Compress the rotated log files, returns true when the byte limit of the pass left files over.
+    */
+    bool ProcessZipLog(bool bForce);
+
 private:
     /**
      * @brief Detection switch is enabled by default.
@@ -172,6 +190,26 @@ private:
      * @brief Clean log file operation.
     */
     UniquePtr<CYLoggerClearLogFile> m_ptrClearLogFile;
+
+    /**
+     * @brief Statistics exporter.
+    */
+    UniquePtr<CYLoggerMetricsExporter> m_ptrMetrics;
+
+    /**
+     * @brief Wake up requested by WakeUp.
+    */
+    std::atomic_bool m_bWakeUp{ false };
+
+    /**
+     * @brief Running schedule, target of WakeUp.
+    */
+    static CYLoggerSchedule* m_pRunning;
+
+    /**
+     * @brief Guards m_pRunning.
+    */
+    static CYNamedLocker m_mutexRunning;
 };
 
 CYLOGGER_NAMESPACE_END
@@ -0,0 +1,97 @@
+#include "Statistics/CYAppenderStats.hpp"
+
+#include <thread>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Single writer, so the counters are read back and stored rather than updated atomically.
+*/
+template<class T>
+static inline void AddRelaxed(std::atomic<T>& objCounter, T nValue)
+{
+    objCounter.store(objCounter.load(std::memory_order_relaxed) + nValue, std::memory_order_relaxed);
+}
+
+template<class T>
+static inline void MaxRelaxed(std::atomic<T>& objCounter, T nValue)
+{
+    if (nValue > objCounter.load(std::memory_order_relaxed))
+        objCounter.store(nValue, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Publish one wake up of the log thread, single writer.
+*/
+void CYAppenderStats::Publish(uint32_t nQueueDepth, uint32_t nLine, uint64_t nByte, uint64_t nWriteTime, uint64_t nFlushTime, double fCurrentFps, double fAverageFps)
+{
+    const uint32_t nSequence = m_nSequence.load(std::memory_order_relaxed);
+    m_nSequence.store(nSequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    m_nQueueDepth.store(nQueueDepth, std::memory_order_relaxed);
+    MaxRelaxed(m_nQueueDepthMax, nQueueDepth);
+    m_fCurrentFps.store(fCurrentFps, std::memory_order_relaxed);
+    m_fAverageFps.store(fAverageFps, std::memory_order_relaxed);
+
+    if (nLine > 0)
+    {
+        AddRelaxed(m_nLine, static_cast<uint64_t>(nLine));
+        AddRelaxed(m_nByte, nByte);
+        AddRelaxed(m_nBatchCount, static_cast<uint64_t>(1));
+        m_nBatchLast.store(nLine, std::memory_order_relaxed);
+        MaxRelaxed(m_nBatchMax, nLine);
+        AddRelaxed(m_nWriteTime, nWriteTime);
+        MaxRelaxed(m_nWriteTimeMax, nWriteTime);
+        AddRelaxed(m_nFlushTime, nFlushTime);
+        MaxRelaxed(m_nFlushTimeMax, nFlushTime);
+    }
+
+    m_nSequence.store(nSequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Count dropped lines, any thread.
+*/
+void CYAppenderStats::AddDrop(uint64_t nLine)
+{
+    m_nDrop.fetch_add(nLine, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Copy the counters into objStats, identity and latency fields are left alone.
+*/
+void CYAppenderStats::Read(STAppenderStats& objStats) const
+{
+    while (true)
+    {
+        const uint32_t nBegin = m_nSequence.load(std::memory_order_acquire);
+        if (nBegin & 1)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        objStats.nLine = m_nLine.load(std::memory_order_relaxed);
+        objStats.nByte = m_nByte.load(std::memory_order_relaxed);
+        objStats.fCurrentFps = m_fCurrentFps.load(std::memory_order_relaxed);
+        objStats.fAverageFps = m_fAverageFps.load(std::memory_order_relaxed);
+        objStats.nQueueDepth = m_nQueueDepth.load(std::memory_order_relaxed);
+        objStats.nQueueDepthMax = m_nQueueDepthMax.load(std::memory_order_relaxed);
+        objStats.nBatchCount = m_nBatchCount.load(std::memory_order_relaxed);
+        objStats.nBatchLast = m_nBatchLast.load(std::memory_order_relaxed);
+        objStats.nBatchMax = m_nBatchMax.load(std::memory_order_relaxed);
+        objStats.nWriteTime = m_nWriteTime.load(std::memory_order_relaxed);
+        objStats.nWriteTimeMax = m_nWriteTimeMax.load(std::memory_order_relaxed);
+        objStats.nFlushTime = m_nFlushTime.load(std::memory_order_relaxed);
+        objStats.nFlushTimeMax = m_nFlushTimeMax.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_nSequence.load(std::memory_order_relaxed) == nBegin)
+            break;
+    }
+
+    objStats.nDrop = m_nDrop.load(std::memory_order_relaxed);
+}
+
+CYLOGGER_NAMESPACE_END
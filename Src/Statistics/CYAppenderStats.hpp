@@ -0,0 +1,109 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_APPENDER_STATS_HPP__
+#define __CY_APPENDER_STATS_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+
+#include <atomic>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Counters of one appender behind a sequence lock. The log thread publishes once per wake up, readers on any
+ *        thread retry until they have copied a set of counters no publish was in the middle of.
+*/
+class CYAppenderStats final
+{
+public:
+    CYAppenderStats() noexcept = default;
+    ~CYAppenderStats() noexcept = default;
+
+public:
+    /**
+     * @brief Publish one wake up of the log thread, single writer.
+     * @param nQueueDepth messages taken over by the flip.
+     * @param nLine lines written by the batch, 0 when nothing was drained.
+    */
+    void Publish(uint32_t nQueueDepth, uint32_t nLine, uint64_t nByte, uint64_t nWriteTime, uint64_t nFlushTime, double fCurrentFps, double fAverageFps);
+
+    /**
+     * @brief Count dropped lines, any thread.
+    */
+    void AddDrop(uint64_t nLine);
+
+    /**
+     * @brief Copy the counters into objStats, identity and latency fields are left alone.
+    */
+    void Read(STAppenderStats& objStats) const;
+
+private:
+    /**
+     * @brief Odd while a publish is in progress.
+    */
+    std::atomic_uint32_t m_nSequence = 0;
+
+    std::atomic_uint64_t m_nLine = 0;
+    std::atomic_uint64_t m_nByte = 0;
+    std::atomic<double> m_fCurrentFps = 0;
+    std::atomic<double> m_fAverageFps = 0;
+    std::atomic_uint32_t m_nQueueDepth = 0;
+    std::atomic_uint32_t m_nQueueDepthMax = 0;
+    std::atomic_uint64_t m_nBatchCount = 0;
+    std::atomic_uint32_t m_nBatchLast = 0;
+    std::atomic_uint32_t m_nBatchMax = 0;
+    std::atomic_uint64_t m_nWriteTime = 0;
+    std::atomic_uint64_t m_nWriteTimeMax = 0;
+    std::atomic_uint64_t m_nFlushTime = 0;
+    std::atomic_uint64_t m_nFlushTimeMax = 0;
+
+    /**
+     * @brief Outside the sequence lock, drops may be counted off the log thread.
+    */
+    std::atomic_uint64_t m_nDrop = 0;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_APPENDER_STATS_HPP__
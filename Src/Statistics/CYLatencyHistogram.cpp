@@ -0,0 +1,101 @@
+#include "Statistics/CYLatencyHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Steady clock time in nanoseconds, used to stamp messages at enqueue.
+*/
+int64_t CYLatencyHistogram::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Record one latency.
+*/
+void CYLatencyHistogram::Record(uint64_t nLatency)
+{
+    m_arrBucket[GetBucketIndex(nLatency)].fetch_add(1, std::memory_order_relaxed);
+
+    // A lock profile is shared by several locks, so the maximum may race with another writer.
+    uint64_t nMax = m_nMax.load(std::memory_order_relaxed);
+    while (nLatency > nMax && !m_nMax.compare_exchange_weak(nMax, nLatency, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @brief Percentiles of the recorded latencies, optionally starting over afterwards.
+*/
+void CYLatencyHistogram::GetLatency(STLatencyStats& objStats, bool bReset)
+{
+    uint64_t arrCount[HISTOGRAM_BUCKET_COUNT];
+    uint64_t nTotal = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKET_COUNT; ++i)
+    {
+        arrCount[i] = bReset ? m_arrBucket[i].exchange(0, std::memory_order_relaxed) : m_arrBucket[i].load(std::memory_order_relaxed);
+        nTotal += arrCount[i];
+    }
+    uint64_t nMax = bReset ? m_nMax.exchange(0, std::memory_order_relaxed) : m_nMax.load(std::memory_order_relaxed);
+
+    objStats = STLatencyStats();
+    objStats.nCount = nTotal;
+    if (nTotal == 0)
+        return;
+
+    // Rank of each percentile is rounded up, so p999 of a small sample is its largest value.
+    const double arrQuantile[] = { 0.5, 0.9, 0.99, 0.999 };
+    uint64_t* arrResult[] = { &objStats.nP50, &objStats.nP90, &objStats.nP99, &objStats.nP999 };
+
+    uint64_t nSeen = 0;
+    int nQuantile = 0;
+    for (int i = 0; i < HISTOGRAM_BUCKET_COUNT && nQuantile < 4; ++i)
+    {
+        nSeen += arrCount[i];
+        while (nQuantile < 4 && nSeen >= static_cast<uint64_t>(std::ceil(arrQuantile[nQuantile] * static_cast<double>(nTotal))))
+        {
+            *arrResult[nQuantile++] = std::min(GetBucketUpper(i), nMax);
+        }
+    }
+
+    objStats.nMax = nMax;
+}
+
+/**
+ * @brief Drop all recorded latencies.
+*/
+void CYLatencyHistogram::Reset()
+{
+    for (auto& nBucket : m_arrBucket)
+    {
+        nBucket.store(0, std::memory_order_relaxed);
+    }
+    m_nMax.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Values below 64 have a bucket each, above that the top HISTOGRAM_SUB_BITS + 1 bits select the bucket.
+*/
+int CYLatencyHistogram::GetBucketIndex(uint64_t nValue)
+{
+    int nMsb = 63 - std::countl_zero(nValue | 1);
+    int nShift = nMsb > HISTOGRAM_SUB_BITS ? nMsb - HISTOGRAM_SUB_BITS : 0;
+    return nShift * HISTOGRAM_SUB_COUNT + static_cast<int>(nValue >> nShift);
+}
+
+/**
+ * @brief Largest value that falls into a bucket.
+*/
+uint64_t CYLatencyHistogram::GetBucketUpper(int nIndex)
+{
+    int nShift = nIndex < 2 * HISTOGRAM_SUB_COUNT ? 0 : nIndex / HISTOGRAM_SUB_COUNT - 1;
+    uint64_t nMantissa = static_cast<uint64_t>(nIndex - nShift * HISTOGRAM_SUB_COUNT);
+    return ((nMantissa + 1) << nShift) - 1;
+}
+
+CYLOGGER_NAMESPACE_END
@@ -0,0 +1,99 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LATENCY_HISTOGRAM_HPP__
+#define __CY_LATENCY_HISTOGRAM_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+
+#include <atomic>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Log bucketed latency histogram in nanoseconds. Every power of two is split into 32 linear buckets, so a
+ *        recorded value is kept within about 3%. Written and read by any thread without locks.
+*/
+class CYLatencyHistogram final
+{
+public:
+    CYLatencyHistogram() noexcept = default;
+    ~CYLatencyHistogram() noexcept = default;
+
+public:
+    /**
+     * @brief Steady clock time in nanoseconds, used to stamp messages at enqueue.
+    */
+    static int64_t Now();
+
+    /**
+     * @brief Record one latency.
+    */
+    void Record(uint64_t nLatency);
+
+    /**
+     * @brief Percentiles of the recorded latencies, optionally starting over afterwards.
+    */
+    void GetLatency(STLatencyStats& objStats, bool bReset);
+
+    /**
+     * @brief Drop all recorded latencies.
+    */
+    void Reset();
+
+private:
+    static constexpr int HISTOGRAM_SUB_BITS = 5;
+    static constexpr int HISTOGRAM_SUB_COUNT = 1 << HISTOGRAM_SUB_BITS;
+    static constexpr int HISTOGRAM_BUCKET_COUNT = (64 - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_COUNT;
+
+    static int GetBucketIndex(uint64_t nValue);
+    static uint64_t GetBucketUpper(int nIndex);
+
+private:
+    std::atomic_uint64_t m_arrBucket[HISTOGRAM_BUCKET_COUNT] = {};
+    std::atomic_uint64_t m_nMax = 0;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LATENCY_HISTOGRAM_HPP__
@@ -0,0 +1,93 @@
+#include "Statistics/CYLockProfile.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief All lock names seen so far. A plain std::mutex guards it, it is taken inside the constructor of a CYNamedLocker.
+*/
+struct STLockRegistry
+{
+    std::mutex mutexRegistry;
+    std::map<std::string, std::unique_ptr<CYLockProfile>> mapProfile;
+};
+
+static STLockRegistry& LockRegistry()
+{
+    static STLockRegistry objRegistry;
+    return objRegistry;
+}
+
+/**
+ * @brief Profile of a lock name, created on first use and kept until the process exits.
+*/
+CYLockProfile* CYLockProfile::Get(const TChar* pszName)
+{
+    // Lock names are plain ASCII.
+    std::string strName;
+    for (const TChar* p = pszName ? pszName : TEXT(""); *p; ++p)
+    {
+        strName += static_cast<char>(*p);
+    }
+
+    STLockRegistry& objRegistry = LockRegistry();
+    LockGuard locker(objRegistry.mutexRegistry);
+    auto& ptrProfile = objRegistry.mapProfile[strName];
+    if (!ptrProfile)
+        ptrProfile = std::make_unique<CYLockProfile>();
+    ptrProfile->m_nInstance.fetch_add(1, std::memory_order_relaxed);
+    return ptrProfile.get();
+}
+
+/**
+ * @brief One record per lock name, sorted by name, optionally starting over afterwards.
+*/
+void CYLockProfile::GetStats(std::vector<STLockStats>& vecStats, bool bReset)
+{
+    STLockRegistry& objRegistry = LockRegistry();
+    LockGuard locker(objRegistry.mutexRegistry);
+    vecStats.clear();
+    vecStats.reserve(objRegistry.mapProfile.size());
+    for (auto& [strName, ptrProfile] : objRegistry.mapProfile)
+    {
+        STLockStats& objStats = vecStats.emplace_back();
+        strName.copy(objStats.szName, sizeof(objStats.szName) - 1);
+        ptrProfile->Read(objStats, bReset);
+    }
+}
+
+/**
+ * @brief Record one acquisition, nWait is only recorded when the lock was held by another thread.
+*/
+void CYLockProfile::AddAcquire(bool bContend, uint64_t nWait)
+{
+    m_nAcquire.fetch_add(1, std::memory_order_relaxed);
+    if (bContend)
+    {
+        m_nContend.fetch_add(1, std::memory_order_relaxed);
+        m_objWait.Record(nWait);
+    }
+}
+
+/**
+ * @brief Record the time one acquisition held the lock.
+*/
+void CYLockProfile::AddHold(uint64_t nHold)
+{
+    m_objHold.Record(nHold);
+}
+
+void CYLockProfile::Read(STLockStats& objStats, bool bReset)
+{
+    objStats.nInstance = m_nInstance.load(std::memory_order_relaxed);
+    objStats.nAcquire = bReset ? m_nAcquire.exchange(0, std::memory_order_relaxed) : m_nAcquire.load(std::memory_order_relaxed);
+    objStats.nContend = bReset ? m_nContend.exchange(0, std::memory_order_relaxed) : m_nContend.load(std::memory_order_relaxed);
+    m_objWait.GetLatency(objStats.objWait, bReset);
+    m_objHold.GetLatency(objStats.objHold, bReset);
+}
+
+CYLOGGER_NAMESPACE_END
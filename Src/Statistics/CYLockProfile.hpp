@@ -0,0 +1,100 @@
+/*
+ * CYLogger License
+ * -----------
+ *
+ * CYLogger is licensed under the terms of the MIT license reproduced below.
+ * This means that CYLogger is free software and can be used for both academic
+ * and commercial purposes at absolutely no cost.
+ *
+ *
+ * ===============================================================================
+ *
+ * Copyright (C) 2023-2024 ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *
+ * ===============================================================================
+ */
+
+ /*
+  * AUTHORS:  ShiLiang.Hao <newhaosl@163.com>, foobra<vipgs99@gmail.com>
+  * VERSION:  1.0.0
+  * PURPOSE:  A cross-platform efficient and stable Log library.
+  * CREATION: 2023.04.15
+  * LCHANGE:  2023.04.15
+  * LICENSE:  Expat/MIT License, See Copyright Notice at the begin of this file.
+  */
+
+#ifndef __CY_LOCK_PROFILE_HPP__
+#define __CY_LOCK_PROFILE_HPP__
+
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Statistics/CYLatencyHistogram.hpp"
+
+#include <atomic>
+#include <vector>
+
+CYLOGGER_NAMESPACE_BEGIN
+
+/**
+ * @brief Contention profile shared by all CYNamedLocker of one name, only created when LOG_LOCK_PROFILE is set.
+ *        Written by the threads holding the locks and read by any thread without locks.
+*/
+class CYLockProfile final
+{
+public:
+    CYLockProfile() noexcept = default;
+    ~CYLockProfile() noexcept = default;
+
+public:
+    /**
+     * @brief Profile of a lock name, created on first use and kept until the process exits.
+    */
+    static CYLockProfile* Get(const TChar* pszName);
+
+    /**
+     * @brief One record per lock name, sorted by name, optionally starting over afterwards.
+    */
+    static void GetStats(std::vector<STLockStats>& vecStats, bool bReset);
+
+public:
+    /**
+     * @brief Record one acquisition, nWait is only recorded when the lock was held by another thread.
+    */
+    void AddAcquire(bool bContend, uint64_t nWait);
+
+    /**
+     * @brief Record the time one acquisition held the lock.
+    */
+    void AddHold(uint64_t nHold);
+
+private:
+    void Read(STLockStats& objStats, bool bReset);
+
+private:
+    std::atomic_uint32_t m_nInstance = 0;
+    std::atomic_uint64_t m_nAcquire = 0;
+    std::atomic_uint64_t m_nContend = 0;
+    CYLatencyHistogram m_objWait;
+    CYLatencyHistogram m_objHold;
+};
+
+CYLOGGER_NAMESPACE_END
+
+#endif //__CY_LOCK_PROFILE_HPP__
@@ -16,875 +16,830 @@ SharePtr<CYStatistics> CYStatistics::m_ptrInstance;
 
 void CYStatistics::AddTotalLine(uint64_t nLine)
 {
-    m_nTotalLine.fetch_add(nLine, std::memory_order_relaxed);
+    m_objTotalLine.Add(nLine);
 }
 
 uint64_t CYStatistics::GetTotalLine()
 {
-    return m_nTotalLine.load(std::memory_order_relaxed);
+    return m_objTotalLine.Get();
 }
 
 void CYStatistics::AddTotalBytes(uint64_t nBytes)
 {
-    m_nTotalByte.fetch_add(nBytes, std::memory_order_relaxed);
+    m_objTotalByte.Add(nBytes);
 }
 
 uint64_t CYStatistics::GetTotalBytes()
 {
-    return m_nTotalByte.load(std::memory_order_relaxed);
+    return m_objTotalByte.Get();
 }
 
 void CYStatistics::AddTotalCurrentFPS(double fps)
 {
-    m_fTotalCurrentFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[STATS_TOTAL].fCurrentFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetTotalCurrentFPS()
 {
-    return m_fTotalCurrentFps.load(std::memory_order_relaxed);
+    return m_arrCounter[STATS_TOTAL].fCurrentFps.load(std::memory_order_relaxed);
 }
 
-
 void CYStatistics::AddTotalAverageFPS(double fps)
 {
-    m_fTotalAverageFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[STATS_TOTAL].fAverageFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetTotalAverageFPS()
 {
-    return m_fTotalAverageFps.load(std::memory_order_relaxed);
+    return m_arrCounter[STATS_TOTAL].fAverageFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddTotalPublicQueue(uint32_t nSize)
 {
-    m_nTotalPublicQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[STATS_TOTAL].arrPublicQueue[LOG_TYPE_NONE].store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetTotalPublicQueue()
 {
-    return m_nTotalPublicQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[STATS_TOTAL].arrPublicQueue[LOG_TYPE_NONE].load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddTotalPrivateQueue(uint32_t nSize)
 {
-    m_nTotalPrivateQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrCounter[STATS_TOTAL].nPrivateQueue.store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetTotalPrivateQueue()
 {
-    return m_nTotalPrivateQueue.load(std::memory_order_seq_cst);
+    return m_arrCounter[STATS_TOTAL].nPrivateQueue.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddConsoleLine(uint64_t nLine)
 {
-    m_nConsoleLine.fetch_add(nLine, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_NONE].nLine.fetch_add(nLine, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetConsoleLine()
 {
-    return m_nConsoleLine.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_NONE].nLine.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddConsoleBytes(uint64_t nBytes)
 {
-    m_nConsoleByte.fetch_add(nBytes, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_NONE].nByte.fetch_add(nBytes, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetConsoleBytes()
 {
-    return m_nConsoleByte.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_NONE].nByte.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddConsoleCurrentFPS(double fps)
 {
-    m_fConsoleCurrentFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_NONE].fCurrentFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetConsoleCurrentFPS()
 {
-    return m_fConsoleCurrentFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_NONE].fCurrentFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddConsoleAverageFPS(double fps)
 {
-    m_fConsoleAverageFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_NONE].fAverageFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetConsoleAverageFPS()
 {
-    return m_fConsoleAverageFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_NONE].fAverageFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddConsolePublicDQueue(uint32_t nSize)
 {
-     m_nConsolePublicDQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_DEBUG].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddConsolePublicTQueue(uint32_t nSize)
 {
-    m_nConsolePublicTQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_TRACE].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddConsolePublicIQueue(uint32_t nSize)
 {
-    m_nConsolePublicIQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_INFO].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddConsolePublicWQueue(uint32_t nSize)
 {
-    m_nConsolePublicWQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_WARN].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddConsolePublicEQueue(uint32_t nSize)
 {
-    m_nConsolePublicEQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_ERROR].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddConsolePublicFQueue(uint32_t nSize)
 {
-    m_nConsolePublicFQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_FATAL].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddConsolePrivateQueue(uint32_t nSize)
 {
-    m_nConsolePrivateQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrCounter[LOG_TYPE_NONE].nPrivateQueue.store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetConsolePublicDQueue()
 {
-    return m_nConsolePublicDQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_DEBUG].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetConsolePublicTQueue()
 {
-    return m_nConsolePublicTQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_TRACE].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetConsolePublicIQueue()
 {
-    return m_nConsolePublicIQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_INFO].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetConsolePublicWQueue()
 {
-    return m_nConsolePublicWQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_WARN].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetConsolePublicEQueue()
 {
-    return m_nConsolePublicEQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_ERROR].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetConsolePublicFQueue()
 {
-    return m_nConsolePublicFQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_NONE].arrPublicQueue[LOG_TYPE_FATAL].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetConsolePrivateQueue()
 {
-    return m_nConsolePrivateQueue.load(std::memory_order_seq_cst);
+    return m_arrCounter[LOG_TYPE_NONE].nPrivateQueue.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddTraceLine(uint64_t nLine)
 {
-    m_nTraceLine.fetch_add(nLine, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_TRACE].nLine.fetch_add(nLine, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetTraceLine()
 {
-    return m_nTraceLine.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_TRACE].nLine.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddTraceBytes(uint64_t nBytes)
 {
-    m_nTraceByte.fetch_add(nBytes, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_TRACE].nByte.fetch_add(nBytes, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetTraceBytes()
 {
-    return m_nTraceByte.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_TRACE].nByte.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddTraceCurrentFPS(double fps)
 {
-    m_fTraceCurrentFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_TRACE].fCurrentFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetTraceCurrentFPS()
 {
-    return m_fTraceCurrentFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_TRACE].fCurrentFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddTraceAverageFPS(double fps)
 {
-    m_fTraceAverageFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_TRACE].fAverageFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetTraceAverageFPS()
 {
-    return m_fTraceAverageFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_TRACE].fAverageFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddTracePublicQueue(uint32_t nSize)
 {
-    m_nTracePublicQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_TRACE].arrPublicQueue[LOG_TYPE_TRACE].store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetTracePublicQueue()
 {
-    return m_nTracePublicQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_TRACE].arrPublicQueue[LOG_TYPE_TRACE].load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddTracePrivateQueue(uint32_t nSize)
 {
-    m_nTracePrivateQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrCounter[LOG_TYPE_TRACE].nPrivateQueue.store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetTracePrivateQueue()
 {
-    return m_nTracePrivateQueue.load(std::memory_order_seq_cst);
+    return m_arrCounter[LOG_TYPE_TRACE].nPrivateQueue.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddDebugLine(uint64_t nLine)
 {
-    m_nDebugLine.fetch_add(nLine, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_DEBUG].nLine.fetch_add(nLine, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetDebugLine()
 {
-    return m_nDebugLine.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_DEBUG].nLine.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddDebugBytes(uint64_t nBytes)
 {
-    m_nDebugByte.fetch_add(nBytes, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_DEBUG].nByte.fetch_add(nBytes, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetDebugBytes()
 {
-    return m_nDebugByte.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_DEBUG].nByte.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddDebugCurrentFPS(double fps)
 {
-    m_fDebugCurrentFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_DEBUG].fCurrentFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetDebugCurrentFPS()
 {
-    return m_fDebugCurrentFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_DEBUG].fCurrentFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddDebugAverageFPS(double fps)
 {
-    m_fDebugAverageFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_DEBUG].fAverageFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetDebugAverageFPS()
 {
-    return m_fDebugAverageFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_DEBUG].fAverageFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddDebugPublicQueue(uint32_t nSize)
 {
-    m_nDebugPublicQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_DEBUG].arrPublicQueue[LOG_TYPE_DEBUG].store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetDebugPublicQueue()
 {
-    return m_nDebugPublicQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_DEBUG].arrPublicQueue[LOG_TYPE_DEBUG].load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddDebugPrivateQueue(uint32_t nSize)
 {
-    m_nDebugPrivateQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrCounter[LOG_TYPE_DEBUG].nPrivateQueue.store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetDebugPrivateQueue()
 {
-    return m_nDebugPrivateQueue.load(std::memory_order_seq_cst);
+    return m_arrCounter[LOG_TYPE_DEBUG].nPrivateQueue.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddInfoLine(uint64_t nLine)
 {
-    m_nInfoLine.fetch_add(nLine, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_INFO].nLine.fetch_add(nLine, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetInfoLine()
 {
-    return m_nInfoLine.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_INFO].nLine.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddInfoBytes(uint64_t nBytes)
 {
-    m_nInfoByte.fetch_add(nBytes, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_INFO].nByte.fetch_add(nBytes, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetInfoBytes()
 {
-    return m_nInfoByte.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_INFO].nByte.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddInfoCurrentFPS(double fps)
 {
-    m_fInfoCurrentFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_INFO].fCurrentFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetInfoCurrentFPS()
 {
-    return m_fInfoCurrentFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_INFO].fCurrentFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddInfoAverageFPS(double fps)
 {
-    m_fInfoAverageFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_INFO].fAverageFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetInfoAverageFPS()
 {
-    return m_fInfoAverageFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_INFO].fAverageFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddInfoPublicQueue(uint32_t nSize)
 {
-    m_nInfoPublicQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_INFO].arrPublicQueue[LOG_TYPE_INFO].store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetInfoPublicQueue()
 {
-    return m_nInfoPublicQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_INFO].arrPublicQueue[LOG_TYPE_INFO].load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddInfoPrivateQueue(uint32_t nSize)
 {
-    m_nInfoPrivateQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrCounter[LOG_TYPE_INFO].nPrivateQueue.store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetInfoPrivateQueue()
 {
-    return m_nInfoPrivateQueue.load(std::memory_order_seq_cst);
+    return m_arrCounter[LOG_TYPE_INFO].nPrivateQueue.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddWarnLine(uint64_t nLine)
 {
-    m_nWarnLine.fetch_add(nLine, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_WARN].nLine.fetch_add(nLine, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetWarnLine()
 {
-    return m_nWarnLine.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_WARN].nLine.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddWarnBytes(uint64_t nBytes)
 {
-    m_nWarnByte.fetch_add(nBytes, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_WARN].nByte.fetch_add(nBytes, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetWarnBytes()
 {
-    return m_nWarnByte.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_WARN].nByte.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddWarnCurrentFPS(double fps)
 {
-    m_fWarnCurrentFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_WARN].fCurrentFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetWarnCurrentFPS()
 {
-    return m_fWarnCurrentFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_WARN].fCurrentFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddWarnAverageFPS(double fps)
 {
-    m_fWarnAverageFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_WARN].fAverageFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetWarnAverageFPS()
 {
-    return m_fWarnAverageFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_WARN].fAverageFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddWarnPublicQueue(uint32_t nSize)
 {
-    m_nWarnPublicQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_WARN].arrPublicQueue[LOG_TYPE_WARN].store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetWarnPublicQueue()
 {
-    return m_nWarnPublicQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_WARN].arrPublicQueue[LOG_TYPE_WARN].load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddWarnPrivateQueue(uint32_t nSize)
 {
-    m_nWarnPrivateQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrCounter[LOG_TYPE_WARN].nPrivateQueue.store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetWarnPrivateQueue()
 {
-    return m_nWarnPrivateQueue.load(std::memory_order_seq_cst);
+    return m_arrCounter[LOG_TYPE_WARN].nPrivateQueue.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddErrorLine(uint64_t nLine)
 {
-    m_nErrorLine.fetch_add(nLine, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_ERROR].nLine.fetch_add(nLine, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetErrorLine()
 {
-    return m_nErrorLine.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_ERROR].nLine.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddErrorBytes(uint64_t nBytes)
 {
-    m_nErrorByte.fetch_add(nBytes, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_ERROR].nByte.fetch_add(nBytes, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetErrorBytes()
 {
-    return m_nErrorByte.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_ERROR].nByte.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddErrorCurrentFPS(double fps)
 {
-    m_fErrorCurrentFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_ERROR].fCurrentFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetErrorCurrentFPS()
 {
-    return m_fErrorCurrentFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_ERROR].fCurrentFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddErrorAverageFPS(double fps)
 {
-    m_fErrorAverageFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_ERROR].fAverageFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetErrorAverageFPS()
 {
-    return m_fErrorAverageFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_ERROR].fAverageFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddErrorPublicQueue(uint32_t nSize)
 {
-    m_nErrorPublicQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_ERROR].arrPublicQueue[LOG_TYPE_ERROR].store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetErrorPublicQueue()
 {
-    return m_nErrorPublicQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_ERROR].arrPublicQueue[LOG_TYPE_ERROR].load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddErrorPrivateQueue(uint32_t nSize)
 {
-    m_nErrorPrivateQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrCounter[LOG_TYPE_ERROR].nPrivateQueue.store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetErrorPrivateQueue()
 {
-    return m_nErrorPrivateQueue.load(std::memory_order_seq_cst);
+    return m_arrCounter[LOG_TYPE_ERROR].nPrivateQueue.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddFatalLine(uint64_t nLine)
 {
-    m_nFatalLine.fetch_add(nLine, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_FATAL].nLine.fetch_add(nLine, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetFatalLine()
 {
-    return m_nFatalLine.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_FATAL].nLine.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddFatalBytes(uint64_t nBytes)
 {
-    m_nFatalByte.fetch_add(nBytes, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_FATAL].nByte.fetch_add(nBytes, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetFatalBytes()
 {
-    return m_nFatalByte.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_FATAL].nByte.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddFatalCurrentFPS(double fps)
 {
-    m_fFatalCurrentFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_FATAL].fCurrentFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetFatalCurrentFPS()
 {
-    return m_fFatalCurrentFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_FATAL].fCurrentFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddFatalAverageFPS(double fps)
 {
-    m_fFatalAverageFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_FATAL].fAverageFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetFatalAverageFPS()
 {
-    return m_fFatalAverageFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_FATAL].fAverageFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddFatalPublicQueue(uint32_t nSize)
 {
-    m_nFatalPublicQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_FATAL].arrPublicQueue[LOG_TYPE_FATAL].store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetFatalPublicQueue()
 {
-    return m_nFatalPublicQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_FATAL].arrPublicQueue[LOG_TYPE_FATAL].load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddFatalPrivateQueue(uint32_t nSize)
 {
-    m_nFatalPrivateQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrCounter[LOG_TYPE_FATAL].nPrivateQueue.store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetFatalPrivateQueue()
 {
-    return m_nFatalPrivateQueue.load(std::memory_order_seq_cst);
+    return m_arrCounter[LOG_TYPE_FATAL].nPrivateQueue.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddMainLine(uint64_t nLine)
 {
-    m_nMainLine.fetch_add(nLine, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_MAIN].nLine.fetch_add(nLine, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetMainLine()
 {
-    return m_nMainLine.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_MAIN].nLine.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddMainBytes(uint64_t nBytes)
 {
-    m_nMainByte.fetch_add(nBytes, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_MAIN].nByte.fetch_add(nBytes, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetMainBytes()
 {
-    return m_nMainByte.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_MAIN].nByte.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddMainCurrentFPS(double fps)
 {
-    m_fMainCurrentFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_MAIN].fCurrentFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetMainCurrentFPS()
 {
-    return m_fMainCurrentFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_MAIN].fCurrentFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddMainAverageFPS(double fps)
 {
-    m_fMainAverageFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_MAIN].fAverageFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetMainAverageFPS()
 {
-    return m_fMainAverageFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_MAIN].fAverageFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddMainPublicDQueue(uint32_t nSize)
 {
-    m_nMainPublicDQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_DEBUG].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddMainPublicTQueue(uint32_t nSize)
 {
-    m_nMainPublicTQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_TRACE].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddMainPublicIQueue(uint32_t nSize)
 {
-    m_nMainPublicIQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_INFO].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddMainPublicWQueue(uint32_t nSize)
 {
-    m_nMainPublicWQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_WARN].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddMainPublicEQueue(uint32_t nSize)
 {
-    m_nMainPublicEQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_ERROR].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddMainPublicFQueue(uint32_t nSize)
 {
-    m_nMainPublicFQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_FATAL].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddMainPrivateQueue(uint32_t nSize)
 {
-    m_nMainPrivateQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrCounter[LOG_TYPE_MAIN].nPrivateQueue.store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetMainPublicDQueue()
 {
-    return m_nMainPublicDQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_DEBUG].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetMainPublicTQueue()
 {
-    return m_nMainPublicTQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_TRACE].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetMainPublicIQueue()
 {
-    return m_nMainPublicIQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_INFO].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetMainPublicWQueue()
 {
-    return m_nMainPublicWQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_WARN].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetMainPublicEQueue()
 {
-    return m_nMainPublicEQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_ERROR].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetMainPublicFQueue()
 {
-    return m_nMainPublicFQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_MAIN].arrPublicQueue[LOG_TYPE_FATAL].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetMainPrivateQueue()
 {
-    return m_nMainPrivateQueue.load(std::memory_order_seq_cst);
+    return m_arrCounter[LOG_TYPE_MAIN].nPrivateQueue.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddRemoteLine(uint64_t nLine)
 {
-    m_nRemoteLine.fetch_add(nLine, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_REMOTE].nLine.fetch_add(nLine, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetRemoteLine()
 {
-    return m_nRemoteLine.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_REMOTE].nLine.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddRemoteBytes(uint64_t nBytes)
 {
-    m_nRemoteByte.fetch_add(nBytes, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_REMOTE].nByte.fetch_add(nBytes, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetRemoteBytes()
 {
-    return m_nRemoteByte.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_REMOTE].nByte.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddRemoteCurrentFPS(double fps)
 {
-    m_fRemoteCurrentFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_REMOTE].fCurrentFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetRemoteCurrentFPS()
 {
-    return m_fRemoteCurrentFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_REMOTE].fCurrentFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddRemoteAverageFPS(double fps)
 {
-    m_fRemoteAverageFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_REMOTE].fAverageFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetRemoteAverageFPS()
 {
-    return m_fRemoteAverageFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_REMOTE].fAverageFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddRemotePublicDQueue(uint32_t nSize)
 {
-    m_nRemotePublicDQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_DEBUG].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddRemotePublicTQueue(uint32_t nSize)
 {
-    m_nRemotePublicTQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_TRACE].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddRemotePublicIQueue(uint32_t nSize)
 {
-    m_nRemotePublicIQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_INFO].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddRemotePublicWQueue(uint32_t nSize)
 {
-    m_nRemotePublicWQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_WARN].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddRemotePublicEQueue(uint32_t nSize)
 {
-    m_nRemotePublicEQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_ERROR].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddRemotePublicFQueue(uint32_t nSize)
 {
-    m_nRemotePublicFQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_FATAL].store(nSize, std::memory_order_relaxed);
 }
 
 void CYStatistics::AddRemotePrivateQueue(uint32_t nSize)
 {
-    m_nRemotePrivateQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrCounter[LOG_TYPE_REMOTE].nPrivateQueue.store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetRemotePublicDQueue()
 {
-    return m_nRemotePublicDQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_DEBUG].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetRemotePublicTQueue()
 {
-    return m_nRemotePublicTQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_TRACE].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetRemotePublicIQueue()
 {
-    return m_nRemotePublicIQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_INFO].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetRemotePublicWQueue()
 {
-    return m_nRemotePublicWQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_WARN].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetRemotePublicEQueue()
 {
-    return m_nRemotePublicEQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_ERROR].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetRemotePublicFQueue()
 {
-    return m_nRemotePublicFQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_REMOTE].arrPublicQueue[LOG_TYPE_FATAL].load(std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetRemotePrivateQueue()
 {
-    return m_nRemotePrivateQueue.load(std::memory_order_seq_cst);
+    return m_arrCounter[LOG_TYPE_REMOTE].nPrivateQueue.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddSysLine(uint64_t nLine)
 {
-    m_nSysLine.fetch_add(nLine, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_SYS].nLine.fetch_add(nLine, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetSysLine()
 {
-    return m_nSysLine.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_SYS].nLine.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddSysBytes(uint64_t nBytes)
 {
-    m_nSysByte.fetch_add(nBytes, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_SYS].nByte.fetch_add(nBytes, std::memory_order_relaxed);
 }
 
 uint64_t CYStatistics::GetSysBytes()
 {
-    return m_nSysByte.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_SYS].nByte.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddSysCurrentFPS(double fps)
 {
-    m_fSysCurrentFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_SYS].fCurrentFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetSysCurrentFPS()
 {
-    return m_fSysCurrentFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_SYS].fCurrentFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddSysAverageFPS(double fps)
 {
-    m_fSysAverageFps.exchange(fps, std::memory_order_relaxed);
+    m_arrCounter[LOG_TYPE_SYS].fAverageFps.store(fps, std::memory_order_relaxed);
 }
 
 double CYStatistics::GetSysAverageFPS()
 {
-    return m_fSysAverageFps.load(std::memory_order_relaxed);
+    return m_arrCounter[LOG_TYPE_SYS].fAverageFps.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddSysPublicQueue(uint32_t nSize)
 {
-    m_nSysPublicQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrQueue[LOG_TYPE_SYS].arrPublicQueue[LOG_TYPE_SYS].store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetSysPublicQueue()
 {
-    return m_nSysPublicQueue.load(std::memory_order_seq_cst);
+    return m_arrQueue[LOG_TYPE_SYS].arrPublicQueue[LOG_TYPE_SYS].load(std::memory_order_relaxed);
 }
 
 void CYStatistics::AddSysPrivateQueue(uint32_t nSize)
 {
-    m_nSysPrivateQueue.exchange(nSize, std::memory_order_seq_cst);
+    m_arrCounter[LOG_TYPE_SYS].nPrivateQueue.store(nSize, std::memory_order_relaxed);
 }
 
 uint32_t CYStatistics::GetSysPrivateQueue()
 {
-    return m_nSysPrivateQueue.load(std::memory_order_seq_cst);
+    return m_arrCounter[LOG_TYPE_SYS].nPrivateQueue.load(std::memory_order_relaxed);
 }
 
 void CYStatistics::Reset()
 {
-    m_nTotalLine.exchange(0, std::memory_order_relaxed);
-    m_nTotalByte.exchange(0, std::memory_order_relaxed);
-    m_fTotalCurrentFps.exchange(0.0, std::memory_order_relaxed);
-    m_fTotalAverageFps.exchange(0.0, std::memory_order_relaxed);
-
-    m_nConsoleLine.exchange(0, std::memory_order_relaxed);
-    m_nConsoleByte.exchange(0, std::memory_order_relaxed);
-    m_fConsoleCurrentFps.exchange(0.0, std::memory_order_relaxed);
-    m_fConsoleAverageFps.exchange(0.0, std::memory_order_relaxed);
-
-    m_nTraceLine.exchange(0, std::memory_order_relaxed);
-    m_nTraceByte.exchange(0, std::memory_order_relaxed);
-    m_fTraceCurrentFps.exchange(0.0, std::memory_order_relaxed);
-    m_fTraceAverageFps.exchange(0.0, std::memory_order_relaxed);
-
-    m_nDebugLine.exchange(0, std::memory_order_relaxed);
-    m_nDebugByte.exchange(0, std::memory_order_relaxed);
-    m_fDebugCurrentFps.exchange(0.0, std::memory_order_relaxed);
-    m_fDebugAverageFps.exchange(0.0, std::memory_order_relaxed);
-
-    m_nInfoLine.exchange(0, std::memory_order_relaxed);
-    m_nInfoByte.exchange(0, std::memory_order_relaxed);
-    m_fInfoCurrentFps.exchange(0.0, std::memory_order_relaxed);
-    m_fInfoAverageFps.exchange(0.0, std::memory_order_relaxed);
-
-    m_nWarnLine.exchange(0, std::memory_order_relaxed);
-    m_nWarnByte.exchange(0, std::memory_order_relaxed);
-    m_fWarnCurrentFps.exchange(0.0, std::memory_order_relaxed);
-    m_fWarnAverageFps.exchange(0.0, std::memory_order_relaxed);
-
-    m_nErrorLine.exchange(0, std::memory_order_relaxed);
-    m_nErrorByte.exchange(0, std::memory_order_relaxed);
-    m_fErrorCurrentFps.exchange(0.0, std::memory_order_relaxed);
-    m_fErrorAverageFps.exchange(0.0, std::memory_order_relaxed);
-
-    m_nFatalLine.exchange(0, std::memory_order_relaxed);
-    m_nFatalByte.exchange(0, std::memory_order_relaxed);
-    m_fFatalCurrentFps.exchange(0.0, std::memory_order_relaxed);
-    m_fFatalAverageFps.exchange(0.0, std::memory_order_relaxed);
-
-    m_nMainLine.exchange(0, std::memory_order_relaxed);
-    m_nMainByte.exchange(0, std::memory_order_relaxed);
-    m_fMainCurrentFps.exchange(0.0, std::memory_order_relaxed);
-    m_fMainAverageFps.exchange(0.0, std::memory_order_relaxed);
-
-    m_nRemoteLine.exchange(0, std::memory_order_relaxed);
-    m_nRemoteByte.exchange(0, std::memory_order_relaxed);
-    m_fRemoteCurrentFps.exchange(0.0, std::memory_order_relaxed);
-    m_fRemoteAverageFps.exchange(0.0, std::memory_order_relaxed);
-
-    m_nSysLine.exchange(0, std::memory_order_relaxed);
-    m_nSysByte.exchange(0, std::memory_order_relaxed);
-    m_fSysCurrentFps.exchange(0.0, std::memory_order_relaxed);
-    m_fSysAverageFps.exchange(0.0, std::memory_order_relaxed);
+    m_objTotalLine.Reset();
+    m_objTotalByte.Reset();
+
+    for (auto& objCounter : m_arrCounter)
+    {
+        objCounter.nLine.store(0, std::memory_order_relaxed);
+        objCounter.nByte.store(0, std::memory_order_relaxed);
+        objCounter.fCurrentFps.store(0.0, std::memory_order_relaxed);
+        objCounter.fAverageFps.store(0.0, std::memory_order_relaxed);
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////
-SharePtr<CYStatistics> CYStatistics::GetInstance()
+const SharePtr<CYStatistics>& CYStatistics::GetInstance()
 {
     if (!m_ptrInstance)
     {
@@ -898,4 +853,44 @@ void CYStatistics::FreeInstance()
     m_ptrInstance.reset();
 }
 
-CYLOGGER_NAMESPACE_END
\ No newline at end of file
+//////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Add to the shard of the calling thread.
+*/
+void CYStatistics::CYShardCounter::Add(uint64_t nValue)
+{
+    m_arrShard[GetShardIndex()].nValue.fetch_add(nValue, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Sum of all shards.
+*/
+uint64_t CYStatistics::CYShardCounter::Get() const
+{
+    uint64_t nValue = 0;
+    for (const auto& objShard : m_arrShard)
+    {
+        nValue += objShard.nValue.load(std::memory_order_relaxed);
+    }
+    return nValue;
+}
+
+void CYStatistics::CYShardCounter::Reset()
+{
+    for (auto& objShard : m_arrShard)
+    {
+        objShard.nValue.store(0, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Shard of the calling thread, threads are spread over the shards in the order they first add.
+*/
+size_t CYStatistics::CYShardCounter::GetShardIndex()
+{
+    static std::atomic<size_t> s_nNextShard = 0;
+    thread_local size_t nShard = s_nNextShard.fetch_add(1, std::memory_order_relaxed) % LOG_STATS_SHARD_COUNT;
+    return nShard;
+}
+
+CYLOGGER_NAMESPACE_END
@@ -288,101 +288,57 @@ public:
     void Reset();
     //////////////////////////////////////////////////////////////////////////
     //Singleton.
-    static SharePtr<CYStatistics> GetInstance();
+    static const SharePtr<CYStatistics>& GetInstance();
     static void FreeInstance();
 
 private:
-    std::atomic_uint64_t m_nTotalLine = 0;          // The total number of lines written to the log.
-    std::atomic_uint64_t m_nTotalByte = 0;          // Total bytes written to the log.
-    std::atomic<double>  m_fTotalCurrentFps = 0;    // Total fps written to the log.
-    std::atomic<double>  m_fTotalAverageFps = 0;    // Total fps written to the log.
-    std::atomic_uint32_t m_nTotalPublicQueue = 0;   // Total public queue length.
-    std::atomic_uint32_t m_nTotalPrivateQueue = 0;  // Total private queue length.
-
-    std::atomic_uint64_t m_nConsoleLine = 0;        // The total number of lines written to the console log.
-    std::atomic_uint64_t m_nConsoleByte = 0;        // Total bytes written to the console log.
-    std::atomic<double>  m_fConsoleCurrentFps = 0;  // Total fps written to the console log.
-    std::atomic<double>  m_fConsoleAverageFps = 0;  // Total fps written to the console log.
-    std::atomic_uint32_t m_nConsolePublicDQueue = 0;// The console public debug queue length.
-    std::atomic_uint32_t m_nConsolePublicTQueue = 0;// The console public trace queue length.
-    std::atomic_uint32_t m_nConsolePublicIQueue = 0;// The console public info queue length.
-    std::atomic_uint32_t m_nConsolePublicWQueue = 0;// The console public warn queue length.
-    std::atomic_uint32_t m_nConsolePublicEQueue = 0;// The console public error queue length.
-    std::atomic_uint32_t m_nConsolePublicFQueue = 0;// The console public fatal queue length.
-    std::atomic_uint32_t m_nConsolePrivateQueue = 0;// The console private queue length.
-
-    std::atomic_uint64_t m_nTraceLine = 0;          // The total number of lines written to the trace log.
-    std::atomic_uint64_t m_nTraceByte = 0;          // Total bytes written to the trace log.
-    std::atomic<double>  m_fTraceCurrentFps = 0;    // Total fps written to the trace log.
-    std::atomic<double>  m_fTraceAverageFps = 0;    // Total fps written to the trace log.
-    std::atomic_uint32_t m_nTracePublicQueue = 0;   // The trace public queue length.
-    std::atomic_uint32_t m_nTracePrivateQueue = 0;  // The trace private queue length.
-
-    std::atomic_uint64_t m_nDebugLine = 0;          // The total number of lines written to the debug log.
-    std::atomic_uint64_t m_nDebugByte = 0;          // Total bytes written to the debug log.
-    std::atomic<double>  m_fDebugCurrentFps = 0;    // Total fps written to the debug log.
-    std::atomic<double>  m_fDebugAverageFps = 0;    // Total fps written to the debug log.
-    std::atomic_uint32_t m_nDebugPublicQueue = 0;   // The debug public queue length.
-    std::atomic_uint32_t m_nDebugPrivateQueue = 0;  // The debug private queue length.
-
-    std::atomic_uint64_t m_nInfoLine = 0;           // The total number of lines written to the info log.
-    std::atomic_uint64_t m_nInfoByte = 0;           // Total bytes written to the info log.
-    std::atomic<double>  m_fInfoCurrentFps = 0;     // Total fps written to the info log.
-    std::atomic<double>  m_fInfoAverageFps = 0;     // Total fps written to the info log.
-    std::atomic_uint32_t m_nInfoPublicQueue = 0;    // The info public queue length.
-    std::atomic_uint32_t m_nInfoPrivateQueue = 0;   // The info private queue length.
-
-    std::atomic_uint64_t m_nWarnLine = 0;           // The total number of lines written to the warn log.
-    std::atomic_uint64_t m_nWarnByte = 0;           // Total bytes written to the warn log.
-    std::atomic<double>  m_fWarnCurrentFps = 0;     // Total fps written to the warn log.
-    std::atomic<double>  m_fWarnAverageFps = 0;     // Total fps written to the warn log.
-    std::atomic_uint32_t m_nWarnPublicQueue = 0;    // The warn public queue length.
-    std::atomic_uint32_t m_nWarnPrivateQueue = 0;   // The warn private queue length.
-
-    std::atomic_uint64_t m_nErrorLine = 0;          // The total number of lines written to the error log.
-    std::atomic_uint64_t m_nErrorByte = 0;          // Total bytes written to the error log.
-    std::atomic<double>  m_fErrorCurrentFps = 0;    // Total fps written to the error log.
-    std::atomic<double>  m_fErrorAverageFps = 0;    // Total fps written to the error log.
-    std::atomic_uint32_t m_nErrorPublicQueue = 0;   // The error public queue length.
-    std::atomic_uint32_t m_nErrorPrivateQueue = 0;  // The error private queue length.
-
-    std::atomic_uint64_t m_nFatalLine = 0;          // The total number of lines written to the fatal log.
-    std::atomic_uint64_t m_nFatalByte = 0;          // Total bytes written to the fatal log.
-    std::atomic<double>  m_fFatalCurrentFps = 0;    // Total fps written to the fatal log.
-    std::atomic<double>  m_fFatalAverageFps = 0;    // Total fps written to the fatal log.
-    std::atomic_uint32_t m_nFatalPublicQueue = 0;   // The fatal public queue length.
-    std::atomic_uint32_t m_nFatalPrivateQueue = 0;  // The fatal private queue length.
-
-    std::atomic_uint64_t m_nMainLine = 0;           // The total number of lines written to the main log.
-    std::atomic_uint64_t m_nMainByte = 0;           // Total bytes written to the main log.
-    std::atomic<double>  m_fMainCurrentFps = 0;     // Total fps written to the main log.
-    std::atomic<double>  m_fMainAverageFps = 0;     // Total fps written to the main log.
-    std::atomic_uint32_t m_nMainPublicDQueue = 0;   // The main public debug queue length.
-    std::atomic_uint32_t m_nMainPublicTQueue = 0;   // The main public trace queue length.
-    std::atomic_uint32_t m_nMainPublicIQueue = 0;   // The main public info queue length.
-    std::atomic_uint32_t m_nMainPublicWQueue = 0;   // The main public warn queue length.
-    std::atomic_uint32_t m_nMainPublicEQueue = 0;   // The main public error queue length.
-    std::atomic_uint32_t m_nMainPublicFQueue = 0;   // The main public queue length.
-    std::atomic_uint32_t m_nMainPrivateQueue = 0;   // The main private queue length.
-
-    std::atomic_uint64_t m_nRemoteLine = 0;         // The total number of lines written to the remote log.
-    std::atomic_uint64_t m_nRemoteByte = 0;         // Total bytes written to the remote log.
-    std::atomic<double>  m_fRemoteCurrentFps = 0;   // Total fps written to the remote log.
-    std::atomic<double>  m_fRemoteAverageFps = 0;   // Total fps written to the remote log.
-    std::atomic_uint32_t m_nRemotePublicDQueue = 0; // The remote public debug queue length.
-    std::atomic_uint32_t m_nRemotePublicTQueue = 0; // The remote public trace queue length.
-    std::atomic_uint32_t m_nRemotePublicIQueue = 0; // The remote public info queue length.
-    std::atomic_uint32_t m_nRemotePublicWQueue = 0; // The remote public warn queue length.
-    std::atomic_uint32_t m_nRemotePublicEQueue = 0; // The remote public error queue length.
-    std::atomic_uint32_t m_nRemotePublicFQueue = 0; // The remote public  queue length.
-    std::atomic_uint32_t m_nRemotePrivateQueue = 0; // The remote private queue length.
-
-    std::atomic_uint64_t m_nSysLine = 0;            // The total number of lines written to the system event log.
-    std::atomic_uint64_t m_nSysByte = 0;            // Total bytes written to the system event log.
-    std::atomic<double>  m_fSysCurrentFps = 0;      // Total fps written to the system log.
-    std::atomic<double>  m_fSysAverageFps = 0;      // Total fps written to the system log.
-    std::atomic_uint32_t m_nSysPublicQueue = 0;     // The system public queue length.
-    std::atomic_uint32_t m_nSysPrivateQueue = 0;    // The system private queue length.
+    /**
+     * @brief Counter split into per-thread shards, a thread only adds to its own shard and the shards are summed when read.
+    */
+    class CYShardCounter final
+    {
+    public:
+        void Add(uint64_t nValue);
+        uint64_t Get() const;
+        void Reset();
+
+    private:
+        struct alignas(LOG_CACHE_LINE_SIZE) STShard
+        {
+            std::atomic_uint64_t nValue = 0;
+        };
+
+        static size_t GetShardIndex();
+
+        STShard m_arrShard[LOG_STATS_SHARD_COUNT];
+    };
+
+    /**
+     * @brief Counters of one appender, written by its log thread only.
+    */
+    struct alignas(LOG_CACHE_LINE_SIZE) STAppenderCounter
+    {
+        std::atomic_uint64_t nLine = 0;                     // The total number of lines written to the log.
+        std::atomic_uint64_t nByte = 0;                     // Total bytes written to the log.
+        std::atomic<double>  fCurrentFps = 0;               // The current fps written to the log.
+        std::atomic<double>  fAverageFps = 0;               // The average fps written to the log.
+        std::atomic_uint32_t nPrivateQueue = 0;             // The private queue length.
+    };
+
+    /**
+     * @brief Public queue lengths of one appender by message type, sampled by its log thread at each flip.
+    */
+    struct alignas(LOG_CACHE_LINE_SIZE) STQueueCounter
+    {
+        std::atomic_uint32_t arrPublicQueue[LOG_TYPE_MAX] = {};
+    };
+
+    static constexpr int STATS_TOTAL = LOG_TYPE_MAX;        // Index of the totals after the appender blocks.
+
+    CYShardCounter    m_objTotalLine;                       // The total number of lines written to the log.
+    CYShardCounter    m_objTotalByte;                       // Total bytes written to the log.
+    STAppenderCounter m_arrCounter[LOG_TYPE_MAX + 1];       // Log thread counters by appender type, console is LOG_TYPE_NONE.
+    STQueueCounter    m_arrQueue[LOG_TYPE_MAX + 1];         // Public queue lengths by appender type.
 
     static SharePtr<CYStatistics> m_ptrInstance;
 };
@@ -0,0 +1,241 @@
+/*
+ * Round trips of the codecs: the LZ block codec and its framed stream, file compression with verification for every
+ * codec compiled in, and the printf argument lists of the binary log format. Recovery of a torn or damaged frame tail.
+ */
+#include "Tests/CYTestDefine.hpp"
+#include "Common/Compress/CYLzCodec.hpp"
+#include "Common/Compress/CYLogFileCompressor.hpp"
+#include "Common/Message/CYLogArgs.hpp"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace CYLOGGER_NAMESPACE;
+
+namespace
+{
+/**
+ * @brief Log like data, repetitive text with random fields.
+*/
+std::string MakeData(size_t nSize, uint32_t nSeed)
+{
+    std::mt19937 objRandom(nSeed);
+    std::string strData;
+    while (strData.size() < nSize)
+    {
+        strData += "[2023-04-15 12:00:00.000|I|P:1|T:" + std::to_string(objRandom() % 64) + "] value=" + std::to_string(objRandom()) + "\n";
+    }
+    strData.resize(nSize);
+    return strData;
+}
+
+std::string ReadAll(const std::string& strFile)
+{
+    std::ifstream objFile(strFile, std::ios_base::in | std::ios_base::binary);
+    std::ostringstream objOut;
+    objOut << objFile.rdbuf();
+    return objOut.str();
+}
+
+void WriteAll(const std::string& strFile, const std::string& strData)
+{
+    std::ofstream objFile(strFile, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    objFile.write(strData.data(), static_cast<std::streamsize>(strData.size()));
+}
+
+void TestLzBlock()
+{
+    std::mt19937 objRandom(7);
+    std::string strNoise(5000, '\0');
+    for (char& c : strNoise) c = static_cast<char>(objRandom());
+
+    for (const std::string& strData : { std::string(), std::string("a"), std::string(70000, 'x'), MakeData(100000, 1), strNoise })
+    {
+        std::vector<uint8_t> vecPacked(CYLzCodec::CompressBound(strData.size()));
+        size_t nPacked = CYLzCodec::Compress(reinterpret_cast<const uint8_t*>(strData.data()), strData.size(), vecPacked.data(), vecPacked.size());
+        CY_TEST_CHECK(strData.empty() || nPacked > 0);
+
+        std::string strOut(strData.size(), '\0');
+        CY_TEST_CHECK(CYLzCodec::Decompress(vecPacked.data(), nPacked, reinterpret_cast<uint8_t*>(strOut.data()), strOut.size()));
+        CY_TEST_CHECK(strOut == strData);
+
+        // A raw size that does not match is rejected.
+        if (!strData.empty())
+        {
+            std::string strShort(strData.size() - 1, '\0');
+            CY_TEST_CHECK(!CYLzCodec::Decompress(vecPacked.data(), nPacked, reinterpret_cast<uint8_t*>(strShort.data()), strShort.size()));
+        }
+    }
+
+    const char szCheck[] = "123456789";
+    CY_TEST_CHECK(CYLzCodec::Crc32(reinterpret_cast<const uint8_t*>(szCheck), 9) == 0xCBF43926u);
+}
+
+void TestLzFrame()
+{
+    std::string strData = MakeData(300000, 2);
+    std::string strFrame;
+    CYLzCodec::AppendFrameHeader(strFrame);
+    for (size_t nPos = 0; nPos < strData.size(); nPos += 65536)
+    {
+        size_t nSize = std::min<size_t>(65536, strData.size() - nPos);
+        CYLzCodec::AppendFrameBlock(reinterpret_cast<const uint8_t*>(strData.data() + nPos), nSize, strFrame);
+    }
+    CYLzCodec::AppendFrameEnd(strFrame);
+
+    std::istringstream objStream(strFrame);
+    CY_TEST_CHECK(CYLzCodec::ReadFrameHeader(objStream));
+    std::string strPacked, strBlock, strOut;
+    bool bEnd = false;
+    while (CYLzCodec::ReadFrameBlock(objStream, strPacked, strBlock, bEnd) && !bEnd)
+    {
+        strOut += strBlock;
+    }
+    CY_TEST_CHECK(bEnd);
+    CY_TEST_CHECK(strOut == strData);
+
+    // A flipped payload byte fails the CRC of its block.
+    std::string strCorrupt = strFrame;
+    strCorrupt[LOG_LZ_FRAME_HEADER_SIZE + LOG_LZ_BLOCK_HEADER_SIZE + 10] ^= 0x01;
+    std::istringstream objCorrupt(strCorrupt);
+    CY_TEST_CHECK(CYLzCodec::ReadFrameHeader(objCorrupt));
+    CY_TEST_CHECK(!CYLzCodec::ReadFrameBlock(objCorrupt, strPacked, strBlock, bEnd));
+}
+
+/**
+ * @brief The valid prefix kept when a compressed log is reopened for appending.
+*/
+void TestLzTornTail()
+{
+    std::string strFrame;
+    CYLzCodec::AppendFrameHeader(strFrame);
+    std::vector<size_t> vecBlockEnd;
+    for (uint32_t nBlock = 0; nBlock < 3; ++nBlock)
+    {
+        std::string strData = MakeData(20000, nBlock);
+        CYLzCodec::AppendFrameBlock(reinterpret_cast<const uint8_t*>(strData.data()), strData.size(), strFrame);
+        vecBlockEnd.push_back(strFrame.size());
+    }
+
+    auto funValid = [](const std::string& strData) {
+        std::istringstream objStream(strData);
+        return CYLzCodec::GetValidFrameLength(objStream);
+        };
+
+    // Complete blocks are kept, an end marker is cut off.
+    CY_TEST_CHECK(funValid(strFrame) == vecBlockEnd[2]);
+    std::string strEnded = strFrame;
+    CYLzCodec::AppendFrameEnd(strEnded);
+    CY_TEST_CHECK(funValid(strEnded) == vecBlockEnd[2]);
+
+    // A torn last block, in its header or its payload.
+    CY_TEST_CHECK(funValid(strFrame.substr(0, vecBlockEnd[1] + 3)) == vecBlockEnd[1]);
+    CY_TEST_CHECK(funValid(strFrame.substr(0, vecBlockEnd[2] - 1)) == vecBlockEnd[1]);
+
+    // A complete last block with a damaged payload fails its CRC.
+    std::string strDamaged = strFrame;
+    strDamaged[vecBlockEnd[2] - 1] ^= 0x20;
+    CY_TEST_CHECK(funValid(strDamaged) == vecBlockEnd[1]);
+
+    // Only the header.
+    CY_TEST_CHECK(funValid(strFrame.substr(0, LOG_LZ_FRAME_HEADER_SIZE)) == LOG_LZ_FRAME_HEADER_SIZE);
+
+    // Not a compressed log.
+    CY_TEST_CHECK(funValid("plain text log\n") == 0);
+}
+
+void TestCompressFile()
+{
+    const std::string strSrc = "CYCodecTest.src";
+    const std::string strDst = "CYCodecTest.dst";
+    const std::string strTorn = "CYCodecTest.torn";
+
+    for (size_t nSize : { size_t(0), size_t(1), size_t(LOG_ZIP_BLOCK_SIZE), size_t(LOG_ZIP_BLOCK_SIZE * 3), size_t(1000003) })
+    {
+        WriteAll(strSrc, MakeData(nSize, static_cast<uint32_t>(nSize)));
+        for (ELogZipCodec eCodec : { ELogZipCodec::LOG_ZIP_LZ, ELogZipCodec::LOG_ZIP_GZIP })
+        {
+            CY_TEST_CHECK(CYLogFileCompressor::CompressFile(strSrc, strDst, eCodec, LOG_ZIP_BLOCK_SIZE));
+            CY_TEST_CHECK(CYLogFileCompressor::VerifyFile(strSrc, strDst, eCodec));
+
+            // A compressed file cut short never verifies.
+            std::string strPacked = ReadAll(strDst);
+            WriteAll(strTorn, strPacked.substr(0, strPacked.size() - 1));
+            CY_TEST_CHECK(!CYLogFileCompressor::VerifyFile(strSrc, strTorn, eCodec));
+        }
+    }
+
+    std::remove(strSrc.c_str());
+    std::remove(strDst.c_str());
+    std::remove(strTorn.c_str());
+}
+
+bool Capture(std::string& strArgs, const char* szFormat, ...)
+{
+    va_list args;
+    va_start(args, szFormat);
+    bool bRet = CYLogArgs::Capture(szFormat, args, strArgs);
+    va_end(args);
+    return bRet;
+}
+
+/**
+ * @brief Render through captured arguments and compare with snprintf.
+*/
+template<typename... Args>
+void CheckArgs(const char* szFormat, Args... args)
+{
+    char szExpect[512];
+    std::snprintf(szExpect, sizeof(szExpect), szFormat, args...);
+
+    std::string strArgs, strOut;
+    CY_TEST_CHECK(Capture(strArgs, szFormat, args...));
+    CY_TEST_CHECK(CYLogArgs::Format(szFormat, strArgs, strOut));
+    CY_TEST_CHECK(strOut == szExpect);
+}
+
+void TestLogArgs()
+{
+    const char szBuffer[4] = { 'a', 'b', 'c', 'd' };
+    CheckArgs("plain text");
+    CheckArgs("%d %5i %-4u| %hhd %hu %ld %lld %zu %td %x %#o %X %c %%", -7, 42, 9u, -3, 65535, -123456789L, -1234567890123LL, size_t(77), ptrdiff_t(-9), 255u, 8u, 0xABCDu, 'Z');
+    CheckArgs("%f %.3e %g %10.2f %*.*f", 3.14159, 12345.678, 0.0001, -2.5, 8, 2, 9.876);
+    CheckArgs("[%s] [%.3s] [%-6s] [%.*s]", "hello", szBuffer, "ab", 2, szBuffer);
+    CheckArgs("%p", reinterpret_cast<void*>(0x1234));
+
+    // Conversions that cannot be deferred are left to the caller.
+    std::string strArgs;
+    CY_TEST_CHECK(!Capture(strArgs, "%Lf", 1.5L));
+    CY_TEST_CHECK(!Capture(strArgs, "%1$d", 1));
+
+    // Arguments that do not match the format are rejected.
+    std::string strOut;
+    strArgs.clear();
+    CY_TEST_CHECK(Capture(strArgs, "%d", 5));
+    CY_TEST_CHECK(!CYLogArgs::Format("%s", strArgs, strOut));
+    CY_TEST_CHECK(!CYLogArgs::Format("%d %d", strArgs, strOut));
+    CY_TEST_CHECK(!CYLogArgs::Format("%d", strArgs.substr(0, strArgs.size() - 1), strOut));
+
+    strArgs.clear();
+    strOut.clear();
+    CYLogArgs::CaptureText("100% text", strArgs);
+    CY_TEST_CHECK(CYLogArgs::Format("%s", strArgs, strOut) && strOut == "100% text");
+}
+}
+
+int main()
+{
+    TestLzBlock();
+    TestLzFrame();
+    TestLzTornTail();
+    TestCompressFile();
+    TestLogArgs();
+    return CY_TEST_RESULT();
+}
@@ -0,0 +1,139 @@
+/*
+ * Latency histogram: exact buckets for small values, percentiles within the bucket error for large ones, the maximum
+ * capping the top bucket, reading with and without a reset, and recording from several threads at once.
+ */
+#include "Tests/CYTestDefine.hpp"
+#include "Statistics/CYLatencyHistogram.hpp"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace CYLOGGER_NAMESPACE;
+
+namespace
+{
+/**
+ * @brief The histogram keeps a value within about 3%, a percentile never reports less than the exact one.
+*/
+bool IsNear(uint64_t nActual, uint64_t nExpected)
+{
+    return nActual >= nExpected && nActual <= nExpected + nExpected / 32;
+}
+
+void TestEmpty()
+{
+    CYLatencyHistogram objHistogram;
+    STLatencyStats objStats;
+    objHistogram.GetLatency(objStats, false);
+    CY_TEST_CHECK(objStats.nCount == 0);
+    CY_TEST_CHECK(objStats.nP50 == 0);
+    CY_TEST_CHECK(objStats.nMax == 0);
+}
+
+void TestSmallValues()
+{
+    // Values below 64 have a bucket each, the percentiles are exact.
+    CYLatencyHistogram objHistogram;
+    for (uint64_t i = 1; i <= 60; ++i)
+    {
+        objHistogram.Record(i);
+    }
+
+    STLatencyStats objStats;
+    objHistogram.GetLatency(objStats, false);
+    CY_TEST_CHECK(objStats.nCount == 60);
+    CY_TEST_CHECK(objStats.nP50 == 30);
+    CY_TEST_CHECK(objStats.nP90 == 54);
+    CY_TEST_CHECK(objStats.nP99 == 60);
+    CY_TEST_CHECK(objStats.nP999 == 60);
+    CY_TEST_CHECK(objStats.nMax == 60);
+}
+
+void TestLargeValues()
+{
+    CYLatencyHistogram objHistogram;
+    for (uint64_t i = 1; i <= 1000; ++i)
+    {
+        objHistogram.Record(i * 1000003);
+    }
+
+    STLatencyStats objStats;
+    objHistogram.GetLatency(objStats, false);
+    CY_TEST_CHECK(objStats.nCount == 1000);
+    CY_TEST_CHECK(IsNear(objStats.nP50, 500 * 1000003ull));
+    CY_TEST_CHECK(IsNear(objStats.nP90, 900 * 1000003ull));
+    CY_TEST_CHECK(IsNear(objStats.nP99, 990 * 1000003ull));
+
+    // The top bucket is capped by the largest recorded value.
+    CY_TEST_CHECK(objStats.nP999 == 1000 * 1000003ull);
+    CY_TEST_CHECK(objStats.nMax == 1000 * 1000003ull);
+
+    // The full range of the clock fits into the buckets.
+    objHistogram.Record(UINT64_MAX);
+    objHistogram.GetLatency(objStats, false);
+    CY_TEST_CHECK(objStats.nCount == 1001);
+    CY_TEST_CHECK(objStats.nMax == UINT64_MAX);
+}
+
+void TestReset()
+{
+    CYLatencyHistogram objHistogram;
+    objHistogram.Record(10);
+    objHistogram.Record(20);
+
+    STLatencyStats objStats;
+    objHistogram.GetLatency(objStats, false);
+    CY_TEST_CHECK(objStats.nCount == 2);
+
+    // Reading with a reset returns the recorded values, the next read starts over.
+    objHistogram.GetLatency(objStats, true);
+    CY_TEST_CHECK(objStats.nCount == 2);
+    CY_TEST_CHECK(objStats.nMax == 20);
+    objHistogram.GetLatency(objStats, false);
+    CY_TEST_CHECK(objStats.nCount == 0);
+    CY_TEST_CHECK(objStats.nMax == 0);
+
+    objHistogram.Record(5);
+    objHistogram.Reset();
+    objHistogram.GetLatency(objStats, false);
+    CY_TEST_CHECK(objStats.nCount == 0);
+}
+
+void TestConcurrentRecord()
+{
+    constexpr int THREAD_COUNT = 4;
+    constexpr uint64_t RECORD_COUNT = 100000;
+
+    CYLatencyHistogram objHistogram;
+    std::vector<std::thread> vecThread;
+    for (int i = 0; i < THREAD_COUNT; ++i)
+    {
+        vecThread.emplace_back([&objHistogram, i]() {
+            for (uint64_t j = 0; j < RECORD_COUNT; ++j)
+            {
+                objHistogram.Record(j + static_cast<uint64_t>(i));
+            }
+        });
+    }
+    for (auto& objThread : vecThread)
+    {
+        objThread.join();
+    }
+
+    STLatencyStats objStats;
+    objHistogram.GetLatency(objStats, false);
+    CY_TEST_CHECK(objStats.nCount == THREAD_COUNT * RECORD_COUNT);
+    CY_TEST_CHECK(objStats.nMax == RECORD_COUNT - 1 + THREAD_COUNT - 1);
+}
+}
+
+int main()
+{
+    TestEmpty();
+    TestSmallValues();
+    TestLargeValues();
+    TestReset();
+    TestConcurrentRecord();
+    return CY_TEST_RESULT();
+}
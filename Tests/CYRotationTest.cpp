@@ -0,0 +1,92 @@
+/*
+ * Rotation policy of a file appender: the size limit of the policy or the shared restriction, the line limit, and the
+ * time boundary that is only due once the next hour or day has begun.
+ */
+#include "Tests/CYTestDefine.hpp"
+#include "Common/CYFileRestriction.hpp"
+
+using namespace CYLOGGER_NAMESPACE;
+
+namespace
+{
+void TestSharedSize()
+{
+    CYFileRestriction::SetRestriction(1000);
+    CYFileRestriction objRestriction;
+    CY_TEST_CHECK(objRestriction.GetMaxSize() == 1000);
+
+    objRestriction.AddFileSize(1000);
+    CY_TEST_CHECK(!objRestriction.IsCreateNewLog());
+    objRestriction.AddFileSize(1);
+    CY_TEST_CHECK(objRestriction.IsCreateNewLog());
+
+    objRestriction.ResetFileSize();
+    CY_TEST_CHECK(objRestriction.GetFileSize() == 0);
+    CY_TEST_CHECK(!objRestriction.IsCreateNewLog());
+}
+
+void TestPolicySize()
+{
+    CYFileRestriction::SetRestriction(1000);
+    CYFileRestriction objRestriction;
+
+    STRotationPolicy objPolicy;
+    objPolicy.nMaxBytes = 100;
+    objRestriction.SetRotation(objPolicy);
+    CY_TEST_CHECK(objRestriction.GetMaxSize() == 100);
+
+    objRestriction.AddFileSize(101);
+    CY_TEST_CHECK(objRestriction.IsCreateNewLog());
+
+    // A policy without a size falls back to the shared restriction.
+    objRestriction.SetRotation(STRotationPolicy());
+    CY_TEST_CHECK(objRestriction.GetMaxSize() == 1000);
+    CY_TEST_CHECK(!objRestriction.IsCreateNewLog());
+}
+
+void TestPolicyLines()
+{
+    CYFileRestriction::SetRestriction(1000);
+    CYFileRestriction objRestriction;
+
+    STRotationPolicy objPolicy;
+    objPolicy.nMaxLines = 3;
+    objRestriction.SetRotation(objPolicy);
+
+    objRestriction.AddFileLine(2);
+    CY_TEST_CHECK(!objRestriction.IsCreateNewLog());
+    objRestriction.AddFileLine(1);
+    CY_TEST_CHECK(objRestriction.IsCreateNewLog());
+
+    objRestriction.ResetFileSize();
+    CY_TEST_CHECK(!objRestriction.IsCreateNewLog());
+}
+
+void TestPolicyTime()
+{
+    CYFileRestriction objRestriction;
+    CY_TEST_CHECK(!objRestriction.IsRotateTimeDue());
+
+    // The boundary is the next hour or day, a file opened now is not due yet.
+    STRotationPolicy objPolicy;
+    objPolicy.eRotateTime = LOG_ROTATE_TIME_HOURLY;
+    objRestriction.SetRotation(objPolicy);
+    CY_TEST_CHECK(!objRestriction.IsRotateTimeDue());
+
+    objPolicy.eRotateTime = LOG_ROTATE_TIME_DAILY;
+    objRestriction.SetRotation(objPolicy);
+    CY_TEST_CHECK(!objRestriction.IsRotateTimeDue());
+
+    objRestriction.SetRotation(STRotationPolicy());
+    CY_TEST_CHECK(!objRestriction.IsRotateTimeDue());
+}
+}
+
+int main()
+{
+    TestSharedSize();
+    TestPolicySize();
+    TestPolicyLines();
+    TestPolicyTime();
+    return CY_TEST_RESULT();
+}
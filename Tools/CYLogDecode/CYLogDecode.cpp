@@ -0,0 +1,407 @@
+/*
+ * cylog-decode: render CYLogger binary log files (LOG_MODE_FILE_BINARY) as text.
+ *
+ * Usage: cylog-decode [-l 1|2|3] [-f] [-z] [-o output] file [file ...]
+ *   -l  built-in layout used for rendering, default 1.
+ *   -f  follow: keep reading records appended to a single input file.
+ *   -z  decompress block compressed text logs (.lz, LOG_MODE_FILE_COMPRESS or rotated files) in the given order.
+ *   -o  write to a file instead of stdout.
+ * Several input files are merged by record time.
+ */
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Common/Binary/CYBinaryLogFormat.hpp"
+#include "Common/Compress/CYLzCodec.hpp"
+#include "Common/Message/CYLogArgs.hpp"
+#include "Common/Time/CYTimeFormat.hpp"
+#include "Entity/Layout/CYLoggerTemplateLayout1.hpp"
+#include "Entity/Layout/CYLoggerTemplateLayout2.hpp"
+#include "Entity/Layout/CYLoggerTemplateLayout3.hpp"
+#include "CYCommon/Common/Structure/CYStringUtils.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <queue>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <cstring>
+
+using namespace CYLOGGER_NAMESPACE;
+
+/**
+ * @brief Decoded log record.
+*/
+struct STBinaryRecord
+{
+    uint64_t    nSequence = 0;
+    int64_t     nTimeNs = 0;
+    int         nLevel = 0;
+    int64_t     nServerCode = 0;
+    uint64_t    nThreadId = 0;
+    uint64_t    nProcessId = 0;
+    std::string strFile;
+    std::string strFunction;
+    uint64_t    nLine = 0;
+    std::string strFormat;
+    std::string strChannel;
+    std::string strMsg;
+};
+
+/**
+ * @brief Streaming reader of one binary log file.
+*/
+class CYBinaryLogReader
+{
+public:
+    explicit CYBinaryLogReader(const std::string& strFileName)
+        : m_strFileName(strFileName)
+        , m_objFile(strFileName, std::ios_base::in | std::ios_base::binary)
+        , m_objReader(m_objFile)
+    {
+    }
+
+    bool IsOpen() const
+    {
+        return m_objFile.is_open();
+    }
+
+    /**
+     * @brief Whether reading stopped for good on corruption or an unsupported version, follow mode gives up then.
+    */
+    bool IsFailed() const
+    {
+        return m_bFailed;
+    }
+
+    const std::string& GetFileName() const
+    {
+        return m_strFileName;
+    }
+
+    /**
+     * @brief Read the next record, false on end of data. A partial record is rewound so it can be read again in follow mode.
+    */
+    bool Next(STBinaryRecord& objRecord)
+    {
+        while (!m_bFailed)
+        {
+            std::streampos nPos = m_objFile.tellg();
+            int nTag = m_objFile.peek();
+            if (nTag == std::char_traits<char>::eof())
+                return Rewind(nPos);
+
+            bool bOk = false;
+            if (nTag == LOG_BINARY_MAGIC[0])
+            {
+                bOk = ReadHeader();
+            }
+            else if (nTag == BINARY_TAG_CALLSITE)
+            {
+                bOk = ReadCallSite();
+            }
+            else if (nTag == BINARY_TAG_LOG)
+            {
+                bOk = ReadLog(objRecord);
+                if (bOk)
+                    return true;
+            }
+            else
+            {
+                m_objReader.SetCorrupt();
+            }
+
+            if (m_objReader.IsCorrupt())
+            {
+                std::cerr << m_strFileName << ": corrupt record at offset " << static_cast<long long>(nPos) << std::endl;
+                m_bFailed = true;
+            }
+
+            if (!bOk)
+                return m_bFailed ? false : Rewind(nPos);
+        }
+        return false;
+    }
+
+private:
+    bool Rewind(std::streampos nPos)
+    {
+        m_objFile.clear();
+        m_objFile.seekg(nPos);
+        return false;
+    }
+
+    bool ReadHeader()
+    {
+        char szMagic[sizeof(LOG_BINARY_MAGIC)] = { 0 };
+        m_objFile.read(szMagic, sizeof(szMagic));
+        if (m_objFile.gcount() != sizeof(szMagic) || std::memcmp(szMagic, LOG_BINARY_MAGIC, sizeof(szMagic)) != 0)
+            return false;
+
+        uint8_t nVersion = 0;
+        uint64_t nBaseTime = 0;
+        if (!m_objReader.GetByte(nVersion) || !m_objReader.GetVarint(m_nProcessId) || !m_objReader.GetFixed64(nBaseTime))
+            return false;
+
+        if (nVersion != LOG_BINARY_VERSION)
+        {
+            std::cerr << m_strFileName << ": unsupported version " << static_cast<int>(nVersion) << std::endl;
+            m_bFailed = true;
+            return false;
+        }
+
+        // New segment, new dictionary.
+        m_vecCallSite.clear();
+        m_nLastTimeNs = static_cast<int64_t>(nBaseTime);
+        return true;
+    }
+
+    bool ReadCallSite()
+    {
+        uint8_t nTag = 0;
+        uint64_t nId = 0;
+        STBinaryRecord objSite;
+        if (!m_objReader.GetByte(nTag) || !m_objReader.GetVarint(nId) || !m_objReader.GetString(objSite.strFile) || !m_objReader.GetString(objSite.strFunction) || !m_objReader.GetVarint(objSite.nLine)
+            || !m_objReader.GetString(objSite.strFormat))
+            return false;
+
+        // Ids count up from 0, anything past the next one is corruption.
+        if (nId > m_vecCallSite.size())
+            return m_objReader.SetCorrupt();
+        if (nId == m_vecCallSite.size())
+            m_vecCallSite.emplace_back();
+        m_vecCallSite[static_cast<size_t>(nId)] = std::move(objSite);
+        return true;
+    }
+
+    bool ReadLog(STBinaryRecord& objRecord)
+    {
+        uint8_t nTag = 0;
+        uint8_t nLevel = 0;
+        int64_t nDelta = 0;
+        uint64_t nCallSite = 0;
+        if (!m_objReader.GetByte(nTag) || !m_objReader.GetVarint(objRecord.nSequence) || !m_objReader.GetZigZag(nDelta) || !m_objReader.GetVarint(nCallSite)
+            || !m_objReader.GetByte(nLevel) || !m_objReader.GetZigZag(objRecord.nServerCode) || !m_objReader.GetVarint(objRecord.nThreadId)
+            || !m_objReader.GetString(objRecord.strChannel) || !m_objReader.GetString(m_strArgs))
+            return false;
+
+        // Every record refers to a call site already read, the arguments must match its format.
+        if (nCallSite >= m_vecCallSite.size())
+            return m_objReader.SetCorrupt();
+
+        m_nLastTimeNs += nDelta;
+        objRecord.nTimeNs = m_nLastTimeNs;
+        objRecord.nLevel = nLevel;
+        objRecord.nProcessId = m_nProcessId;
+
+        const STBinaryRecord& objSite = m_vecCallSite[static_cast<size_t>(nCallSite)];
+        objRecord.strFile = objSite.strFile;
+        objRecord.strFunction = objSite.strFunction;
+        objRecord.nLine = objSite.nLine;
+        objRecord.strMsg.clear();
+        if (!CYLogArgs::Format(objSite.strFormat, m_strArgs, objRecord.strMsg))
+            return m_objReader.SetCorrupt();
+        return true;
+    }
+
+private:
+    std::string m_strFileName;
+    std::ifstream m_objFile;
+    CYBinaryReader m_objReader;
+    std::vector<STBinaryRecord> m_vecCallSite;
+    uint64_t m_nProcessId = 0;
+    int64_t m_nLastTimeNs = 0;
+    std::string m_strArgs;
+    bool m_bFailed = false;
+};
+
+static TString ToTString(const std::string& str)
+{
+#if CY_USE_UNICODE
+    return CYCOMMON_NAMESPACE::CYStringUtils::String2TString(str);
+#else
+    return str;
+#endif
+}
+
+/**
+ * @brief Render one record through a built-in layout.
+*/
+static void Render(ICYLoggerTemplateLayout& objLayout, const STBinaryRecord& objRecord, std::ostream& objOut)
+{
+    int nYY, nMM, nDD, nHR, nMN, nSC, nMMN;
+    CYTimeFormat::Split(objRecord.nTimeNs, nYY, nMM, nDD, nHR, nMN, nSC, nMMN);
+
+    TString strLine = objLayout.GetFormatMessage(ToTString(objRecord.strChannel), static_cast<ELogType>(objRecord.nLevel), static_cast<int>(objRecord.nServerCode),
+        ToTString(objRecord.strMsg), ToTString(objRecord.strFile), ToTString(objRecord.strFunction), static_cast<int>(objRecord.nLine),
+        static_cast<unsigned long>(objRecord.nProcessId), static_cast<unsigned long>(objRecord.nThreadId), nYY, nMM, nDD, nHR, nMN, nSC, nMMN, false);
+
+#if CY_USE_UNICODE
+    objOut << CYCOMMON_NAMESPACE::CYStringUtils::TString2String(strLine.c_str()) << '\n';
+#else
+    objOut << strLine << '\n';
+#endif
+}
+
+static int Usage()
+{
+    std::cerr << "Usage: cylog-decode [-l 1|2|3] [-f] [-z] [-o output] file [file ...]" << std::endl;
+    return 2;
+}
+
+/**
+ * @brief Write the text of block compressed files, a torn last block is reported and skipped.
+*/
+static int Decompress(const std::vector<std::string>& vecInput, std::ostream& objOut)
+{
+    int nRet = 0;
+    std::string strPacked, strBlock;
+    for (const std::string& strInput : vecInput)
+    {
+        std::ifstream objFile(strInput, std::ios_base::in | std::ios_base::binary);
+        if (!objFile || !CYLzCodec::ReadFrameHeader(objFile))
+        {
+            std::cerr << "not a compressed log: " << strInput << std::endl;
+            nRet = 1;
+            continue;
+        }
+
+        bool bEnd = false;
+        std::streamoff nDecoded = objFile.tellg();
+        while (CYLzCodec::ReadFrameBlock(objFile, strPacked, strBlock, bEnd) && !bEnd)
+        {
+            objOut.write(strBlock.data(), static_cast<std::streamsize>(strBlock.size()));
+            nDecoded = objFile.tellg();
+        }
+
+        // Files written by the appender have no end marker and end at a block boundary.
+        objFile.clear();
+        objFile.seekg(0, std::ios_base::end);
+        if (!bEnd && objFile.tellg() != nDecoded)
+        {
+            std::cerr << "truncated or corrupt block in " << strInput << std::endl;
+            nRet = 1;
+        }
+    }
+    return nRet;
+}
+
+int main(int argc, char* argv[])
+{
+    int nLayout = 1;
+    bool bFollow = false;
+    bool bDecompress = false;
+    std::string strOutput;
+    std::vector<std::string> vecInput;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string strArg = argv[i];
+        if (strArg == "-l" && i + 1 < argc)
+            nLayout = std::atoi(argv[++i]);
+        else if (strArg == "-f")
+            bFollow = true;
+        else if (strArg == "-z")
+            bDecompress = true;
+        else if (strArg == "-o" && i + 1 < argc)
+            strOutput = argv[++i];
+        else if (!strArg.empty() && strArg[0] == '-')
+            return Usage();
+        else
+            vecInput.push_back(strArg);
+    }
+
+    if (vecInput.empty() || (bFollow && (vecInput.size() != 1 || bDecompress)))
+        return Usage();
+
+    UniquePtr<ICYLoggerTemplateLayout> ptrLayout;
+    switch (nLayout)
+    {
+    case 1:
+        ptrLayout = MakeUnique<CYLoggerTemplateLayout1>();
+        break;
+    case 2:
+        ptrLayout = MakeUnique<CYLoggerTemplateLayout2>();
+        break;
+    case 3:
+        ptrLayout = MakeUnique<CYLoggerTemplateLayout3>();
+        break;
+    default:
+        return Usage();
+    }
+
+    std::ofstream objFileOut;
+    if (!strOutput.empty())
+    {
+        objFileOut.open(strOutput, std::ios_base::out | std::ios_base::trunc);
+        if (!objFileOut)
+        {
+            std::cerr << "cannot open " << strOutput << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& objOut = strOutput.empty() ? std::cout : objFileOut;
+
+    if (bDecompress)
+        return Decompress(vecInput, objOut);
+
+    std::vector<UniquePtr<CYBinaryLogReader>> vecReader;
+    for (const std::string& strInput : vecInput)
+    {
+        auto ptrReader = MakeUnique<CYBinaryLogReader>(strInput);
+        if (!ptrReader->IsOpen())
+        {
+            std::cerr << "cannot open " << strInput << std::endl;
+            return 1;
+        }
+        vecReader.push_back(std::move(ptrReader));
+    }
+
+    STBinaryRecord objRecord;
+    if (vecReader.size() == 1)
+    {
+        // Single file, stream records in file order.
+        CYBinaryLogReader& objReader = *vecReader.front();
+        while (true)
+        {
+            while (objReader.Next(objRecord))
+            {
+                Render(*ptrLayout, objRecord, objOut);
+            }
+
+            if (!bFollow || objReader.IsFailed())
+                break;
+
+            objOut.flush();
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+        return objReader.IsFailed() ? 1 : 0;
+    }
+
+    // K-way merge by record time, one pending record per file.
+    using MergeItem = std::pair<STBinaryRecord, size_t>;
+    auto funLater = [](const MergeItem& objLeft, const MergeItem& objRight) {
+        if (objLeft.first.nTimeNs != objRight.first.nTimeNs)
+            return objLeft.first.nTimeNs > objRight.first.nTimeNs;
+        return objLeft.second > objRight.second;
+        };
+    std::priority_queue<MergeItem, std::vector<MergeItem>, decltype(funLater)> queMerge(funLater);
+
+    for (size_t nIndex = 0; nIndex < vecReader.size(); ++nIndex)
+    {
+        if (vecReader[nIndex]->Next(objRecord))
+            queMerge.emplace(std::move(objRecord), nIndex);
+    }
+
+    while (!queMerge.empty())
+    {
+        MergeItem objItem = queMerge.top();
+        queMerge.pop();
+        Render(*ptrLayout, objItem.first, objOut);
+
+        if (vecReader[objItem.second]->Next(objRecord))
+            queMerge.emplace(std::move(objRecord), objItem.second);
+    }
+
+    return 0;
+}
@@ -0,0 +1,613 @@
+/*
+ * cylog-listen: local stand-in collector for the remote appender (LOG_TYPE_REMOTE) and the syslog socket (LOG_TYPE_SYS).
+ *
+ * Usage: cylog-listen [-p port] [-T | -u path | -d path | -j path] [-k frames] [-t seconds] [-e] [-b lines]
+ *   -p  port to listen on, default 7000. UDP unless -T is given.
+ *   -T  accept "tcp://host:port" stream appenders on the port instead of UDP datagrams.
+ *   -u  accept "unix://path" stream appenders on a Unix domain socket.
+ *   -d  fake /dev/log: receive syslog frames, one per datagram, on a Unix domain datagram socket ("AppName@path").
+ *   -j  fake journald: receive native journal entries on a Unix domain datagram socket ("AppName@journal://path"),
+ *       including entries passed as a memfd, and echo them as KEY=value lines separated by a blank line.
+ *   -k  stream mode: close each connection after the given number of frames to exercise reconnects.
+ *   -t  stop after the given number of seconds, default runs until killed.
+ *   -e  echo received lines to stdout.
+ *   -b  UDP benchmark: send the given number of lines to the listener twice, one datagram per line
+ *       with sendto and packed into LOG_REMOTE_MTU datagrams with sendmmsg, and compare the rates.
+ * Once per second it prints datagrams (or connections), lines and bytes received in that second, entries count as lines with -j.
+ */
+#include "Inc/ICYLoggerDefine.hpp"
+#include "Entity/Appender/CYLoggerAppenderDefine.hpp"
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+using CYLOGGER_NAMESPACE::LOG_STREAM_FRAME_HEADER_SIZE;
+
+/**
+ * @brief Received counters, updated by the receive loop and read by the reporter.
+*/
+struct STListenStats
+{
+    std::atomic<uint64_t> nDatagrams{ 0 };
+    std::atomic<uint64_t> nLines{ 0 };
+    std::atomic<uint64_t> nBytes{ 0 };
+    std::atomic<uint64_t> nConnections{ 0 };
+};
+
+static constexpr int LISTEN_BATCH_COUNT = 64;
+static constexpr int LISTEN_BUFFER_SIZE = 64 * 1024;
+
+/**
+ * @brief Open the UDP socket bound to the port, or the Unix domain datagram socket when strPath is set.
+*/
+static int OpenListenSocket(int nPort, const std::string& strPath)
+{
+    int nSocket = socket(strPath.empty() ? AF_INET : AF_UNIX, SOCK_DGRAM, 0);
+    if (nSocket < 0)
+        return -1;
+
+    int nBufferSize = 8 * 1024 * 1024;
+    setsockopt(nSocket, SOL_SOCKET, SO_RCVBUF, &nBufferSize, sizeof(nBufferSize));
+
+    timeval objTimeout{ 0, 200 * 1000 };
+    setsockopt(nSocket, SOL_SOCKET, SO_RCVTIMEO, &objTimeout, sizeof(objTimeout));
+
+    if (!strPath.empty())
+    {
+        sockaddr_un objAddr;
+        memset(&objAddr, 0, sizeof(objAddr));
+        objAddr.sun_family = AF_UNIX;
+        strncpy(objAddr.sun_path, strPath.c_str(), sizeof(objAddr.sun_path) - 1);
+        unlink(strPath.c_str());
+        if (bind(nSocket, (struct sockaddr*)&objAddr, sizeof(objAddr)) != 0)
+        {
+            close(nSocket);
+            return -1;
+        }
+        return nSocket;
+    }
+
+    sockaddr_in sain;
+    memset(&sain, 0, sizeof(sain));
+    sain.sin_family = AF_INET;
+    sain.sin_port = htons(static_cast<uint16_t>(nPort));
+    sain.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(nSocket, (struct sockaddr*)&sain, sizeof(sain)) != 0)
+    {
+        close(nSocket);
+        return -1;
+    }
+    return nSocket;
+}
+
+/**
+ * @brief Open a listening stream socket, TCP on the port or a Unix domain socket when strPath is set.
+*/
+static int OpenStreamSocket(int nPort, const std::string& strPath)
+{
+    int nSocket = -1;
+    if (!strPath.empty())
+    {
+        sockaddr_un objAddr;
+        memset(&objAddr, 0, sizeof(objAddr));
+        objAddr.sun_family = AF_UNIX;
+        if (strPath.size() >= sizeof(objAddr.sun_path))
+            return -1;
+        memcpy(objAddr.sun_path, strPath.c_str(), strPath.size());
+        unlink(strPath.c_str());
+
+        nSocket = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (nSocket < 0 || bind(nSocket, (struct sockaddr*)&objAddr, sizeof(objAddr)) != 0)
+        {
+            if (nSocket >= 0)
+                close(nSocket);
+            return -1;
+        }
+    }
+    else
+    {
+        nSocket = socket(AF_INET, SOCK_STREAM, 0);
+        if (nSocket < 0)
+            return -1;
+        int nReuse = 1;
+        setsockopt(nSocket, SOL_SOCKET, SO_REUSEADDR, &nReuse, sizeof(nReuse));
+
+        sockaddr_in sain;
+        memset(&sain, 0, sizeof(sain));
+        sain.sin_family = AF_INET;
+        sain.sin_port = htons(static_cast<uint16_t>(nPort));
+        sain.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (bind(nSocket, (struct sockaddr*)&sain, sizeof(sain)) != 0)
+        {
+            close(nSocket);
+            return -1;
+        }
+    }
+
+    if (listen(nSocket, 16) != 0)
+    {
+        close(nSocket);
+        return -1;
+    }
+    return nSocket;
+}
+
+/**
+ * @brief One accepted stream connection.
+*/
+struct STStreamClient
+{
+    int nSocket = -1;
+    std::string strBuffer;
+    uint64_t nFrames = 0;
+};
+
+/**
+ * @brief Accept stream appenders and decode their length prefixed frames until bStop is set.
+*/
+static void StreamLoop(int nListenSocket, bool bEcho, uint64_t nKillAfter, STListenStats& objStats, const std::atomic<bool>& bStop)
+{
+    std::vector<STStreamClient> vecClient;
+    std::vector<pollfd> vecPoll;
+    std::vector<char> vecBuffer(LISTEN_BUFFER_SIZE);
+    while (!bStop)
+    {
+        vecPoll.clear();
+        vecPoll.push_back({ nListenSocket, POLLIN, 0 });
+        for (const STStreamClient& objClient : vecClient)
+        {
+            vecPoll.push_back({ objClient.nSocket, POLLIN, 0 });
+        }
+        if (poll(vecPoll.data(), vecPoll.size(), 200) <= 0)
+            continue;
+
+        if (vecPoll[0].revents & POLLIN)
+        {
+            int nClient = accept(nListenSocket, nullptr, nullptr);
+            if (nClient >= 0)
+            {
+                vecClient.push_back({ nClient, std::string(), 0 });
+                ++objStats.nConnections;
+            }
+        }
+
+        for (size_t i = 1; i < vecPoll.size(); ++i)
+        {
+            if ((vecPoll[i].revents & (POLLIN | POLLHUP | POLLERR)) == 0)
+                continue;
+
+            STStreamClient& objClient = vecClient[i - 1];
+            ssize_t nRet = recv(objClient.nSocket, vecBuffer.data(), vecBuffer.size(), 0);
+            if (nRet <= 0)
+            {
+                close(objClient.nSocket);
+                objClient.nSocket = -1;
+                continue;
+            }
+            objClient.strBuffer.append(vecBuffer.data(), static_cast<size_t>(nRet));
+            objStats.nBytes += static_cast<uint64_t>(nRet);
+
+            size_t nOffset = 0;
+            while (objClient.strBuffer.size() - nOffset >= static_cast<size_t>(LOG_STREAM_FRAME_HEADER_SIZE))
+            {
+                const unsigned char* pHeader = reinterpret_cast<const unsigned char*>(objClient.strBuffer.data() + nOffset);
+                size_t nLength = (static_cast<size_t>(pHeader[0]) << 24) | (static_cast<size_t>(pHeader[1]) << 16) | (static_cast<size_t>(pHeader[2]) << 8) | pHeader[3];
+                if (objClient.strBuffer.size() - nOffset - LOG_STREAM_FRAME_HEADER_SIZE < nLength)
+                    break;
+
+                if (bEcho)
+                {
+                    std::cout.write(objClient.strBuffer.data() + nOffset + LOG_STREAM_FRAME_HEADER_SIZE, static_cast<std::streamsize>(nLength));
+                    std::cout.put('\n');
+                }
+                nOffset += LOG_STREAM_FRAME_HEADER_SIZE + nLength;
+                ++objStats.nLines;
+
+                if (nKillAfter > 0 && ++objClient.nFrames >= nKillAfter)
+                {
+                    // Simulated collector failure, the rest of the received bytes is lost with the connection.
+                    close(objClient.nSocket);
+                    objClient.nSocket = -1;
+                    break;
+                }
+            }
+            objClient.strBuffer.erase(0, nOffset);
+        }
+
+        vecClient.erase(std::remove_if(vecClient.begin(), vecClient.end(), [](const STStreamClient& objClient) {
+            return objClient.nSocket < 0;
+            }), vecClient.end());
+    }
+
+    for (const STStreamClient& objClient : vecClient)
+    {
+        close(objClient.nSocket);
+    }
+}
+
+/**
+ * @brief Decode one native journal entry to KEY=value lines, binary fields are "KEY\n", a 64 bit little endian size and the value.
+*/
+static void DecodeJournalEntry(const char* pData, size_t nLength, std::string& strOut)
+{
+    size_t nOffset = 0;
+    while (nOffset < nLength)
+    {
+        const char* pLineEnd = static_cast<const char*>(memchr(pData + nOffset, '\n', nLength - nOffset));
+        const size_t nLineEnd = pLineEnd != nullptr ? static_cast<size_t>(pLineEnd - pData) : nLength;
+        const char* pEqual = static_cast<const char*>(memchr(pData + nOffset, '=', nLineEnd - nOffset));
+        if (pEqual != nullptr || nLineEnd + 9 > nLength)
+        {
+            strOut.append(pData + nOffset, nLineEnd - nOffset).push_back('\n');
+            nOffset = nLineEnd + 1;
+            continue;
+        }
+
+        uint64_t nSize = 0;
+        for (int i = 7; i >= 0; --i)
+        {
+            nSize = (nSize << 8) | static_cast<unsigned char>(pData[nLineEnd + 1 + i]);
+        }
+        const size_t nValue = nLineEnd + 9;
+        nSize = (std::min)(nSize, static_cast<uint64_t>(nLength - nValue));
+        strOut.append(pData + nOffset, nLineEnd - nOffset).append("=").append(pData + nValue, static_cast<size_t>(nSize)).push_back('\n');
+        nOffset = nValue + static_cast<size_t>(nSize) + 1;
+    }
+    strOut.push_back('\n');
+}
+
+/**
+ * @brief Receive native journal entries until bStop is set, an entry without payload carries a memfd.
+*/
+static void JournalLoop(int nSocket, bool bEcho, STListenStats& objStats, const std::atomic<bool>& bStop)
+{
+    std::vector<char> vecBuffer(LISTEN_BUFFER_SIZE * 128);
+    std::string strEntry;
+    std::string strOut;
+    while (!bStop)
+    {
+        union
+        {
+            cmsghdr objHeader;
+            char arrayBuffer[CMSG_SPACE(sizeof(int))];
+        } objControl;
+        iovec objIov{ vecBuffer.data(), vecBuffer.size() };
+        msghdr objMsg;
+        memset(&objMsg, 0, sizeof(objMsg));
+        objMsg.msg_iov = &objIov;
+        objMsg.msg_iovlen = 1;
+        objMsg.msg_control = objControl.arrayBuffer;
+        objMsg.msg_controllen = sizeof(objControl.arrayBuffer);
+
+        ssize_t nRet = recvmsg(nSocket, &objMsg, MSG_CMSG_CLOEXEC);
+        if (nRet < 0)
+            continue;
+
+        strEntry.assign(vecBuffer.data(), static_cast<size_t>(nRet));
+        cmsghdr* pHeader = CMSG_FIRSTHDR(&objMsg);
+        if (pHeader != nullptr && pHeader->cmsg_level == SOL_SOCKET && pHeader->cmsg_type == SCM_RIGHTS)
+        {
+            int nFd = -1;
+            memcpy(&nFd, CMSG_DATA(pHeader), sizeof(int));
+            strEntry.clear();
+            char arrayChunk[LISTEN_BUFFER_SIZE];
+            ssize_t nRead = 0;
+            off_t nPosition = 0;
+            while ((nRead = pread(nFd, arrayChunk, sizeof(arrayChunk), nPosition)) > 0)
+            {
+                strEntry.append(arrayChunk, static_cast<size_t>(nRead));
+                nPosition += nRead;
+            }
+            close(nFd);
+            ++objStats.nConnections;
+        }
+
+        objStats.nDatagrams += 1;
+        objStats.nLines += 1;
+        objStats.nBytes += strEntry.size();
+        if (bEcho)
+        {
+            strOut.clear();
+            DecodeJournalEntry(strEntry.data(), strEntry.size(), strOut);
+            std::cout.write(strOut.data(), static_cast<std::streamsize>(strOut.size()));
+        }
+    }
+}
+
+/**
+ * @brief Receive until bStop is set, counting datagrams and lines.
+*/
+static void ReceiveLoop(int nSocket, bool bEcho, bool bFrames, STListenStats& objStats, const std::atomic<bool>& bStop)
+{
+    std::vector<char> vecBuffer(static_cast<size_t>(LISTEN_BATCH_COUNT) * LISTEN_BUFFER_SIZE);
+#ifdef __linux__
+    mmsghdr arrayMsg[LISTEN_BATCH_COUNT];
+    iovec arrayIov[LISTEN_BATCH_COUNT];
+#endif
+    while (!bStop)
+    {
+        int nCount = 0;
+        size_t arraySize[LISTEN_BATCH_COUNT];
+#ifdef __linux__
+        memset(arrayMsg, 0, sizeof(arrayMsg));
+        for (int i = 0; i < LISTEN_BATCH_COUNT; ++i)
+        {
+            arrayIov[i].iov_base = &vecBuffer[static_cast<size_t>(i) * LISTEN_BUFFER_SIZE];
+            arrayIov[i].iov_len = LISTEN_BUFFER_SIZE;
+            arrayMsg[i].msg_hdr.msg_iov = &arrayIov[i];
+            arrayMsg[i].msg_hdr.msg_iovlen = 1;
+        }
+        nCount = recvmmsg(nSocket, arrayMsg, LISTEN_BATCH_COUNT, MSG_WAITFORONE, nullptr);
+        for (int i = 0; i < nCount; ++i)
+        {
+            arraySize[i] = arrayMsg[i].msg_len;
+        }
+#else
+        ssize_t nRet = recv(nSocket, &vecBuffer[0], LISTEN_BUFFER_SIZE, 0);
+        if (nRet >= 0)
+        {
+            arraySize[0] = static_cast<size_t>(nRet);
+            nCount = 1;
+        }
+#endif
+        if (nCount <= 0)
+            continue;
+
+        uint64_t nLines = 0;
+        uint64_t nBytes = 0;
+        for (int i = 0; i < nCount; ++i)
+        {
+            const char* pData = &vecBuffer[static_cast<size_t>(i) * LISTEN_BUFFER_SIZE];
+            nLines += bFrames ? 1 : static_cast<uint64_t>(std::count(pData, pData + arraySize[i], '\n'));
+            nBytes += arraySize[i];
+            if (bEcho)
+            {
+                std::cout.write(pData, static_cast<std::streamsize>(arraySize[i]));
+                if (bFrames)
+                    std::cout.put('\n');
+            }
+        }
+        objStats.nDatagrams += static_cast<uint64_t>(nCount);
+        objStats.nLines += nLines;
+        objStats.nBytes += nBytes;
+    }
+}
+
+/**
+ * @brief Send nLines test lines to the port, one datagram per line or packed, returns the elapsed seconds.
+*/
+static double SendLines(int nPort, uint64_t nLines, bool bPacked, uint64_t& nDatagrams)
+{
+    int nSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (nSocket < 0)
+        return 0.0;
+
+    sockaddr_in sain;
+    memset(&sain, 0, sizeof(sain));
+    sain.sin_family = AF_INET;
+    sain.sin_port = htons(static_cast<uint16_t>(nPort));
+    sain.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    const std::string strLine = "[2024-01-01 00:00:00.000000][INFO][12345][main.cpp:42][Run] benchmark line for the remote appender\n";
+    std::string strBatch;
+    std::vector<std::pair<size_t, size_t>> vecDatagram;
+    nDatagrams = 0;
+
+    auto objBegin = std::chrono::steady_clock::now();
+    uint64_t nDone = 0;
+    while (nDone < nLines)
+    {
+        if (!bPacked)
+        {
+            sendto(nSocket, strLine.data(), strLine.size(), 0, (struct sockaddr*)&sain, sizeof(sain));
+            ++nDone;
+            ++nDatagrams;
+            continue;
+        }
+
+        // Same packing as CYLoggerRemoteAppender: whole lines share a datagram up to LOG_REMOTE_MTU bytes.
+        strBatch.clear();
+        vecDatagram.clear();
+        while (nDone < nLines)
+        {
+            if (!vecDatagram.empty() && vecDatagram.back().second + strLine.size() <= static_cast<size_t>(LOG_REMOTE_MTU))
+            {
+                vecDatagram.back().second += strLine.size();
+            }
+            else if (vecDatagram.size() < static_cast<size_t>(LOG_REMOTE_BATCH_COUNT))
+            {
+                vecDatagram.push_back({ strBatch.size(), strLine.size() });
+            }
+            else
+            {
+                break;
+            }
+            strBatch += strLine;
+            ++nDone;
+        }
+
+#ifdef __linux__
+        mmsghdr arrayMsg[LOG_REMOTE_BATCH_COUNT];
+        iovec arrayIov[LOG_REMOTE_BATCH_COUNT];
+        memset(arrayMsg, 0, sizeof(arrayMsg));
+        for (size_t i = 0; i < vecDatagram.size(); ++i)
+        {
+            arrayIov[i].iov_base = strBatch.data() + vecDatagram[i].first;
+            arrayIov[i].iov_len = vecDatagram[i].second;
+            arrayMsg[i].msg_hdr.msg_name = &sain;
+            arrayMsg[i].msg_hdr.msg_namelen = sizeof(sain);
+            arrayMsg[i].msg_hdr.msg_iov = &arrayIov[i];
+            arrayMsg[i].msg_hdr.msg_iovlen = 1;
+        }
+        size_t nSent = 0;
+        while (nSent < vecDatagram.size())
+        {
+            int nRet = sendmmsg(nSocket, &arrayMsg[nSent], static_cast<unsigned int>(vecDatagram.size() - nSent), 0);
+            if (nRet < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                break;
+            }
+            nSent += static_cast<size_t>(nRet);
+        }
+#else
+        for (const auto& objDatagram : vecDatagram)
+        {
+            sendto(nSocket, strBatch.data() + objDatagram.first, objDatagram.second, 0, (struct sockaddr*)&sain, sizeof(sain));
+        }
+#endif
+        nDatagrams += vecDatagram.size();
+    }
+    double fSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - objBegin).count();
+    close(nSocket);
+    return fSeconds;
+}
+
+/**
+ * @brief Run one benchmark pass and print the send and receive rates.
+*/
+static void RunBenchmark(int nPort, uint64_t nLines, bool bPacked, STListenStats& objStats)
+{
+    uint64_t nLinesBefore = objStats.nLines;
+    uint64_t nDatagramsBefore = objStats.nDatagrams;
+
+    uint64_t nDatagrams = 0;
+    double fSeconds = SendLines(nPort, nLines, bPacked, nDatagrams);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    uint64_t nReceived = objStats.nLines - nLinesBefore;
+    fSeconds = (std::max)(fSeconds, 1e-9);
+    std::cout << (bPacked ? "packed  " : "per-line")
+        << "  lines/s " << static_cast<uint64_t>(static_cast<double>(nLines) / fSeconds)
+        << "  datagrams/s " << static_cast<uint64_t>(static_cast<double>(nDatagrams) / fSeconds)
+        << "  datagrams " << nDatagrams
+        << "  received lines " << nReceived << "/" << nLines
+        << "  received datagrams " << (objStats.nDatagrams - nDatagramsBefore)
+        << std::endl;
+}
+
+static void Usage()
+{
+    std::cerr << "Usage: cylog-listen [-p port] [-T | -u path | -d path | -j path] [-k frames] [-t seconds] [-e] [-b lines]" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    int nPort = 7000;
+    int nSeconds = 0;
+    bool bEcho = false;
+    uint64_t nBenchLines = 0;
+    bool bStream = false;
+    std::string strPath;
+    std::string strDgramPath;
+    bool bJournal = false;
+    uint64_t nKillAfter = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string strArg = argv[i];
+        if (strArg == "-p" && i + 1 < argc)
+            nPort = atoi(argv[++i]);
+        else if (strArg == "-t" && i + 1 < argc)
+            nSeconds = atoi(argv[++i]);
+        else if (strArg == "-e")
+            bEcho = true;
+        else if (strArg == "-b" && i + 1 < argc)
+            nBenchLines = strtoull(argv[++i], nullptr, 10);
+        else if (strArg == "-T")
+            bStream = true;
+        else if (strArg == "-u" && i + 1 < argc)
+        {
+            bStream = true;
+            strPath = argv[++i];
+        }
+        else if ((strArg == "-d" || strArg == "-j") && i + 1 < argc)
+        {
+            bJournal = strArg == "-j";
+            strDgramPath = argv[++i];
+        }
+        else if (strArg == "-k" && i + 1 < argc)
+            nKillAfter = strtoull(argv[++i], nullptr, 10);
+        else
+        {
+            Usage();
+            return 1;
+        }
+    }
+
+    const bool bSyslog = !strDgramPath.empty();
+    if ((bStream && bSyslog) || ((bStream || bSyslog) && nBenchLines > 0))
+    {
+        Usage();
+        return 1;
+    }
+
+    if (bSyslog)
+        strPath = strDgramPath;
+    int nSocket = bStream ? OpenStreamSocket(nPort, strPath) : OpenListenSocket(nPort, strDgramPath);
+    if (nSocket < 0)
+    {
+        std::cerr << "cannot listen on " << (strPath.empty() ? "port " + std::to_string(nPort) : strPath) << ": " << strerror(errno) << std::endl;
+        return 1;
+    }
+
+    STListenStats objStats;
+    std::atomic<bool> bStop{ false };
+    std::thread objReceiver;
+    if (bJournal)
+        objReceiver = std::thread(JournalLoop, nSocket, bEcho, std::ref(objStats), std::cref(bStop));
+    else if (bStream)
+        objReceiver = std::thread(StreamLoop, nSocket, bEcho, nKillAfter, std::ref(objStats), std::cref(bStop));
+    else
+        objReceiver = std::thread(ReceiveLoop, nSocket, bEcho && nBenchLines == 0, bSyslog, std::ref(objStats), std::cref(bStop));
+
+    if (nBenchLines > 0)
+    {
+        RunBenchmark(nPort, nBenchLines, false, objStats);
+        RunBenchmark(nPort, nBenchLines, true, objStats);
+    }
+    else
+    {
+        uint64_t nLastDatagrams = 0;
+        uint64_t nLastLines = 0;
+        uint64_t nLastBytes = 0;
+        for (int nElapsed = 0; nSeconds == 0 || nElapsed < nSeconds; ++nElapsed)
+        {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            uint64_t nDatagrams = bStream ? objStats.nConnections.load() : objStats.nDatagrams.load();
+            uint64_t nLines = objStats.nLines;
+            uint64_t nBytes = objStats.nBytes;
+            std::cerr << (bStream ? "connections/s " : "datagrams/s ") << (nDatagrams - nLastDatagrams)
+                << "  lines/s " << (nLines - nLastLines)
+                << "  bytes/s " << (nBytes - nLastBytes)
+                << "  total lines " << nLines
+                << (bJournal ? "  memfd entries " + std::to_string(objStats.nConnections.load()) : std::string()) << std::endl;
+            nLastDatagrams = nDatagrams;
+            nLastLines = nLines;
+            nLastBytes = nBytes;
+        }
+    }
+
+    bStop = true;
+    objReceiver.join();
+    close(nSocket);
+    if (!strPath.empty())
+        unlink(strPath.c_str());
+    return 0;
+}
@@ -0,0 +1,609 @@
+/*
+ * CYLoggerBench: micro and macro benchmarks of the logger, results are written as JSON.
+ *
+ * Usage: CYLoggerBench [-n lines] [-t threads] [-d directory] [-o output] [-s suite[,suite...]]
+ *   -n  lines per measurement, default 200000.
+ *   -t  largest producer thread count of the thread suite, default 64. Counts double from 1.
+ *   -d  log directory, default CYLoggerBench.
+ *   -o  write the JSON to a file instead of stdout.
+ *   -s  suites to run, default all:
+ *       macro     caller side latency of the entry points behind CY_LOG_DIRECT_*, CY_LOG_*, CY_LOG_ESCAPE_* and CY_LOG_HEX_*.
+ *       filter    caller side latency of a call whose level is filtered out.
+ *       thread    enqueue and end to end throughput against the number of producer threads.
+ *       appender  backend throughput of the text, time named, binary and compressed file appenders, and of the null
+ *                 sink as the cost of the pipeline without I/O.
+ *       layout    render cost of the built-in layouts, with and without escaping.
+ *       latency   enqueue to write latency percentiles of a paced producer, see GetLatency.
+ * Calls leave out LOG_LEVEL_CONSOLE so the console appender stays quiet. Times are in nanoseconds.
+ */
+#include "Inc/ICYLogger.hpp"
+#include "Entity/Layout/CYLoggerTemplateLayout1.hpp"
+#include "Entity/Layout/CYLoggerTemplateLayout2.hpp"
+#include "Entity/Layout/CYLoggerTemplateLayout3.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace CYLOGGER_NAMESPACE;
+
+/**
+ * @brief Version of the JSON layout, raised whenever a field changes meaning.
+*/
+static constexpr int BENCH_JSON_VERSION = 1;
+
+/**
+ * @brief Longest wait for an appender to write a measurement, in seconds.
+*/
+static constexpr int BENCH_DRAIN_TIMEOUT = 120;
+
+/**
+ * @brief Paced producer of the latency suite: lines per burst and pause between bursts, in microseconds.
+*/
+static constexpr int BENCH_LATENCY_BURST = 64;
+static constexpr int BENCH_LATENCY_PAUSE = 200;
+
+/**
+ * @brief Percentiles of a set of samples.
+*/
+struct STBenchSummary
+{
+    uint64_t nCount = 0;
+    double   fMean = 0;
+    uint64_t nP50 = 0;
+    uint64_t nP90 = 0;
+    uint64_t nP99 = 0;
+    uint64_t nP999 = 0;
+    uint64_t nMax = 0;
+};
+
+/**
+ * @brief Minimal JSON writer, members are separated as they are added.
+*/
+class CYBenchJson
+{
+public:
+    CYBenchJson()
+    {
+        m_objOut.precision(15);
+    }
+
+    void BeginObject(const char* pszKey = nullptr)
+    {
+        Key(pszKey);
+        m_objOut << '{';
+        m_bFirst = true;
+    }
+
+    void EndObject()
+    {
+        m_objOut << '}';
+        m_bFirst = false;
+    }
+
+    void BeginArray(const char* pszKey)
+    {
+        Key(pszKey);
+        m_objOut << '[';
+        m_bFirst = true;
+    }
+
+    void EndArray()
+    {
+        m_objOut << ']';
+        m_bFirst = false;
+    }
+
+    void Value(const char* pszKey, const std::string& strValue)
+    {
+        Key(pszKey);
+        m_objOut << '"' << strValue << '"';
+    }
+
+    void Value(const char* pszKey, double fValue)
+    {
+        Key(pszKey);
+        m_objOut << fValue;
+    }
+
+    void Value(const char* pszKey, uint64_t nValue)
+    {
+        Key(pszKey);
+        m_objOut << nValue;
+    }
+
+    void Value(const char* pszKey, bool bValue)
+    {
+        Key(pszKey);
+        m_objOut << (bValue ? "true" : "false");
+    }
+
+    void Summary(const STBenchSummary& objSummary)
+    {
+        Value("count", objSummary.nCount);
+        Value("mean_ns", objSummary.fMean);
+        Value("p50_ns", objSummary.nP50);
+        Value("p90_ns", objSummary.nP90);
+        Value("p99_ns", objSummary.nP99);
+        Value("p999_ns", objSummary.nP999);
+        Value("max_ns", objSummary.nMax);
+    }
+
+    std::string ToString() const
+    {
+        return m_objOut.str();
+    }
+
+private:
+    void Key(const char* pszKey)
+    {
+        if (!m_bFirst)
+            m_objOut << ',';
+        m_bFirst = false;
+        if (pszKey)
+            m_objOut << '"' << pszKey << "\":";
+    }
+
+private:
+    std::ostringstream m_objOut;
+    bool m_bFirst = true;
+};
+
+/**
+ * @brief Steady clock time in nanoseconds.
+*/
+static inline uint64_t Now()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Sort the samples and take the percentiles.
+*/
+static STBenchSummary Summarize(std::vector<uint64_t>& vecSample)
+{
+    STBenchSummary objSummary;
+    if (vecSample.empty())
+        return objSummary;
+
+    std::sort(vecSample.begin(), vecSample.end());
+    uint64_t nTotal = 0;
+    for (uint64_t nSample : vecSample)
+    {
+        nTotal += nSample;
+    }
+
+    auto Percentile = [&](double fRank) { return vecSample[std::min(vecSample.size() - 1, static_cast<size_t>(fRank * vecSample.size()))]; };
+    objSummary.nCount = vecSample.size();
+    objSummary.fMean = static_cast<double>(nTotal) / vecSample.size();
+    objSummary.nP50 = Percentile(0.50);
+    objSummary.nP90 = Percentile(0.90);
+    objSummary.nP99 = Percentile(0.99);
+    objSummary.nP999 = Percentile(0.999);
+    objSummary.nMax = vecSample.back();
+    return objSummary;
+}
+
+/**
+ * @brief Statistics record of one added appender, false if it was not added.
+*/
+static bool GetAppenderStats(ELogType eLogType, STAppenderStats& objStats)
+{
+    STStatsSnapshot objSnapshot;
+    STAppenderStats arrRecord[LOG_TYPE_MAX];
+    if (!CY_LOG()->GetStatsSnapshot(&objSnapshot, arrRecord, LOG_TYPE_MAX))
+        return false;
+
+    for (uint32_t i = 0; i < std::min<uint32_t>(objSnapshot.nCount, LOG_TYPE_MAX); ++i)
+    {
+        if (arrRecord[i].eLogType == eLogType)
+        {
+            objStats = arrRecord[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Wait until the appender has written nLines lines in total, false on timeout.
+*/
+static bool WaitWritten(ELogType eLogType, uint64_t nLines, STAppenderStats& objStats)
+{
+    const uint64_t nDeadline = Now() + static_cast<uint64_t>(BENCH_DRAIN_TIMEOUT) * 1000000000ull;
+    while (GetAppenderStats(eLogType, objStats) && objStats.nLine < nLines)
+    {
+        if (Now() > nDeadline)
+        {
+            std::cerr << "timeout waiting for appender " << objStats.szName << std::endl;
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return objStats.nLine >= nLines;
+}
+
+static uint64_t GetWrittenLines(ELogType eLogType)
+{
+    STAppenderStats objStats;
+    return GetAppenderStats(eLogType, objStats) ? objStats.nLine : 0;
+}
+
+/**
+ * @brief Mean cost of reading the clock, included in every per call sample.
+*/
+static double MeasureTimerOverhead()
+{
+    constexpr int nRounds = 1000000;
+    uint64_t nSink = 0;
+    const uint64_t nBegin = Now();
+    for (int i = 0; i < nRounds; ++i)
+    {
+        nSink += Now();
+    }
+    const uint64_t nEnd = Now();
+    return nSink == 0 ? 0 : static_cast<double>(nEnd - nBegin) / nRounds;
+}
+
+/**
+ * @brief Time each call of fnCall on its own, then wait until the INFO appender wrote them so suites do not overlap.
+*/
+template <typename TCall>
+static STBenchSummary MeasureCalls(uint64_t nLines, bool bWritten, TCall&& fnCall)
+{
+    const uint64_t nWrittenBefore = GetWrittenLines(LOG_TYPE_INFO);
+    std::vector<uint64_t> vecSample(nLines);
+    for (uint64_t i = 0; i < nLines; ++i)
+    {
+        const uint64_t nBegin = Now();
+        fnCall(static_cast<int>(i));
+        vecSample[i] = Now() - nBegin;
+    }
+
+    STAppenderStats objStats;
+    if (bWritten)
+        WaitWritten(LOG_TYPE_INFO, nWrittenBefore + nLines, objStats);
+    return Summarize(vecSample);
+}
+
+static void RunMacroSuite(uint64_t nLines, CYBenchJson& objJson)
+{
+    static const char arrHex[32] = "0123456789abcdefghijklmnopqrstu";
+
+    objJson.BeginArray("macro");
+
+    objJson.BeginObject();
+    objJson.Value("family", std::string("direct"));
+    objJson.Summary(MeasureCalls(nLines, true, [](int) {
+        CY_LOG()->WriteLog(LOG_LEVEL_INFO, LOG_TYPE_INFO, UNKNOWN_SEVER_CODE, TEXT("benchmark direct message of typical length"));
+        }));
+    objJson.EndObject();
+
+    objJson.BeginObject();
+    objJson.Value("family", std::string("printf"));
+    objJson.Summary(MeasureCalls(nLines, true, [](int i) {
+        CY_LOG()->WriteLog(LOG_LEVEL_INFO, LOG_TYPE_INFO, UNKNOWN_SEVER_CODE, __TFILE__, __TFUNCTION__, __TLINE__, TEXT("benchmark printf message %d of %s"), i, TEXT("typical length"));
+        }));
+    objJson.EndObject();
+
+    objJson.BeginObject();
+    objJson.Value("family", std::string("escape"));
+    objJson.Summary(MeasureCalls(nLines, true, [](int i) {
+        CY_LOG()->WriteEscapeLog(LOG_LEVEL_INFO, LOG_TYPE_INFO, UNKNOWN_SEVER_CODE, __TFILE__, __TFUNCTION__, __TLINE__, TEXT("benchmark escape message %d of \"%s\""), i, TEXT("<typical> & length"));
+        }));
+    objJson.EndObject();
+
+    objJson.BeginObject();
+    objJson.Value("family", std::string("hex"));
+    objJson.Summary(MeasureCalls(nLines, true, [](int) {
+        CY_LOG()->WriteHexLog(LOG_LEVEL_INFO, LOG_TYPE_INFO, UNKNOWN_SEVER_CODE, __TFILE__, __TFUNCTION__, __TLINE__, arrHex, sizeof(arrHex));
+        }));
+    objJson.EndObject();
+
+    objJson.EndArray();
+}
+
+static void RunFilterSuite(uint64_t nLines, CYBenchJson& objJson)
+{
+    // A level outside the filter of the instance, REMOTE and SYS are not part of LOG_FILTER_ALL.
+    int nFilteredLevel = 0;
+    for (int nLevel : { LOG_LEVEL_SYS, LOG_LEVEL_REMOTE, LOG_LEVEL_TRACE })
+    {
+        if ((LOG_LEVEL_FILTER & nLevel) == 0)
+        {
+            nFilteredLevel = nLevel;
+            break;
+        }
+    }
+
+    objJson.BeginObject("filter");
+    objJson.Value("skipped", nFilteredLevel == 0);
+    if (nFilteredLevel != 0)
+    {
+        objJson.BeginObject("direct");
+        objJson.Summary(MeasureCalls(nLines, false, [=](int) {
+            CY_LOG()->WriteLog(nFilteredLevel, LOG_TYPE_INFO, UNKNOWN_SEVER_CODE, TEXT("benchmark filtered message"));
+            }));
+        objJson.EndObject();
+
+        objJson.BeginObject("printf");
+        objJson.Summary(MeasureCalls(nLines, false, [=](int i) {
+            CY_LOG()->WriteLog(nFilteredLevel, LOG_TYPE_INFO, UNKNOWN_SEVER_CODE, __TFILE__, __TFUNCTION__, __TLINE__, TEXT("benchmark filtered message %d"), i);
+            }));
+        objJson.EndObject();
+    }
+    objJson.EndObject();
+}
+
+static void RunThreadSuite(uint64_t nLines, int nMaxThreads, CYBenchJson& objJson)
+{
+    objJson.BeginArray("thread");
+    for (int nThreads = 1; nThreads <= nMaxThreads; nThreads *= 2)
+    {
+        const uint64_t nPerThread = std::max<uint64_t>(1, nLines / nThreads);
+        const uint64_t nWrittenBefore = GetWrittenLines(LOG_TYPE_INFO);
+
+        std::atomic<int> nReady{ 0 };
+        std::atomic<bool> bGo{ false };
+        std::vector<std::thread> vecThread;
+        for (int i = 0; i < nThreads; ++i)
+        {
+            vecThread.emplace_back([&, i] {
+                nReady.fetch_add(1);
+                while (!bGo.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+                for (uint64_t n = 0; n < nPerThread; ++n)
+                {
+                    CY_LOG()->WriteLog(LOG_LEVEL_INFO, LOG_TYPE_INFO, UNKNOWN_SEVER_CODE, __TFILE__, __TFUNCTION__, __TLINE__, TEXT("benchmark thread %d line %d"), i, static_cast<int>(n));
+                }
+                });
+        }
+        while (nReady.load() < nThreads)
+        {
+            std::this_thread::yield();
+        }
+
+        const uint64_t nBegin = Now();
+        bGo.store(true, std::memory_order_release);
+        for (auto& objThread : vecThread)
+        {
+            objThread.join();
+        }
+        const uint64_t nEnqueued = Now();
+
+        STAppenderStats objStats;
+        const uint64_t nTotal = nPerThread * nThreads;
+        const bool bWritten = WaitWritten(LOG_TYPE_INFO, nWrittenBefore + nTotal, objStats);
+        const uint64_t nEnd = Now();
+
+        objJson.BeginObject();
+        objJson.Value("threads", static_cast<uint64_t>(nThreads));
+        objJson.Value("lines", nTotal);
+        objJson.Value("enqueue_lines_per_sec", nTotal * 1e9 / std::max<uint64_t>(1, nEnqueued - nBegin));
+        objJson.Value("end_to_end_lines_per_sec", bWritten ? nTotal * 1e9 / std::max<uint64_t>(1, nEnd - nBegin) : 0.0);
+        objJson.Value("dropped", objStats.nDrop);
+        objJson.EndObject();
+    }
+    objJson.EndArray();
+}
+
+/**
+ * @brief Appender measured by the appender suite.
+*/
+struct STBenchAppender
+{
+    const char*  pszName;
+    ELogType     eLogType;
+    ELogLevel    eLogLevel;
+    const TChar* pszFile;
+    int          nFileMode;
+};
+
+static const STBenchAppender g_arrBenchAppender[] =
+{
+    { "text_append",   LOG_TYPE_TRACE, LOG_LEVEL_TRACE, TEXT("Trace.log"), LOG_MODE_FILE_APPEND },
+    { "text_time",     LOG_TYPE_DEBUG, LOG_LEVEL_DEBUG, TEXT("Debug.log"), LOG_MODE_FILE_TIME },
+    { "binary",        LOG_TYPE_WARN,  LOG_LEVEL_WARN,  TEXT("Warn.log"),  LOG_MODE_FILE_TIME | LOG_MODE_FILE_BINARY },
+    { "compress",      LOG_TYPE_ERROR, LOG_LEVEL_ERROR, TEXT("Error.log"), LOG_MODE_FILE_TIME | LOG_MODE_FILE_COMPRESS },
+    { "null",          LOG_TYPE_FATAL, LOG_LEVEL_FATAL, TEXT("Fatal.log"), LOG_MODE_FILE_TIME | LOG_MODE_FILE_NULL },
+};
+
+static void RunAppenderSuite(uint64_t nLines, CYBenchJson& objJson)
+{
+    objJson.BeginArray("appender");
+    for (const STBenchAppender& objAppender : g_arrBenchAppender)
+    {
+        STAppenderStats objBefore;
+        if (!GetAppenderStats(objAppender.eLogType, objBefore))
+            continue;
+
+        const uint64_t nBegin = Now();
+        for (uint64_t i = 0; i < nLines; ++i)
+        {
+            CY_LOG()->WriteLog(objAppender.eLogLevel, objAppender.eLogType, UNKNOWN_SEVER_CODE, __TFILE__, __TFUNCTION__, __TLINE__, TEXT("benchmark appender line %d of %s"), static_cast<int>(i), TEXT("typical length"));
+        }
+
+        STAppenderStats objAfter;
+        const bool bWritten = WaitWritten(objAppender.eLogType, objBefore.nLine + nLines, objAfter);
+        const uint64_t nEnd = Now();
+
+        // Backend time is the time the log thread spent writing and flushing, the wall time includes the producer.
+        const uint64_t nLine = objAfter.nLine - objBefore.nLine;
+        const uint64_t nByte = objAfter.nByte - objBefore.nByte;
+        const uint64_t nBackend = std::max<uint64_t>(1, (objAfter.nWriteTime - objBefore.nWriteTime) + (objAfter.nFlushTime - objBefore.nFlushTime));
+
+        objJson.BeginObject();
+        objJson.Value("appender", std::string(objAppender.pszName));
+        objJson.Value("thread", std::string(objAfter.szName));
+        objJson.Value("complete", bWritten);
+        objJson.Value("lines", nLine);
+        objJson.Value("bytes", nByte);
+        objJson.Value("backend_lines_per_sec", nLine * 1e9 / nBackend);
+        objJson.Value("backend_bytes_per_sec", nByte * 1e9 / nBackend);
+        objJson.Value("backend_ns_per_line", static_cast<double>(nBackend) / std::max<uint64_t>(1, nLine));
+        objJson.Value("wall_lines_per_sec", nLine * 1e9 / std::max<uint64_t>(1, nEnd - nBegin));
+        objJson.Value("batches", objAfter.nBatchCount - objBefore.nBatchCount);
+        objJson.EndObject();
+    }
+    objJson.EndArray();
+}
+
+static void RunLayoutSuite(uint64_t nLines, CYBenchJson& objJson)
+{
+    CYLoggerTemplateLayout1 objLayout1;
+    CYLoggerTemplateLayout2 objLayout2;
+    CYLoggerTemplateLayout3 objLayout3;
+    ICYLoggerTemplateLayout* arrLayout[] = { &objLayout1, &objLayout2, &objLayout3 };
+
+    const TString strChannel = TEXT("Bench");
+    const TString strMsg = TEXT("benchmark layout message with <markup> & \"quotes\" of typical length");
+    const TString strFile = TEXT("CYLoggerBench.cpp");
+    const TString strFunction = TEXT("RunLayoutSuite");
+
+    objJson.BeginArray("layout");
+    for (int nLayout = 0; nLayout < 3; ++nLayout)
+    {
+        for (bool bEscape : { false, true })
+        {
+            size_t nSink = 0;
+            const uint64_t nBegin = Now();
+            for (uint64_t i = 0; i < nLines; ++i)
+            {
+                nSink += arrLayout[nLayout]->GetFormatMessage(strChannel, LOG_TYPE_INFO, UNKNOWN_SEVER_CODE, strMsg, strFile, strFunction, __LINE__,
+                    1234, 5678, 2024, 1, 2, 3, 4, 5, static_cast<int>(i % 1000000), bEscape).size();
+            }
+            const uint64_t nEnd = Now();
+
+            objJson.BeginObject();
+            objJson.Value("layout", static_cast<uint64_t>(nLayout + 1));
+            objJson.Value("escape", bEscape);
+            objJson.Value("mean_ns", static_cast<double>(nEnd - nBegin) / std::max<uint64_t>(1, nLines));
+            objJson.Value("bytes_per_line", static_cast<double>(nSink) / std::max<uint64_t>(1, nLines));
+            objJson.EndObject();
+        }
+    }
+    objJson.EndArray();
+}
+
+static void RunLatencySuite(uint64_t nLines, CYBenchJson& objJson)
+{
+    STLatencyStats objLatency;
+    CY_LOG()->GetLatency(LOG_TYPE_INFO, &objLatency, true);
+
+    const uint64_t nWrittenBefore = GetWrittenLines(LOG_TYPE_INFO);
+    for (uint64_t i = 0; i < nLines; ++i)
+    {
+        CY_LOG()->WriteLog(LOG_LEVEL_INFO, LOG_TYPE_INFO, UNKNOWN_SEVER_CODE, __TFILE__, __TFUNCTION__, __TLINE__, TEXT("benchmark latency line %d"), static_cast<int>(i));
+        if ((i + 1) % BENCH_LATENCY_BURST == 0)
+            std::this_thread::sleep_for(std::chrono::microseconds(BENCH_LATENCY_PAUSE));
+    }
+
+    STAppenderStats objStats;
+    WaitWritten(LOG_TYPE_INFO, nWrittenBefore + nLines, objStats);
+
+    const bool bValid = CY_LOG()->GetLatency(LOG_TYPE_INFO, &objLatency, false);
+    objJson.BeginObject("latency");
+    objJson.Value("enabled", bValid && LOG_LATENCY_STATS);
+    objJson.Value("burst", static_cast<uint64_t>(BENCH_LATENCY_BURST));
+    objJson.Value("pause_us", static_cast<uint64_t>(BENCH_LATENCY_PAUSE));
+    objJson.Value("count", objLatency.nCount);
+    objJson.Value("p50_ns", objLatency.nP50);
+    objJson.Value("p90_ns", objLatency.nP90);
+    objJson.Value("p99_ns", objLatency.nP99);
+    objJson.Value("p999_ns", objLatency.nP999);
+    objJson.Value("max_ns", objLatency.nMax);
+    objJson.EndObject();
+}
+
+static int Usage()
+{
+    std::cerr << "Usage: CYLoggerBench [-n lines] [-t threads] [-d directory] [-o output] [-s macro,filter,thread,appender,layout,latency]" << std::endl;
+    return 2;
+}
+
+int main(int argc, char* argv[])
+{
+    uint64_t nLines = 200000;
+    int nMaxThreads = 64;
+    std::string strDir = "CYLoggerBench";
+    std::string strOutput;
+    std::string strSuite = "macro,filter,thread,appender,layout,latency";
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string strArg = argv[i];
+        if (strArg == "-n" && i + 1 < argc)
+            nLines = strtoull(argv[++i], nullptr, 10);
+        else if (strArg == "-t" && i + 1 < argc)
+            nMaxThreads = atoi(argv[++i]);
+        else if (strArg == "-d" && i + 1 < argc)
+            strDir = argv[++i];
+        else if (strArg == "-o" && i + 1 < argc)
+            strOutput = argv[++i];
+        else if (strArg == "-s" && i + 1 < argc)
+            strSuite = argv[++i];
+        else
+            return Usage();
+    }
+    if (nLines == 0 || nMaxThreads <= 0)
+        return Usage();
+
+    auto HasSuite = [&](const std::string& strName) { return ("," + strSuite + ",").find("," + strName + ",") != std::string::npos; };
+
+    const TString strLogDir(strDir.begin(), strDir.end());
+    CY_LOG()->SetConfig(strLogDir.c_str(), false);
+    CY_LOG()->AddApender(LOG_TYPE_INFO, nullptr, TEXT("Info.log"), LOG_MODE_FILE_TIME);
+    if (HasSuite("appender"))
+    {
+        for (const STBenchAppender& objAppender : g_arrBenchAppender)
+        {
+            CY_LOG()->AddApender(objAppender.eLogType, nullptr, objAppender.pszFile, static_cast<ELogFileMode>(objAppender.nFileMode));
+        }
+    }
+
+    CYBenchJson objJson;
+    objJson.BeginObject();
+    objJson.Value("version", static_cast<uint64_t>(BENCH_JSON_VERSION));
+    objJson.Value("lines", nLines);
+    objJson.Value("hardware_threads", static_cast<uint64_t>(std::thread::hardware_concurrency()));
+    objJson.Value("timer_overhead_ns", MeasureTimerOverhead());
+
+    if (HasSuite("macro"))
+        RunMacroSuite(nLines, objJson);
+    if (HasSuite("filter"))
+        RunFilterSuite(nLines, objJson);
+    if (HasSuite("thread"))
+        RunThreadSuite(nLines, nMaxThreads, objJson);
+    if (HasSuite("appender"))
+        RunAppenderSuite(nLines, objJson);
+    if (HasSuite("layout"))
+        RunLayoutSuite(nLines, objJson);
+    if (HasSuite("latency"))
+        RunLatencySuite(nLines, objJson);
+
+    objJson.EndObject();
+    CY_LOG_FREE();
+
+    if (strOutput.empty())
+    {
+        std::cout << objJson.ToString() << std::endl;
+        return 0;
+    }
+
+    std::ofstream objFile(strOutput, std::ios_base::out | std::ios_base::trunc);
+    objFile << objJson.ToString() << std::endl;
+    if (!objFile)
+    {
+        std::cerr << "cannot write " << strOutput << std::endl;
+        return 1;
+    }
+    return 0;
+}